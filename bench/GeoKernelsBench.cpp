@@ -0,0 +1,318 @@
+#include "core/geo/Geodesy.h"
+#include "ui/draw/DrawingGeometry.h"
+
+#include <benchmark/benchmark.h>
+
+#include <osg/Vec3d>
+#include <osgEarth/GeoData>
+#include <osgEarth/SpatialReference>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr double kAirportLon = 119.28;
+constexpr double kAirportLat = 26.01;
+constexpr double kSpreadDeg = 0.5;
+
+/**
+ * @brief 机场周边 ±0.5° 内的确定性随机点集，SoA 布局；各基准共用同一组输入。
+ */
+struct PointSet {
+    std::vector<double> lon;
+    std::vector<double> lat;
+    std::vector<double> height;
+
+    explicit PointSet(std::size_t count, unsigned int seed = 42U)
+        : lon(count)
+        , lat(count)
+        , height(count) {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<double> offset(-kSpreadDeg, kSpreadDeg);
+        std::uniform_real_distribution<double> altitude(0.0, 3000.0);
+        for (std::size_t i = 0; i < count; ++i) {
+            lon[i] = kAirportLon + offset(engine);
+            lat[i] = kAirportLat + offset(engine);
+            height[i] = altitude(engine);
+        }
+    }
+};
+
+/**
+ * @brief 基准期间强制批量核的指令集，第二个参数 0 为标量、1 为本机最高级别；结束时恢复。
+ */
+class SimdLevelScope {
+public:
+    explicit SimdLevelScope(benchmark::State& state)
+        : m_previous(earth::core::geo::activeSimdLevel()) {
+        const earth::core::geo::SimdLevel level = state.range(1) == 0 ? earth::core::geo::SimdLevel::Scalar
+                                                                      : earth::core::geo::detectedSimdLevel();
+        state.SetLabel(earth::core::geo::simdLevelName(earth::core::geo::setSimdLevel(level)));
+    }
+    ~SimdLevelScope() { earth::core::geo::setSimdLevel(m_previous); }
+
+    SimdLevelScope(const SimdLevelScope&) = delete;
+    SimdLevelScope& operator=(const SimdLevelScope&) = delete;
+
+private:
+    earth::core::geo::SimdLevel m_previous;
+};
+
+void batchArgs(benchmark::internal::Benchmark* bench) {
+    for (const int64_t count : {64, 4096, 32768}) {
+        bench->Args({count, 0});
+        bench->Args({count, 1});
+    }
+}
+
+// ---- haversine：MapDrawingController::distanceMeters 的逐点调用 vs 批量接口 ----
+
+void BM_HaversinePerPoint(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet a(count, 1U);
+    const PointSet b(count, 2U);
+    std::vector<double> out(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = earth::core::geo::haversineMeters(a.lon[i], a.lat[i], b.lon[i], b.lat[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HaversinePerPoint)->RangeMultiplier(8)->Range(64, 32768);
+
+void BM_HaversineBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet a(count, 1U);
+    const PointSet b(count, 2U);
+    std::vector<double> out(count);
+    for (auto _ : state) {
+        earth::core::geo::haversineMeters(a.lon.data(), a.lat.data(), b.lon.data(), b.lat.data(), out.data(), count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HaversineBatch)->Apply(batchArgs);
+
+// ---- Vincenty / 方位角 / 正算：航迹量测与预测使用的批量核 ----
+
+void BM_VincentyPerPoint(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet a(count, 1U);
+    const PointSet b(count, 2U);
+    std::vector<double> out(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = earth::core::geo::vincentyMeters(a.lon[i], a.lat[i], b.lon[i], b.lat[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VincentyPerPoint)->Arg(4096);
+
+void BM_VincentyBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet a(count, 1U);
+    const PointSet b(count, 2U);
+    std::vector<double> out(count);
+    for (auto _ : state) {
+        earth::core::geo::vincentyMeters(a.lon.data(), a.lat.data(), b.lon.data(), b.lat.data(), out.data(), count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VincentyBatch)->Apply(batchArgs);
+
+void BM_InitialBearingBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet a(count, 1U);
+    const PointSet b(count, 2U);
+    std::vector<double> out(count);
+    for (auto _ : state) {
+        earth::core::geo::initialBearingDeg(a.lon.data(), a.lat.data(), b.lon.data(), b.lat.data(), out.data(),
+                                            count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InitialBearingBatch)->Apply(batchArgs);
+
+void BM_DestinationPointBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    // height 列复用为行进距离（0~3 km），lat 列平移后作为方位角。
+    std::vector<double> bearing(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        bearing[i] = (points.lat[i] - kAirportLat + kSpreadDeg) * 360.0;
+    }
+    std::vector<double> lon(count);
+    std::vector<double> lat(count);
+    for (auto _ : state) {
+        earth::core::geo::destinationPoint(points.lon.data(), points.lat.data(), bearing.data(),
+                                           points.height.data(), lon.data(), lat.data(), count);
+        benchmark::DoNotOptimize(lat.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DestinationPointBatch)->Apply(batchArgs);
+
+// ---- 矩形绘制：拖拽预览每帧调用一次 ----
+
+void BM_RectangleVertices(benchmark::State& state) {
+    const earth::ui::draw::MapGeoPoint first {kAirportLon, kAirportLat, 10.0};
+    earth::ui::draw::MapGeoPoint second {kAirportLon + 0.01, kAirportLat - 0.01, 20.0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(second);
+        auto corners = earth::ui::draw::rectangleVertices(first, second);
+        benchmark::DoNotOptimize(corners);
+    }
+}
+BENCHMARK(BM_RectangleVertices);
+
+// ---- 大地坐标 <-> ECEF：自有实现 vs computeGeoAt 中使用的 osgEarth GeoPoint ----
+
+void BM_GeodeticToEcef(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    std::vector<earth::core::geo::Ecef> out(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = earth::core::geo::geodeticToEcef(points.lon[i], points.lat[i], points.height[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GeodeticToEcef)->Arg(4096);
+
+void BM_EcefToGeodetic(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    std::vector<earth::core::geo::Ecef> world(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        world[i] = earth::core::geo::geodeticToEcef(points.lon[i], points.lat[i], points.height[i]);
+    }
+    std::vector<double> lon(count);
+    std::vector<double> lat(count);
+    std::vector<double> height(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            earth::core::geo::ecefToGeodetic(world[i], lon[i], lat[i], height[i]);
+        }
+        benchmark::DoNotOptimize(height.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EcefToGeodetic)->Arg(4096);
+
+void BM_GeodeticToEcefBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> z(count);
+    for (auto _ : state) {
+        earth::core::geo::geodeticToEcef(points.lon.data(), points.lat.data(), points.height.data(), x.data(),
+                                         y.data(), z.data(), count);
+        benchmark::DoNotOptimize(z.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GeodeticToEcefBatch)->Apply(batchArgs);
+
+void BM_EcefToGeodeticBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> z(count);
+    earth::core::geo::geodeticToEcef(points.lon.data(), points.lat.data(), points.height.data(), x.data(), y.data(),
+                                     z.data(), count);
+    std::vector<double> lon(count);
+    std::vector<double> lat(count);
+    std::vector<double> height(count);
+    for (auto _ : state) {
+        earth::core::geo::ecefToGeodetic(x.data(), y.data(), z.data(), lon.data(), lat.data(), height.data(), count);
+        benchmark::DoNotOptimize(height.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EcefToGeodeticBatch)->Apply(batchArgs);
+
+void BM_GeodeticToEnuBatch(benchmark::State& state) {
+    const SimdLevelScope simd(state);
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    const earth::core::geo::EnuFrame frame = earth::core::geo::EnuFrame::at(kAirportLon, kAirportLat, 0.0);
+    std::vector<double> east(count);
+    std::vector<double> north(count);
+    std::vector<double> up(count);
+    for (auto _ : state) {
+        earth::core::geo::geodeticToEnu(frame, points.lon.data(), points.lat.data(), points.height.data(),
+                                        east.data(), north.data(), up.data(), count);
+        benchmark::DoNotOptimize(up.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GeodeticToEnuBatch)->Apply(batchArgs);
+
+void BM_OsgEarthGeoPointToWorld(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    const osgEarth::SpatialReference* wgs84 = osgEarth::SpatialReference::get("wgs84");
+    std::vector<osg::Vec3d> out(count);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            osgEarth::GeoPoint(wgs84, points.lon[i], points.lat[i], points.height[i], osgEarth::ALTMODE_ABSOLUTE)
+                .toWorld(out[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OsgEarthGeoPointToWorld)->Arg(4096);
+
+void BM_OsgEarthGeoPointFromWorld(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const PointSet points(count);
+    const osgEarth::SpatialReference* wgs84 = osgEarth::SpatialReference::get("wgs84");
+    std::vector<osg::Vec3d> world(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        osgEarth::GeoPoint(wgs84, points.lon[i], points.lat[i], points.height[i], osgEarth::ALTMODE_ABSOLUTE)
+            .toWorld(world[i]);
+    }
+    osgEarth::GeoPoint point;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            point.fromWorld(wgs84, world[i]);
+            benchmark::DoNotOptimize(point);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OsgEarthGeoPointFromWorld)->Arg(4096);
+
+} // namespace
@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+
+#include <osg/Geode>
+#include <osg/GL>
+#include <osg/Shape>
+#include <osg/ShapeDrawable>
+#include <osgGA/TrackballManipulator>
+#include <osgQt/GraphicsWindowQt>
+#include <osgViewer/Viewer>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QWidget>
+#include <QWindow>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 600;
+constexpr int kWarmupFrames = 10;
+constexpr int kExposeTimeoutMs = 2000;
+
+enum Backend : int64_t { kGLWidget = 0, kQWindow = 1 };
+
+/**
+ * @brief 宿主窗口 + 一种后端的 GL 表面 + 单线程 viewer，与 SceneWidget 的嵌入方式一致。
+ */
+struct Surface {
+    std::unique_ptr<QWidget> host;
+    osg::ref_ptr<osgViewer::GraphicsWindow> window;
+    QObject* input = nullptr;
+    osg::ref_ptr<osgViewer::Viewer> viewer;
+};
+
+osg::ref_ptr<osg::GraphicsContext::Traits> createTraits(QWidget* host, Backend backend) {
+    osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+    traits->windowDecoration = false;
+    traits->doubleBuffer = true;
+    traits->width = kWidth;
+    traits->height = kHeight;
+    traits->alpha = 8;
+    traits->stencil = 8;
+    // 交换间隔为 0，测到的是管线本身的延迟而不是等垂直同步的时间。
+    traits->vsync = false;
+    if (backend == kQWindow) {
+        traits->inheritedWindowData = new osgQt::GraphicsWindowQWindow::WindowData(host);
+    } else {
+        traits->inheritedWindowData = new osgQt::GraphicsWindowQt::WindowData(nullptr, host);
+    }
+    return traits;
+}
+
+bool createSurface(Backend backend, Surface& surface) {
+    surface.host = std::make_unique<QWidget>();
+    surface.host->resize(kWidth, kHeight);
+
+    osg::ref_ptr<osg::GraphicsContext::Traits> traits = createTraits(surface.host.get(), backend);
+    QWidget* child = nullptr;
+    if (backend == kQWindow) {
+        osg::ref_ptr<osgQt::GraphicsWindowQWindow> window =
+            new osgQt::GraphicsWindowQWindow(traits.get(), surface.host.get());
+        if (!window->valid()) {
+            return false;
+        }
+        child = window->getContainer();
+        surface.input = window->getGLWindow();
+        surface.window = window;
+    } else {
+        osg::ref_ptr<osgQt::GraphicsWindowQt> window = new osgQt::GraphicsWindowQt(traits.get(), surface.host.get());
+        if (window->getGLWidget() == nullptr) {
+            return false;
+        }
+        child = window->getGLWidget();
+        surface.input = window->getGLWidget();
+        surface.window = window;
+    }
+    child->setGeometry(0, 0, kWidth, kHeight);
+    surface.host->show();
+
+    // 等待表面真正映射到屏幕上，未曝光时两种后端都会跳过交换。
+    QWindow* exposed = backend == kQWindow ? static_cast<QWindow*>(surface.input) : child->windowHandle();
+    QElapsedTimer exposeTimer;
+    exposeTimer.start();
+    while (!child->isVisible() || (exposed != nullptr && !exposed->isExposed())) {
+        QApplication::processEvents(QEventLoop::AllEvents, 10);
+        if (exposeTimer.elapsed() > kExposeTimeoutMs) {
+            return false;
+        }
+    }
+
+    osg::ref_ptr<osg::Geode> scene = new osg::Geode;
+    scene->addDrawable(new osg::ShapeDrawable(new osg::Sphere(osg::Vec3(), 1.0F)));
+
+    surface.viewer = new osgViewer::Viewer;
+    surface.viewer->setThreadingModel(osgViewer::Viewer::SingleThreaded);
+    surface.viewer->getCamera()->setGraphicsContext(surface.window.get());
+    surface.viewer->getCamera()->setViewport(0, 0, kWidth, kHeight);
+    surface.viewer->getCamera()->setProjectionMatrixAsPerspective(30.0, static_cast<double>(kWidth) / kHeight, 1.0, 100.0);
+    surface.viewer->setCameraManipulator(new osgGA::TrackballManipulator);
+    surface.viewer->setSceneData(scene.get());
+    surface.viewer->realize();
+    return surface.viewer->isRealized();
+}
+
+/**
+ * @brief 输入到画面的延迟：从 Qt 收到一次拖拽移动，到 osgGA 处理、绘制、交换并 glFinish 完成的时间。
+ *        参数 0 为 QGLWidget 后端，1 为 QWindow + QOpenGLContext 后端。
+ */
+void BM_InputToSwapLatency(benchmark::State& state) {
+    const auto backend = static_cast<Backend>(state.range(0));
+    state.SetLabel(backend == kQWindow ? "QWindow" : "QGLWidget");
+
+    Surface surface;
+    if (!createSurface(backend, surface)) {
+        state.SkipWithError("GL surface unavailable (needs a display)");
+        return;
+    }
+
+    const QPointF center(kWidth * 0.5, kHeight * 0.5);
+    QMouseEvent press(QEvent::MouseButtonPress, center, Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(surface.input, &press);
+    for (int i = 0; i < kWarmupFrames; ++i) {
+        surface.viewer->frame();
+    }
+
+    QElapsedTimer timer;
+    double frameMsTotal = 0.0;
+    int step = 0;
+    for (auto _ : state) {
+        const QPointF pos(center.x() + (step % 2 == 0 ? 20.0 : -20.0), center.y());
+        ++step;
+
+        timer.start();
+        QMouseEvent move(QEvent::MouseMove, pos, Qt::NoButton, Qt::LeftButton, Qt::NoModifier);
+        QCoreApplication::sendEvent(surface.input, &move);
+        const qint64 frameStart = timer.nsecsElapsed();
+        surface.viewer->frame();
+        // frame() 结束时已释放上下文（QWindow 后端还解除了线程归属），重新设为当前后 glFinish 才会等待 GPU 完成。
+        if (surface.window->makeCurrent()) {
+            glFinish();
+        }
+        const qint64 end = timer.nsecsElapsed();
+
+        frameMsTotal += static_cast<double>(end - frameStart) / 1.0e6;
+        state.SetIterationTime(static_cast<double>(end) / 1.0e9);
+    }
+
+    QMouseEvent release(QEvent::MouseButtonRelease, center, Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(surface.input, &release);
+
+    state.counters["frame_ms"] = benchmark::Counter(frameMsTotal / static_cast<double>(std::max(step, 1)));
+    surface.window->releaseContext();
+    surface.viewer = nullptr;
+}
+BENCHMARK(BM_InputToSwapLatency)->Arg(kGLWidget)->Arg(kQWindow)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+/**
+ * @brief GL 表面需要 QApplication 与真实的显示连接，因此不使用 benchmark_main。
+ */
+int main(int argc, char** argv) {
+    QApplication app(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,271 @@
+#include "airtraffic/AirTrafficLayer.h"
+
+#include "airtraffic/TrackRecorder.h"
+#include "airtraffic/TrackReplayPlayer.h"
+
+#include "core/FrameMetrics.h"
+
+#include <chrono>
+#include <cmath>
+
+#include <osg/CoordinateSystemNode>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Math>
+#include <osg/MatrixTransform>
+#include <osg/NodeCallback>
+#include <osg/NodeVisitor>
+#include <osg/StateAttribute>
+
+#include <osgEarth/GeoData>
+#include <osgEarth/MapNode>
+#include <osgEarth/SpatialReference>
+
+namespace {
+constexpr float kMarkerLengthMeters = 70.0F;
+constexpr float kMarkerSpanMeters = 50.0F;
+
+/**
+ * @brief 在 update 遍历中驱动 AirTrafficLayer 的预测与节点刷新。
+ */
+class TrackUpdateCallback final : public osg::NodeCallback {
+public:
+    explicit TrackUpdateCallback(earth::airtraffic::AirTrafficLayer* layer)
+        : m_layer(layer) {
+    }
+
+    void operator()(osg::Node* node, osg::NodeVisitor* nv) override {
+        if (m_layer != nullptr) {
+            m_layer->updateTraversal();
+        }
+        traverse(node, nv);
+    }
+
+    void detach() noexcept { m_layer = nullptr; }
+
+private:
+    earth::airtraffic::AirTrafficLayer* m_layer = nullptr;
+};
+
+double systemClockSeconds() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+} // namespace
+
+namespace earth::airtraffic {
+
+AirTrafficLayer::AirTrafficLayer()
+    : m_root(new osg::Group())
+    , m_ellipsoid(new osg::EllipsoidModel()) {
+    m_root->setName("AirTrafficRoot");
+    m_updateCallback = new TrackUpdateCallback(this);
+    m_root->setUpdateCallback(m_updateCallback.get());
+}
+
+AirTrafficLayer::~AirTrafficLayer() {
+    if (auto* callback = dynamic_cast<TrackUpdateCallback*>(m_updateCallback.get())) {
+        callback->detach();
+    }
+    if (m_root.valid()) {
+        m_root->setUpdateCallback(nullptr);
+    }
+    detachRoot();
+}
+
+void AirTrafficLayer::setMapNode(osgEarth::MapNode* node) {
+    if (m_mapNode.get() == node) {
+        return;
+    }
+    detachRoot();
+    m_mapNode = node;
+    attachRoot();
+}
+
+void AirTrafficLayer::submitReport(const TrackReport& report) {
+    std::lock_guard<std::mutex> lock(m_inboxMutex);
+    m_inbox.push_back(report);
+}
+
+void AirTrafficLayer::submitReports(const std::vector<TrackReport>& reports) {
+    std::lock_guard<std::mutex> lock(m_inboxMutex);
+    m_inbox.insert(m_inbox.end(), reports.begin(), reports.end());
+}
+
+void AirTrafficLayer::clearTracks() {
+    std::lock_guard<std::mutex> lock(m_inboxMutex);
+    m_inbox.clear();
+    m_clearRequested = true;
+}
+
+void AirTrafficLayer::setClock(Clock clock) {
+    m_clock = std::move(clock);
+}
+
+void AirTrafficLayer::setReportSource(ReportSource source) {
+    m_reportSource = std::move(source);
+}
+
+void AirTrafficLayer::setExtrapolationMode(ExtrapolationMode mode) {
+    m_predictor.setMode(mode);
+}
+
+void AirTrafficLayer::setRecorder(TrackRecorder* recorder) {
+    m_recorder = recorder;
+}
+
+void AirTrafficLayer::setReplayPlayer(TrackReplayPlayer* player) {
+    if (m_replayPlayer == player) {
+        return;
+    }
+    m_replayPlayer = player;
+    m_predictor.clear();
+}
+
+osg::Group* AirTrafficLayer::root() const {
+    return m_root.get();
+}
+
+void AirTrafficLayer::updateTraversal() {
+    bool clearRequested = false;
+    {
+        std::lock_guard<std::mutex> lock(m_inboxMutex);
+        m_pending.swap(m_inbox);
+        clearRequested = m_clearRequested;
+        m_clearRequested = false;
+    }
+    if (m_reportSource) {
+        m_reportSource(m_pending);
+    }
+
+    const bool replaying = m_replayPlayer != nullptr && m_replayPlayer->isOpen();
+    if (replaying) {
+        m_replayPlayer->update(m_predictor);
+    } else {
+        if (clearRequested) {
+            m_predictor.clear();
+        }
+        for (const TrackReport& report : m_pending) {
+            m_predictor.ingest(report);
+        }
+    }
+
+    const double nowSec = now();
+    if (!replaying && m_recorder != nullptr && m_recorder->isRecording()) {
+        m_recorder->record(m_pending, m_predictor, nowSec);
+    }
+    m_pending.clear();
+    m_predictor.prune(nowSec);
+    m_predictor.predict(nowSec);
+
+    const auto applyStart = std::chrono::steady_clock::now();
+    applyPredictions();
+    const auto applyEnd = std::chrono::steady_clock::now();
+
+    auto& metrics = core::FrameMetrics::instance();
+    metrics.recordDuration("airtraffic.predict", m_predictor.stats().lastPassMs);
+    metrics.recordDuration("airtraffic.apply", std::chrono::duration<double, std::milli>(applyEnd - applyStart).count());
+    metrics.recordValue("airtraffic.tracks", static_cast<double>(m_predictor.size()), "条");
+}
+
+void AirTrafficLayer::attachRoot() {
+    osgEarth::MapNode* node = m_mapNode.get();
+    if (node == nullptr || !m_root.valid()) {
+        return;
+    }
+    if (!node->containsNode(m_root.get())) {
+        node->addChild(m_root.get());
+    }
+}
+
+void AirTrafficLayer::detachRoot() {
+    osgEarth::MapNode* node = m_mapNode.get();
+    if (node != nullptr && m_root.valid()) {
+        node->removeChild(m_root.get());
+    }
+}
+
+void AirTrafficLayer::applyPredictions() {
+    const std::size_t count = m_predictor.size();
+
+    // 节点按预测器索引复用：第 i 个节点总是显示第 i 条航迹，增删航迹时无需重建子树。
+    while (m_trackNodes.size() < count) {
+        osg::ref_ptr<osg::MatrixTransform> transform = new osg::MatrixTransform();
+        transform->addChild(markerNode());
+        m_trackNodes.push_back(transform);
+    }
+
+    const unsigned int visible = static_cast<unsigned int>(count);
+    if (m_root->getNumChildren() > visible) {
+        m_root->removeChildren(visible, m_root->getNumChildren() - visible);
+    }
+    while (m_root->getNumChildren() < visible) {
+        m_root->addChild(m_trackNodes[m_root->getNumChildren()].get());
+    }
+
+    const osgEarth::MapNode* mapNode = m_mapNode.get();
+    const osgEarth::SpatialReference* mapSRS = mapNode != nullptr ? mapNode->getMapSRS() : nullptr;
+    const bool geocentric = mapSRS == nullptr || mapSRS->isGeographic();
+    const osgEarth::SpatialReference* geoSRS = mapSRS != nullptr ? mapSRS->getGeographicSRS() : nullptr;
+
+    const std::vector<double>& lon = m_predictor.longitudes();
+    const std::vector<double>& lat = m_predictor.latitudes();
+    const std::vector<double>& alt = m_predictor.altitudes();
+    const std::vector<double>& heading = m_predictor.headings();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        osg::Matrixd localToWorld;
+        if (geocentric) {
+            m_ellipsoid->computeLocalToWorldTransformFromLatLongHeight(
+                osg::DegreesToRadians(lat[i]), osg::DegreesToRadians(lon[i]), alt[i], localToWorld);
+        } else if (geoSRS != nullptr) {
+            osgEarth::GeoPoint point(geoSRS, lon[i], lat[i], alt[i], osgEarth::ALTMODE_ABSOLUTE);
+            point.createLocalToWorld(localToWorld);
+        }
+        const osg::Matrixd rotation = osg::Matrixd::rotate(-osg::DegreesToRadians(heading[i]), osg::Vec3d(0.0, 0.0, 1.0));
+        m_trackNodes[i]->setMatrix(rotation * localToWorld);
+    }
+}
+
+osg::Node* AirTrafficLayer::markerNode() {
+    if (m_marker.valid()) {
+        return m_marker.get();
+    }
+
+    // 局部 ENU 坐标系下的箭头轮廓：+Y 指向机头（正北），旋转由航向决定。
+    osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array();
+    vertices->push_back(osg::Vec3(0.0F, kMarkerLengthMeters * 0.5F, 0.0F));
+    vertices->push_back(osg::Vec3(-kMarkerSpanMeters * 0.5F, -kMarkerLengthMeters * 0.5F, 0.0F));
+    vertices->push_back(osg::Vec3(0.0F, -kMarkerLengthMeters * 0.25F, 0.0F));
+    vertices->push_back(osg::Vec3(0.0F, kMarkerLengthMeters * 0.5F, 0.0F));
+    vertices->push_back(osg::Vec3(0.0F, -kMarkerLengthMeters * 0.25F, 0.0F));
+    vertices->push_back(osg::Vec3(kMarkerSpanMeters * 0.5F, -kMarkerLengthMeters * 0.5F, 0.0F));
+
+    osg::ref_ptr<osg::Vec4Array> colors = new osg::Vec4Array();
+    colors->push_back(osg::Vec4(1.0F, 0.85F, 0.1F, 1.0F));
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geometry->setName("AirTrafficMarker");
+    geometry->setVertexArray(vertices.get());
+    geometry->setColorArray(colors.get(), osg::Array::BIND_OVERALL);
+    geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices->size())));
+    geometry->setUseVertexBufferObjects(true);
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable(geometry.get());
+    geode->getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    geode->getOrCreateStateSet()->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+
+    m_marker = geode;
+    return m_marker.get();
+}
+
+double AirTrafficLayer::now() const {
+    if (m_replayPlayer != nullptr && m_replayPlayer->isOpen()) {
+        return m_replayPlayer->currentTime();
+    }
+    return m_clock ? m_clock() : systemClockSeconds();
+}
+
+} // namespace earth::airtraffic
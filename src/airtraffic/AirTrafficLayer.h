@@ -0,0 +1,135 @@
+#pragma once
+
+#include "airtraffic/TrackPredictor.h"
+#include "airtraffic/TrackTypes.h"
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace osg {
+class EllipsoidModel;
+class Group;
+class MatrixTransform;
+class Node;
+class NodeCallback;
+} // namespace osg
+
+namespace osgEarth {
+class MapNode;
+}
+
+namespace earth::airtraffic {
+
+class TrackRecorder;
+class TrackReplayPlayer;
+
+/**
+ * @brief 空管交通图层：接收航迹报文，在每帧 update 遍历中批量外推并写回目标节点位置。
+ *
+ * 报文可以从任意线程提交，先进入收件箱，再由 update 遍历统一并入预测器，
+ * 因此渲染线程只在每帧开始时持有一次短暂的锁。
+ */
+class AirTrafficLayer {
+public:
+    /**
+     * @brief 预测时钟，返回与报文时间戳同一基准的“当前时刻”（秒）。
+     */
+    using Clock = std::function<double()>;
+
+    /**
+     * @brief 每帧拉取式报文源，在 update 遍历中被调用，把新报文追加到传入的容器。
+     */
+    using ReportSource = std::function<void(std::vector<TrackReport>&)>;
+
+    AirTrafficLayer();
+    ~AirTrafficLayer();
+
+    AirTrafficLayer(const AirTrafficLayer&) = delete;
+    AirTrafficLayer& operator=(const AirTrafficLayer&) = delete;
+
+    /**
+     * @brief 更新挂载的 MapNode，图层根节点会随之迁移。
+     */
+    void setMapNode(osgEarth::MapNode* node);
+
+    /**
+     * @brief 提交一条航迹报文，线程安全。
+     */
+    void submitReport(const TrackReport& report);
+
+    /**
+     * @brief 批量提交航迹报文，线程安全。
+     */
+    void submitReports(const std::vector<TrackReport>& reports);
+
+    /**
+     * @brief 请求在下一次 update 遍历中清空全部航迹，线程安全。
+     */
+    void clearTracks();
+
+    /**
+     * @brief 替换预测时钟；传入空函数时恢复为系统 UTC 时钟。挂接回放器时以回放时钟为准。
+     */
+    void setClock(Clock clock);
+
+    /**
+     * @brief 设置每帧拉取的报文源（如数据桥接模块），省去跨线程收件箱；传入空函数取消。
+     */
+    void setReportSource(ReportSource source);
+
+    void setExtrapolationMode(ExtrapolationMode mode);
+
+    /**
+     * @brief 挂接录制器，每帧合并的报文与周期关键帧都会写入日志；传入 nullptr 停止挂接。
+     */
+    void setRecorder(TrackRecorder* recorder);
+
+    /**
+     * @brief 挂接回放器。回放期间忽略实时报文，预测时钟切换为回放时钟；传入 nullptr 恢复实时模式。
+     */
+    void setReplayPlayer(TrackReplayPlayer* player);
+
+    /**
+     * @brief 访问预测器，仅允许在 update 遍历所在线程（GUI 线程）调用。
+     */
+    [[nodiscard]] TrackPredictor& predictor() noexcept { return m_predictor; }
+    [[nodiscard]] const TrackPredictor& predictor() const noexcept { return m_predictor; }
+
+    [[nodiscard]] osg::Group* root() const;
+
+    /**
+     * @brief 由 update 回调调用：合并收件箱、批量外推并刷新目标节点。
+     */
+    void updateTraversal();
+
+private:
+    void attachRoot();
+    void detachRoot();
+    void applyPredictions();
+    [[nodiscard]] osg::Node* markerNode();
+    [[nodiscard]] double now() const;
+
+    osg::ref_ptr<osg::Group> m_root;
+    osg::ref_ptr<osg::NodeCallback> m_updateCallback;
+    osg::ref_ptr<osg::Node> m_marker;
+    osg::ref_ptr<osg::EllipsoidModel> m_ellipsoid;
+    osg::observer_ptr<osgEarth::MapNode> m_mapNode;
+    std::vector<osg::ref_ptr<osg::MatrixTransform>> m_trackNodes;
+
+    std::mutex m_inboxMutex;
+    std::vector<TrackReport> m_inbox;
+    std::vector<TrackReport> m_pending;
+    bool m_clearRequested = false;
+
+    TrackPredictor m_predictor;
+    Clock m_clock;
+    ReportSource m_reportSource;
+    TrackRecorder* m_recorder = nullptr;
+    TrackReplayPlayer* m_replayPlayer = nullptr;
+};
+
+} // namespace earth::airtraffic
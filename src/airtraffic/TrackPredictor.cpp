@@ -0,0 +1,252 @@
+#include "airtraffic/TrackPredictor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+constexpr double kEarthRadius = 6378137.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+constexpr double kRadToDeg = 180.0 / kPi;
+constexpr double kMinCosLatitude = 1e-6;
+// 偏差超过该距离（米）时视为跳点，直接吸附到新报文而不再平滑过渡。
+constexpr double kMaxSmoothingMeters = 2000.0;
+
+inline double wrapPi(double angle) {
+    return std::remainder(angle, 2.0 * kPi);
+}
+
+inline double wrapDegrees(double angle) {
+    return std::remainder(angle, 360.0);
+}
+} // namespace
+
+namespace earth::airtraffic {
+
+void TrackPredictor::setSmoothingSeconds(double seconds) noexcept {
+    m_smoothingSeconds = std::max(seconds, 1e-3);
+}
+
+void TrackPredictor::setMaxCoastSeconds(double seconds) noexcept {
+    m_maxCoastSeconds = std::max(seconds, 0.0);
+}
+
+void TrackPredictor::setStaleSeconds(double seconds) noexcept {
+    m_staleSeconds = std::max(seconds, 0.0);
+}
+
+void TrackPredictor::ingest(const TrackReport& report) {
+    const double lon = report.longitudeDeg * kDegToRad;
+    const double lat = report.latitudeDeg * kDegToRad;
+
+    std::size_t index = 0;
+    double offsetLon = 0.0;
+    double offsetLat = 0.0;
+    double offsetAlt = 0.0;
+
+    auto found = m_indexById.find(report.trackId);
+    if (found == m_indexById.end()) {
+        index = m_ids.size();
+        resizeStorage(index + 1);
+        m_ids[index] = report.trackId;
+        m_indexById.emplace(report.trackId, index);
+    } else {
+        index = found->second;
+        const double dt = report.timestampSec - m_fixTime[index];
+        if (dt <= 0.0) {
+            // 乱序或重复报文：保留已有状态。
+            return;
+        }
+
+        double shownLon = 0.0;
+        double shownLat = 0.0;
+        double shownAlt = 0.0;
+        double heading = 0.0;
+        extrapolate(index, dt, shownLon, shownLat, shownAlt, heading);
+        const double decay = std::exp(-dt / m_smoothingSeconds);
+        shownLon += m_offsetLon[index] * decay;
+        shownLat += m_offsetLat[index] * decay;
+        shownAlt += m_offsetAlt[index] * decay;
+
+        offsetLon = wrapPi(shownLon - lon);
+        offsetLat = shownLat - lat;
+        offsetAlt = shownAlt - report.altitudeMeters;
+
+        const double northMeters = offsetLat * kEarthRadius;
+        const double eastMeters = offsetLon * kEarthRadius * std::cos(lat);
+        if (std::hypot(northMeters, eastMeters) > kMaxSmoothingMeters) {
+            offsetLon = 0.0;
+            offsetLat = 0.0;
+            offsetAlt = 0.0;
+        }
+    }
+
+    m_fixLon[index] = lon;
+    m_fixLat[index] = lat;
+    m_fixAlt[index] = report.altitudeMeters;
+    m_fixTime[index] = report.timestampSec;
+    m_speed[index] = std::max(report.groundSpeedMps, 0.0);
+    m_track[index] = report.trackDeg * kDegToRad;
+    m_verticalRate[index] = report.verticalRateMps;
+    m_offsetLon[index] = offsetLon;
+    m_offsetLat[index] = offsetLat;
+    m_offsetAlt[index] = offsetAlt;
+}
+
+std::size_t TrackPredictor::prune(double nowSec) {
+    std::size_t removed = 0;
+    std::size_t index = 0;
+    while (index < m_ids.size()) {
+        if (nowSec - m_fixTime[index] > m_staleSeconds) {
+            removeAt(index);
+            ++removed;
+        } else {
+            ++index;
+        }
+    }
+    return removed;
+}
+
+void TrackPredictor::clear() {
+    m_indexById.clear();
+    m_ids.clear();
+    resizeStorage(0);
+    m_stats = {};
+}
+
+void TrackPredictor::predict(double nowSec) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const std::size_t count = m_ids.size();
+    const double invTau = 1.0 / m_smoothingSeconds;
+    const double maxCoast = m_maxCoastSeconds;
+
+    const double* fixLon = m_fixLon.data();
+    const double* fixLat = m_fixLat.data();
+    const double* fixAlt = m_fixAlt.data();
+    const double* fixTime = m_fixTime.data();
+    const double* speed = m_speed.data();
+    const double* track = m_track.data();
+    const double* verticalRate = m_verticalRate.data();
+    const double* offsetLon = m_offsetLon.data();
+    const double* offsetLat = m_offsetLat.data();
+    const double* offsetAlt = m_offsetAlt.data();
+    double* outLon = m_outLon.data();
+    double* outLat = m_outLat.data();
+    double* outAlt = m_outAlt.data();
+    double* outHeading = m_outHeading.data();
+
+    if (m_mode == ExtrapolationMode::Linear) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const double age = std::max(nowSec - fixTime[i], 0.0);
+            const double dt = std::min(age, maxCoast);
+            const double distance = speed[i] * dt;
+            const double cosLat = std::max(std::cos(fixLat[i]), kMinCosLatitude);
+            const double decay = std::exp(-age * invTau);
+
+            const double lat = fixLat[i] + distance * std::cos(track[i]) / kEarthRadius;
+            const double lon = fixLon[i] + distance * std::sin(track[i]) / (kEarthRadius * cosLat);
+            outLat[i] = (lat + offsetLat[i] * decay) * kRadToDeg;
+            outLon[i] = wrapDegrees((lon + offsetLon[i] * decay) * kRadToDeg);
+            outAlt[i] = fixAlt[i] + verticalRate[i] * dt + offsetAlt[i] * decay;
+            outHeading[i] = track[i] * kRadToDeg;
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            const double age = std::max(nowSec - fixTime[i], 0.0);
+            const double dt = std::min(age, maxCoast);
+            const double delta = speed[i] * dt / kEarthRadius;
+            const double decay = std::exp(-age * invTau);
+
+            const double sinLat1 = std::sin(fixLat[i]);
+            const double cosLat1 = std::cos(fixLat[i]);
+            const double sinDelta = std::sin(delta);
+            const double cosDelta = std::cos(delta);
+            const double sinTrack = std::sin(track[i]);
+            const double cosTrack = std::cos(track[i]);
+
+            const double sinLat2 = std::clamp(sinLat1 * cosDelta + cosLat1 * sinDelta * cosTrack, -1.0, 1.0);
+            const double lat = std::asin(sinLat2);
+            const double lon = fixLon[i] + std::atan2(sinTrack * sinDelta * cosLat1, cosDelta - sinLat1 * sinLat2);
+            const double heading = std::atan2(sinTrack * cosLat1, cosDelta * cosLat1 * cosTrack - sinLat1 * sinDelta);
+
+            outLat[i] = (lat + offsetLat[i] * decay) * kRadToDeg;
+            outLon[i] = wrapDegrees((lon + offsetLon[i] * decay) * kRadToDeg);
+            outAlt[i] = fixAlt[i] + verticalRate[i] * dt + offsetAlt[i] * decay;
+            outHeading[i] = heading * kRadToDeg;
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    m_stats.trackCount = count;
+    m_stats.lastPassMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::vector<TrackReport> TrackPredictor::latestFixes() const {
+    std::vector<TrackReport> fixes;
+    fixes.reserve(m_ids.size());
+    for (std::size_t i = 0; i < m_ids.size(); ++i) {
+        TrackReport report;
+        report.trackId = m_ids[i];
+        report.timestampSec = m_fixTime[i];
+        report.longitudeDeg = m_fixLon[i] * kRadToDeg;
+        report.latitudeDeg = m_fixLat[i] * kRadToDeg;
+        report.altitudeMeters = m_fixAlt[i];
+        report.groundSpeedMps = m_speed[i];
+        report.trackDeg = m_track[i] * kRadToDeg;
+        report.verticalRateMps = m_verticalRate[i];
+        fixes.push_back(report);
+    }
+    return fixes;
+}
+
+void TrackPredictor::resizeStorage(std::size_t count) {
+    for (std::vector<double>* column : {&m_fixLon, &m_fixLat, &m_fixAlt, &m_fixTime, &m_speed, &m_track,
+                                        &m_verticalRate, &m_offsetLon, &m_offsetLat, &m_offsetAlt, &m_outLon,
+                                        &m_outLat, &m_outAlt, &m_outHeading}) {
+        column->resize(count, 0.0);
+    }
+    m_ids.resize(count, 0U);
+}
+
+void TrackPredictor::removeAt(std::size_t index) {
+    const std::size_t last = m_ids.size() - 1;
+    m_indexById.erase(m_ids[index]);
+    if (index != last) {
+        for (std::vector<double>* column : {&m_fixLon, &m_fixLat, &m_fixAlt, &m_fixTime, &m_speed, &m_track,
+                                            &m_verticalRate, &m_offsetLon, &m_offsetLat, &m_offsetAlt, &m_outLon,
+                                            &m_outLat, &m_outAlt, &m_outHeading}) {
+            (*column)[index] = (*column)[last];
+        }
+        m_ids[index] = m_ids[last];
+        m_indexById[m_ids[index]] = index;
+    }
+    resizeStorage(last);
+}
+
+void TrackPredictor::extrapolate(std::size_t index, double dt, double& lon, double& lat, double& alt, double& heading) const {
+    const double coast = std::min(std::max(dt, 0.0), m_maxCoastSeconds);
+    const double distance = m_speed[index] * coast;
+    const double track = m_track[index];
+    const double lat1 = m_fixLat[index];
+
+    if (m_mode == ExtrapolationMode::Linear) {
+        const double cosLat = std::max(std::cos(lat1), kMinCosLatitude);
+        lat = lat1 + distance * std::cos(track) / kEarthRadius;
+        lon = m_fixLon[index] + distance * std::sin(track) / (kEarthRadius * cosLat);
+        heading = track;
+    } else {
+        const double delta = distance / kEarthRadius;
+        const double sinLat2 =
+            std::clamp(std::sin(lat1) * std::cos(delta) + std::cos(lat1) * std::sin(delta) * std::cos(track), -1.0, 1.0);
+        lat = std::asin(sinLat2);
+        lon = m_fixLon[index] +
+              std::atan2(std::sin(track) * std::sin(delta) * std::cos(lat1), std::cos(delta) - std::sin(lat1) * sinLat2);
+        heading = std::atan2(std::sin(track) * std::cos(lat1),
+                             std::cos(delta) * std::cos(lat1) * std::cos(track) - std::sin(lat1) * std::sin(delta));
+    }
+    alt = m_fixAlt[index] + m_verticalRate[index] * coast;
+}
+
+} // namespace earth::airtraffic
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "airtraffic/TrackTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace earth::airtraffic {
+
+/**
+ * @brief 航迹运动预测器：在稀疏报文（1~4 Hz）之间做外推，并将显示位置平滑地收敛到新报文。
+ *
+ * 所有航迹以结构数组（SoA）形式存放，每帧通过 predict() 对全部航迹执行一次无分支的批量计算，
+ * 便于编译器向量化；输出数组与内部索引一一对应，调用方可按索引直接写回场景节点。
+ */
+class TrackPredictor {
+public:
+    /**
+     * @brief 单次预测遍历的统计信息。
+     */
+    struct Stats {
+        std::size_t trackCount = 0; /**< 参与预测的航迹数量。 */
+        double lastPassMs = 0.0;    /**< 最近一次 predict() 的耗时（毫秒）。 */
+    };
+
+    TrackPredictor() = default;
+
+    void setMode(ExtrapolationMode mode) noexcept { m_mode = mode; }
+    [[nodiscard]] ExtrapolationMode mode() const noexcept { return m_mode; }
+
+    /**
+     * @brief 设置新报文修正量的衰减时间常数（秒），数值越大收敛越平缓。
+     */
+    void setSmoothingSeconds(double seconds) noexcept;
+
+    /**
+     * @brief 设置最长外推时间（秒），超过后目标停留在最后外推位置，避免失联目标漂移过远。
+     */
+    void setMaxCoastSeconds(double seconds) noexcept;
+
+    /**
+     * @brief 设置失联剔除时间（秒），超过该时长未更新的航迹会在 prune() 中移除。
+     */
+    void setStaleSeconds(double seconds) noexcept;
+
+    /**
+     * @brief 写入一条报文；若航迹已存在，则保留当前显示位置与新报文之间的偏差并逐步消除。
+     */
+    void ingest(const TrackReport& report);
+
+    /**
+     * @brief 移除在 now 之前已失联的航迹，返回移除数量。索引会被重新压紧。
+     */
+    std::size_t prune(double nowSec);
+
+    /**
+     * @brief 清空全部航迹。
+     */
+    void clear();
+
+    /**
+     * @brief 对全部航迹执行一次批量外推，结果写入 longitudes()/latitudes()/altitudes()/headings()。
+     */
+    void predict(double nowSec);
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_ids.size(); }
+    [[nodiscard]] const std::vector<std::uint32_t>& trackIds() const noexcept { return m_ids; }
+    [[nodiscard]] const std::vector<double>& longitudes() const noexcept { return m_outLon; }
+    [[nodiscard]] const std::vector<double>& latitudes() const noexcept { return m_outLat; }
+    [[nodiscard]] const std::vector<double>& altitudes() const noexcept { return m_outAlt; }
+    [[nodiscard]] const std::vector<double>& headings() const noexcept { return m_outHeading; }
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    /**
+     * @brief 以报文形式导出每条航迹最近一次的原始定位，用于录制关键帧。
+     */
+    [[nodiscard]] std::vector<TrackReport> latestFixes() const;
+
+private:
+    void resizeStorage(std::size_t count);
+    void removeAt(std::size_t index);
+    void extrapolate(std::size_t index, double dt, double& lon, double& lat, double& alt, double& heading) const;
+
+    ExtrapolationMode m_mode = ExtrapolationMode::GreatCircle;
+    double m_smoothingSeconds = 1.5;
+    double m_maxCoastSeconds = 10.0;
+    double m_staleSeconds = 30.0;
+
+    std::unordered_map<std::uint32_t, std::size_t> m_indexById;
+    std::vector<std::uint32_t> m_ids;
+
+    // 最近一次报文（弧度/米/秒）
+    std::vector<double> m_fixLon;
+    std::vector<double> m_fixLat;
+    std::vector<double> m_fixAlt;
+    std::vector<double> m_fixTime;
+    std::vector<double> m_speed;
+    std::vector<double> m_track;
+    std::vector<double> m_verticalRate;
+
+    // 显示位置相对新报文外推结果的修正量，随时间指数衰减
+    std::vector<double> m_offsetLon;
+    std::vector<double> m_offsetLat;
+    std::vector<double> m_offsetAlt;
+
+    // 预测输出（度/米）
+    std::vector<double> m_outLon;
+    std::vector<double> m_outLat;
+    std::vector<double> m_outAlt;
+    std::vector<double> m_outHeading;
+
+    Stats m_stats;
+};
+
+} // namespace earth::airtraffic
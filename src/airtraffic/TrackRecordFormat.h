@@ -0,0 +1,62 @@
+#pragma once
+
+#include "airtraffic/TrackTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace earth::airtraffic {
+
+/**
+ * @brief 航迹录制记录类型，写入回放日志记录头的 type 字段。
+ */
+enum class TrackRecordType : std::uint16_t {
+    ReportBatch = 1, /**< 一帧内收到的增量报文。 */
+    Keyframe = 2     /**< 全部在册航迹的最近定位，用于定位回放起点。 */
+};
+
+/**
+ * @brief 单条报文的紧凑编码长度：编号 4 字节 + 7 个双精度字段，不含结构体填充。
+ */
+constexpr std::size_t kEncodedReportSize = sizeof(std::uint32_t) + 7 * sizeof(double);
+
+/**
+ * @brief 将报文序列编码为连续字节，追加到 out 末尾。
+ */
+inline void encodeReports(const std::vector<TrackReport>& reports, std::vector<unsigned char>& out) {
+    const std::size_t base = out.size();
+    out.resize(base + reports.size() * kEncodedReportSize);
+    unsigned char* cursor = out.data() + base;
+    for (const TrackReport& report : reports) {
+        const double values[7] = {report.timestampSec, report.longitudeDeg, report.latitudeDeg, report.altitudeMeters,
+                                  report.groundSpeedMps, report.trackDeg, report.verticalRateMps};
+        std::memcpy(cursor, &report.trackId, sizeof(report.trackId));
+        std::memcpy(cursor + sizeof(report.trackId), values, sizeof(values));
+        cursor += kEncodedReportSize;
+    }
+}
+
+/**
+ * @brief 从字节序列解码报文，结果覆盖写入 out；长度不是整条报文倍数时忽略尾部残片。
+ */
+inline void decodeReports(const unsigned char* data, std::size_t size, std::vector<TrackReport>& out) {
+    const std::size_t count = size / kEncodedReportSize;
+    out.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const unsigned char* cursor = data + i * kEncodedReportSize;
+        double values[7];
+        std::memcpy(&out[i].trackId, cursor, sizeof(out[i].trackId));
+        std::memcpy(values, cursor + sizeof(out[i].trackId), sizeof(values));
+        out[i].timestampSec = values[0];
+        out[i].longitudeDeg = values[1];
+        out[i].latitudeDeg = values[2];
+        out[i].altitudeMeters = values[3];
+        out[i].groundSpeedMps = values[4];
+        out[i].trackDeg = values[5];
+        out[i].verticalRateMps = values[6];
+    }
+}
+
+} // namespace earth::airtraffic
@@ -0,0 +1,61 @@
+#include "airtraffic/TrackRecorder.h"
+
+#include "airtraffic/TrackPredictor.h"
+#include "airtraffic/TrackRecordFormat.h"
+
+#include <algorithm>
+
+namespace earth::airtraffic {
+
+bool TrackRecorder::start(const QString& filePath) {
+    m_hasKeyframe = false;
+    m_lastKeyframeTime = 0.0;
+    return m_writer.open(filePath);
+}
+
+void TrackRecorder::stop() {
+    m_writer.close();
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+}
+
+void TrackRecorder::setKeyframeInterval(double seconds) noexcept {
+    m_keyframeInterval = std::max(seconds, 0.5);
+}
+
+void TrackRecorder::record(const std::vector<TrackReport>& reports, const TrackPredictor& predictor, double nowSec) {
+    if (!m_writer.isOpen()) {
+        return;
+    }
+
+    if (!reports.empty()) {
+        writeReports(reports, nowSec, false);
+    }
+
+    // 关键帧写在本帧增量之后，包含已合并的最新定位；首帧立即写入，保证任意时刻都能定位。
+    if (!m_hasKeyframe || nowSec - m_lastKeyframeTime >= m_keyframeInterval) {
+        writeReports(predictor.latestFixes(), nowSec, true);
+        m_lastKeyframeTime = nowSec;
+        m_hasKeyframe = true;
+    }
+}
+
+void TrackRecorder::recordRaw(double nowSec, std::uint16_t type, core::replay::RecordSource source, const void* data,
+                              std::uint32_t size) {
+    if (!m_writer.isOpen() || size == 0) {
+        return;
+    }
+    m_writer.append(nowSec, type, source, core::replay::RecordFlagNone, data, size);
+}
+
+void TrackRecorder::writeReports(const std::vector<TrackReport>& reports, double nowSec, bool keyframe) {
+    m_buffer.clear();
+    encodeReports(reports, m_buffer);
+
+    const auto type = keyframe ? TrackRecordType::Keyframe : TrackRecordType::ReportBatch;
+    const std::uint32_t flags = keyframe ? core::replay::RecordFlagKeyframe : core::replay::RecordFlagNone;
+    m_writer.append(nowSec, static_cast<std::uint16_t>(type), core::replay::RecordSource::AirTraffic, flags,
+                    m_buffer.data(), static_cast<std::uint32_t>(m_buffer.size()));
+}
+
+} // namespace earth::airtraffic
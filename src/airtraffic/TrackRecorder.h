@@ -0,0 +1,62 @@
+#pragma once
+
+#include "airtraffic/TrackTypes.h"
+#include "core/replay/ReplayLog.h"
+
+#include <QString>
+
+#include <vector>
+
+namespace earth::airtraffic {
+
+class TrackPredictor;
+
+/**
+ * @brief 将空管交通图层收到的报文写入回放日志，并周期性写入关键帧。
+ *
+ * 由 AirTrafficLayer 在 update 遍历中调用，与预测器处于同一线程。
+ */
+class TrackRecorder {
+public:
+    TrackRecorder() = default;
+
+    /**
+     * @brief 开始录制到指定文件，成功返回 true。
+     */
+    bool start(const QString& filePath);
+
+    /**
+     * @brief 结束录制，写入时间索引。
+     */
+    void stop();
+
+    [[nodiscard]] bool isRecording() const noexcept { return m_writer.isOpen(); }
+    [[nodiscard]] QString filePath() const { return m_writer.filePath(); }
+
+    /**
+     * @brief 设置关键帧间隔（秒），决定回放定位时最多需要重放多少增量记录。
+     */
+    void setKeyframeInterval(double seconds) noexcept;
+
+    /**
+     * @brief 记录本帧合并的报文；到达关键帧间隔时追加一份预测器完整状态。
+     */
+    void record(const std::vector<TrackReport>& reports, const TrackPredictor& predictor, double nowSec);
+
+    /**
+     * @brief 追加其他模块的原始记录（例如数据桥接收到的实体状态），与航迹记录写入同一日志。
+     */
+    void recordRaw(double nowSec, std::uint16_t type, core::replay::RecordSource source, const void* data,
+                   std::uint32_t size);
+
+private:
+    void writeReports(const std::vector<TrackReport>& reports, double nowSec, bool keyframe);
+
+    core::replay::ReplayLogWriter m_writer;
+    std::vector<unsigned char> m_buffer;
+    double m_keyframeInterval = 10.0;
+    double m_lastKeyframeTime = 0.0;
+    bool m_hasKeyframe = false;
+};
+
+} // namespace earth::airtraffic
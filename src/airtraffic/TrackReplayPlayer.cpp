@@ -0,0 +1,114 @@
+#include "airtraffic/TrackReplayPlayer.h"
+
+#include "airtraffic/TrackPredictor.h"
+#include "airtraffic/TrackRecordFormat.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+double steadySeconds() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+} // namespace
+
+namespace earth::airtraffic {
+
+bool TrackReplayPlayer::open(const QString& filePath) {
+    close();
+    if (!m_reader.open(filePath)) {
+        return false;
+    }
+    m_anchorReplayTime = m_reader.startTime();
+    m_anchorWallTime = steadySeconds();
+    m_currentTime = m_anchorReplayTime;
+    m_seekPending = true;
+    return true;
+}
+
+void TrackReplayPlayer::close() {
+    m_reader.close();
+    m_decoded.clear();
+    m_cursor = 0;
+    m_playing = false;
+    m_seekPending = false;
+}
+
+void TrackReplayPlayer::play() {
+    if (!isOpen() || m_playing) {
+        return;
+    }
+    if (m_currentTime >= m_reader.endTime()) {
+        seek(m_reader.startTime());
+    }
+    reanchor();
+    m_playing = true;
+}
+
+void TrackReplayPlayer::pause() {
+    if (!m_playing) {
+        return;
+    }
+    reanchor();
+    m_playing = false;
+}
+
+void TrackReplayPlayer::setSpeed(double speed) {
+    reanchor();
+    m_speed = std::clamp(speed, kMinSpeed, kMaxSpeed);
+}
+
+void TrackReplayPlayer::seek(double timestampSec) {
+    if (!isOpen()) {
+        return;
+    }
+    m_anchorReplayTime = std::clamp(timestampSec, m_reader.startTime(), m_reader.endTime());
+    m_anchorWallTime = steadySeconds();
+    m_currentTime = m_anchorReplayTime;
+    m_seekPending = true;
+}
+
+void TrackReplayPlayer::update(TrackPredictor& predictor) {
+    if (!isOpen()) {
+        return;
+    }
+
+    m_currentTime = clockTime();
+    if (m_currentTime >= m_reader.endTime()) {
+        m_currentTime = m_reader.endTime();
+        m_anchorReplayTime = m_currentTime;
+        m_playing = false;
+    }
+
+    if (m_seekPending) {
+        predictor.clear();
+        m_cursor = m_reader.keyframeOffsetAt(m_currentTime);
+        m_seekPending = false;
+    }
+
+    core::replay::ReplayLogReader::Record record;
+    while (m_reader.readAt(m_cursor, record) && record.timestampSec <= m_currentTime) {
+        if (record.source == core::replay::RecordSource::AirTraffic) {
+            decodeReports(record.data, record.size, m_decoded);
+            for (const TrackReport& report : m_decoded) {
+                predictor.ingest(report);
+            }
+        }
+        m_cursor = record.nextOffset;
+    }
+}
+
+double TrackReplayPlayer::clockTime() const {
+    if (!m_playing) {
+        return m_anchorReplayTime;
+    }
+    return m_anchorReplayTime + (steadySeconds() - m_anchorWallTime) * m_speed;
+}
+
+void TrackReplayPlayer::reanchor() {
+    m_anchorReplayTime = clockTime();
+    m_anchorWallTime = steadySeconds();
+}
+
+} // namespace earth::airtraffic
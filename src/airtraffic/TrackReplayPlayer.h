@@ -0,0 +1,75 @@
+#pragma once
+
+#include "airtraffic/TrackTypes.h"
+#include "core/replay/ReplayLog.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace earth::airtraffic {
+
+class TrackPredictor;
+
+/**
+ * @brief 航迹回放器：按回放时钟从日志中取出报文并写入预测器。
+ *
+ * 定位时先通过稀疏索引找到不晚于目标时刻的关键帧，恢复完整状态后只重放其后的增量记录，
+ * 因此多小时日志的任意定位都只需读取一个关键帧间隔的数据。控制接口与 update() 须在同一线程调用。
+ */
+class TrackReplayPlayer {
+public:
+    static constexpr double kMinSpeed = 1.0;
+    static constexpr double kMaxSpeed = 100.0;
+
+    TrackReplayPlayer() = default;
+
+    bool open(const QString& filePath);
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_reader.isOpen(); }
+    [[nodiscard]] double startTime() const noexcept { return m_reader.startTime(); }
+    [[nodiscard]] double endTime() const noexcept { return m_reader.endTime(); }
+
+    /**
+     * @brief 当前回放时刻，与报文时间戳同一基准；由 update() 刷新。
+     */
+    [[nodiscard]] double currentTime() const noexcept { return m_currentTime; }
+
+    void play();
+    void pause();
+    [[nodiscard]] bool isPlaying() const noexcept { return m_playing; }
+
+    /**
+     * @brief 设置回放倍速，限制在 1×~100×。
+     */
+    void setSpeed(double speed);
+    [[nodiscard]] double speed() const noexcept { return m_speed; }
+
+    /**
+     * @brief 跳转到指定时刻，在下一次 update() 中从最近关键帧重建状态。
+     */
+    void seek(double timestampSec);
+
+    /**
+     * @brief 推进回放时钟，并把截至当前时刻的记录写入预测器。
+     */
+    void update(TrackPredictor& predictor);
+
+private:
+    [[nodiscard]] double clockTime() const;
+    void reanchor();
+
+    core::replay::ReplayLogReader m_reader;
+    std::vector<TrackReport> m_decoded;
+    std::uint64_t m_cursor = 0;
+    double m_anchorReplayTime = 0.0;
+    double m_anchorWallTime = 0.0;
+    double m_currentTime = 0.0;
+    double m_speed = 1.0;
+    bool m_playing = false;
+    bool m_seekPending = false;
+};
+
+} // namespace earth::airtraffic
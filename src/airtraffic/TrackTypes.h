@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace earth::airtraffic {
+
+/**
+ * @brief 单条航迹报文（雷达/ADS-B/仿真器输出），角度单位为度，距离单位为米，时间单位为秒。
+ */
+struct TrackReport {
+    std::uint32_t trackId = 0;    /**< 航迹编号，同一目标在整个会话内保持不变。 */
+    double timestampSec = 0.0;    /**< 报文时刻（UTC 纪元秒），与预测时钟保持同一时间基准。 */
+    double longitudeDeg = 0.0;    /**< 经度（度）。 */
+    double latitudeDeg = 0.0;     /**< 纬度（度）。 */
+    double altitudeMeters = 0.0;  /**< 高度（米），相对 WGS84 椭球。 */
+    double groundSpeedMps = 0.0;  /**< 地速（米/秒）。 */
+    double trackDeg = 0.0;        /**< 航迹角（度），真北顺时针。 */
+    double verticalRateMps = 0.0; /**< 垂直速度（米/秒），向上为正。 */
+};
+
+/**
+ * @brief 报文之间的外推方式。
+ */
+enum class ExtrapolationMode {
+    Linear,     /**< 局部切平面直线外推，适合短时间、低速目标。 */
+    GreatCircle /**< 沿大圆航线外推，适合长间隔或高速航路目标。 */
+};
+
+} // namespace earth::airtraffic
@@ -1,25 +1,83 @@
 #include "ui/MainWindow.h"
 #include "core/EnvironmentBootstrapper.h"
+#ifdef EARTH_ENABLE_HEADLESS
+#include "headless/SnapshotBatchRunner.h"
+#endif
+
+#include <osgQt/GlyphCache>
 
 #include <QApplication>
 #include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QGuiApplication>
 #include <QResource>
 
-/**
- * @brief Qt 应用程序入口，负责初始化环境并启动三维仿真主窗体。
- */
-int main(int argc, char* argv[]) {
+namespace {
+
+void setApplicationInfo() {
     QCoreApplication::setOrganizationName(QStringLiteral("EarthSimLab"));
     QCoreApplication::setApplicationName(QStringLiteral("airport-earth"));
     QCoreApplication::setApplicationVersion(QStringLiteral("0.1.0"));
+}
+
+/**
+ * @brief 字形缓存持久化到数据根目录，冷启动时直接读回已光栅化的中文字形。
+ */
+void setupGlyphCache() {
+    const QString dataRoot = earth::core::EnvironmentBootstrapper::instance().dataRoot();
+    if (!dataRoot.isEmpty()) {
+        osgQt::GlyphCache::instance().setDirectory(QDir(dataRoot).filePath(QStringLiteral("cache/glyphs")).toStdString());
+    }
+}
+
+#ifdef EARTH_ENABLE_HEADLESS
+/**
+ * @brief 离屏批量快照入口：不创建任何窗口，只需要 QGuiApplication 提供 QOffscreenSurface。
+ */
+int runHeadless(int argc, char* argv[]) {
+#if defined(Q_OS_LINUX)
+    // Qt5 的 offscreen 插件经 GLX 创建上下文，仍需要 X 显示，没有显示服务器时无法得到 OpenGL。
+    // 无显示的机器请用 xvfb-run -a 启动，配合 LIBGL_ALWAYS_SOFTWARE=1 即走 Mesa llvmpipe。
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM") && !qEnvironmentVariableIsSet("DISPLAY") &&
+        !qEnvironmentVariableIsSet("WAYLAND_DISPLAY")) {
+        qWarning() << "[Snapshot] 没有可用的显示服务器，请通过 xvfb-run -a 运行 --headless";
+        return 1;
+    }
+#endif
+    QGuiApplication app(argc, argv);
+    earth::core::EnvironmentBootstrapper::instance().initialize();
+    setupGlyphCache();
+    const int result = earth::headless::SnapshotBatchRunner::runFromCommandLine(app.arguments());
+    osgQt::GlyphCache::instance().save();
+    return result;
+}
+#endif
+
+} // namespace
+
+/**
+ * @brief Qt 应用程序入口，负责初始化环境并启动三维仿真主窗体；带 --headless 时改为离屏批量快照。
+ */
+int main(int argc, char* argv[]) {
+    setApplicationInfo();
+
+#ifdef EARTH_ENABLE_HEADLESS
+    if (earth::headless::SnapshotBatchRunner::requested(argc, argv)) {
+        return runHeadless(argc, argv);
+    }
+#endif
 
     QApplication app(argc, argv);
 
     // 初始化资源文件
     Q_INIT_RESOURCE(ui_resources);
     earth::core::EnvironmentBootstrapper::instance().initialize();
+    setupGlyphCache();
 
     earth::ui::MainWindow window;
     window.show();
-    return app.exec();
+    const int result = app.exec();
+    osgQt::GlyphCache::instance().save();
+    return result;
 }
@@ -40,6 +40,10 @@ std::string EnvironmentBootstrapper::moonTextureFile() const {
     return m_moonTexturePath;
 }
 
+QString EnvironmentBootstrapper::dataRoot() const {
+    return m_dataRoot;
+}
+
 void EnvironmentBootstrapper::ensureDataRoot() {
     if (!m_dataRoot.isEmpty()) {
         return;
@@ -31,6 +31,11 @@ public:
      */
     [[nodiscard]] std::string moonTextureFile() const;
 
+    /**
+     * @brief 返回可写的数据根目录（缓存、录制日志等），初始化前为空字符串。
+     */
+    [[nodiscard]] QString dataRoot() const;
+
 private:
     EnvironmentBootstrapper() = default;
 
@@ -0,0 +1,69 @@
+#include "core/FrameMetrics.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+namespace {
+constexpr double kAverageWeight = 0.1;
+} // namespace
+
+namespace earth::core {
+
+FrameMetrics& FrameMetrics::instance() {
+    static FrameMetrics metrics;
+    return metrics;
+}
+
+void FrameMetrics::recordDuration(const std::string& name, double milliseconds) {
+    recordValue(name, milliseconds, "ms");
+}
+
+void FrameMetrics::recordValue(const std::string& name, double value, const char* unit) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = findOrCreate(name, unit);
+    entry.lastValue = value;
+    entry.averageValue = entry.samples == 0 ? value : entry.averageValue + (value - entry.averageValue) * kAverageWeight;
+    entry.peakValue = std::max(entry.peakValue, value);
+    ++entry.samples;
+}
+
+std::vector<FrameMetrics::Entry> FrameMetrics::takeSnapshot() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Entry> snapshot = m_entries;
+    for (Entry& entry : m_entries) {
+        entry.peakValue = entry.lastValue;
+    }
+    return snapshot;
+}
+
+QString FrameMetrics::formatSnapshot(const std::vector<Entry>& entries) {
+    QStringList lines;
+    lines.reserve(static_cast<int>(entries.size()));
+    for (const Entry& entry : entries) {
+        lines << QStringLiteral("%1: %2 %4 (均值 %3, 峰值 %5)")
+                     .arg(QString::fromStdString(entry.name))
+                     .arg(entry.lastValue, 0, 'f', 3)
+                     .arg(entry.averageValue, 0, 'f', 3)
+                     .arg(QString::fromStdString(entry.unit))
+                     .arg(entry.peakValue, 0, 'f', 3);
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+FrameMetrics::Entry& FrameMetrics::findOrCreate(const std::string& name, const char* unit) {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&name](const Entry& entry) {
+        return entry.name == name;
+    });
+    if (it != m_entries.end()) {
+        return *it;
+    }
+
+    Entry entry;
+    entry.name = name;
+    entry.unit = unit != nullptr ? unit : "";
+    m_entries.push_back(entry);
+    return m_entries.back();
+}
+
+} // namespace earth::core
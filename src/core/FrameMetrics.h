@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace earth::core {
+
+/**
+ * @brief 逐帧性能指标登记表，各模块在更新/绘制阶段写入自身耗时或计数，由 UI 周期性汇总展示。
+ *
+ * 写入端仅持有短暂的互斥锁，适合“每帧每模块数次”的调用频率；读取端通过快照获取数据，不阻塞渲染。
+ */
+class FrameMetrics final {
+public:
+    /**
+     * @brief 单项指标的统计快照。
+     */
+    struct Entry {
+        std::string name;          /**< 指标名称，建议使用“模块.阶段”形式，例如 airtraffic.predict。 */
+        std::string unit;          /**< 单位文本，例如 ms、条。 */
+        double lastValue = 0.0;    /**< 最近一次写入的数值。 */
+        double averageValue = 0.0; /**< 指数滑动平均值。 */
+        double peakValue = 0.0;    /**< 自上次快照以来的峰值。 */
+        std::uint64_t samples = 0; /**< 累计写入次数。 */
+    };
+
+    /**
+     * @brief 获取全局唯一实例。
+     */
+    static FrameMetrics& instance();
+
+    /**
+     * @brief 记录一次耗时，单位毫秒。
+     */
+    void recordDuration(const std::string& name, double milliseconds);
+
+    /**
+     * @brief 记录任意数值型指标（计数、容量等）。
+     */
+    void recordValue(const std::string& name, double value, const char* unit);
+
+    /**
+     * @brief 获取当前全部指标快照，并将峰值复位以便统计下一个窗口。
+     */
+    [[nodiscard]] std::vector<Entry> takeSnapshot();
+
+    /**
+     * @brief 将快照格式化为多行文本，供状态栏提示框展示。
+     */
+    [[nodiscard]] static QString formatSnapshot(const std::vector<Entry>& entries);
+
+private:
+    FrameMetrics() = default;
+
+    Entry& findOrCreate(const std::string& name, const char* unit);
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+};
+
+} // namespace earth::core
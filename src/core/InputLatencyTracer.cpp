@@ -0,0 +1,229 @@
+#include "core/InputLatencyTracer.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QSaveFile>
+#include <QStringList>
+
+#include <algorithm>
+#include <cmath>
+
+namespace earth::core {
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
+
+} // namespace
+
+InputLatencyTracer& InputLatencyTracer::instance() {
+    static InputLatencyTracer tracer;
+    return tracer;
+}
+
+void InputLatencyTracer::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (enabled && !m_enabled.load(std::memory_order_relaxed)) {
+        m_origin = osg::Timer::instance()->tick();
+        m_pending = {};
+        m_samples.clear();
+        m_samples.reserve(kWindowSize);
+        m_next = 0;
+    }
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+InputLatencyTracer::PendingFrame* InputLatencyTracer::findPending(unsigned int frameNumber) {
+    for (PendingFrame& frame : m_pending) {
+        if (frame.active && frame.frameNumber == frameNumber) {
+            return &frame;
+        }
+    }
+    return nullptr;
+}
+
+void InputLatencyTracer::markInput(unsigned int frameNumber, osg::Timer_t eventTick, osg::Timer_t now) {
+    if (!enabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PendingFrame* frame = findPending(frameNumber);
+    if (frame == nullptr) {
+        // 未交换的旧帧（例如窗口未曝光）让位给新帧，取帧号最小的一条。
+        frame = &m_pending.front();
+        for (PendingFrame& candidate : m_pending) {
+            if (!candidate.active) {
+                frame = &candidate;
+                break;
+            }
+            if (candidate.frameNumber < frame->frameNumber) {
+                frame = &candidate;
+            }
+        }
+        *frame = PendingFrame {};
+        frame->active = true;
+        frame->frameNumber = frameNumber;
+        frame->firstInput = eventTick;
+        frame->stamps[static_cast<std::size_t>(Stage::Dispatch)] = now;
+    }
+
+    frame->firstInput = std::min(frame->firstInput, eventTick);
+    ++frame->inputs;
+}
+
+void InputLatencyTracer::markStage(Stage stage, unsigned int frameNumber, osg::Timer_t now) {
+    if (!enabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PendingFrame* frame = findPending(frameNumber);
+    if (frame == nullptr) {
+        return;
+    }
+
+    osg::Timer_t& stamp = frame->stamps[static_cast<std::size_t>(stage)];
+    if (stamp == 0) {
+        stamp = now;
+    }
+    if (stage != Stage::Swap) {
+        return;
+    }
+
+    const osg::Timer* timer = osg::Timer::instance();
+    Sample sample;
+    sample.frameNumber = frame->frameNumber;
+    sample.timeSec = timer->delta_s(m_origin, frame->firstInput);
+    sample.inputs = frame->inputs;
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        sample.stageMs[i] = frame->stamps[i] != 0 ? timer->delta_m(frame->firstInput, frame->stamps[i]) : -1.0;
+    }
+    frame->active = false;
+
+    if (m_samples.size() < kWindowSize) {
+        m_samples.push_back(sample);
+    } else {
+        m_samples[m_next] = sample;
+    }
+    m_next = (m_next + 1) % kWindowSize;
+}
+
+InputLatencyTracer::Summary InputLatencyTracer::summarize() const {
+    std::array<std::vector<double>, kStageCount> values;
+    Summary summary;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const Sample& sample : m_samples) {
+            for (std::size_t i = 0; i < kStageCount; ++i) {
+                if (sample.stageMs[i] >= 0.0) {
+                    values[i].push_back(sample.stageMs[i]);
+                }
+            }
+            if (sample.stageMs[static_cast<std::size_t>(Stage::Swap)] > kBudgetMs) {
+                ++summary.overBudget;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        std::vector<double>& stage = values[i];
+        std::sort(stage.begin(), stage.end());
+        StageSummary& out = summary.stages[i];
+        out.samples = stage.size();
+        out.p50 = percentile(stage, 0.50);
+        out.p95 = percentile(stage, 0.95);
+        out.p99 = percentile(stage, 0.99);
+        out.max = stage.empty() ? 0.0 : stage.back();
+    }
+    return summary;
+}
+
+QString InputLatencyTracer::formatSummary(const Summary& summary) {
+    // 叠加层只预生成 ASCII 距离场字形，只输出 ASCII。
+    QStringList lines;
+    lines << QStringLiteral("input latency ms    p50     p95     p99     max");
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        const StageSummary& stage = summary.stages[i];
+        if (stage.samples == 0) {
+            continue;
+        }
+        lines << QStringLiteral("%1 %2 %3 %4 %5")
+                     .arg(QString::fromLatin1(stageName(static_cast<Stage>(i))), -16)
+                     .arg(stage.p50, 7, 'f', 1)
+                     .arg(stage.p95, 7, 'f', 1)
+                     .arg(stage.p99, 7, 'f', 1)
+                     .arg(stage.max, 7, 'f', 1);
+    }
+    const std::size_t total = summary.stages[static_cast<std::size_t>(Stage::Swap)].samples;
+    lines << QStringLiteral("over %1 ms: %2 / %3 frames").arg(kBudgetMs, 0, 'f', 0).arg(summary.overBudget).arg(total);
+    return lines.join(QLatin1Char('\n'));
+}
+
+bool InputLatencyTracer::exportCsv(const QString& filePath) const {
+    QByteArray csv("frame,time_s,inputs");
+    for (std::size_t i = 0; i < kStageCount; ++i) {
+        csv += ',';
+        csv += stageName(static_cast<Stage>(i));
+        csv += "_ms";
+    }
+    csv += '\n';
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 窗口写满后 m_next 指向最旧的样本，按时间顺序输出。
+        const std::size_t start = m_samples.size() < kWindowSize ? 0 : m_next;
+        for (std::size_t n = 0; n < m_samples.size(); ++n) {
+            const Sample& sample = m_samples[(start + n) % m_samples.size()];
+            csv += QByteArray::number(sample.frameNumber);
+            csv += ',';
+            csv += QByteArray::number(sample.timeSec, 'f', 6);
+            csv += ',';
+            csv += QByteArray::number(sample.inputs);
+            for (const double value : sample.stageMs) {
+                csv += ',';
+                if (value >= 0.0) {
+                    csv += QByteArray::number(value, 'f', 3);
+                }
+            }
+            csv += '\n';
+        }
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "[InputLatency] 无法写入" << filePath << file.errorString();
+        return false;
+    }
+    file.write(csv);
+    if (!file.commit()) {
+        qWarning() << "[InputLatency] 提交失败" << filePath << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+const char* InputLatencyTracer::stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Dispatch:
+        return "dispatch";
+    case Stage::Handler:
+        return "handler";
+    case Stage::Cull:
+        return "cull";
+    case Stage::Draw:
+        return "draw";
+    case Stage::Swap:
+        return "swap";
+    case Stage::Count:
+        break;
+    }
+    return "unknown";
+}
+
+} // namespace earth::core
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QString>
+
+#include <osg/Timer>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace earth::core {
+
+/**
+ * @brief 输入到画面的延迟追踪：按帧记录输入事件经过 Qt → osgGA → 事件处理器 → 剔除/绘制 → 交换各阶段的时刻。
+ *
+ * 起点是 GLWidget 把 Qt 输入写入 osgGA 事件队列的时刻（即事件自带的队列时间），同一帧内取最早的输入，
+ * 因此每个样本都是该帧最坏情况的延迟；终点是 SwapBuffers 返回，显示器扫描输出的时间不在统计之内。
+ * 所有时刻都基于 osg::Timer，写入端加短暂的互斥锁，绘制线程与 GUI 线程均可调用。
+ */
+class InputLatencyTracer final {
+public:
+    /**
+     * @brief 延迟阶段，每个阶段的数值都是从输入事件到该阶段开始的耗时。
+     */
+    enum class Stage : std::size_t {
+        Dispatch = 0, /**< osgGA 事件遍历取出事件。 */
+        Handler,      /**< 绘制工具等事件处理器处理事件（无处理器参与时缺省）。 */
+        Cull,         /**< 主相机开始剔除。 */
+        Draw,         /**< 主相机开始绘制。 */
+        Swap,         /**< SwapBuffers 返回，即样本的总延迟。 */
+        Count
+    };
+    static constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::Count);
+
+    /**
+     * @brief 操作员可感知延迟的上限，超出的样本单独计数。
+     */
+    static constexpr double kBudgetMs = 50.0;
+
+    /**
+     * @brief 单帧样本，缺省阶段为负值。
+     */
+    struct Sample {
+        unsigned int frameNumber = 0;
+        double timeSec = 0.0;             /**< 输入时刻，相对追踪器启用时刻。 */
+        std::uint32_t inputs = 0;         /**< 本帧取出的输入事件数。 */
+        std::array<double, kStageCount> stageMs {};
+    };
+
+    /**
+     * @brief 单个阶段的延迟分布。
+     */
+    struct StageSummary {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        std::size_t samples = 0;
+    };
+
+    /**
+     * @brief 最近窗口内全部阶段的分布与超预算样本数。
+     */
+    struct Summary {
+        std::array<StageSummary, kStageCount> stages {};
+        std::size_t overBudget = 0;
+    };
+
+    static InputLatencyTracer& instance();
+
+    /**
+     * @brief 启用时清空已有样本；关闭后各打点函数立即返回。
+     */
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 事件遍历取出一个输入事件，eventTick 为它进入 osgGA 事件队列的时刻。
+     */
+    void markInput(unsigned int frameNumber, osg::Timer_t eventTick, osg::Timer_t now);
+
+    /**
+     * @brief 记录阶段时刻，只对已有输入的帧生效；Swap 结束该帧并生成样本。同一阶段只保留首次打点。
+     */
+    void markStage(Stage stage, unsigned int frameNumber, osg::Timer_t now);
+
+    /**
+     * @brief 统计最近窗口（最多 kWindowSize 个样本）的分布。
+     */
+    [[nodiscard]] Summary summarize() const;
+
+    /**
+     * @brief 格式化为叠加层显示的多行文本。
+     */
+    [[nodiscard]] static QString formatSummary(const Summary& summary);
+
+    /**
+     * @brief 将窗口内的逐帧样本写为 CSV（每行一帧，缺省阶段留空），成功返回 true。
+     */
+    bool exportCsv(const QString& filePath) const;
+
+    [[nodiscard]] static const char* stageName(Stage stage);
+
+    static constexpr std::size_t kWindowSize = 4096;
+
+private:
+    InputLatencyTracer() = default;
+
+    /**
+     * @brief 尚未交换完成的帧；多线程模型下事件遍历可能领先绘制一帧，因此保留少量并行记录。
+     */
+    struct PendingFrame {
+        bool active = false;
+        unsigned int frameNumber = 0;
+        std::uint32_t inputs = 0;
+        osg::Timer_t firstInput = 0;
+        std::array<osg::Timer_t, kStageCount> stamps {};
+    };
+    static constexpr std::size_t kPendingFrames = 4;
+
+    PendingFrame* findPending(unsigned int frameNumber);
+
+    std::atomic<bool> m_enabled {false};
+    mutable std::mutex m_mutex;
+    osg::Timer_t m_origin = 0;
+    std::array<PendingFrame, kPendingFrames> m_pending {};
+    std::vector<Sample> m_samples;
+    std::size_t m_next = 0;
+};
+
+} // namespace earth::core
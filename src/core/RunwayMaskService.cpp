@@ -0,0 +1,343 @@
+#include "core/RunwayMaskService.h"
+
+#include "core/FrameMetrics.h"
+
+#include <osg/Math>
+#include <osgEarth/Feature>
+#include <osgEarth/FeatureCursor>
+#include <osgEarth/FeatureSource>
+#include <osgEarth/Geometry>
+#include <osgEarth/Map>
+#include <osgEarth/MapNode>
+#include <osgEarth/SpatialReference>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr double kMetersPerDegree = 111319.49079327357;
+constexpr double kDefaultLineWidthMeters = 45.0;
+constexpr double kExtentPaddingMeters = 200.0;
+constexpr std::uint8_t kRunwayValue = 255;
+constexpr std::uint8_t kTaxiwayValue = 128;
+// fillPoly/polylines 的定点小数位数，8k 掩码下也保留亚像素精度。
+constexpr int kSubpixelShift = 4;
+
+// 与 SimulationBootstrapper 中 ProceduralRunway 盒子一致的占位尺寸。
+constexpr double kSyntheticRunwayLength = 1000.0;
+constexpr double kSyntheticRunwayWidth = 60.0;
+constexpr double kSyntheticCenterLineWidth = 7.5;
+constexpr double kSyntheticExtent = 2000.0;
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return text;
+}
+
+std::uint8_t classifyLayer(const std::string& layerName) {
+    const std::string name = toLower(layerName);
+    if (name.find("runway") != std::string::npos) {
+        return kRunwayValue;
+    }
+    if (name.find("taxiway") != std::string::npos) {
+        return kTaxiwayValue;
+    }
+    return 0;
+}
+
+std::uint8_t classifyFeature(const osgEarth::Feature& feature, std::uint8_t layerDefault) {
+    const std::string aeroway = toLower(feature.getString("aeroway"));
+    if (aeroway == "runway") {
+        return kRunwayValue;
+    }
+    if (aeroway == "taxiway") {
+        return kTaxiwayValue;
+    }
+    return layerDefault;
+}
+} // namespace
+
+namespace earth::core {
+
+int RunwayMaskPyramid::findLevel(int resolution) const noexcept {
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i].cols == resolution && levels[i].rows == resolution) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::size_t RunwayMaskPyramid::byteSize() const noexcept {
+    std::size_t total = 0;
+    for (const cv::Mat& level : levels) {
+        total += level.total() * level.elemSize();
+    }
+    return total;
+}
+
+RunwayMaskView::RunwayMaskView(std::shared_ptr<const RunwayMaskPyramid> pyramid, int level)
+    : m_pyramid(std::move(pyramid))
+    , m_level(level) {
+}
+
+bool RunwayMaskView::empty() const noexcept {
+    return !m_pyramid || m_level < 0 || static_cast<std::size_t>(m_level) >= m_pyramid->levels.size();
+}
+
+const cv::Mat& RunwayMaskView::mat() const noexcept {
+    static const cv::Mat kEmpty;
+    return empty() ? kEmpty : m_pyramid->levels[static_cast<std::size_t>(m_level)];
+}
+
+double RunwayMaskView::metersPerPixel() const noexcept {
+    const cv::Mat& image = mat();
+    return image.cols > 0 ? m_pyramid->extentMeters / static_cast<double>(image.cols) : 0.0;
+}
+
+RunwayMaskView RunwayMaskService::mask(const osgEarth::MapNode* mapNode, int resolution) const {
+    resolution = std::clamp(resolution, kMinLevelSize, kMaxResolution);
+    const std::string airport = airportKey(mapNode);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (it->airport != airport) {
+                continue;
+            }
+            // 只认第 0 层：pyrDown 层级边缘带高斯过渡灰度，返回它会让结果取决于此前请求过哪些分辨率。
+            if (it->pyramid->findLevel(resolution) == 0) {
+                m_cache.splice(m_cache.begin(), m_cache, it);
+                return {m_cache.front().pyramid, 0};
+            }
+        }
+    }
+
+    // 栅格化在锁外进行，8k 掩码构建期间不阻塞其他分辨率/机场的读取。
+    const std::shared_ptr<const Layout> layout = layoutFor(mapNode, airport);
+    const auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<const RunwayMaskPyramid> pyramid = buildPyramid(*layout, airport, resolution);
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    FrameMetrics::instance().recordDuration("runwayMask.build", elapsed.count());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.push_front({airport, pyramid});
+    trimLocked();
+    return {std::move(pyramid), 0};
+}
+
+void RunwayMaskService::invalidate(const std::string& airport) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_layouts.erase(airport);
+    m_cache.remove_if([&airport](const CacheEntry& entry) {
+        return entry.airport == airport;
+    });
+}
+
+void RunwayMaskService::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_layouts.clear();
+    m_cache.clear();
+}
+
+std::string RunwayMaskService::airportKey(const osgEarth::MapNode* mapNode) {
+    if (mapNode == nullptr) {
+        return "synthetic";
+    }
+    if (const osgEarth::Map* map = mapNode->getMap(); map != nullptr && !map->getMapName().empty()) {
+        return map->getMapName();
+    }
+    return mapNode->getName().empty() ? std::string("unnamed") : mapNode->getName();
+}
+
+std::shared_ptr<const RunwayMaskService::Layout> RunwayMaskService::layoutFor(const osgEarth::MapNode* mapNode,
+                                                                              const std::string& airport) const {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = m_layouts.find(airport); it != m_layouts.end()) {
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<const Layout> layout = collectLayout(mapNode);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_layouts.emplace(airport, std::move(layout)).first->second;
+}
+
+std::shared_ptr<const RunwayMaskService::Layout> RunwayMaskService::collectLayout(const osgEarth::MapNode* mapNode) {
+    const osgEarth::Map* map = mapNode != nullptr ? mapNode->getMap() : nullptr;
+    if (map == nullptr) {
+        return syntheticLayout();
+    }
+
+    struct GeoShape {
+        std::vector<osg::Vec3d> points;
+        double widthMeters = 0.0;
+        std::uint8_t value = 0;
+    };
+    std::vector<GeoShape> runways;
+    std::vector<GeoShape> taxiways;
+
+    osg::ref_ptr<const osgEarth::SpatialReference> wgs84 = osgEarth::SpatialReference::get("wgs84");
+    std::vector<osg::ref_ptr<osgEarth::FeatureSource>> sources;
+    map->getLayers(sources);
+    for (const osg::ref_ptr<osgEarth::FeatureSource>& source : sources) {
+        if (!source.valid() || source->getStatus().isError()) {
+            continue;
+        }
+        const std::uint8_t layerDefault = classifyLayer(source->getName());
+        osg::ref_ptr<osgEarth::FeatureCursor> cursor = source->createFeatureCursor(osgEarth::Query(), nullptr);
+        while (cursor.valid() && cursor->hasMore()) {
+            osg::ref_ptr<osgEarth::Feature> feature = cursor->nextFeature();
+            if (!feature.valid() || feature->getGeometry() == nullptr) {
+                continue;
+            }
+            const std::uint8_t value = classifyFeature(*feature, layerDefault);
+            if (value == 0) {
+                continue;
+            }
+
+            const double width = feature->hasAttr("width") ? feature->getDouble("width") : kDefaultLineWidthMeters;
+            osgEarth::GeometryIterator parts(feature->getGeometry(), false);
+            while (parts.hasMore()) {
+                const osgEarth::Geometry* part = parts.next();
+                GeoShape shape;
+                shape.points.assign(part->begin(), part->end());
+                if (shape.points.size() < 2) {
+                    continue;
+                }
+                if (const osgEarth::SpatialReference* srs = feature->getSRS();
+                    srs != nullptr && !srs->isHorizEquivalentTo(wgs84.get()) && !srs->transform(shape.points, wgs84.get())) {
+                    continue;
+                }
+                const bool area = part->getType() == osgEarth::Geometry::TYPE_POLYGON ||
+                                  part->getType() == osgEarth::Geometry::TYPE_RING;
+                shape.widthMeters = area ? 0.0 : std::max(width, 1.0);
+                shape.value = value;
+                (value == kRunwayValue ? runways : taxiways).push_back(std::move(shape));
+            }
+        }
+    }
+
+    if (runways.empty() && taxiways.empty()) {
+        return syntheticLayout();
+    }
+
+    double minLon = std::numeric_limits<double>::max();
+    double minLat = std::numeric_limits<double>::max();
+    double maxLon = std::numeric_limits<double>::lowest();
+    double maxLat = std::numeric_limits<double>::lowest();
+    for (const std::vector<GeoShape>* group : {&runways, &taxiways}) {
+        for (const GeoShape& shape : *group) {
+            for (const osg::Vec3d& point : shape.points) {
+                minLon = std::min(minLon, point.x());
+                maxLon = std::max(maxLon, point.x());
+                minLat = std::min(minLat, point.y());
+                maxLat = std::max(maxLat, point.y());
+            }
+        }
+    }
+
+    auto layout = std::make_shared<Layout>();
+    layout->centerLon = (minLon + maxLon) * 0.5;
+    layout->centerLat = (minLat + maxLat) * 0.5;
+    const double metersPerLon = kMetersPerDegree * std::cos(osg::DegreesToRadians(layout->centerLat));
+    layout->extentMeters =
+        std::max((maxLon - minLon) * metersPerLon, (maxLat - minLat) * kMetersPerDegree) + 2.0 * kExtentPaddingMeters;
+
+    // 机场尺度内等距圆柱近似足够精确；滑行道先画，跑道覆盖其上。
+    for (const std::vector<GeoShape>* group : {&taxiways, &runways}) {
+        for (const GeoShape& geo : *group) {
+            Shape shape;
+            shape.widthMeters = geo.widthMeters;
+            shape.value = geo.value;
+            shape.points.reserve(geo.points.size());
+            for (const osg::Vec3d& point : geo.points) {
+                shape.points.emplace_back((point.x() - layout->centerLon) * metersPerLon,
+                                          (point.y() - layout->centerLat) * kMetersPerDegree);
+            }
+            layout->shapes.push_back(std::move(shape));
+        }
+    }
+    return layout;
+}
+
+std::shared_ptr<const RunwayMaskService::Layout> RunwayMaskService::syntheticLayout() {
+    auto layout = std::make_shared<Layout>();
+    layout->extentMeters = kSyntheticExtent;
+    layout->synthetic = true;
+
+    const double halfLength = kSyntheticRunwayLength * 0.5;
+    const double halfWidth = kSyntheticRunwayWidth * 0.5;
+    Shape runway;
+    runway.value = kRunwayValue;
+    runway.points = {{-halfLength, -halfWidth}, {halfLength, -halfWidth}, {halfLength, halfWidth}, {-halfLength, halfWidth}};
+    layout->shapes.push_back(std::move(runway));
+
+    Shape centerLine;
+    centerLine.value = kTaxiwayValue;
+    centerLine.widthMeters = kSyntheticCenterLineWidth;
+    centerLine.points = {{-halfLength, 0.0}, {halfLength, 0.0}};
+    layout->shapes.push_back(std::move(centerLine));
+    return layout;
+}
+
+std::shared_ptr<const RunwayMaskPyramid> RunwayMaskService::buildPyramid(const Layout& layout,
+                                                                        const std::string& airport,
+                                                                        int resolution) {
+    auto pyramid = std::make_shared<RunwayMaskPyramid>();
+    pyramid->airport = airport;
+    pyramid->centerLon = layout.centerLon;
+    pyramid->centerLat = layout.centerLat;
+    pyramid->extentMeters = layout.extentMeters;
+    pyramid->synthetic = layout.synthetic;
+
+    cv::Mat base(resolution, resolution, CV_8UC1, cv::Scalar(0));
+    const double scale = static_cast<double>(resolution) / layout.extentMeters;
+    const double half = layout.extentMeters * 0.5;
+    const double fixedPoint = static_cast<double>(1 << kSubpixelShift);
+    std::vector<std::vector<cv::Point>> contour(1);
+    for (const Shape& shape : layout.shapes) {
+        std::vector<cv::Point>& points = contour.front();
+        points.clear();
+        for (const cv::Point2d& local : shape.points) {
+            points.emplace_back(static_cast<int>(std::lround((local.x + half) * scale * fixedPoint)),
+                                static_cast<int>(std::lround((half - local.y) * scale * fixedPoint)));
+        }
+        const cv::Scalar color(shape.value);
+        if (shape.widthMeters > 0.0) {
+            const int thickness = std::max(1, static_cast<int>(std::lround(shape.widthMeters * scale)));
+            cv::polylines(base, contour, false, color, thickness, cv::LINE_8, kSubpixelShift);
+        } else {
+            cv::fillPoly(base, contour, color, cv::LINE_8, kSubpixelShift);
+        }
+    }
+
+    pyramid->levels.push_back(base);
+    while (pyramid->levels.back().cols / 2 >= kMinLevelSize) {
+        cv::Mat next;
+        cv::pyrDown(pyramid->levels.back(), next);
+        pyramid->levels.push_back(next);
+    }
+    return pyramid;
+}
+
+void RunwayMaskService::trimLocked() const {
+    std::size_t total = 0;
+    for (const CacheEntry& entry : m_cache) {
+        total += entry.pyramid->byteSize();
+    }
+    // 至少保留最近使用的一项；被淘汰的金字塔仍由外部视图持有直到释放。
+    while (total > kMaxCachedBytes && m_cache.size() > 1) {
+        total -= m_cache.back().pyramid->byteSize();
+        m_cache.pop_back();
+    }
+}
+
+} // namespace earth::core
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osgEarth {
+class MapNode;
+}
+
+namespace earth::core {
+
+/**
+ * @brief 某机场某分辨率的跑道掩码金字塔，构建后只读，由 RunwayMaskService 通过 shared_ptr 共享。
+ *
+ * levels[0] 为请求分辨率，以 cv::LINE_8 栅格化，边缘为硬边，像素值只有跑道 255、滑行道 128、其余 0 三种；
+ * 其后每级由 cv::pyrDown 减半，高斯平滑使这些层级的边缘出现过渡灰度。
+ * 掩码覆盖以机场中心为原点、边长 extentMeters 的正方形区域，行方向自北向南。
+ */
+struct RunwayMaskPyramid {
+    std::string airport;
+    double centerLon = 0.0;
+    double centerLat = 0.0;
+    double extentMeters = 0.0;
+    bool synthetic = false; /**< 地图中没有跑道要素，使用程序化跑道的占位掩码。 */
+    std::vector<cv::Mat> levels;
+
+    /**
+     * @brief 边长等于 resolution 的层级下标，不存在时返回 -1。
+     */
+    [[nodiscard]] int findLevel(int resolution) const noexcept;
+
+    [[nodiscard]] std::size_t byteSize() const noexcept;
+};
+
+/**
+ * @brief 金字塔某一层的只读视图：持有金字塔的共享引用，不复制像素数据。
+ */
+class RunwayMaskView {
+public:
+    RunwayMaskView() = default;
+    RunwayMaskView(std::shared_ptr<const RunwayMaskPyramid> pyramid, int level);
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * @brief 掩码图像；视图为空时返回空 Mat。可直接作为 cv::InputArray 传给 OpenCV 算法。
+     */
+    [[nodiscard]] const cv::Mat& mat() const noexcept;
+
+    [[nodiscard]] int level() const noexcept { return m_level; }
+    [[nodiscard]] double metersPerPixel() const noexcept;
+    [[nodiscard]] const RunwayMaskPyramid* pyramid() const noexcept { return m_pyramid.get(); }
+
+private:
+    std::shared_ptr<const RunwayMaskPyramid> m_pyramid;
+    int m_level = -1;
+};
+
+/**
+ * @brief 跑道掩码服务：从当前地图的要素图层栅格化跑道/滑行道多边形，按“机场 + 分辨率”缓存掩码金字塔。
+ *
+ * 要素按 OSM 约定的 aeroway 属性（runway / taxiway）或图层名称识别；线要素按 width 属性（缺省 45 米）加宽。
+ * 已缓存金字塔的第 0 层边长与请求相同时直接返回，不再栅格化；较低层级是平滑过的，不用于应答 mask()，
+ * 需要时经 RunwayMaskView::pyramid() 的 levels 显式取用。缓存总量超过上限时按最近最少使用淘汰，
+ * 被淘汰的金字塔在最后一个视图释放后才真正回收。所有接口线程安全。
+ */
+class RunwayMaskService {
+public:
+    static constexpr int kMaxResolution = 8192;
+    static constexpr int kMinLevelSize = 32;
+    static constexpr std::size_t kMaxCachedBytes = std::size_t {256} * 1024U * 1024U;
+
+    /**
+     * @brief 获取 mapNode 所在机场、边长为 resolution 的硬边掩码视图（总是金字塔第 0 层）；
+     * resolution 限制在 [kMinLevelSize, kMaxResolution]。
+     */
+    [[nodiscard]] RunwayMaskView mask(const osgEarth::MapNode* mapNode, int resolution) const;
+
+    /**
+     * @brief 丢弃某机场的要素与金字塔缓存（例如重新加载了同名 .earth）。
+     */
+    void invalidate(const std::string& airport);
+
+    void clear();
+
+    /**
+     * @brief 机场标识：地图名称，缺省时取 MapNode 节点名。
+     */
+    [[nodiscard]] static std::string airportKey(const osgEarth::MapNode* mapNode);
+
+private:
+    /**
+     * @brief 机场局部坐标（米，东/北）下的跑道形状。
+     */
+    struct Shape {
+        std::vector<cv::Point2d> points;
+        double widthMeters = 0.0; /**< 大于 0 表示线要素，按该宽度描边。 */
+        std::uint8_t value = 0;
+    };
+
+    struct Layout {
+        double centerLon = 0.0;
+        double centerLat = 0.0;
+        double extentMeters = 0.0;
+        bool synthetic = false;
+        std::vector<Shape> shapes;
+    };
+
+    struct CacheEntry {
+        std::string airport;
+        std::shared_ptr<const RunwayMaskPyramid> pyramid;
+    };
+
+    [[nodiscard]] std::shared_ptr<const Layout> layoutFor(const osgEarth::MapNode* mapNode, const std::string& airport) const;
+    [[nodiscard]] static std::shared_ptr<const Layout> collectLayout(const osgEarth::MapNode* mapNode);
+    [[nodiscard]] static std::shared_ptr<const Layout> syntheticLayout();
+    [[nodiscard]] static std::shared_ptr<const RunwayMaskPyramid> buildPyramid(const Layout& layout,
+                                                                              const std::string& airport,
+                                                                              int resolution);
+    void trimLocked() const;
+
+    mutable std::mutex m_mutex;
+    mutable std::map<std::string, std::shared_ptr<const Layout>> m_layouts;
+    mutable std::list<CacheEntry> m_cache; /**< 表头为最近使用。 */
+};
+
+} // namespace earth::core
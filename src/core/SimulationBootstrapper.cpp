@@ -7,14 +7,12 @@
 #include <osg/ShapeDrawable>
 #include <osg/StateAttribute>
 #include <osg/Vec3>
-#include <osgEarth/DateTime>
 #include <osgEarth/GeoData>
 #include <osgEarth/MapNode>
 #include <osgEarth/NodeUtils>
 #include <osgEarth/SpatialReference>
 #include <osgEarth/URI>
 #include <osgEarthDrivers/sky_simple/SimpleSkyOptions>
-#include <opencv2/imgproc.hpp>
 
 namespace earth::core {
 namespace {
@@ -23,24 +21,28 @@ namespace {
 SimulationBootstrapper::SimulationBootstrapper()
     : m_root(new osg::Group())
     , m_map(new osgEarth::Map())
-    , m_sceneContainer(new osg::Group()) {
+    , m_sceneContainer(new osg::Group())
+    , m_environmentRoot(new osg::Group()) {
     if (m_sceneContainer.valid()) {
         m_sceneContainer->setName("SceneContainer");
     }
+    m_environmentRoot->setName("EnvironmentRoot");
+    m_skyTime.install(m_root.get());
 }
 
 void SimulationBootstrapper::initialize() {
     EnvironmentBootstrapper::instance().initialize();
     buildSceneGraph();
-    m_cachedRunwayMask = buildRunwayMask(128);
+    // 预热默认分辨率，后续同分辨率请求直接命中缓存。
+    (void)runwayMask(kDefaultRunwayMaskResolution);
 }
 
 osg::Group* SimulationBootstrapper::sceneRoot() const {
     return m_root.get();
 }
 
-cv::Mat SimulationBootstrapper::runwayMask() const {
-    return m_cachedRunwayMask;
+RunwayMaskView SimulationBootstrapper::runwayMask(int resolution) const {
+    return m_runwayMasks.mask(activeMapNode(), resolution);
 }
 
 osgEarth::SkyNode* SimulationBootstrapper::skyNode() const {
@@ -53,6 +55,14 @@ osgEarth::SkyNode* SimulationBootstrapper::skyNode() const {
     return nullptr;
 }
 
+osg::Group* SimulationBootstrapper::environmentRoot() const {
+    return m_environmentRoot.get();
+}
+
+SkyTimeController& SimulationBootstrapper::skyTime() {
+    return m_skyTime;
+}
+
 bool SimulationBootstrapper::applyExternalScene(osg::Node* externalScene) {
     if (!externalScene || !m_sceneContainer.valid()) {
         return false;
@@ -62,6 +72,8 @@ bool SimulationBootstrapper::applyExternalScene(osg::Node* externalScene) {
     m_sceneContainer->addChild(externalScene);
 
     osgEarth::MapNode* mapNode = osgEarth::MapNode::findMapNode(externalScene);
+    // 同名地图可能已被修改，重新读取其跑道要素。
+    m_runwayMasks.invalidate(RunwayMaskService::airportKey(mapNode));
     configureSky(mapNode);
     rebuildSceneGraph();
     return mapNode != nullptr;
@@ -90,6 +102,22 @@ void SimulationBootstrapper::buildSceneGraph() {
     rebuildSceneGraph();
 }
 
+bool SimulationBootstrapper::setSkyQuality(osgEarth::SkyOptions::Quality quality, float ambient) {
+    if (m_skyQuality == quality && m_skyAmbient == ambient) {
+        return false;
+    }
+    m_skyQuality = quality;
+    m_skyAmbient = ambient;
+
+    // 外部场景自带天空时保持原样，新档位在下次使用内置天空时生效。
+    if (!m_sky.valid()) {
+        return false;
+    }
+    configureSky(activeMapNode());
+    rebuildSceneGraph();
+    return true;
+}
+
 osgEarth::MapNode* SimulationBootstrapper::activeMapNode() const {
     if (m_activeMapNode.valid()) {
         return m_activeMapNode.get();
@@ -97,32 +125,11 @@ osgEarth::MapNode* SimulationBootstrapper::activeMapNode() const {
     return nullptr;
 }
 
-cv::Mat SimulationBootstrapper::buildRunwayMask(int resolution) const {
-    cv::Mat mask(resolution, resolution, CV_8UC1, cv::Scalar(0));
-
-    const int runwayWidth = resolution / 10;
-    const cv::Rect runwayRect(resolution / 4, (resolution - runwayWidth) / 2, resolution / 2, runwayWidth);
-
-    cv::Mat roiRunway = mask(runwayRect);
-    roiRunway.setTo(cv::Scalar(255));
-
-    const int centerLineThickness = std::max(1, runwayWidth / 8);
-    const int centerY = runwayRect.y + runwayRect.height / 2 - centerLineThickness / 2;
-    cv::Rect centerRect(runwayRect.x, std::max(0, centerY), runwayRect.width, centerLineThickness);
-    centerRect &= cv::Rect(0, 0, mask.cols, mask.rows);
-    if (centerRect.width > 0 && centerRect.height > 0) {
-        cv::Mat roiCenter = mask(centerRect);
-        roiCenter.setTo(cv::Scalar(128));
-    }
-
-    return mask;
-}
-
 std::unique_ptr<osgEarth::SkyOptions> SimulationBootstrapper::buildSkyOptions(const osgEarth::SpatialReference* srs) const {
     const bool useSimpleSky = (srs == nullptr) || srs->isGeographic();
-    const auto configureCommon = [](osgEarth::SkyOptions& opts) {
-        opts.quality() = osgEarth::SkyOptions::QUALITY_LOW;
-        opts.ambient() = 0.08f;
+    const auto configureCommon = [this](osgEarth::SkyOptions& opts) {
+        opts.quality() = m_skyQuality;
+        opts.ambient() = m_skyAmbient;
         opts.hours() = 22.0f;
     };
 
@@ -150,6 +157,7 @@ void SimulationBootstrapper::configureSky(osgEarth::MapNode* mapNode) {
     if (!mapNode) {
         m_sky = nullptr;
         m_externalSky = nullptr;
+        m_skyTime.setSky(nullptr);
         return;
     }
 
@@ -168,6 +176,7 @@ void SimulationBootstrapper::configureSky(osgEarth::MapNode* mapNode) {
         embeddedSky->setMoonVisible(true);
         embeddedSky->setStarsVisible(true);
         embeddedSky->setAtmosphereVisible(true);
+        m_skyTime.setSky(embeddedSky);
         return;
     }
 
@@ -177,12 +186,12 @@ void SimulationBootstrapper::configureSky(osgEarth::MapNode* mapNode) {
         return;
     }
     m_sky = osgEarth::SkyNode::create(*options);
+    m_skyTime.setSky(m_sky.get());
     if (!m_sky.valid()) {
         return;
     }
 
     m_sky->setName("AtmosphereSkyNode");
-    m_sky->setDateTime(osgEarth::DateTime(2021, 4, 21, 22.0));
     m_sky->setSunVisible(true);
     m_sky->setMoonVisible(true);
     m_sky->setStarsVisible(true);
@@ -212,6 +221,10 @@ void SimulationBootstrapper::rebuildSceneGraph() {
     } else if (m_sceneContainer.valid()) {
         m_root->addChild(m_sceneContainer.get());
     }
+
+    if (m_environmentRoot.valid()) {
+        m_root->addChild(m_environmentRoot.get());
+    }
 }
 
 } // namespace earth::core
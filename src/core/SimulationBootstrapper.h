@@ -1,12 +1,14 @@
 #pragma once
 
+#include "core/RunwayMaskService.h"
+#include "core/SkyTimeController.h"
+
 #include <osg/Group>
 #include <osg/Node>
 #include <osg/observer_ptr>
 #include <osg/ref_ptr>
 #include <osgEarth/Map>
 #include <osgEarth/Sky>
-#include <opencv2/core.hpp>
 #include <memory>
 
 namespace osgEarth {
@@ -23,6 +25,8 @@ namespace earth::core {
  */
 class SimulationBootstrapper {
 public:
+    static constexpr int kDefaultRunwayMaskResolution = 128;
+
     SimulationBootstrapper();
 
     /**
@@ -36,15 +40,42 @@ public:
     osg::Group* sceneRoot() const;
 
     /**
-     * @brief 获取跑道区域掩码图，供视觉算法或调试面板复用。
+     * @brief 当前机场指定分辨率的跑道掩码只读视图，供视觉算法或调试面板复用；不复制像素数据。
+     */
+    RunwayMaskView runwayMask(int resolution = kDefaultRunwayMaskResolution) const;
+
+    /**
+     * @brief 跑道掩码服务，可按需获取其他分辨率或金字塔层级。
      */
-    cv::Mat runwayMask() const;
+    const RunwayMaskService& runwayMasks() const noexcept { return m_runwayMasks; }
 
     /**
      * @brief 暴露当前激活的 SkyNode，方便 SceneWidget 将其 attach 到 viewer 以驱动光照与星空。
      */
     osgEarth::SkyNode* skyNode() const;
 
+    /**
+     * @brief 环境效果根节点（降水、云层等），与天空节点并列挂在场景根下，加载外部场景时保持不变。
+     */
+    osg::Group* environmentRoot() const;
+
+    /**
+     * @brief 天空时间控制器，SkyNode 重建或切换为外部场景自带的天空后仍沿用同一时钟。
+     */
+    SkyTimeController& skyTime();
+
+    /**
+     * @brief 设置内置天空的画质档位与环境光，变化时按新参数重建 SkyNode；外部场景自带的天空不受影响。
+     * @return 重建了 SkyNode 时返回 true，调用方需重新将天空 attach 到 view。
+     */
+    bool setSkyQuality(osgEarth::SkyOptions::Quality quality, float ambient);
+    [[nodiscard]] osgEarth::SkyOptions::Quality skyQuality() const noexcept { return m_skyQuality; }
+
+    /**
+     * @brief 当前是否使用内置 SkyNode（而非外部 .earth 自带的天空）。
+     */
+    [[nodiscard]] bool usesBuiltinSky() const noexcept { return m_sky.valid(); }
+
     /**
      * @brief 将 .earth 文件加载得到的场景并入当前框架，自动接管天空与环境设置。
      * @param externalScene osgDB::readNodeFile 返回的根节点，必须包含 MapNode。
@@ -63,11 +94,6 @@ private:
      */
     void buildSceneGraph();
 
-    /**
-     * @brief 生成指定分辨率的跑道掩码，用于视觉算法或材质调试。
-     */
-    cv::Mat buildRunwayMask(int resolution) const;
-
     /**
      * @brief 根据地图空间参考配置 SkyNode 驱动、品质、时间等参数。
      */
@@ -86,10 +112,14 @@ private:
     osg::ref_ptr<osg::Group> m_root;
     osg::ref_ptr<osgEarth::Map> m_map;
     osg::ref_ptr<osg::Group> m_sceneContainer;
+    osg::ref_ptr<osg::Group> m_environmentRoot;
     osg::ref_ptr<osgEarth::SkyNode> m_sky;
     osg::observer_ptr<osgEarth::SkyNode> m_externalSky;
     osg::observer_ptr<osgEarth::MapNode> m_activeMapNode;
-    cv::Mat m_cachedRunwayMask;
+    RunwayMaskService m_runwayMasks;
+    SkyTimeController m_skyTime;
+    osgEarth::SkyOptions::Quality m_skyQuality = osgEarth::SkyOptions::QUALITY_LOW;
+    float m_skyAmbient = 0.08f;
 };
 
 } // namespace earth::core
@@ -0,0 +1,112 @@
+#include "core/SkyQualitySettings.h"
+
+#include "core/EnvironmentBootstrapper.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSettings>
+
+#include <algorithm>
+
+namespace {
+const char* const kSettingsFileName = "sky-quality.ini";
+
+osgEarth::SkyOptions::Quality qualityFromInt(int value, osgEarth::SkyOptions::Quality fallback) {
+    switch (value) {
+    case osgEarth::SkyOptions::QUALITY_DEFAULT:
+    case osgEarth::SkyOptions::QUALITY_LOW:
+    case osgEarth::SkyOptions::QUALITY_MEDIUM:
+    case osgEarth::SkyOptions::QUALITY_HIGH:
+        return static_cast<osgEarth::SkyOptions::Quality>(value);
+    default:
+        return fallback;
+    }
+}
+} // namespace
+
+namespace earth::core {
+
+osgEarth::SkyOptions::Quality SkyQualitySettings::effectiveQuality() const noexcept {
+    if (overrideQuality != osgEarth::SkyOptions::QUALITY_DEFAULT) {
+        return overrideQuality;
+    }
+    return calibratedQuality;
+}
+
+bool SkyQualitySettings::needsCalibration(const QString& currentRenderer) const {
+    return !calibrated || (!currentRenderer.isEmpty() && currentRenderer != renderer);
+}
+
+SkyQualitySettings SkyQualitySettings::load() {
+    SkyQualitySettings result;
+    const QString path = settingsFile();
+    if (path.isEmpty() || !QFileInfo::exists(path)) {
+        return result;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    settings.beginGroup(QStringLiteral("sky"));
+    result.calibratedQuality =
+        qualityFromInt(settings.value(QStringLiteral("calibratedQuality"), result.calibratedQuality).toInt(),
+                       osgEarth::SkyOptions::QUALITY_LOW);
+    result.overrideQuality =
+        qualityFromInt(settings.value(QStringLiteral("overrideQuality"), result.overrideQuality).toInt(),
+                       osgEarth::SkyOptions::QUALITY_DEFAULT);
+    result.ambient = std::clamp(settings.value(QStringLiteral("ambient"), result.ambient).toFloat(), 0.0F, 1.0F);
+    result.frameBudgetMs =
+        std::max(settings.value(QStringLiteral("frameBudgetMs"), result.frameBudgetMs).toDouble(), 1.0);
+    result.renderer = settings.value(QStringLiteral("renderer")).toString();
+    result.calibratedAt = settings.value(QStringLiteral("calibratedAt")).toString();
+    result.calibrated = settings.value(QStringLiteral("calibrated"), false).toBool();
+    settings.endGroup();
+    return result;
+}
+
+bool SkyQualitySettings::save() const {
+    const QString path = settingsFile();
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    settings.beginGroup(QStringLiteral("sky"));
+    settings.setValue(QStringLiteral("calibratedQuality"), static_cast<int>(calibratedQuality));
+    settings.setValue(QStringLiteral("overrideQuality"), static_cast<int>(overrideQuality));
+    settings.setValue(QStringLiteral("ambient"), ambient);
+    settings.setValue(QStringLiteral("frameBudgetMs"), frameBudgetMs);
+    settings.setValue(QStringLiteral("renderer"), renderer);
+    settings.setValue(QStringLiteral("calibratedAt"), calibratedAt);
+    settings.setValue(QStringLiteral("calibrated"), calibrated);
+    settings.endGroup();
+    settings.sync();
+    if (settings.status() != QSettings::NoError) {
+        qWarning() << "[SkyQuality] Failed to write" << path;
+        return false;
+    }
+    return true;
+}
+
+QString SkyQualitySettings::settingsFile() {
+    const QString root = EnvironmentBootstrapper::instance().dataRoot();
+    if (root.isEmpty()) {
+        return {};
+    }
+    return QDir(root).filePath(QString::fromLatin1(kSettingsFileName));
+}
+
+QString skyQualityName(osgEarth::SkyOptions::Quality quality) {
+    switch (quality) {
+    case osgEarth::SkyOptions::QUALITY_LOW:
+        return QStringLiteral("低");
+    case osgEarth::SkyOptions::QUALITY_MEDIUM:
+        return QStringLiteral("中");
+    case osgEarth::SkyOptions::QUALITY_HIGH:
+        return QStringLiteral("高");
+    case osgEarth::SkyOptions::QUALITY_DEFAULT:
+    default:
+        return QStringLiteral("自动");
+    }
+}
+
+} // namespace earth::core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QString>
+
+#include <osgEarth/Sky>
+
+namespace earth::core {
+
+/**
+ * @brief 天空画质档位配置：启动校准的结果与操作员的手动覆盖，保存在数据根目录的 sky-quality.ini 中。
+ *
+ * 校准结果与显卡型号绑定，换卡或驱动上报的渲染器名称变化后会重新校准；手动覆盖优先于校准结果。
+ */
+struct SkyQualitySettings {
+    /**
+     * @brief 校准时单帧耗时预算（毫秒），与云层步进自适应的预算一致。
+     */
+    static constexpr double kDefaultFrameBudgetMs = 22.0;
+
+    osgEarth::SkyOptions::Quality calibratedQuality = osgEarth::SkyOptions::QUALITY_LOW;
+    osgEarth::SkyOptions::Quality overrideQuality = osgEarth::SkyOptions::QUALITY_DEFAULT; /**< DEFAULT 表示不覆盖。 */
+    float ambient = 0.08F;
+    double frameBudgetMs = kDefaultFrameBudgetMs;
+    QString renderer;   /**< 校准时的 GL_RENDERER。 */
+    QString calibratedAt;
+    bool calibrated = false;
+
+    /**
+     * @brief 实际生效的档位：有覆盖时取覆盖值，否则取校准结果。
+     */
+    [[nodiscard]] osgEarth::SkyOptions::Quality effectiveQuality() const noexcept;
+
+    /**
+     * @brief 从未校准，或当前渲染器与校准时不同，需要重新校准。
+     */
+    [[nodiscard]] bool needsCalibration(const QString& currentRenderer) const;
+
+    /**
+     * @brief 读取配置；数据根目录未初始化或文件不存在时返回默认值。
+     */
+    static SkyQualitySettings load();
+
+    bool save() const;
+
+    static QString settingsFile();
+};
+
+/**
+ * @brief 档位的中文名称，供菜单与状态栏显示。
+ */
+QString skyQualityName(osgEarth::SkyOptions::Quality quality);
+
+} // namespace earth::core
@@ -0,0 +1,173 @@
+#include "core/SkyTimeController.h"
+
+#include "core/FrameMetrics.h"
+
+#include <osg/Node>
+#include <osg/NodeCallback>
+#include <osgEarth/DateTime>
+#include <osgEarth/Sky>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+// 保持与旧版 configureSky 写死的初始时刻一致。
+constexpr int kDefaultYear = 2021;
+constexpr int kDefaultMonth = 4;
+constexpr int kDefaultDay = 21;
+constexpr double kDefaultHours = 22.0;
+constexpr double kMaxTimeScale = 86400.0;
+
+double steadySeconds() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+
+double systemClockSeconds() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+
+/**
+ * @brief 在 update 遍历中驱动 SkyTimeController 下发时刻。
+ */
+class SkyTimeCallback final : public osg::NodeCallback {
+public:
+    explicit SkyTimeCallback(earth::core::SkyTimeController* controller)
+        : m_controller(controller) {
+    }
+
+    void operator()(osg::Node* node, osg::NodeVisitor* nv) override {
+        if (m_controller != nullptr) {
+            m_controller->updateTraversal();
+        }
+        traverse(node, nv);
+    }
+
+    void detach() noexcept { m_controller = nullptr; }
+
+private:
+    earth::core::SkyTimeController* m_controller = nullptr;
+};
+} // namespace
+
+namespace earth::core {
+
+SkyTimeController::SkyTimeController()
+    : m_updateCallback(new SkyTimeCallback(this)) {
+    const osgEarth::DateTime initial(kDefaultYear, kDefaultMonth, kDefaultDay, kDefaultHours);
+    reanchorLocked(static_cast<double>(initial.asTimeStamp()));
+}
+
+SkyTimeController::~SkyTimeController() {
+    if (auto* callback = dynamic_cast<SkyTimeCallback*>(m_updateCallback.get())) {
+        callback->detach();
+    }
+    osg::ref_ptr<osg::Node> host;
+    if (m_host.lock(host) && host->getUpdateCallback() == m_updateCallback.get()) {
+        host->setUpdateCallback(nullptr);
+    }
+}
+
+void SkyTimeController::install(osg::Node* host) {
+    osg::ref_ptr<osg::Node> previous;
+    if (m_host.lock(previous) && previous.get() != host && previous->getUpdateCallback() == m_updateCallback.get()) {
+        previous->setUpdateCallback(nullptr);
+    }
+    m_host = host;
+    if (host != nullptr) {
+        host->setUpdateCallback(m_updateCallback.get());
+    }
+}
+
+void SkyTimeController::setSky(osgEarth::SkyNode* sky) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sky = sky;
+    m_dirty = true;
+}
+
+void SkyTimeController::setMode(SkyClockMode mode) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_mode == mode) {
+        return;
+    }
+    const double current = currentEpochLocked();
+    m_mode = mode;
+    reanchorLocked(current);
+}
+
+SkyClockMode SkyTimeController::mode() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mode;
+}
+
+void SkyTimeController::setTimeScale(double scale) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const double current = currentEpochLocked();
+    m_timeScale = std::clamp(scale, 0.0, kMaxTimeScale);
+    reanchorLocked(current);
+}
+
+double SkyTimeController::timeScale() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timeScale;
+}
+
+void SkyTimeController::setEpochSeconds(double epochSeconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    reanchorLocked(epochSeconds);
+}
+
+double SkyTimeController::epochSeconds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return currentEpochLocked();
+}
+
+void SkyTimeController::setMinimumStepSeconds(double seconds) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_minimumStep = std::max(seconds, 0.0);
+}
+
+void SkyTimeController::updateTraversal() {
+    osg::ref_ptr<osgEarth::SkyNode> sky;
+    double epoch = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_sky.lock(sky)) {
+            return;
+        }
+        epoch = currentEpochLocked();
+        // 滑块一帧内的多次拖动只取最后一次；变化不可察觉时跳过星历与光照 uniform 的重算。
+        if (!m_dirty && std::abs(epoch - m_appliedEpoch) < m_minimumStep) {
+            return;
+        }
+        m_appliedEpoch = epoch;
+        m_dirty = false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    sky->setDateTime(osgEarth::DateTime(static_cast<osgEarth::TimeStamp>(std::llround(epoch))));
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    FrameMetrics::instance().recordDuration("sky.setDateTime", elapsed.count());
+}
+
+double SkyTimeController::currentEpochLocked() const {
+    switch (m_mode) {
+    case SkyClockMode::Realtime:
+        return systemClockSeconds();
+    case SkyClockMode::Accelerated:
+        return m_anchorEpoch + (steadySeconds() - m_anchorWallTime) * m_timeScale;
+    case SkyClockMode::Manual:
+    default:
+        return m_anchorEpoch;
+    }
+}
+
+void SkyTimeController::reanchorLocked(double epochSeconds) {
+    m_anchorEpoch = epochSeconds;
+    m_anchorWallTime = steadySeconds();
+    m_dirty = true;
+}
+
+} // namespace earth::core
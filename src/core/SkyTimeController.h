@@ -0,0 +1,101 @@
+#pragma once
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <mutex>
+
+namespace osg {
+class Node;
+class NodeCallback;
+} // namespace osg
+
+namespace osgEarth {
+class SkyNode;
+}
+
+namespace earth::core {
+
+/**
+ * @brief 天空时钟模式。
+ */
+enum class SkyClockMode {
+    Manual,      /**< 固定时刻，由时间滑块拖动。 */
+    Realtime,    /**< 跟随系统 UTC 时间。 */
+    Accelerated  /**< 从锚定时刻起按倍率推进。 */
+};
+
+/**
+ * @brief 驱动 SkyNode 昼夜变化的时间控制器，替代 configureSky 中写死的日期。
+ *
+ * UI 线程只修改目标时刻与模式；update 遍历中每帧最多调用一次 SkyNode::setDateTime，
+ * 且仅在太阳位置变化可察觉（仿真时间前进超过阈值）或天空节点更换时才下发，
+ * 星历与光照 uniform 的重算因此与滑块信号频率、加速倍率解耦。SkyNode 重建后自动续用当前时刻。
+ */
+class SkyTimeController {
+public:
+    /**
+     * @brief 默认下发阈值（秒）：太阳每秒移动约 0.004°，10 秒的变化在画面上不可察觉。
+     */
+    static constexpr double kDefaultMinimumStepSeconds = 10.0;
+
+    SkyTimeController();
+    ~SkyTimeController();
+
+    SkyTimeController(const SkyTimeController&) = delete;
+    SkyTimeController& operator=(const SkyTimeController&) = delete;
+
+    /**
+     * @brief 在宿主节点上安装 update 回调；宿主应为常驻的场景根节点。
+     */
+    void install(osg::Node* host);
+
+    /**
+     * @brief 绑定当前天空节点，更换后下一帧立即下发当前时刻。
+     */
+    void setSky(osgEarth::SkyNode* sky);
+
+    void setMode(SkyClockMode mode);
+    [[nodiscard]] SkyClockMode mode() const;
+
+    /**
+     * @brief 加速模式的时间倍率（仿真秒 / 真实秒）。
+     */
+    void setTimeScale(double scale);
+    [[nodiscard]] double timeScale() const;
+
+    /**
+     * @brief 设置当前时刻（UTC 秒）；手动模式下即滑块位置，加速模式下作为新的起点。
+     */
+    void setEpochSeconds(double epochSeconds);
+
+    /**
+     * @brief 按当前模式推算的时刻（UTC 秒）。
+     */
+    [[nodiscard]] double epochSeconds() const;
+
+    void setMinimumStepSeconds(double seconds);
+
+    /**
+     * @brief 由 update 回调调用：按需把当前时刻下发给 SkyNode。
+     */
+    void updateTraversal();
+
+private:
+    [[nodiscard]] double currentEpochLocked() const;
+    void reanchorLocked(double epochSeconds);
+
+    mutable std::mutex m_mutex;
+    osg::observer_ptr<osgEarth::SkyNode> m_sky;
+    osg::observer_ptr<osg::Node> m_host;
+    osg::ref_ptr<osg::NodeCallback> m_updateCallback;
+    SkyClockMode m_mode = SkyClockMode::Manual;
+    double m_anchorEpoch = 0.0;
+    double m_anchorWallTime = 0.0;
+    double m_timeScale = 60.0;
+    double m_minimumStep = kDefaultMinimumStepSeconds;
+    double m_appliedEpoch = 0.0;
+    bool m_dirty = true;
+};
+
+} // namespace earth::core
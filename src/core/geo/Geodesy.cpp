@@ -0,0 +1,226 @@
+#include "core/geo/Geodesy.h"
+
+#include "core/geo/GeodesyKernels.h"
+
+#include <atomic>
+
+#if defined(EARTH_GEODESY_AVX2) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace earth::core::geo {
+namespace {
+using Scalar = simd::ScalarBackend;
+
+bool cpuSupportsAvx2() noexcept {
+#if defined(EARTH_GEODESY_AVX2) && defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave || !fma) {
+        return false;
+    }
+    // 操作系统须同时保存 XMM 与 YMM 寄存器状态。
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(EARTH_GEODESY_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+const detail::KernelTable& scalarTable() {
+    static const detail::KernelTable table = detail::makeKernelTable<Scalar>(SimdLevel::Scalar);
+    return table;
+}
+
+#if defined(EARTH_GEO_BACKEND_NEON)
+const detail::KernelTable& neonTable() {
+    static const detail::KernelTable table = detail::makeKernelTable<simd::NeonBackend>(SimdLevel::Neon);
+    return table;
+}
+#endif
+
+const detail::KernelTable& tableFor(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Avx2:
+#if defined(EARTH_GEODESY_AVX2)
+        return detail::avx2KernelTable();
+#else
+        break;
+#endif
+    case SimdLevel::Neon:
+#if defined(EARTH_GEO_BACKEND_NEON)
+        return neonTable();
+#else
+        break;
+#endif
+    case SimdLevel::Scalar:
+        break;
+    }
+    return scalarTable();
+}
+
+std::atomic<const detail::KernelTable*>& activeTableSlot() {
+    static std::atomic<const detail::KernelTable*> slot {&tableFor(detectedSimdLevel())};
+    return slot;
+}
+
+const detail::KernelTable& kernels() {
+    return *activeTableSlot().load(std::memory_order_acquire);
+}
+} // namespace
+
+EnuFrame EnuFrame::at(double lonDeg, double latDeg, double heightMeters) noexcept {
+    double sinLat = 0.0;
+    double cosLat = 0.0;
+    simd::sincos<Scalar>(latDeg * detail::kDegToRad, sinLat, cosLat);
+    double sinLon = 0.0;
+    double cosLon = 0.0;
+    simd::sincos<Scalar>(lonDeg * detail::kDegToRad, sinLon, cosLon);
+
+    EnuFrame frame;
+    frame.origin = geodeticToEcef(lonDeg, latDeg, heightMeters);
+    frame.east[0] = -sinLon;
+    frame.east[1] = cosLon;
+    frame.east[2] = 0.0;
+    frame.north[0] = -sinLat * cosLon;
+    frame.north[1] = -sinLat * sinLon;
+    frame.north[2] = cosLat;
+    frame.up[0] = cosLat * cosLon;
+    frame.up[1] = cosLat * sinLon;
+    frame.up[2] = sinLat;
+    return frame;
+}
+
+SimdLevel detectedSimdLevel() noexcept {
+    static const SimdLevel level = []() {
+        if (cpuSupportsAvx2()) {
+            return SimdLevel::Avx2;
+        }
+#if defined(EARTH_GEO_BACKEND_NEON)
+        // AArch64 的 Advanced SIMD 是基线指令集，无需运行时检测。
+        return SimdLevel::Neon;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+    return level;
+}
+
+SimdLevel activeSimdLevel() noexcept {
+    return kernels().level;
+}
+
+SimdLevel setSimdLevel(SimdLevel level) noexcept {
+    const SimdLevel detected = detectedSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(detected)) {
+        level = detected;
+    }
+    const detail::KernelTable& table = tableFor(level);
+    activeTableSlot().store(&table, std::memory_order_release);
+    return table.level;
+}
+
+const char* simdLevelName(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Avx2:
+        return "avx2";
+    case SimdLevel::Neon:
+        return "neon";
+    case SimdLevel::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+double haversineMeters(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept {
+    return detail::haversinePack<Scalar>(lon1Deg, lat1Deg, lon2Deg, lat2Deg);
+}
+
+void haversineMeters(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                     double* out, std::size_t count) noexcept {
+    kernels().haversine(lon1Deg, lat1Deg, lon2Deg, lat2Deg, out, count);
+}
+
+double vincentyMeters(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept {
+    return detail::vincentyPack<Scalar>(lon1Deg, lat1Deg, lon2Deg, lat2Deg);
+}
+
+void vincentyMeters(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                    double* out, std::size_t count) noexcept {
+    kernels().vincenty(lon1Deg, lat1Deg, lon2Deg, lat2Deg, out, count);
+}
+
+double initialBearingDeg(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept {
+    return detail::bearingPack<Scalar>(lon1Deg, lat1Deg, lon2Deg, lat2Deg);
+}
+
+void initialBearingDeg(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                       double* out, std::size_t count) noexcept {
+    kernels().bearing(lon1Deg, lat1Deg, lon2Deg, lat2Deg, out, count);
+}
+
+void destinationPoint(double lonDeg, double latDeg, double bearingDeg, double distanceMeters, double& outLonDeg,
+                      double& outLatDeg) noexcept {
+    detail::destinationPack<Scalar>(lonDeg, latDeg, bearingDeg, distanceMeters, outLonDeg, outLatDeg);
+}
+
+void destinationPoint(const double* lonDeg, const double* latDeg, const double* bearingDeg,
+                      const double* distanceMeters, double* outLonDeg, double* outLatDeg, std::size_t count) noexcept {
+    kernels().destination(lonDeg, latDeg, bearingDeg, distanceMeters, outLonDeg, outLatDeg, count);
+}
+
+Ecef geodeticToEcef(double lonDeg, double latDeg, double heightMeters) noexcept {
+    Ecef ecef;
+    detail::geodeticToEcefPack<Scalar>(lonDeg, latDeg, heightMeters, ecef.x, ecef.y, ecef.z);
+    return ecef;
+}
+
+void geodeticToEcef(const double* lonDeg, const double* latDeg, const double* heightMeters, double* x, double* y,
+                    double* z, std::size_t count) noexcept {
+    kernels().geodeticToEcef(lonDeg, latDeg, heightMeters, x, y, z, count);
+}
+
+void ecefToGeodetic(const Ecef& ecef, double& lonDeg, double& latDeg, double& heightMeters) noexcept {
+    detail::ecefToGeodeticPack<Scalar>(ecef.x, ecef.y, ecef.z, lonDeg, latDeg, heightMeters);
+}
+
+void ecefToGeodetic(const double* x, const double* y, const double* z, double* lonDeg, double* latDeg,
+                    double* heightMeters, std::size_t count) noexcept {
+    kernels().ecefToGeodetic(x, y, z, lonDeg, latDeg, heightMeters, count);
+}
+
+void ecefToEnu(const EnuFrame& frame, const double* x, const double* y, const double* z, double* east, double* north,
+               double* up, std::size_t count) noexcept {
+    kernels().ecefToEnu(frame, x, y, z, east, north, up, count);
+}
+
+void enuToEcef(const EnuFrame& frame, const double* east, const double* north, const double* up, double* x, double* y,
+               double* z, std::size_t count) noexcept {
+    kernels().enuToEcef(frame, east, north, up, x, y, z, count);
+}
+
+void geodeticToEnu(const EnuFrame& frame, const double* lonDeg, const double* latDeg, const double* heightMeters,
+                   double* east, double* north, double* up, std::size_t count) noexcept {
+    const detail::KernelTable& table = kernels();
+    // 逐包先读后写，ECEF 中间结果可原地转换。
+    table.geodeticToEcef(lonDeg, latDeg, heightMeters, east, north, up, count);
+    table.ecefToEnu(frame, east, north, up, east, north, up, count);
+}
+
+void enuToGeodetic(const EnuFrame& frame, const double* east, const double* north, const double* up, double* lonDeg,
+                   double* latDeg, double* heightMeters, std::size_t count) noexcept {
+    const detail::KernelTable& table = kernels();
+    table.enuToEcef(frame, east, north, up, lonDeg, latDeg, heightMeters, count);
+    table.ecefToGeodetic(lonDeg, latDeg, heightMeters, lonDeg, latDeg, heightMeters, count);
+}
+
+} // namespace earth::core::geo
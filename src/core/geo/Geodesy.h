@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+
+namespace earth::core::geo {
+
+constexpr double kWgs84SemiMajorAxis = 6378137.0;
+constexpr double kWgs84Flattening = 1.0 / 298.257223563;
+constexpr double kWgs84SemiMinorAxis = kWgs84SemiMajorAxis * (1.0 - kWgs84Flattening);
+constexpr double kWgs84EccentricitySq = kWgs84Flattening * (2.0 - kWgs84Flattening);
+
+/**
+ * @brief 地心地固（ECEF）坐标，单位米。
+ */
+struct Ecef {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+/**
+ * @brief 以某一大地坐标点为原点的局部东-北-天（ENU）坐标系；east/north/up 为 ECEF 下的单位轴向量。
+ */
+struct EnuFrame {
+    Ecef origin;
+    double east[3] = {1.0, 0.0, 0.0};
+    double north[3] = {0.0, 1.0, 0.0};
+    double up[3] = {0.0, 0.0, 1.0};
+
+    static EnuFrame at(double lonDeg, double latDeg, double heightMeters) noexcept;
+};
+
+/**
+ * @brief 批量核使用的指令集。运行时按 CPU 能力选择，可向下强制以便对比与排查。
+ */
+enum class SimdLevel {
+    Scalar,
+    Neon,
+    Avx2,
+};
+
+/**
+ * @brief 本机可用的最高指令集（编译时未包含的后端不计入）。
+ */
+SimdLevel detectedSimdLevel() noexcept;
+SimdLevel activeSimdLevel() noexcept;
+
+/**
+ * @brief 强制批量核使用指定指令集，高于 detectedSimdLevel() 时取后者；返回实际生效的级别。
+ */
+SimdLevel setSimdLevel(SimdLevel level) noexcept;
+const char* simdLevelName(SimdLevel level) noexcept;
+
+/**
+ * @brief 半正矢（haversine）球面距离，球半径取 WGS84 长半轴，输入为度。
+ *
+ * 绘制量测的最小采样间距判定等对精度要求不高的场景使用；需要椭球精度时使用 Vincenty。
+ */
+double haversineMeters(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept;
+
+/**
+ * @brief 批量 haversine：结构数组（SoA）输入，out[i] 为第 i 对点的距离；各数组长度均为 count。
+ *
+ * 以下批量接口均按 activeSimdLevel() 分派到向量核，数组无对齐要求，输出不可与输入重叠。
+ */
+void haversineMeters(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                     double* out, std::size_t count) noexcept;
+
+/**
+ * @brief Vincenty 反算的 WGS84 椭球测地线距离，毫米级精度；近对跖点不收敛时退化为 haversine。
+ */
+double vincentyMeters(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept;
+void vincentyMeters(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                    double* out, std::size_t count) noexcept;
+
+/**
+ * @brief 从点 1 指向点 2 的球面初始方位角，正北起顺时针，范围 [0, 360)。
+ */
+double initialBearingDeg(double lon1Deg, double lat1Deg, double lon2Deg, double lat2Deg) noexcept;
+void initialBearingDeg(const double* lon1Deg, const double* lat1Deg, const double* lon2Deg, const double* lat2Deg,
+                       double* out, std::size_t count) noexcept;
+
+/**
+ * @brief 球面正算：自起点沿方位角行进 distanceMeters 后的终点，经度归一化到 [-180, 180]。
+ */
+void destinationPoint(double lonDeg, double latDeg, double bearingDeg, double distanceMeters, double& outLonDeg,
+                      double& outLatDeg) noexcept;
+void destinationPoint(const double* lonDeg, const double* latDeg, const double* bearingDeg,
+                      const double* distanceMeters, double* outLonDeg, double* outLatDeg, std::size_t count) noexcept;
+
+/**
+ * @brief WGS84 大地坐标（度、度、米）转 ECEF。
+ */
+Ecef geodeticToEcef(double lonDeg, double latDeg, double heightMeters) noexcept;
+void geodeticToEcef(const double* lonDeg, const double* latDeg, const double* heightMeters, double* x, double* y,
+                    double* z, std::size_t count) noexcept;
+
+/**
+ * @brief ECEF 转 WGS84 大地坐标，Bowring 单次迭代，近地表误差在毫米级。
+ */
+void ecefToGeodetic(const Ecef& ecef, double& lonDeg, double& latDeg, double& heightMeters) noexcept;
+void ecefToGeodetic(const double* x, const double* y, const double* z, double* lonDeg, double* latDeg,
+                    double* heightMeters, std::size_t count) noexcept;
+
+/**
+ * @brief ECEF 与局部 ENU 之间的刚体变换。
+ */
+void ecefToEnu(const EnuFrame& frame, const double* x, const double* y, const double* z, double* east, double* north,
+               double* up, std::size_t count) noexcept;
+void enuToEcef(const EnuFrame& frame, const double* east, const double* north, const double* up, double* x, double* y,
+               double* z, std::size_t count) noexcept;
+
+/**
+ * @brief 大地坐标与局部 ENU 直接互转；输出数组兼作 ECEF 中间结果，不额外分配。
+ */
+void geodeticToEnu(const EnuFrame& frame, const double* lonDeg, const double* latDeg, const double* heightMeters,
+                   double* east, double* north, double* up, std::size_t count) noexcept;
+void enuToGeodetic(const EnuFrame& frame, const double* east, const double* north, const double* up, double* lonDeg,
+                   double* latDeg, double* heightMeters, std::size_t count) noexcept;
+
+} // namespace earth::core::geo
@@ -0,0 +1,15 @@
+// 本翻译单元以 AVX2/FMA 编译（见 src/CMakeLists.txt），只在运行时检测到 CPU 支持后才会被调用。
+#include "core/geo/GeodesyKernels.h"
+
+#if !defined(EARTH_GEO_BACKEND_AVX2)
+#error "GeodesyAvx2.cpp must be compiled with AVX2 and FMA enabled"
+#endif
+
+namespace earth::core::geo::detail {
+
+const KernelTable& avx2KernelTable() {
+    static const KernelTable table = makeKernelTable<simd::Avx2Backend>(SimdLevel::Avx2);
+    return table;
+}
+
+} // namespace earth::core::geo::detail
@@ -0,0 +1,401 @@
+#pragma once
+
+/**
+ * @file GeodesyKernels.h
+ * @brief 测地批量核：按向量后端模板化的单包（pack）计算与 SoA 循环驱动，以及供分派使用的函数表。
+ *
+ * Geodesy.cpp 实例化标量与 NEON 版本，GeodesyAvx2.cpp 以 AVX2/FMA 编译选项实例化 AVX2 版本。
+ * 单点接口直接调用标量后端的 pack 函数，因此单点与批量在标量路径上结果逐位一致。
+ * 仅供 core/geo 内部使用。
+ */
+
+#include "core/geo/Geodesy.h"
+#include "core/geo/SimdMath.h"
+
+#include <array>
+#include <cstddef>
+
+namespace earth::core::geo::detail {
+
+using BinaryKernel = void (*)(const double*, const double*, const double*, const double*, double*, std::size_t);
+using TripleKernel = void (*)(const double*, const double*, const double*, double*, double*, double*, std::size_t);
+using DestinationKernel = void (*)(const double*, const double*, const double*, const double*, double*, double*,
+                                   std::size_t);
+using FrameKernel = void (*)(const EnuFrame&, const double*, const double*, const double*, double*, double*, double*,
+                             std::size_t);
+
+/**
+ * @brief 一个后端的全部批量核。
+ */
+struct KernelTable {
+    SimdLevel level = SimdLevel::Scalar;
+    BinaryKernel haversine = nullptr;
+    BinaryKernel vincenty = nullptr;
+    BinaryKernel bearing = nullptr;
+    DestinationKernel destination = nullptr;
+    TripleKernel geodeticToEcef = nullptr;
+    TripleKernel ecefToGeodetic = nullptr;
+    FrameKernel ecefToEnu = nullptr;
+    FrameKernel enuToEcef = nullptr;
+};
+
+/**
+ * @brief AVX2 函数表，未编译 AVX2 翻译单元时不存在，由 CMake 定义 EARTH_GEODESY_AVX2 指示。
+ */
+const KernelTable& avx2KernelTable();
+
+constexpr double kDegToRad = simd::kPi / 180.0;
+constexpr double kRadToDeg = 180.0 / simd::kPi;
+// 第二偏心率平方 e'^2 = (a^2 - b^2) / b^2。
+constexpr double kSecondEccentricitySq =
+    (kWgs84SemiMajorAxis * kWgs84SemiMajorAxis - kWgs84SemiMinorAxis * kWgs84SemiMinorAxis) /
+    (kWgs84SemiMinorAxis * kWgs84SemiMinorAxis);
+constexpr int kVincentyMaxIterations = 100;
+constexpr double kVincentyTolerance = 1e-12;
+
+// ---- 单包计算 ----
+
+template <class B>
+typename B::V haversinePack(typename B::V lon1, typename B::V lat1, typename B::V lon2, typename B::V lat2) {
+    using V = typename B::V;
+    const V toRad = B::set1(kDegToRad);
+    const V half = B::set1(0.5);
+    V sinHalfLat;
+    V cosUnused;
+    simd::sincos<B>((lat2 - lat1) * toRad * half, sinHalfLat, cosUnused);
+    V sinHalfLon;
+    simd::sincos<B>((lon2 - lon1) * toRad * half, sinHalfLon, cosUnused);
+    V sinLat1;
+    V cosLat1;
+    simd::sincos<B>(lat1 * toRad, sinLat1, cosLat1);
+    V sinLat2;
+    V cosLat2;
+    simd::sincos<B>(lat2 * toRad, sinLat2, cosLat2);
+
+    V hav = B::fma(cosLat1 * cosLat2, sinHalfLon * sinHalfLon, sinHalfLat * sinHalfLat);
+    hav = B::min(B::max(hav, B::set1(0.0)), B::set1(1.0));
+    return B::set1(2.0 * kWgs84SemiMajorAxis) * simd::atan2<B>(B::sqrt(hav), B::sqrt(B::set1(1.0) - hav));
+}
+
+template <class B>
+typename B::V bearingPack(typename B::V lon1, typename B::V lat1, typename B::V lon2, typename B::V lat2) {
+    using V = typename B::V;
+    const V toRad = B::set1(kDegToRad);
+    V sinLat1;
+    V cosLat1;
+    simd::sincos<B>(lat1 * toRad, sinLat1, cosLat1);
+    V sinLat2;
+    V cosLat2;
+    simd::sincos<B>(lat2 * toRad, sinLat2, cosLat2);
+    V sinDLon;
+    V cosDLon;
+    simd::sincos<B>((lon2 - lon1) * toRad, sinDLon, cosDLon);
+
+    const V y = sinDLon * cosLat2;
+    const V x = cosLat1 * sinLat2 - sinLat1 * cosLat2 * cosDLon;
+    const V degrees = simd::atan2<B>(y, x) * B::set1(kRadToDeg);
+    return B::select(B::lt(degrees, B::set1(0.0)), degrees + B::set1(360.0), degrees);
+}
+
+template <class B>
+void destinationPack(typename B::V lon, typename B::V lat, typename B::V bearing, typename B::V distance,
+                     typename B::V& outLon, typename B::V& outLat) {
+    using V = typename B::V;
+    const V toRad = B::set1(kDegToRad);
+    V sinLat;
+    V cosLat;
+    simd::sincos<B>(lat * toRad, sinLat, cosLat);
+    V sinBearing;
+    V cosBearing;
+    simd::sincos<B>(bearing * toRad, sinBearing, cosBearing);
+    V sinDelta;
+    V cosDelta;
+    simd::sincos<B>(distance * B::set1(1.0 / kWgs84SemiMajorAxis), sinDelta, cosDelta);
+
+    V sinLat2 = B::fma(cosLat * sinDelta, cosBearing, sinLat * cosDelta);
+    sinLat2 = B::min(B::max(sinLat2, B::set1(-1.0)), B::set1(1.0));
+    const V lat2 = simd::asin<B>(sinLat2);
+    const V dLon = simd::atan2<B>(sinBearing * sinDelta * cosLat, cosDelta - sinLat * sinLat2);
+
+    V lon2 = lon + dLon * B::set1(kRadToDeg);
+    lon2 = lon2 - B::set1(360.0) * B::round(lon2 * B::set1(1.0 / 360.0));
+    outLon = lon2;
+    outLat = lat2 * B::set1(kRadToDeg);
+}
+
+template <class B>
+void geodeticToEcefPack(typename B::V lon, typename B::V lat, typename B::V height, typename B::V& x,
+                        typename B::V& y, typename B::V& z) {
+    using V = typename B::V;
+    const V toRad = B::set1(kDegToRad);
+    V sinLat;
+    V cosLat;
+    simd::sincos<B>(lat * toRad, sinLat, cosLat);
+    V sinLon;
+    V cosLon;
+    simd::sincos<B>(lon * toRad, sinLon, cosLon);
+
+    const V n = B::set1(kWgs84SemiMajorAxis) /
+                B::sqrt(B::set1(1.0) - B::set1(kWgs84EccentricitySq) * sinLat * sinLat);
+    const V horizontal = (n + height) * cosLat;
+    x = horizontal * cosLon;
+    y = horizontal * sinLon;
+    z = B::fma(n, B::set1(1.0 - kWgs84EccentricitySq), height) * sinLat;
+}
+
+/**
+ * @brief Bowring 单次迭代：以参数纬度 θ 近似后直接求大地纬度，近地表误差在毫米级。
+ */
+template <class B>
+void ecefToGeodeticPack(typename B::V x, typename B::V y, typename B::V z, typename B::V& lon, typename B::V& lat,
+                        typename B::V& height) {
+    using V = typename B::V;
+    const V a = B::set1(kWgs84SemiMajorAxis);
+    const V b = B::set1(kWgs84SemiMinorAxis);
+    const V p = B::sqrt(B::fma(x, x, y * y));
+
+    V sinTheta;
+    V cosTheta;
+    simd::sincos<B>(simd::atan2<B>(z * a, p * b), sinTheta, cosTheta);
+    const V latitude =
+        simd::atan2<B>(B::fma(B::set1(kSecondEccentricitySq) * b, sinTheta * sinTheta * sinTheta, z),
+                       p - B::set1(kWgs84EccentricitySq) * a * cosTheta * cosTheta * cosTheta);
+    V sinLat;
+    V cosLat;
+    simd::sincos<B>(latitude, sinLat, cosLat);
+    const V n = a / B::sqrt(B::set1(1.0) - B::set1(kWgs84EccentricitySq) * sinLat * sinLat);
+
+    lon = simd::atan2<B>(y, x) * B::set1(kRadToDeg);
+    lat = latitude * B::set1(kRadToDeg);
+    // 高纬处 cosLat 趋零，改用 z 分量求高程以避免除零放大误差。
+    const auto nearPole = B::lt(B::abs(cosLat), B::set1(1e-10));
+    const V safeCos = B::select(nearPole, B::set1(1.0), cosLat);
+    height = B::select(nearPole, B::abs(z) - b, p / safeCos - n);
+}
+
+/**
+ * @brief Vincenty 反算（椭球测地线距离）。各通道独立迭代，全部收敛后退出；
+ * 近对跖点在迭代上限内不收敛的通道退化为 haversine 球面距离。
+ */
+template <class B>
+typename B::V vincentyPack(typename B::V lon1, typename B::V lat1, typename B::V lon2, typename B::V lat2) {
+    using V = typename B::V;
+    const V one = B::set1(1.0);
+    const V zero = B::set1(0.0);
+    const V f = B::set1(kWgs84Flattening);
+    const V toRad = B::set1(kDegToRad);
+
+    // 归化纬度：tanU = (1-f)·tanφ，直接由 sin/cos 求出 sinU、cosU，避免 atan。
+    V sinLat1;
+    V cosLat1;
+    simd::sincos<B>(lat1 * toRad, sinLat1, cosLat1);
+    V sinLat2;
+    V cosLat2;
+    simd::sincos<B>(lat2 * toRad, sinLat2, cosLat2);
+    const V sy1 = B::set1(1.0 - kWgs84Flattening) * sinLat1;
+    const V sy2 = B::set1(1.0 - kWgs84Flattening) * sinLat2;
+    const V invNorm1 = one / B::sqrt(B::fma(sy1, sy1, cosLat1 * cosLat1));
+    const V invNorm2 = one / B::sqrt(B::fma(sy2, sy2, cosLat2 * cosLat2));
+    const V sinU1 = sy1 * invNorm1;
+    const V cosU1 = cosLat1 * invNorm1;
+    const V sinU2 = sy2 * invNorm2;
+    const V cosU2 = cosLat2 * invNorm2;
+
+    const V bigL = (lon2 - lon1) * toRad;
+    V lambda = bigL;
+    V sinSigma = zero;
+    V cosSigma = one;
+    V sigma = zero;
+    V cosSqAlpha = one;
+    V cos2SigmaM = zero;
+    auto pending = B::eq(zero, zero);
+
+    for (int iteration = 0; iteration < kVincentyMaxIterations && B::any(pending); ++iteration) {
+        V sinLambda;
+        V cosLambda;
+        simd::sincos<B>(lambda, sinLambda, cosLambda);
+        const V t1 = cosU2 * sinLambda;
+        const V t2 = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+        const V newSinSigma = B::sqrt(B::fma(t1, t1, t2 * t2));
+        const V newCosSigma = B::fma(cosU1 * cosU2, cosLambda, sinU1 * sinU2);
+        const V newSigma = simd::atan2<B>(newSinSigma, newCosSigma);
+
+        const auto coincident = B::eq(newSinSigma, zero);
+        const V sinAlpha = cosU1 * cosU2 * sinLambda / B::select(coincident, one, newSinSigma);
+        const V newCosSqAlpha = one - sinAlpha * sinAlpha;
+        const auto equatorial = B::eq(newCosSqAlpha, zero);
+        const V newCos2SigmaM = B::select(
+            equatorial, zero,
+            newCosSigma - B::set1(2.0) * sinU1 * sinU2 / B::select(equatorial, one, newCosSqAlpha));
+        const V c = f * B::set1(1.0 / 16.0) * newCosSqAlpha *
+                    (B::set1(4.0) + f * (B::set1(4.0) - B::set1(3.0) * newCosSqAlpha));
+        const V inner = newCos2SigmaM +
+                        c * newCosSigma * (B::set1(-1.0) + B::set1(2.0) * newCos2SigmaM * newCos2SigmaM);
+        const V newLambda = bigL + (one - c) * f * sinAlpha * (newSigma + c * newSinSigma * inner);
+
+        // 已收敛的通道保持上一次结果不变。
+        sinSigma = B::select(pending, newSinSigma, sinSigma);
+        cosSigma = B::select(pending, newCosSigma, cosSigma);
+        sigma = B::select(pending, newSigma, sigma);
+        cosSqAlpha = B::select(pending, newCosSqAlpha, cosSqAlpha);
+        cos2SigmaM = B::select(pending, newCos2SigmaM, cos2SigmaM);
+        const auto converged = B::orMask(B::lt(B::abs(newLambda - lambda), B::set1(kVincentyTolerance)), coincident);
+        lambda = B::select(pending, newLambda, lambda);
+        pending = B::andMask(pending, B::notMask(converged));
+    }
+
+    const V uSq = cosSqAlpha * B::set1(kSecondEccentricitySq);
+    const V bigA = one + uSq * B::set1(1.0 / 16384.0) *
+                             (B::set1(4096.0) + uSq * (B::set1(-768.0) + uSq * (B::set1(320.0) - B::set1(175.0) * uSq)));
+    const V bigB = uSq * B::set1(1.0 / 1024.0) *
+                   (B::set1(256.0) + uSq * (B::set1(-128.0) + uSq * (B::set1(74.0) - B::set1(47.0) * uSq)));
+    const V c2 = cos2SigmaM * cos2SigmaM;
+    const V deltaSigma =
+        bigB * sinSigma *
+        (cos2SigmaM + bigB * B::set1(0.25) *
+                          (cosSigma * (B::set1(-1.0) + B::set1(2.0) * c2) -
+                           bigB * B::set1(1.0 / 6.0) * cos2SigmaM * (B::set1(-3.0) + B::set1(4.0) * sinSigma * sinSigma) *
+                               (B::set1(-3.0) + B::set1(4.0) * c2)));
+    const V distance = B::set1(kWgs84SemiMinorAxis) * bigA * (sigma - deltaSigma);
+    if (!B::any(pending)) {
+        return distance;
+    }
+    return B::select(pending, haversinePack<B>(lon1, lat1, lon2, lat2), distance);
+}
+
+template <class B>
+void ecefToEnuPack(const EnuFrame& frame, typename B::V x, typename B::V y, typename B::V z, typename B::V& east,
+                   typename B::V& north, typename B::V& up) {
+    using V = typename B::V;
+    const V dx = x - B::set1(frame.origin.x);
+    const V dy = y - B::set1(frame.origin.y);
+    const V dz = z - B::set1(frame.origin.z);
+    east = B::fma(B::set1(frame.east[0]), dx, B::fma(B::set1(frame.east[1]), dy, B::set1(frame.east[2]) * dz));
+    north = B::fma(B::set1(frame.north[0]), dx, B::fma(B::set1(frame.north[1]), dy, B::set1(frame.north[2]) * dz));
+    up = B::fma(B::set1(frame.up[0]), dx, B::fma(B::set1(frame.up[1]), dy, B::set1(frame.up[2]) * dz));
+}
+
+template <class B>
+void enuToEcefPack(const EnuFrame& frame, typename B::V east, typename B::V north, typename B::V up,
+                   typename B::V& x, typename B::V& y, typename B::V& z) {
+    // 旋转矩阵正交，逆变换即转置。
+    x = B::fma(B::set1(frame.east[0]), east,
+               B::fma(B::set1(frame.north[0]), north, B::fma(B::set1(frame.up[0]), up, B::set1(frame.origin.x))));
+    y = B::fma(B::set1(frame.east[1]), east,
+               B::fma(B::set1(frame.north[1]), north, B::fma(B::set1(frame.up[1]), up, B::set1(frame.origin.y))));
+    z = B::fma(B::set1(frame.east[2]), east,
+               B::fma(B::set1(frame.north[2]), north, B::fma(B::set1(frame.up[2]), up, B::set1(frame.origin.z))));
+}
+
+// ---- SoA 循环驱动 ----
+
+/**
+ * @brief 以 In 个输入数组、Out 个输出数组逐包调用 op；不足一包的尾部拷入补齐缓冲区后按整包计算，
+ * 保证尾部元素与主体走同一条代码路径。补齐值复制尾部首元素，避免无效输入触发 NaN 分支。
+ *
+ * 这里刻意不调用 std::fill/std::copy 等与后端无关的内联模板：AVX2 翻译单元中的同名实例可能被链接器选中，
+ * 在不支持 AVX2 的 CPU 上执行 VEX 指令。
+ */
+template <class B, std::size_t In, std::size_t Out, class Op>
+void forEachPack(const double* const (&inputs)[In], double* const (&outputs)[Out], std::size_t count, Op&& op) {
+    using V = typename B::V;
+    constexpr std::size_t kWidth = B::kWidth;
+    std::array<V, In> in {};
+    std::array<V, Out> out {};
+
+    std::size_t i = 0;
+    for (; i + kWidth <= count; i += kWidth) {
+        for (std::size_t k = 0; k < In; ++k) {
+            in[k] = B::load(inputs[k] + i);
+        }
+        op(in, out);
+        for (std::size_t k = 0; k < Out; ++k) {
+            B::store(outputs[k] + i, out[k]);
+        }
+    }
+    if (i == count) {
+        return;
+    }
+
+    const std::size_t rest = count - i;
+    double buffer[kWidth];
+    for (std::size_t k = 0; k < In; ++k) {
+        for (std::size_t lane = 0; lane < kWidth; ++lane) {
+            buffer[lane] = inputs[k][lane < rest ? i + lane : i];
+        }
+        in[k] = B::load(buffer);
+    }
+    op(in, out);
+    for (std::size_t k = 0; k < Out; ++k) {
+        B::store(buffer, out[k]);
+        for (std::size_t lane = 0; lane < rest; ++lane) {
+            outputs[k][i + lane] = buffer[lane];
+        }
+    }
+}
+
+template <class B>
+KernelTable makeKernelTable(SimdLevel level) {
+    using V = typename B::V;
+    KernelTable table;
+    table.level = level;
+    table.haversine = [](const double* lon1, const double* lat1, const double* lon2, const double* lat2, double* out,
+                         std::size_t count) {
+        forEachPack<B, 4, 1>({lon1, lat1, lon2, lat2}, {out}, count,
+                             [](const std::array<V, 4>& in, std::array<V, 1>& result) {
+                                 result[0] = haversinePack<B>(in[0], in[1], in[2], in[3]);
+                             });
+    };
+    table.vincenty = [](const double* lon1, const double* lat1, const double* lon2, const double* lat2, double* out,
+                        std::size_t count) {
+        forEachPack<B, 4, 1>({lon1, lat1, lon2, lat2}, {out}, count,
+                             [](const std::array<V, 4>& in, std::array<V, 1>& result) {
+                                 result[0] = vincentyPack<B>(in[0], in[1], in[2], in[3]);
+                             });
+    };
+    table.bearing = [](const double* lon1, const double* lat1, const double* lon2, const double* lat2, double* out,
+                       std::size_t count) {
+        forEachPack<B, 4, 1>({lon1, lat1, lon2, lat2}, {out}, count,
+                             [](const std::array<V, 4>& in, std::array<V, 1>& result) {
+                                 result[0] = bearingPack<B>(in[0], in[1], in[2], in[3]);
+                             });
+    };
+    table.destination = [](const double* lon, const double* lat, const double* bearing, const double* distance,
+                           double* outLon, double* outLat, std::size_t count) {
+        forEachPack<B, 4, 2>({lon, lat, bearing, distance}, {outLon, outLat}, count,
+                             [](const std::array<V, 4>& in, std::array<V, 2>& result) {
+                                 destinationPack<B>(in[0], in[1], in[2], in[3], result[0], result[1]);
+                             });
+    };
+    table.geodeticToEcef = [](const double* lon, const double* lat, const double* height, double* x, double* y,
+                              double* z, std::size_t count) {
+        forEachPack<B, 3, 3>({lon, lat, height}, {x, y, z}, count,
+                             [](const std::array<V, 3>& in, std::array<V, 3>& result) {
+                                 geodeticToEcefPack<B>(in[0], in[1], in[2], result[0], result[1], result[2]);
+                             });
+    };
+    table.ecefToGeodetic = [](const double* x, const double* y, const double* z, double* lon, double* lat,
+                              double* height, std::size_t count) {
+        forEachPack<B, 3, 3>({x, y, z}, {lon, lat, height}, count,
+                             [](const std::array<V, 3>& in, std::array<V, 3>& result) {
+                                 ecefToGeodeticPack<B>(in[0], in[1], in[2], result[0], result[1], result[2]);
+                             });
+    };
+    table.ecefToEnu = [](const EnuFrame& frame, const double* x, const double* y, const double* z, double* east,
+                         double* north, double* up, std::size_t count) {
+        forEachPack<B, 3, 3>({x, y, z}, {east, north, up}, count,
+                             [&frame](const std::array<V, 3>& in, std::array<V, 3>& result) {
+                                 ecefToEnuPack<B>(frame, in[0], in[1], in[2], result[0], result[1], result[2]);
+                             });
+    };
+    table.enuToEcef = [](const EnuFrame& frame, const double* east, const double* north, const double* up,
+                         double* x, double* y, double* z, std::size_t count) {
+        forEachPack<B, 3, 3>({east, north, up}, {x, y, z}, count,
+                             [&frame](const std::array<V, 3>& in, std::array<V, 3>& result) {
+                                 enuToEcefPack<B>(frame, in[0], in[1], in[2], result[0], result[1], result[2]);
+                             });
+    };
+    return table;
+}
+
+} // namespace earth::core::geo::detail
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file SimdBackends.h
+ * @brief 批量测地核使用的 double 向量后端：标量、AVX2（4 路）与 NEON（2 路）。
+ *
+ * 每个后端是一个只含静态函数的 traits 结构，V 为向量类型（支持 + - * / 与取负），M 为比较掩码。
+ * 核函数按后端模板化，同一份源码分别实例化；AVX2 后端只在以 AVX2/FMA 编译的翻译单元中可见。
+ * 仅供 core/geo 内部使用。
+ */
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define EARTH_GEO_BACKEND_AVX2 1
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define EARTH_GEO_BACKEND_AVX2 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define EARTH_GEO_BACKEND_NEON 1
+#endif
+
+namespace earth::core::geo::simd {
+
+struct ScalarBackend {
+    using V = double;
+    using M = bool;
+    static constexpr std::size_t kWidth = 1;
+
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V set1(double x) { return x; }
+    // 标量路径不假定硬件 FMA，std::fma 在无 FMA 指令的目标上是软件实现，反而更慢。
+    static V fma(V a, V b, V c) { return a * b + c; }
+    static V sqrt(V v) { return std::sqrt(v); }
+    static V abs(V v) { return std::fabs(v); }
+    static V round(V v) { return std::nearbyint(v); }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static M lt(V a, V b) { return a < b; }
+    static M gt(V a, V b) { return a > b; }
+    static M eq(V a, V b) { return a == b; }
+    static M andMask(M a, M b) { return a && b; }
+    static M orMask(M a, M b) { return a || b; }
+    static M notMask(M a) { return !a; }
+    static bool any(M m) { return m; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if defined(EARTH_GEO_BACKEND_AVX2)
+struct Avx2Vec {
+    __m256d v;
+};
+inline Avx2Vec operator+(Avx2Vec a, Avx2Vec b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline Avx2Vec operator-(Avx2Vec a, Avx2Vec b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline Avx2Vec operator*(Avx2Vec a, Avx2Vec b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline Avx2Vec operator/(Avx2Vec a, Avx2Vec b) { return {_mm256_div_pd(a.v, b.v)}; }
+inline Avx2Vec operator-(Avx2Vec a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+
+struct Avx2Backend {
+    using V = Avx2Vec;
+    using M = __m256d;
+    static constexpr std::size_t kWidth = 4;
+
+    static V load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v.v); }
+    static V set1(double x) { return {_mm256_set1_pd(x)}; }
+    static V fma(V a, V b, V c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+    static V sqrt(V v) { return {_mm256_sqrt_pd(v.v)}; }
+    static V abs(V v) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), v.v)}; }
+    static V round(V v) { return {_mm256_round_pd(v.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    static V min(V a, V b) { return {_mm256_min_pd(a.v, b.v)}; }
+    static V max(V a, V b) { return {_mm256_max_pd(a.v, b.v)}; }
+    static M lt(V a, V b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    static M gt(V a, V b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+    static M eq(V a, V b) { return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+    static M andMask(M a, M b) { return _mm256_and_pd(a, b); }
+    static M orMask(M a, M b) { return _mm256_or_pd(a, b); }
+    static M notMask(M a) { return _mm256_xor_pd(a, _mm256_castsi256_pd(_mm256_set1_epi64x(-1))); }
+    static bool any(M m) { return _mm256_movemask_pd(m) != 0; }
+    static V select(M m, V a, V b) { return {_mm256_blendv_pd(b.v, a.v, m)}; }
+};
+#endif
+
+#if defined(EARTH_GEO_BACKEND_NEON)
+struct NeonVec {
+    float64x2_t v;
+};
+inline NeonVec operator+(NeonVec a, NeonVec b) { return {vaddq_f64(a.v, b.v)}; }
+inline NeonVec operator-(NeonVec a, NeonVec b) { return {vsubq_f64(a.v, b.v)}; }
+inline NeonVec operator*(NeonVec a, NeonVec b) { return {vmulq_f64(a.v, b.v)}; }
+inline NeonVec operator/(NeonVec a, NeonVec b) { return {vdivq_f64(a.v, b.v)}; }
+inline NeonVec operator-(NeonVec a) { return {vnegq_f64(a.v)}; }
+
+struct NeonBackend {
+    using V = NeonVec;
+    using M = uint64x2_t;
+    static constexpr std::size_t kWidth = 2;
+
+    static V load(const double* p) { return {vld1q_f64(p)}; }
+    static void store(double* p, V v) { vst1q_f64(p, v.v); }
+    static V set1(double x) { return {vdupq_n_f64(x)}; }
+    static V fma(V a, V b, V c) { return {vfmaq_f64(c.v, a.v, b.v)}; }
+    static V sqrt(V v) { return {vsqrtq_f64(v.v)}; }
+    static V abs(V v) { return {vabsq_f64(v.v)}; }
+    static V round(V v) { return {vrndnq_f64(v.v)}; }
+    static V min(V a, V b) { return {vminq_f64(a.v, b.v)}; }
+    static V max(V a, V b) { return {vmaxq_f64(a.v, b.v)}; }
+    static M lt(V a, V b) { return vcltq_f64(a.v, b.v); }
+    static M gt(V a, V b) { return vcgtq_f64(a.v, b.v); }
+    static M eq(V a, V b) { return vceqq_f64(a.v, b.v); }
+    static M andMask(M a, M b) { return vandq_u64(a, b); }
+    static M orMask(M a, M b) { return vorrq_u64(a, b); }
+    static M notMask(M a) { return veorq_u64(a, vdupq_n_u64(~0ULL)); }
+    static bool any(M m) { return (vgetq_lane_u64(m, 0) | vgetq_lane_u64(m, 1)) != 0; }
+    static V select(M m, V a, V b) { return {vbslq_f64(m, a.v, b.v)}; }
+};
+#endif
+
+} // namespace earth::core::geo::simd
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file SimdMath.h
+ * @brief 后端无关的向量三角函数，系数取自 Cephes 双精度实现，[-2π, 2π] 内相对误差约 1e-16。
+ *
+ * 象限选择全部用浮点比较与 select 完成，不依赖整数 SIMD，三个后端共用同一份代码。
+ * 仅供 core/geo 内部使用。
+ */
+
+#include "core/geo/SimdBackends.h"
+
+namespace earth::core::geo::simd {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kHalfPi = kPi / 2.0;
+constexpr double kQuarterPi = kPi / 4.0;
+
+template <class B>
+typename B::V polynomial(typename B::V x, const double* coefficients, int count) {
+    typename B::V result = B::set1(coefficients[0]);
+    for (int i = 1; i < count; ++i) {
+        result = B::fma(result, x, B::set1(coefficients[i]));
+    }
+    return result;
+}
+
+/**
+ * @brief 同时求 sin 与 cos：按 π/2 做 Cody-Waite 三段约简，再在 [-π/4, π/4] 上用多项式逼近。
+ */
+template <class B>
+void sincos(typename B::V x, typename B::V& sinOut, typename B::V& cosOut) {
+    using V = typename B::V;
+    static constexpr double kSinCoefficients[] = {1.58962301576546568060E-10, -2.50507477628578072866E-8,
+                                                  2.75573136213857245213E-6,  -1.98412698295895385996E-4,
+                                                  8.33333333332211858878E-3,  -1.66666666666666307295E-1};
+    static constexpr double kCosCoefficients[] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9,
+                                                  -2.75573141792967388112E-7,  2.48015872888517045348E-5,
+                                                  -1.38888888888730564116E-3,  4.16666666666665929218E-2};
+
+    const V j = B::round(x * B::set1(1.0 / kHalfPi));
+    V r = B::fma(j, B::set1(-1.57079625129699707031E+00), x);
+    r = B::fma(j, B::set1(-7.54978941586159635335E-08), r);
+    r = B::fma(j, B::set1(-5.39030285815811905290E-15), r);
+
+    const V r2 = r * r;
+    const V sinR = B::fma(r * r2, polynomial<B>(r2, kSinCoefficients, 6), r);
+    const V cosR = B::fma(r2 * r2, polynomial<B>(r2, kCosCoefficients, 6), B::set1(1.0) - B::set1(0.5) * r2);
+
+    // q = j mod 4 ∈ {0,1,2,3}
+    const V q = j - B::set1(4.0) * B::round((j - B::set1(1.5)) * B::set1(0.25));
+    const auto odd = B::orMask(B::eq(q, B::set1(1.0)), B::eq(q, B::set1(3.0)));
+    const auto sinNegative = B::orMask(B::eq(q, B::set1(2.0)), B::eq(q, B::set1(3.0)));
+    const auto cosNegative = B::orMask(B::eq(q, B::set1(1.0)), B::eq(q, B::set1(2.0)));
+
+    const V s = B::select(odd, cosR, sinR);
+    const V c = B::select(odd, sinR, cosR);
+    sinOut = B::select(sinNegative, -s, s);
+    cosOut = B::select(cosNegative, -c, c);
+}
+
+template <class B>
+typename B::V atan(typename B::V x) {
+    using V = typename B::V;
+    static constexpr double kP[] = {-8.750608600031904122785E-1, -1.615753718733365076637E1,
+                                    -7.500855792314704667340E1, -1.228866684490136173410E2,
+                                    -6.485021904942025371773E1};
+    static constexpr double kQ[] = {1.0,
+                                    2.485846490142306297962E1,
+                                    1.650270098316988542046E2,
+                                    4.328810604912902668951E2,
+                                    4.853903996359136964868E2,
+                                    1.945506571482613964425E2};
+    constexpr double kTan3PiOver8 = 2.41421356237309504880;
+    constexpr double kMoreBits = 6.123233995736765886130E-17;
+
+    const auto negative = B::lt(x, B::set1(0.0));
+    const V a = B::abs(x);
+    const auto big = B::gt(a, B::set1(kTan3PiOver8));
+    const auto mid = B::andMask(B::notMask(big), B::gt(a, B::set1(0.66)));
+
+    const V one = B::set1(1.0);
+    // 未选中的分支可能产生 inf（a 为 0 时的 -1/a），随后被 select 丢弃，不影响结果。
+    const V reduced = B::select(big, -one / a, B::select(mid, (a - one) / (a + one), a));
+    const V base = B::select(big, B::set1(kHalfPi), B::select(mid, B::set1(kQuarterPi), B::set1(0.0)));
+    const V extra = B::select(big, B::set1(kMoreBits), B::select(mid, B::set1(0.5 * kMoreBits), B::set1(0.0)));
+
+    const V z = reduced * reduced;
+    const V ratio = z * polynomial<B>(z, kP, 5) / polynomial<B>(z, kQ, 6);
+    const V result = base + B::fma(reduced, ratio, reduced) + extra;
+    return B::select(negative, -result, result);
+}
+
+template <class B>
+typename B::V atan2(typename B::V y, typename B::V x) {
+    using V = typename B::V;
+    const V zero = B::set1(0.0);
+    const auto xZero = B::eq(x, zero);
+    const auto yNegative = B::lt(y, zero);
+
+    const V safeX = B::select(xZero, B::set1(1.0), x);
+    V result = atan<B>(y / safeX);
+    result = B::select(B::lt(x, zero), result + B::select(yNegative, B::set1(-kPi), B::set1(kPi)), result);
+    const V vertical = B::select(yNegative, B::set1(-kHalfPi), B::select(B::eq(y, zero), zero, B::set1(kHalfPi)));
+    return B::select(xZero, vertical, result);
+}
+
+/**
+ * @brief asin(x) = atan2(x, √(1-x²))，x 需已限定在 [-1, 1]。
+ */
+template <class B>
+typename B::V asin(typename B::V x) {
+    const typename B::V one = B::set1(1.0);
+    return atan2<B>(x, B::sqrt((one - x) * (one + x)));
+}
+
+} // namespace earth::core::geo::simd
@@ -0,0 +1,268 @@
+#include "core/replay/ReplayLog.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+constexpr char kFileMagic[8] = {'E', 'A', 'R', 'T', 'H', 'R', 'P', 'L'};
+constexpr char kTrailerMagic[8] = {'R', 'P', 'L', 'I', 'N', 'D', 'E', 'X'};
+constexpr std::uint32_t kFormatVersion = 1;
+// 每条记录头末尾的同步字，扫描重建索引时用于识别截断或损坏的记录。
+constexpr std::uint32_t kRecordMarker = 0x52504C52U;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+};
+
+struct RecordHeader {
+    double timestampSec;
+    std::uint32_t size;
+    std::uint16_t type;
+    std::uint16_t source;
+    std::uint32_t flags;
+    std::uint32_t marker;
+};
+
+struct Trailer {
+    std::uint64_t indexOffset;
+    std::uint64_t indexCount;
+    double endTimestampSec;
+    char magic[8];
+};
+
+static_assert(sizeof(FileHeader) == 16, "unexpected replay file header layout");
+static_assert(sizeof(RecordHeader) == 24, "unexpected replay record header layout");
+static_assert(sizeof(earth::core::replay::ReplayIndexEntry) == 16, "unexpected replay index entry layout");
+static_assert(sizeof(Trailer) == 32, "unexpected replay trailer layout");
+
+template <typename T>
+bool readPod(const unsigned char* base, std::uint64_t size, std::uint64_t offset, T& out) {
+    if (offset > size || size - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&out, base + offset, sizeof(T));
+    return true;
+}
+} // namespace
+
+namespace earth::core::replay {
+
+ReplayLogWriter::~ReplayLogWriter() {
+    close();
+}
+
+bool ReplayLogWriter::open(const QString& filePath) {
+    close();
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[ReplayLog] 无法创建录制文件" << filePath << m_file.errorString();
+        return false;
+    }
+
+    FileHeader header {};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFormatVersion;
+    header.headerSize = sizeof(FileHeader);
+    if (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+        m_file.close();
+        return false;
+    }
+
+    m_index.clear();
+    m_lastTimestamp = 0.0;
+    return true;
+}
+
+void ReplayLogWriter::close() {
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    Trailer trailer {};
+    trailer.indexOffset = static_cast<std::uint64_t>(m_file.pos());
+    trailer.indexCount = m_index.size();
+    trailer.endTimestampSec = m_lastTimestamp;
+    std::memcpy(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic));
+
+    if (!m_index.empty()) {
+        m_file.write(reinterpret_cast<const char*>(m_index.data()),
+                     static_cast<qint64>(m_index.size() * sizeof(ReplayIndexEntry)));
+    }
+    m_file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+    m_file.close();
+    m_index.clear();
+}
+
+bool ReplayLogWriter::append(double timestampSec, std::uint16_t type, RecordSource source, std::uint32_t flags,
+                             const void* data, std::uint32_t size) {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+
+    RecordHeader header {};
+    header.timestampSec = std::max(timestampSec, m_lastTimestamp);
+    header.size = size;
+    header.type = type;
+    header.source = static_cast<std::uint16_t>(source);
+    header.flags = flags;
+    header.marker = kRecordMarker;
+
+    const qint64 offset = m_file.pos();
+    if (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    if (size > 0 && m_file.write(static_cast<const char*>(data), size) != static_cast<qint64>(size)) {
+        return false;
+    }
+
+    if ((flags & RecordFlagKeyframe) != 0U) {
+        m_index.push_back({header.timestampSec, static_cast<std::uint64_t>(offset)});
+    }
+    m_lastTimestamp = header.timestampSec;
+    return true;
+}
+
+ReplayLogReader::~ReplayLogReader() {
+    close();
+}
+
+bool ReplayLogReader::open(const QString& filePath) {
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[ReplayLog] 无法打开录制文件" << filePath << m_file.errorString();
+        return false;
+    }
+
+    m_size = static_cast<std::uint64_t>(m_file.size());
+    FileHeader header {};
+    if (m_size < sizeof(FileHeader)) {
+        close();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_file.size());
+    if (m_data == nullptr || !readPod(m_data, m_size, 0, header) ||
+        std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kFormatVersion) {
+        qWarning() << "[ReplayLog] 录制文件格式无效" << filePath;
+        close();
+        return false;
+    }
+
+    if (!loadIndexFromTrailer()) {
+        qWarning() << "[ReplayLog] 索引缺失，正在扫描重建" << filePath;
+        rebuildIndex();
+    }
+
+    Record first;
+    m_startTime = readAt(firstRecordOffset(), first) ? first.timestampSec : 0.0;
+    return true;
+}
+
+void ReplayLogReader::close() {
+    if (m_data != nullptr) {
+        m_file.unmap(const_cast<unsigned char*>(m_data));
+        m_data = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_recordsEnd = 0;
+    m_index.clear();
+    m_startTime = 0.0;
+    m_endTime = 0.0;
+}
+
+std::uint64_t ReplayLogReader::firstRecordOffset() const noexcept {
+    return sizeof(FileHeader);
+}
+
+bool ReplayLogReader::readAt(std::uint64_t offset, Record& record) const {
+    RecordHeader header {};
+    if (m_data == nullptr || offset >= m_recordsEnd || !readPod(m_data, m_recordsEnd, offset, header) ||
+        header.marker != kRecordMarker) {
+        return false;
+    }
+
+    const std::uint64_t payloadOffset = offset + sizeof(RecordHeader);
+    if (m_recordsEnd - payloadOffset < header.size) {
+        return false;
+    }
+
+    record.timestampSec = header.timestampSec;
+    record.type = header.type;
+    record.source = static_cast<RecordSource>(header.source);
+    record.flags = header.flags;
+    record.data = m_data + payloadOffset;
+    record.size = header.size;
+    record.offset = offset;
+    record.nextOffset = payloadOffset + header.size;
+    return true;
+}
+
+std::uint64_t ReplayLogReader::keyframeOffsetAt(double timestampSec) const {
+    auto it = std::upper_bound(m_index.begin(), m_index.end(), timestampSec,
+                               [](double value, const ReplayIndexEntry& entry) {
+                                   return value < entry.timestampSec;
+                               });
+    if (it == m_index.begin()) {
+        return firstRecordOffset();
+    }
+    return std::prev(it)->offset;
+}
+
+bool ReplayLogReader::loadIndexFromTrailer() {
+    Trailer trailer {};
+    if (m_size < sizeof(FileHeader) + sizeof(Trailer) || !readPod(m_data, m_size, m_size - sizeof(Trailer), trailer) ||
+        std::memcmp(trailer.magic, kTrailerMagic, sizeof(kTrailerMagic)) != 0) {
+        return false;
+    }
+
+    const std::uint64_t indexBytes = trailer.indexCount * sizeof(ReplayIndexEntry);
+    if (trailer.indexOffset < sizeof(FileHeader) || trailer.indexOffset > m_size - sizeof(Trailer) ||
+        m_size - sizeof(Trailer) - trailer.indexOffset != indexBytes) {
+        return false;
+    }
+
+    m_index.resize(static_cast<std::size_t>(trailer.indexCount));
+    if (indexBytes > 0) {
+        std::memcpy(m_index.data(), m_data + trailer.indexOffset, static_cast<std::size_t>(indexBytes));
+    }
+    m_recordsEnd = trailer.indexOffset;
+    m_endTime = trailer.endTimestampSec;
+    return true;
+}
+
+void ReplayLogReader::rebuildIndex() {
+    // 异常退出的日志没有尾部：顺序扫描记录头，遇到截断的记录即停止。
+    m_index.clear();
+    m_recordsEnd = m_size;
+    m_endTime = -std::numeric_limits<double>::infinity();
+
+    std::uint64_t offset = firstRecordOffset();
+    Record record;
+    while (readAt(offset, record) && record.timestampSec >= m_endTime) {
+        if (record.isKeyframe()) {
+            m_index.push_back({record.timestampSec, record.offset});
+        }
+        m_endTime = record.timestampSec;
+        offset = record.nextOffset;
+    }
+    m_recordsEnd = offset;
+    if (offset == firstRecordOffset()) {
+        m_endTime = 0.0;
+    }
+}
+
+} // namespace earth::core::replay
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace earth::core::replay {
+
+/**
+ * @brief 录制数据来源，写入每条记录的头部，便于回放时按模块分发。
+ */
+enum class RecordSource : std::uint16_t {
+    AirTraffic = 1, /**< 空管交通图层收到的航迹报文。 */
+    DataBridge = 2  /**< 数据桥接模块收到的原始实体数据。 */
+};
+
+/**
+ * @brief 单条记录的附加标志。
+ */
+enum RecordFlag : std::uint32_t {
+    RecordFlagNone = 0,
+    RecordFlagKeyframe = 1U << 0 /**< 关键帧：记录完整状态，可作为定位起点，并进入稀疏时间索引。 */
+};
+
+/**
+ * @brief 稀疏时间索引条目，仅指向关键帧记录。
+ */
+struct ReplayIndexEntry {
+    double timestampSec = 0.0; /**< 关键帧时刻。 */
+    std::uint64_t offset = 0;  /**< 关键帧记录头在文件中的偏移。 */
+};
+
+/**
+ * @brief 只追加的二进制录制日志写入器。
+ *
+ * 文件布局：文件头 | 记录（记录头 + 负载）… | 索引条目… | 尾部（索引偏移/数量/结束时刻）。
+ * 正常关闭时写入索引与尾部；若进程异常退出，读取端会顺序扫描记录头重建索引。
+ * 所有数值按主机字节序（小端）写入。
+ */
+class ReplayLogWriter final {
+public:
+    ReplayLogWriter() = default;
+    ~ReplayLogWriter();
+
+    ReplayLogWriter(const ReplayLogWriter&) = delete;
+    ReplayLogWriter& operator=(const ReplayLogWriter&) = delete;
+
+    /**
+     * @brief 新建日志文件（已存在则覆盖），成功返回 true。
+     */
+    bool open(const QString& filePath);
+
+    /**
+     * @brief 写入索引与尾部并关闭文件。
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+    [[nodiscard]] QString filePath() const { return m_file.fileName(); }
+
+    /**
+     * @brief 追加一条记录。时间戳应单调不减，关键帧会登记到稀疏索引。
+     */
+    bool append(double timestampSec, std::uint16_t type, RecordSource source, std::uint32_t flags, const void* data,
+                std::uint32_t size);
+
+private:
+    QFile m_file;
+    std::vector<ReplayIndexEntry> m_index;
+    double m_lastTimestamp = 0.0;
+};
+
+/**
+ * @brief 录制日志读取器，以内存映射方式访问文件，多小时的日志也无需整体读入内存。
+ */
+class ReplayLogReader final {
+public:
+    /**
+     * @brief 指向映射内存的记录视图，仅在读取器保持打开期间有效。
+     */
+    struct Record {
+        double timestampSec = 0.0;
+        std::uint16_t type = 0;
+        RecordSource source = RecordSource::AirTraffic;
+        std::uint32_t flags = RecordFlagNone;
+        const unsigned char* data = nullptr;
+        std::uint32_t size = 0;
+        std::uint64_t offset = 0;     /**< 当前记录头偏移。 */
+        std::uint64_t nextOffset = 0; /**< 下一条记录头偏移。 */
+
+        [[nodiscard]] bool isKeyframe() const noexcept { return (flags & RecordFlagKeyframe) != 0U; }
+    };
+
+    ReplayLogReader() = default;
+    ~ReplayLogReader();
+
+    ReplayLogReader(const ReplayLogReader&) = delete;
+    ReplayLogReader& operator=(const ReplayLogReader&) = delete;
+
+    bool open(const QString& filePath);
+    void close();
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_data != nullptr; }
+    [[nodiscard]] double startTime() const noexcept { return m_startTime; }
+    [[nodiscard]] double endTime() const noexcept { return m_endTime; }
+    [[nodiscard]] std::uint64_t firstRecordOffset() const noexcept;
+    [[nodiscard]] const std::vector<ReplayIndexEntry>& index() const noexcept { return m_index; }
+
+    /**
+     * @brief 解析 offset 处的记录，越界或记录损坏时返回 false。
+     */
+    bool readAt(std::uint64_t offset, Record& record) const;
+
+    /**
+     * @brief 二分查找时刻不晚于 timestampSec 的最后一个关键帧偏移；若不存在则返回首条记录偏移。
+     */
+    [[nodiscard]] std::uint64_t keyframeOffsetAt(double timestampSec) const;
+
+private:
+    bool loadIndexFromTrailer();
+    void rebuildIndex();
+
+    QFile m_file;
+    const unsigned char* m_data = nullptr;
+    std::uint64_t m_size = 0;
+    std::uint64_t m_recordsEnd = 0;
+    std::vector<ReplayIndexEntry> m_index;
+    double m_startTime = 0.0;
+    double m_endTime = 0.0;
+};
+
+} // namespace earth::core::replay
@@ -0,0 +1,96 @@
+#include "databridge/DataBridgeService.h"
+
+#include "core/FrameMetrics.h"
+
+#include <QObject>
+
+#include <algorithm>
+
+namespace earth::databridge {
+
+DataBridgeService::Transport DataBridgeService::start(std::uint16_t udpPort) {
+    stop();
+    m_running = true;
+    m_lastAttachNs = steadyNowNs();
+    m_ring.open();
+    m_udp.open(udpPort);
+    updateTransport();
+    return m_stats.transport;
+}
+
+void DataBridgeService::stop() {
+    m_ring.close();
+    m_udp.close();
+    m_stats = {};
+    m_running = false;
+    m_lastAttachNs = 0;
+}
+
+void DataBridgeService::updateTransport() noexcept {
+    if (m_ring.isOpen() && m_udp.isOpen()) {
+        m_stats.transport = Transport::SharedMemoryAndUdp;
+    } else if (m_ring.isOpen()) {
+        m_stats.transport = Transport::SharedMemory;
+    } else if (m_udp.isOpen()) {
+        m_stats.transport = Transport::Udp;
+    } else {
+        m_stats.transport = Transport::None;
+    }
+}
+
+QString DataBridgeService::transportName(Transport transport) {
+    switch (transport) {
+    case Transport::SharedMemory:
+        return QObject::tr("共享内存");
+    case Transport::Udp:
+        return QObject::tr("本机 UDP");
+    case Transport::SharedMemoryAndUdp:
+        return QObject::tr("共享内存 + 本机 UDP");
+    case Transport::None:
+    default:
+        return QObject::tr("未连接");
+    }
+}
+
+std::size_t DataBridgeService::poll(const Visitor& visitor) {
+    if (!m_running) {
+        return 0;
+    }
+
+    const std::uint64_t nowNs = steadyNowNs();
+    if (!m_ring.isOpen() && nowNs - m_lastAttachNs >= kAttachRetryNs) {
+        // 模拟器可能晚于视景启动，按固定间隔重试附加，避免每帧一次系统调用。
+        m_lastAttachNs = nowNs;
+        if (m_ring.open()) {
+            updateTransport();
+        }
+    }
+
+    double latencySumMs = 0.0;
+    double latencyPeakMs = 0.0;
+    const auto forward = [&](const EntityState& state) {
+        if (state.publishSteadyNs != 0 && state.publishSteadyNs <= nowNs) {
+            const double latencyMs = static_cast<double>(nowNs - state.publishSteadyNs) * 1e-6;
+            latencySumMs += latencyMs;
+            latencyPeakMs = std::max(latencyPeakMs, latencyMs);
+        }
+        visitor(state);
+    };
+
+    const std::size_t count = m_ring.poll(forward) + m_udp.poll(forward);
+    m_stats.received = m_ring.counters().received + m_udp.counters().received;
+    m_stats.dropped = m_ring.counters().dropped + m_udp.counters().malformed;
+    m_stats.torn = m_ring.counters().torn;
+
+    auto& metrics = core::FrameMetrics::instance();
+    if (count > 0) {
+        m_stats.lastLatencyMs = latencySumMs / static_cast<double>(count);
+        m_stats.peakLatencyMs = latencyPeakMs;
+        metrics.recordDuration("databridge.latency", m_stats.lastLatencyMs);
+    }
+    metrics.recordValue("databridge.received", static_cast<double>(m_stats.received), "条");
+    metrics.recordValue("databridge.dropped", static_cast<double>(m_stats.dropped + m_stats.torn), "条");
+    return count;
+}
+
+} // namespace earth::databridge
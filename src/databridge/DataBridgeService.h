@@ -0,0 +1,71 @@
+#pragma once
+
+#include "databridge/EntityState.h"
+#include "databridge/SharedMemoryRing.h"
+#include "databridge/UdpEntityReceiver.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+
+namespace earth::databridge {
+
+/**
+ * @brief 数据桥接服务：同时接收同机模拟器经共享内存环形缓冲与本机 UDP 发布的实体状态。
+ *
+ * 共享内存段由模拟器创建，视景端只附加；段尚不存在时 poll() 每隔 kAttachRetryNs 重试附加，
+ * 因此模拟器可以后启动。UDP 端口始终监听，只走 UDP 的模拟器不会被忽略。
+ * poll() 设计为在渲染循环中每帧调用一次：共享内存路径只做内存读取，UDP 路径为非阻塞读取。
+ * 发布延迟与丢包计数同步写入 core::FrameMetrics，可在帧率标签提示中查看。
+ */
+class DataBridgeService {
+public:
+    enum class Transport {
+        None,
+        SharedMemory,
+        Udp,
+        SharedMemoryAndUdp
+    };
+
+    struct Stats {
+        Transport transport = Transport::None;
+        std::uint64_t received = 0;
+        std::uint64_t dropped = 0;   /**< 环形缓冲覆盖丢失 + UDP 非法数据报。 */
+        std::uint64_t torn = 0;      /**< 读取期间被覆盖的记录。 */
+        double lastLatencyMs = 0.0;  /**< 最近一批记录的平均发布延迟。 */
+        double peakLatencyMs = 0.0;  /**< 最近一批记录的最大发布延迟。 */
+    };
+
+    using Visitor = std::function<void(const EntityState&)>;
+
+    DataBridgeService() = default;
+
+    /**
+     * @brief 启动接收，返回当前已打开的传输方式。
+     */
+    Transport start(std::uint16_t udpPort = kDefaultUdpPort);
+    void stop();
+
+    [[nodiscard]] Transport transport() const noexcept { return m_stats.transport; }
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    [[nodiscard]] static QString transportName(Transport transport);
+
+    /**
+     * @brief 取出自上次调用以来的全部实体状态，返回条数。
+     */
+    std::size_t poll(const Visitor& visitor);
+
+private:
+    static constexpr std::uint64_t kAttachRetryNs = 1'000'000'000ULL;
+
+    void updateTransport() noexcept;
+
+    SharedMemoryRingReader m_ring;
+    UdpEntityReceiver m_udp;
+    Stats m_stats;
+    bool m_running = false;
+    std::uint64_t m_lastAttachNs = 0;
+};
+
+} // namespace earth::databridge
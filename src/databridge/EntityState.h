@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace earth::databridge {
+
+/**
+ * @brief 共享内存段名称，模拟器与视景进程需使用同一名称。
+ */
+constexpr const char* kSharedMemoryKey = "earth.databridge.entities";
+
+/**
+ * @brief 共享内存环形缓冲的默认槽位数量（必须为 2 的幂）。
+ */
+constexpr std::uint32_t kDefaultSlotCount = 4096;
+
+/**
+ * @brief 本机 UDP 回退通道端口。
+ */
+constexpr std::uint16_t kDefaultUdpPort = 47800;
+
+/**
+ * @brief 实体状态记录，定长 POD，直接作为共享内存槽位与 UDP 负载的二进制布局。
+ *
+ * 角度单位为度，距离单位为米，时间单位为秒；publishSteadyNs 为发布方写入时的单调时钟读数，
+ * 同一主机上各进程的 steady_clock 共用同一时基，视景端据此统计发布延迟。
+ */
+struct EntityState {
+    std::uint32_t entityId = 0;
+    std::uint32_t flags = 0;
+    std::uint64_t publishSteadyNs = 0;
+    double timestampSec = 0.0;
+    double longitudeDeg = 0.0;
+    double latitudeDeg = 0.0;
+    double altitudeMeters = 0.0;
+    double groundSpeedMps = 0.0;
+    double trackDeg = 0.0;
+    double verticalRateMps = 0.0;
+};
+
+static_assert(std::is_trivially_copyable_v<EntityState>, "EntityState must stay a POD wire record");
+static_assert(sizeof(EntityState) == 72, "EntityState layout is part of the wire protocol");
+
+/**
+ * @brief UDP 数据报头，其后紧跟 count 条 EntityState。
+ */
+struct UdpDatagramHeader {
+    std::uint32_t magic = 0;
+    std::uint32_t count = 0;
+};
+
+constexpr std::uint32_t kUdpDatagramMagic = 0x45424447U; // "EBDG"
+
+/**
+ * @brief 回放日志中数据桥接记录（RecordSource::DataBridge）的类型：负载为一帧内收到的 EntityState 数组，布局与线上格式一致。
+ */
+constexpr std::uint16_t kEntityBatchRecordType = 1;
+
+/**
+ * @brief 当前单调时钟读数（纳秒），发布方在写入前调用以便视景端计算延迟。
+ */
+inline std::uint64_t steadyNowNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+} // namespace earth::databridge
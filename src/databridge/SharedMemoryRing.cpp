@@ -0,0 +1,209 @@
+#include "databridge/SharedMemoryRing.h"
+
+#include <QDebug>
+
+#include <cstring>
+#include <new>
+
+namespace {
+constexpr std::uint32_t kRingMagic = 0x45415254U; // "EART"
+constexpr std::uint32_t kRingVersion = 1;
+constexpr std::size_t kSlotsOffset = 64;
+
+static_assert(sizeof(earth::databridge::SharedRingHeader) <= kSlotsOffset, "ring header must fit before slots");
+
+std::uint32_t roundUpPowerOfTwo(std::uint32_t value) {
+    std::uint32_t result = 1;
+    while (result < value && result < (1U << 30)) {
+        result <<= 1U;
+    }
+    return result;
+}
+
+std::size_t segmentSize(std::uint32_t slotCount) {
+    return kSlotsOffset + static_cast<std::size_t>(slotCount) * sizeof(earth::databridge::SharedRingSlot);
+}
+
+/**
+ * @brief 创建或附加共享内存段；由创建方负责初始化头部与槽位序号。
+ */
+bool createOrAttach(QSharedMemory& memory, std::uint32_t slotCount) {
+    if (memory.create(static_cast<int>(segmentSize(slotCount)))) {
+        auto* base = static_cast<unsigned char*>(memory.data());
+        std::memset(base, 0, static_cast<std::size_t>(memory.size()));
+        auto* header = new (base) earth::databridge::SharedRingHeader();
+        header->version = kRingVersion;
+        header->slotCount = slotCount;
+        header->recordSize = sizeof(earth::databridge::EntityState);
+        header->writeIndex.store(0, std::memory_order_relaxed);
+        auto* slots = reinterpret_cast<earth::databridge::SharedRingSlot*>(base + kSlotsOffset);
+        for (std::uint32_t i = 0; i < slotCount; ++i) {
+            new (&slots[i]) earth::databridge::SharedRingSlot();
+            slots[i].sequence.store(0, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = kRingMagic;
+        return true;
+    }
+
+    if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach()) {
+        qWarning() << "[DataBridge] 共享内存不可用:" << memory.errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 校验已附加段的头部，返回槽位数量；段尚未初始化完毕或布局不兼容时返回 0。
+ */
+std::uint32_t validateHeader(const QSharedMemory& memory) {
+    if (memory.size() < static_cast<int>(kSlotsOffset)) {
+        return 0;
+    }
+    const auto* header = static_cast<const earth::databridge::SharedRingHeader*>(memory.constData());
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->magic != kRingMagic || header->version != kRingVersion ||
+        header->recordSize != sizeof(earth::databridge::EntityState) || header->slotCount == 0 ||
+        (header->slotCount & (header->slotCount - 1)) != 0 ||
+        static_cast<std::size_t>(memory.size()) < segmentSize(header->slotCount)) {
+        return 0;
+    }
+    return header->slotCount;
+}
+} // namespace
+
+namespace earth::databridge {
+
+SharedMemoryRingWriter::SharedMemoryRingWriter(const QString& key)
+    : m_memory(key) {
+}
+
+SharedMemoryRingWriter::~SharedMemoryRingWriter() {
+    close();
+}
+
+bool SharedMemoryRingWriter::open(std::uint32_t slotCount) {
+    close();
+    if (!createOrAttach(m_memory, roundUpPowerOfTwo(slotCount))) {
+        return false;
+    }
+    const std::uint32_t count = validateHeader(m_memory);
+    if (count == 0) {
+        qWarning() << "[DataBridge] 共享内存布局不兼容";
+        m_memory.detach();
+        return false;
+    }
+    auto* base = static_cast<unsigned char*>(m_memory.data());
+    m_header = reinterpret_cast<SharedRingHeader*>(base);
+    m_slots = reinterpret_cast<SharedRingSlot*>(base + kSlotsOffset);
+    m_mask = count - 1U;
+    return true;
+}
+
+void SharedMemoryRingWriter::close() {
+    m_header = nullptr;
+    m_slots = nullptr;
+    if (m_memory.isAttached()) {
+        m_memory.detach();
+    }
+}
+
+void SharedMemoryRingWriter::publish(const EntityState& state) {
+    if (m_header == nullptr) {
+        return;
+    }
+
+    const std::uint64_t index = m_header->writeIndex.load(std::memory_order_relaxed);
+    SharedRingSlot& slot = m_slots[index & m_mask];
+    slot.sequence.store(index * 2U + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.state = state;
+    if (slot.state.publishSteadyNs == 0) {
+        slot.state.publishSteadyNs = steadyNowNs();
+    }
+
+    slot.sequence.store(index * 2U + 2U, std::memory_order_release);
+    m_header->writeIndex.store(index + 1U, std::memory_order_release);
+}
+
+SharedMemoryRingReader::SharedMemoryRingReader(const QString& key)
+    : m_memory(key) {
+}
+
+SharedMemoryRingReader::~SharedMemoryRingReader() {
+    close();
+}
+
+bool SharedMemoryRingReader::open() {
+    close();
+    if (!m_memory.attach(QSharedMemory::ReadOnly)) {
+        return false;
+    }
+    const std::uint32_t count = validateHeader(m_memory);
+    if (count == 0) {
+        m_memory.detach();
+        return false;
+    }
+    const auto* base = static_cast<const unsigned char*>(m_memory.constData());
+    m_header = reinterpret_cast<const SharedRingHeader*>(base);
+    m_slots = reinterpret_cast<const SharedRingSlot*>(base + kSlotsOffset);
+    m_mask = count - 1U;
+    // 只接收附加之后发布的记录，历史槽位可能早已过期。
+    m_readIndex = m_header->writeIndex.load(std::memory_order_acquire);
+    return true;
+}
+
+void SharedMemoryRingReader::close() {
+    m_header = nullptr;
+    m_slots = nullptr;
+    if (m_memory.isAttached()) {
+        m_memory.detach();
+    }
+}
+
+std::size_t SharedMemoryRingReader::poll(const Visitor& visitor) {
+    if (m_header == nullptr) {
+        return 0;
+    }
+
+    const std::uint64_t writeIndex = m_header->writeIndex.load(std::memory_order_acquire);
+    const std::uint64_t capacity = m_mask + 1U;
+    if (writeIndex - m_readIndex > capacity) {
+        m_counters.dropped += writeIndex - m_readIndex - capacity;
+        m_readIndex = writeIndex - capacity;
+    }
+
+    std::size_t delivered = 0;
+    while (m_readIndex < writeIndex) {
+        const SharedRingSlot& slot = m_slots[m_readIndex & m_mask];
+        const std::uint64_t expected = m_readIndex * 2U + 2U;
+
+        const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before < expected) {
+            // 写端已推进 writeIndex 但槽位仍在写入中，留待下次读取。
+            break;
+        }
+        if (before > expected) {
+            ++m_counters.dropped;
+            ++m_readIndex;
+            continue;
+        }
+
+        const EntityState state = slot.state;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+        ++m_readIndex;
+        if (after != before) {
+            ++m_counters.torn;
+            continue;
+        }
+
+        ++m_counters.received;
+        ++delivered;
+        visitor(state);
+    }
+    return delivered;
+}
+
+} // namespace earth::databridge
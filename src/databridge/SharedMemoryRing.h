@@ -0,0 +1,114 @@
+#pragma once
+
+#include "databridge/EntityState.h"
+
+#include <QSharedMemory>
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace earth::databridge {
+
+/**
+ * @brief 共享内存环形缓冲的进程间布局：头部 + slotCount 个槽位。
+ *
+ * 每个槽位带一个序号（seqlock）：写入第 n 条记录时先置为 2n+1（奇数表示写入中），写完后置为 2n+2。
+ * 读端按序号判断槽位是否已写完、是否已被新一圈覆盖，全程无锁、无系统调用。
+ */
+struct SharedRingHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t recordSize;
+    std::atomic<std::uint64_t> writeIndex; /**< 已发布记录总数，单调递增。 */
+};
+
+struct SharedRingSlot {
+    std::atomic<std::uint64_t> sequence;
+    EntityState state;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared-memory ring requires lock-free 64-bit atomics");
+
+/**
+ * @brief 共享内存发布端，供同机模拟器写入实体状态。单写者。
+ */
+class SharedMemoryRingWriter {
+public:
+    explicit SharedMemoryRingWriter(const QString& key = QString::fromLatin1(kSharedMemoryKey));
+    ~SharedMemoryRingWriter();
+
+    SharedMemoryRingWriter(const SharedMemoryRingWriter&) = delete;
+    SharedMemoryRingWriter& operator=(const SharedMemoryRingWriter&) = delete;
+
+    /**
+     * @brief 创建或附加到共享内存段，slotCount 会向上取整到 2 的幂。
+     */
+    bool open(std::uint32_t slotCount = kDefaultSlotCount);
+    void close();
+    [[nodiscard]] bool isOpen() const noexcept { return m_header != nullptr; }
+
+    /**
+     * @brief 发布一条记录；publishSteadyNs 为 0 时自动填入当前时刻。
+     */
+    void publish(const EntityState& state);
+
+private:
+    QSharedMemory m_memory;
+    SharedRingHeader* m_header = nullptr;
+    SharedRingSlot* m_slots = nullptr;
+    std::uint64_t m_mask = 0;
+};
+
+/**
+ * @brief 共享内存读取端，视景进程每帧调用 poll() 取出新记录。单读者。
+ */
+class SharedMemoryRingReader {
+public:
+    /**
+     * @brief 读取统计，计数均为累计值。
+     */
+    struct Counters {
+        std::uint64_t received = 0; /**< 成功读取的记录数。 */
+        std::uint64_t dropped = 0;  /**< 读端落后一圈以上而被覆盖的记录数。 */
+        std::uint64_t torn = 0;     /**< 读取过程中被写端覆盖、已丢弃的记录数。 */
+    };
+
+    using Visitor = std::function<void(const EntityState&)>;
+
+    explicit SharedMemoryRingReader(const QString& key = QString::fromLatin1(kSharedMemoryKey));
+    ~SharedMemoryRingReader();
+
+    SharedMemoryRingReader(const SharedMemoryRingReader&) = delete;
+    SharedMemoryRingReader& operator=(const SharedMemoryRingReader&) = delete;
+
+    /**
+     * @brief 只附加到模拟器已创建并初始化的共享内存段，段不存在或布局不兼容时返回 false。
+     *
+     * 读端从不创建共享内存段，否则无论模拟器是否在线 open() 都会成功，调用方无法判断应回退到 UDP。
+     */
+    bool open();
+    void close();
+    [[nodiscard]] bool isOpen() const noexcept { return m_header != nullptr; }
+
+    /**
+     * @brief 读取自上次调用以来发布的记录，对每条记录调用 visitor，返回本次读取条数。
+     *
+     * 当前被写入中的槽位留到下一次读取，不会阻塞等待。
+     */
+    std::size_t poll(const Visitor& visitor);
+
+    [[nodiscard]] const Counters& counters() const noexcept { return m_counters; }
+
+private:
+    QSharedMemory m_memory;
+    const SharedRingHeader* m_header = nullptr;
+    const SharedRingSlot* m_slots = nullptr;
+    std::uint64_t m_mask = 0;
+    std::uint64_t m_readIndex = 0;
+    Counters m_counters;
+};
+
+} // namespace earth::databridge
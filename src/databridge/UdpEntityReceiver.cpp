@@ -0,0 +1,62 @@
+#include "databridge/UdpEntityReceiver.h"
+
+#include <QDebug>
+#include <QHostAddress>
+
+#include <algorithm>
+#include <cstring>
+
+namespace earth::databridge {
+
+bool UdpEntityReceiver::open(std::uint16_t port) {
+    close();
+    if (!m_socket.bind(QHostAddress::LocalHost, port)) {
+        qWarning() << "[DataBridge] UDP 端口绑定失败:" << port << m_socket.errorString();
+        return false;
+    }
+    return true;
+}
+
+void UdpEntityReceiver::close() {
+    if (m_socket.state() != QAbstractSocket::UnconnectedState) {
+        m_socket.close();
+    }
+}
+
+bool UdpEntityReceiver::isOpen() const {
+    return m_socket.state() == QAbstractSocket::BoundState;
+}
+
+std::size_t UdpEntityReceiver::poll(const Visitor& visitor) {
+    std::size_t delivered = 0;
+    while (m_socket.hasPendingDatagrams()) {
+        const qint64 pending = m_socket.pendingDatagramSize();
+        m_datagram.resize(static_cast<int>(std::max<qint64>(pending, 0)));
+        const qint64 length = m_socket.readDatagram(m_datagram.data(), m_datagram.size());
+        if (length < static_cast<qint64>(sizeof(UdpDatagramHeader))) {
+            ++m_counters.malformed;
+            continue;
+        }
+
+        UdpDatagramHeader header;
+        std::memcpy(&header, m_datagram.constData(), sizeof(header));
+        const auto payload = static_cast<std::size_t>(length) - sizeof(header);
+        if (header.magic != kUdpDatagramMagic || payload != static_cast<std::size_t>(header.count) * sizeof(EntityState)) {
+            ++m_counters.malformed;
+            continue;
+        }
+
+        const char* cursor = m_datagram.constData() + sizeof(header);
+        for (std::uint32_t i = 0; i < header.count; ++i) {
+            EntityState state;
+            std::memcpy(&state, cursor, sizeof(state));
+            cursor += sizeof(state);
+            ++m_counters.received;
+            ++delivered;
+            visitor(state);
+        }
+    }
+    return delivered;
+}
+
+} // namespace earth::databridge
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "databridge/EntityState.h"
+
+#include <QByteArray>
+#include <QUdpSocket>
+
+#include <cstdint>
+#include <functional>
+
+namespace earth::databridge {
+
+/**
+ * @brief 本机 UDP 回退通道：共享内存不可用或模拟器运行在不支持共享内存的环境时使用。
+ *
+ * 只绑定回环地址，数据报格式为 UdpDatagramHeader + count 条 EntityState。
+ */
+class UdpEntityReceiver {
+public:
+    struct Counters {
+        std::uint64_t received = 0;  /**< 成功解析的记录数。 */
+        std::uint64_t malformed = 0; /**< 头部或长度不合法而丢弃的数据报数。 */
+    };
+
+    using Visitor = std::function<void(const EntityState&)>;
+
+    UdpEntityReceiver() = default;
+
+    bool open(std::uint16_t port = kDefaultUdpPort);
+    void close();
+    [[nodiscard]] bool isOpen() const;
+
+    /**
+     * @brief 非阻塞地读取全部待处理数据报，返回本次读取条数。
+     */
+    std::size_t poll(const Visitor& visitor);
+
+    [[nodiscard]] const Counters& counters() const noexcept { return m_counters; }
+
+private:
+    QUdpSocket m_socket;
+    QByteArray m_datagram;
+    Counters m_counters;
+};
+
+} // namespace earth::databridge
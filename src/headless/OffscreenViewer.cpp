@@ -0,0 +1,199 @@
+#include "headless/OffscreenViewer.h"
+
+#include "core/SimulationBootstrapper.h"
+
+#include <QDebug>
+
+#include <osg/Camera>
+#include <osg/GL>
+#include <osg/GraphicsContext>
+#include <osg/Image>
+#include <osgDB/DatabasePager>
+#include <osgDB/ReadFile>
+#include <osgEarth/Common>
+#include <osgEarth/EarthManipulator>
+#include <osgEarth/GeoData>
+#include <osgEarth/MapNode>
+#include <osgEarth/Sky>
+#include <osgEarth/SpatialReference>
+#include <osgEarth/Viewpoint>
+#include <osgViewer/Viewer>
+
+#include <mutex>
+
+namespace earth::headless {
+namespace {
+constexpr double kNearPlane = 0.1;
+constexpr double kFarPlane = 5e6;
+} // namespace
+
+OffscreenViewer::OffscreenViewer() = default;
+
+OffscreenViewer::~OffscreenViewer() = default;
+
+bool OffscreenViewer::initialize(const QString& earthFile, int width, int height) {
+    static std::once_flag initFlag;
+    std::call_once(initFlag, [] {
+        osgEarth::initialize();
+    });
+
+    m_simulation = std::make_unique<core::SimulationBootstrapper>();
+    m_simulation->initialize();
+    if (!earthFile.isEmpty()) {
+        osg::ref_ptr<osg::Node> node = osgDB::readNodeFile(earthFile.toStdString());
+        if (!node.valid() || !m_simulation->applyExternalScene(node.get())) {
+            qWarning() << "[Offscreen] 无法加载 Earth 文件" << earthFile;
+            return false;
+        }
+    }
+    // 离屏输出要求可复现：天空时间只随调用方显式设置变化，不随墙钟走动。
+    m_simulation->skyTime().setMode(core::SkyClockMode::Manual);
+
+    osg::ref_ptr<osg::GraphicsContext::Traits> traits = new osg::GraphicsContext::Traits;
+    traits->windowingSystemPreference = "Qt";
+    traits->pbuffer = true;
+    traits->doubleBuffer = false;
+    traits->x = 0;
+    traits->y = 0;
+    traits->width = width;
+    traits->height = height;
+    traits->alpha = 8;
+    traits->depth = 24;
+    traits->stencil = 8;
+    m_context = osg::GraphicsContext::createGraphicsContext(traits.get());
+    if (!m_context.valid()) {
+        qWarning() << "[Offscreen] 无法创建离屏 OpenGL 上下文";
+        return false;
+    }
+
+    m_image = new osg::Image();
+    m_viewer = new osgViewer::Viewer();
+    m_viewer->setThreadingModel(osgViewer::Viewer::SingleThreaded);
+    m_viewer->setKeyEventSetsDone(0);
+    m_viewer->setQuitEventSetsDone(false);
+
+    osg::Camera* camera = m_viewer->getCamera();
+    camera->setGraphicsContext(m_context.get());
+    camera->setClearColor(osg::Vec4(0.1f, 0.1f, 0.15f, 1.0f));
+    camera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+    camera->setDrawBuffer(GL_COLOR_ATTACHMENT0_EXT);
+    camera->setReadBuffer(GL_COLOR_ATTACHMENT0_EXT);
+
+    m_viewer->setSceneData(m_simulation->sceneRoot());
+    m_manipulator = new osgEarth::Util::EarthManipulator();
+    m_viewer->setCameraManipulator(m_manipulator.get());
+    if (osgEarth::SkyNode* sky = m_simulation->skyNode()) {
+        sky->attach(m_viewer.get(), 0);
+    }
+
+    resize(width, height);
+    return true;
+}
+
+bool OffscreenViewer::realize() {
+    if (!m_viewer.valid()) {
+        return false;
+    }
+    // QOpenGLContext 在 realize 时于本线程创建，此后只能在本线程 makeCurrent。
+    m_viewer->realize();
+    return isRealized();
+}
+
+bool OffscreenViewer::isRealized() const {
+    return m_context.valid() && m_context->isRealized();
+}
+
+void OffscreenViewer::close() {
+    // Viewer 析构时释放 GL 对象，必须留在拥有上下文的线程；
+    // m_context 仍持有 QOffscreenSurface，随本对象回到 GUI 线程再销毁。
+    m_manipulator = nullptr;
+    m_viewer = nullptr;
+    if (m_context.valid()) {
+        m_context->close();
+    }
+}
+
+void OffscreenViewer::resize(int width, int height) {
+    if (width == m_width && height == m_height) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    m_sizeDirty = true;
+}
+
+void OffscreenViewer::applySize() {
+    osg::Camera* camera = m_viewer->getCamera();
+    m_image->allocateImage(m_width, m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+    camera->setViewport(0, 0, m_width, m_height);
+    camera->setProjectionMatrixAsPerspective(kFieldOfViewDegrees,
+                                             static_cast<double>(m_width) / static_cast<double>(m_height), kNearPlane,
+                                             kFarPlane);
+    camera->detach(osg::Camera::COLOR_BUFFER);
+    camera->detach(osg::Camera::DEPTH_BUFFER);
+    camera->attach(osg::Camera::COLOR_BUFFER, m_image.get(), kMultisamples, 0);
+    camera->attach(osg::Camera::DEPTH_BUFFER, GL_DEPTH_COMPONENT24);
+    camera->dirtyAttachmentMap();
+    m_sizeDirty = false;
+}
+
+osgEarth::Viewpoint OffscreenViewer::makeViewpoint(double lon, double lat, double alt, double heading, double pitch,
+                                                   double range) const {
+    osgEarth::Viewpoint viewpoint;
+    const osgEarth::MapNode* mapNode = m_simulation ? m_simulation->activeMapNode() : nullptr;
+    if (mapNode == nullptr || mapNode->getMapSRS() == nullptr) {
+        return viewpoint;
+    }
+    viewpoint.focalPoint() =
+        osgEarth::GeoPoint(mapNode->getMapSRS()->getGeographicSRS(), lon, lat, alt, osgEarth::ALTMODE_ABSOLUTE);
+    viewpoint.heading() = osgEarth::Angle(heading, osgEarth::Units::DEGREES);
+    viewpoint.pitch() = osgEarth::Angle(pitch, osgEarth::Units::DEGREES);
+    viewpoint.range() = osgEarth::Distance(range, osgEarth::Units::METERS);
+    return viewpoint;
+}
+
+void OffscreenViewer::setViewpoint(const osgEarth::Viewpoint& viewpoint) {
+    if (m_manipulator.valid() && viewpoint.isValid()) {
+        m_manipulator->setViewpoint(viewpoint, 0.0);
+    }
+}
+
+void OffscreenViewer::frame(double simulationTime) {
+    if (!m_viewer.valid()) {
+        return;
+    }
+    if (m_sizeDirty) {
+        applySize();
+    }
+    if (simulationTime < 0.0) {
+        m_viewer->frame();
+    } else {
+        m_viewer->frame(simulationTime);
+    }
+}
+
+bool OffscreenViewer::pagingBusy() const {
+    const osgDB::DatabasePager* pager = m_viewer.valid() ? m_viewer->getDatabasePager() : nullptr;
+    return pager != nullptr && pager->getRequestsInProgress();
+}
+
+QString OffscreenViewer::rendererName() const {
+    if (!isRealized() || !m_context->makeCurrent()) {
+        return {};
+    }
+    const auto* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    const QString name = renderer != nullptr ? QString::fromLatin1(renderer) : QString();
+    m_context->releaseContext();
+    return name;
+}
+
+QImage OffscreenViewer::grab() const {
+    if (!m_image.valid() || m_image->data() == nullptr) {
+        return {};
+    }
+    // FBO 回读的 osg::Image 自下而上存放。
+    const QImage frame(m_image->data(), m_image->s(), m_image->t(), QImage::Format_RGBA8888);
+    return frame.mirrored(false, true);
+}
+
+} // namespace earth::headless
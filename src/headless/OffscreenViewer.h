@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QImage>
+#include <QString>
+
+#include <osg/ref_ptr>
+
+#include <memory>
+
+namespace osg {
+class GraphicsContext;
+class Image;
+} // namespace osg
+
+namespace osgViewer {
+class Viewer;
+}
+
+namespace osgEarth {
+class Viewpoint;
+namespace Util {
+class EarthManipulator;
+}
+} // namespace osgEarth
+
+namespace earth::core {
+class SimulationBootstrapper;
+}
+
+namespace earth::headless {
+
+/**
+ * @brief 离屏视图：独立的仿真场景 + 单线程 osgViewer::Viewer + pbuffer 上下文，渲染到带 MSAA 的 FBO 并回读到内存。
+ *
+ * initialize() 需在 GUI 线程调用（场景加载与 QOffscreenSurface 创建）；realize() 在哪个线程调用，
+ * 该线程就拥有 GL 上下文，此后 frame()/close() 都必须在同一线程。快照批处理与渲染基准共用本类。
+ */
+class OffscreenViewer {
+public:
+    static constexpr double kFieldOfViewDegrees = 30.0;
+    static constexpr int kMultisamples = 4;
+
+    OffscreenViewer();
+    ~OffscreenViewer();
+
+    OffscreenViewer(const OffscreenViewer&) = delete;
+    OffscreenViewer& operator=(const OffscreenViewer&) = delete;
+
+    /**
+     * @brief 构建场景并创建离屏上下文；earthFile 为空时使用内置默认机场场景。
+     */
+    bool initialize(const QString& earthFile, int width, int height);
+
+    /**
+     * @brief 在当前线程创建并初始化 GL 上下文。
+     */
+    bool realize();
+
+    /**
+     * @brief 关闭上下文并释放 GL 对象，须在 realize() 所在线程调用。
+     */
+    void close();
+
+    /**
+     * @brief 调整输出尺寸，下一帧重建 FBO。
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief 立即跳转到视点（无过渡动画）。
+     */
+    void setViewpoint(const osgEarth::Viewpoint& viewpoint);
+
+    /**
+     * @brief 以经纬度焦点、航向/俯仰（度）与距离（米）构造视点，焦点高度按绝对高度解释。
+     */
+    [[nodiscard]] osgEarth::Viewpoint makeViewpoint(double lon, double lat, double alt, double heading, double pitch,
+                                                    double range) const;
+
+    /**
+     * @brief 渲染一帧；simulationTime < 0 时使用墙钟，否则使用给定的仿真时间（秒），便于逐帧可复现。
+     */
+    void frame(double simulationTime = -1.0);
+
+    /**
+     * @brief 数据库分页器是否仍有未完成的请求。
+     */
+    [[nodiscard]] bool pagingBusy() const;
+
+    /**
+     * @brief 上一帧的颜色缓冲，已翻转为自上而下的行序。
+     */
+    [[nodiscard]] QImage grab() const;
+
+    /**
+     * @brief GL_RENDERER 字符串，用于区分软件/硬件渲染的结果；须在 realize() 所在线程调用。
+     */
+    [[nodiscard]] QString rendererName() const;
+
+    [[nodiscard]] int width() const noexcept { return m_width; }
+    [[nodiscard]] int height() const noexcept { return m_height; }
+    [[nodiscard]] bool isRealized() const;
+
+    osgViewer::Viewer* viewer() const { return m_viewer.get(); }
+    core::SimulationBootstrapper& simulation() const { return *m_simulation; }
+
+private:
+    void applySize();
+
+    std::unique_ptr<core::SimulationBootstrapper> m_simulation;
+    osg::ref_ptr<osg::GraphicsContext> m_context;
+    osg::ref_ptr<osgViewer::Viewer> m_viewer;
+    osg::ref_ptr<osgEarth::Util::EarthManipulator> m_manipulator;
+    osg::ref_ptr<osg::Image> m_image;
+    int m_width = 0;
+    int m_height = 0;
+    bool m_sizeDirty = true;
+};
+
+} // namespace earth::headless
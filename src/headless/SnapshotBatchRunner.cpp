@@ -0,0 +1,176 @@
+#include "headless/SnapshotBatchRunner.h"
+
+#include "core/FrameMetrics.h"
+#include "core/SimulationBootstrapper.h"
+#include "headless/OffscreenViewer.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+
+#include <osgEarth/Viewpoint>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace earth::headless {
+namespace {
+// llvmpipe 每个上下文自带光栅化线程池，渲染线程再多只会互相争抢。
+constexpr unsigned int kMaxAutoThreads = 4;
+} // namespace
+
+struct SnapshotBatchRunner::Worker {
+    int index = 0;
+    OffscreenViewer view;
+};
+
+SnapshotBatchRunner::SnapshotBatchRunner(SnapshotJobList jobs)
+    : m_jobs(std::move(jobs)) {
+}
+
+SnapshotBatchRunner::~SnapshotBatchRunner() = default;
+
+unsigned int SnapshotBatchRunner::resolveThreadCount() const {
+    unsigned int count = m_threadCount;
+    if (count == 0) {
+        count = std::clamp(std::thread::hardware_concurrency() / 4U, 1U, kMaxAutoThreads);
+    }
+    return std::max(1U, std::min(count, static_cast<unsigned int>(m_jobs.jobs.size())));
+}
+
+std::size_t SnapshotBatchRunner::run() {
+    if (m_jobs.jobs.empty()) {
+        return 0;
+    }
+    m_nextJob = 0;
+    m_succeeded = 0;
+
+    // 场景加载与 QOffscreenSurface 创建都必须在 GUI 线程完成，渲染线程只负责 realize 与绘制。
+    const unsigned int threadCount = resolveThreadCount();
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->index = static_cast<int>(i);
+        const SnapshotJob& first = m_jobs.jobs.front();
+        if (!worker->view.initialize(m_jobs.earthFile, first.width, first.height)) {
+            return 0;
+        }
+        workers.push_back(std::move(worker));
+    }
+    // 未给出 time 的任务统一使用批次开始时的天空时刻，输出不随任务被哪个线程、在哪个任务之后领取而变化。
+    m_defaultEpochSeconds = workers.front()->view.simulation().skyTime().epochSeconds();
+
+    qInfo() << "[Snapshot] 开始渲染" << m_jobs.jobs.size() << "个视点，渲染线程" << threadCount;
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (const std::unique_ptr<Worker>& worker : workers) {
+        threads.emplace_back([this, &worker]() { renderLoop(*worker); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return m_succeeded.load();
+}
+
+void SnapshotBatchRunner::renderLoop(Worker& worker) {
+    if (!worker.view.realize()) {
+        qWarning() << "[Snapshot] 渲染线程" << worker.index << "无法初始化 OpenGL 上下文";
+        worker.view.close();
+        return;
+    }
+
+    for (std::size_t next = m_nextJob++; next < m_jobs.jobs.size(); next = m_nextJob++) {
+        if (renderJob(worker, m_jobs.jobs[next])) {
+            ++m_succeeded;
+        }
+    }
+    worker.view.close();
+}
+
+bool SnapshotBatchRunner::renderJob(Worker& worker, const SnapshotJob& job) const {
+    QElapsedTimer timer;
+    timer.start();
+
+    OffscreenViewer& view = worker.view;
+    view.resize(job.width, job.height);
+    view.simulation().skyTime().setEpochSeconds(job.hasTime ? job.epochSeconds : m_defaultEpochSeconds);
+
+    osgEarth::Viewpoint viewpoint =
+        view.makeViewpoint(job.longitude, job.latitude, job.altitude, job.heading, job.pitch, job.range);
+    if (!viewpoint.isValid()) {
+        qWarning() << "[Snapshot] 当前场景没有 MapNode，跳过" << job.name;
+        return false;
+    }
+    viewpoint.name() = job.name.toStdString();
+    view.setViewpoint(viewpoint);
+
+    // 至少渲染 settleFrames 帧让地形分页与 LOD 收敛，分页仍在进行时继续等待直到超时。
+    QElapsedTimer settle;
+    settle.start();
+    for (int frame = 1;; ++frame) {
+        view.frame();
+        if (frame >= m_jobs.settleFrames && !view.pagingBusy()) {
+            break;
+        }
+        if (static_cast<double>(settle.elapsed()) / 1000.0 > m_jobs.settleTimeoutSeconds) {
+            qWarning() << "[Snapshot] 视点" << job.name << "等待分页超时，按当前画面输出";
+            break;
+        }
+    }
+
+    const QImage output = view.grab().convertToFormat(QImage::Format_RGB888);
+    QDir().mkpath(QFileInfo(job.outputPath).absolutePath());
+    if (output.isNull() || !output.save(job.outputPath)) {
+        qWarning() << "[Snapshot] 无法写出图像" << job.outputPath;
+        return false;
+    }
+
+    const auto elapsedMs = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+    core::FrameMetrics::instance().recordDuration("snapshot.render", elapsedMs);
+    qInfo() << "[Snapshot]" << job.name << "->" << job.outputPath << QString::number(elapsedMs, 'f', 0) << "ms";
+    return true;
+}
+
+bool SnapshotBatchRunner::requested(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SnapshotBatchRunner::runFromCommandLine(const QStringList& arguments) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("按任务文件离屏批量渲染机场视点快照。"));
+    parser.addHelpOption();
+    const QCommandLineOption headlessOption(QStringLiteral("headless"), QStringLiteral("JSON 任务文件路径。"),
+                                            QStringLiteral("jobs"));
+    const QCommandLineOption threadsOption(QStringLiteral("threads"),
+                                           QStringLiteral("渲染线程数，0 为自动。"), QStringLiteral("n"),
+                                           QStringLiteral("0"));
+    parser.addOption(headlessOption);
+    parser.addOption(threadsOption);
+    parser.process(arguments);
+
+    SnapshotJobList jobs;
+    if (!jobs.load(parser.value(headlessOption))) {
+        return 2;
+    }
+    const std::size_t total = jobs.jobs.size();
+
+    SnapshotBatchRunner runner(std::move(jobs));
+    runner.setThreadCount(parser.value(threadsOption).toUInt());
+    const std::size_t succeeded = runner.run();
+    qInfo() << "[Snapshot] 完成" << succeeded << "/" << total;
+    return succeeded == total ? 0 : 1;
+}
+
+} // namespace earth::headless
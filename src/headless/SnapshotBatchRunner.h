@@ -0,0 +1,63 @@
+#pragma once
+
+#include "headless/SnapshotJob.h"
+
+#include <QStringList>
+
+#include <atomic>
+#include <cstddef>
+
+namespace earth::headless {
+
+/**
+ * @brief 离屏批量快照：每个渲染线程持有一个 OffscreenViewer（独立场景、Viewer 与 pbuffer 上下文），
+ * 从共享任务游标领取视点，渲染到 FBO 后写出图像文件。
+ *
+ * 上下文由 osgQt 的 PixelBufferQt 提供（QOffscreenSurface + QOpenGLContext），不需要可见窗口，
+ * 可运行在 Mesa llvmpipe 等软件 GL 上。各线程的场景互不共享，避免多个 update 遍历并发修改同一场景图；
+ * 代价是每个线程各加载一份地图。
+ */
+class SnapshotBatchRunner {
+public:
+    explicit SnapshotBatchRunner(SnapshotJobList jobs);
+    ~SnapshotBatchRunner();
+
+    SnapshotBatchRunner(const SnapshotBatchRunner&) = delete;
+    SnapshotBatchRunner& operator=(const SnapshotBatchRunner&) = delete;
+
+    /**
+     * @brief 渲染线程数，0 表示按硬件并发数自动选择；不会超过任务数。
+     */
+    void setThreadCount(unsigned int count) noexcept { m_threadCount = count; }
+
+    /**
+     * @brief 在 GUI 线程调用，阻塞到全部任务完成。
+     * @return 成功写出的图像数量。
+     */
+    std::size_t run();
+
+    /**
+     * @brief 命令行中是否带有 --headless，需在创建 QApplication 之前判断。
+     */
+    static bool requested(int argc, char* argv[]);
+
+    /**
+     * @brief 解析 --headless <任务文件> [--threads N] 并执行，返回进程退出码。
+     */
+    static int runFromCommandLine(const QStringList& arguments);
+
+private:
+    struct Worker;
+
+    void renderLoop(Worker& worker);
+    bool renderJob(Worker& worker, const SnapshotJob& job) const;
+    [[nodiscard]] unsigned int resolveThreadCount() const;
+
+    SnapshotJobList m_jobs;
+    unsigned int m_threadCount = 0;
+    std::atomic<std::size_t> m_nextJob {0};
+    std::atomic<std::size_t> m_succeeded {0};
+    double m_defaultEpochSeconds = 0.0; /**< 未给出 time 的任务使用的天空时刻（UTC 秒），run() 开始时确定。 */
+};
+
+} // namespace earth::headless
@@ -0,0 +1,97 @@
+#include "headless/SnapshotJob.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace earth::headless {
+namespace {
+// 单边上限，避免误填的尺寸让软件光栅化分配数 GB 的 FBO。
+constexpr int kMaxImageSize = 16384;
+
+bool validSize(int width, int height) {
+    return width > 0 && height > 0 && width <= kMaxImageSize && height <= kMaxImageSize;
+}
+} // namespace
+
+bool SnapshotJobList::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[Snapshot] 无法打开任务文件" << path << file.errorString();
+        return false;
+    }
+
+    QJsonParseError parseError {};
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!document.isObject()) {
+        qWarning() << "[Snapshot] 任务文件解析失败" << path << parseError.errorString();
+        return false;
+    }
+
+    const QDir baseDir = QFileInfo(path).absoluteDir();
+    const QJsonObject root = document.object();
+
+    const QString earth = root.value(QStringLiteral("earthFile")).toString();
+    const QDir outputDir(baseDir.absoluteFilePath(root.value(QStringLiteral("outputDir")).toString(QStringLiteral("."))));
+    const int defaultWidth = root.value(QStringLiteral("width")).toInt(kDefaultWidth);
+    const int defaultHeight = root.value(QStringLiteral("height")).toInt(kDefaultHeight);
+    const QJsonArray jobArray = root.value(QStringLiteral("jobs")).toArray();
+    if (jobArray.isEmpty()) {
+        qWarning() << "[Snapshot] 任务文件中没有 jobs" << path;
+        return false;
+    }
+
+    std::vector<SnapshotJob> parsed;
+    parsed.reserve(static_cast<std::size_t>(jobArray.size()));
+    for (const QJsonValue& value : jobArray) {
+        const QJsonObject object = value.toObject();
+        SnapshotJob job;
+        job.name = object.value(QStringLiteral("name")).toString();
+        if (job.name.isEmpty() || !object.contains(QStringLiteral("lon")) || !object.contains(QStringLiteral("lat"))) {
+            qWarning() << "[Snapshot] 任务缺少 name/lon/lat 字段" << path;
+            return false;
+        }
+        job.longitude = object.value(QStringLiteral("lon")).toDouble();
+        job.latitude = object.value(QStringLiteral("lat")).toDouble();
+        job.altitude = object.value(QStringLiteral("alt")).toDouble(0.0);
+        job.heading = object.value(QStringLiteral("heading")).toDouble(job.heading);
+        job.pitch = std::clamp(object.value(QStringLiteral("pitch")).toDouble(job.pitch), -90.0, 0.0);
+        job.range = std::max(object.value(QStringLiteral("range")).toDouble(job.range), 1.0);
+        job.width = object.value(QStringLiteral("width")).toInt(defaultWidth);
+        job.height = object.value(QStringLiteral("height")).toInt(defaultHeight);
+        if (!validSize(job.width, job.height)) {
+            qWarning() << "[Snapshot] 任务图像尺寸无效" << job.name << job.width << job.height;
+            return false;
+        }
+
+        const QString output = object.value(QStringLiteral("output")).toString(job.name + QStringLiteral(".png"));
+        job.outputPath = outputDir.absoluteFilePath(output);
+
+        if (object.contains(QStringLiteral("time"))) {
+            const QDateTime time = QDateTime::fromString(object.value(QStringLiteral("time")).toString(), Qt::ISODate);
+            if (!time.isValid()) {
+                qWarning() << "[Snapshot] 任务时刻无效" << job.name << object.value(QStringLiteral("time")).toString();
+                return false;
+            }
+            job.epochSeconds = static_cast<double>(time.toMSecsSinceEpoch()) / 1000.0;
+            job.hasTime = true;
+        }
+        parsed.push_back(std::move(job));
+    }
+
+    earthFile = earth.isEmpty() ? QString() : baseDir.absoluteFilePath(earth);
+    settleFrames = std::max(root.value(QStringLiteral("settleFrames")).toInt(kDefaultSettleFrames), 1);
+    settleTimeoutSeconds =
+        std::max(root.value(QStringLiteral("settleTimeoutSeconds")).toDouble(kDefaultSettleTimeoutSeconds), 0.0);
+    jobs = std::move(parsed);
+    return true;
+}
+
+} // namespace earth::headless
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QString>
+
+#include <vector>
+
+namespace earth::headless {
+
+/**
+ * @brief 单张快照：视点（EarthManipulator 语义）、输出尺寸与可选的天空时刻。
+ */
+struct SnapshotJob {
+    QString name;
+    QString outputPath;     /**< 已解析为绝对路径，扩展名决定图像格式。 */
+    double longitude = 0.0;
+    double latitude = 0.0;
+    double altitude = 0.0;  /**< 焦点高度（米）。 */
+    double heading = 0.0;   /**< 度，正北为 0。 */
+    double pitch = -45.0;   /**< 度，负值为俯视。 */
+    double range = 2000.0;  /**< 相机到焦点的距离（米）。 */
+    int width = 0;
+    int height = 0;
+    double epochSeconds = 0.0; /**< UTC 秒，仅 hasTime 为 true 时生效；否则使用批次开始时的天空时刻。 */
+    bool hasTime = false;
+};
+
+/**
+ * @brief 批量快照任务列表，由 JSON 文件描述：
+ * @code
+ * {
+ *   "earthFile": "airport.earth",
+ *   "outputDir": "snapshots",
+ *   "width": 1920, "height": 1080,
+ *   "settleFrames": 90, "settleTimeoutSeconds": 30,
+ *   "jobs": [
+ *     { "name": "rwy18-approach", "lon": 119.28, "lat": 26.01, "heading": 180, "pitch": -12,
+ *       "range": 4000, "time": "2026-10-18T09:30:00Z" },
+ *     { "name": "apron", "output": "apron-night.jpg", "lon": 119.29, "lat": 26.02, "range": 1200,
+ *       "time": "2026-10-18T13:00:00Z", "width": 1024, "height": 1024 }
+ *   ]
+ * }
+ * @endcode
+ * earthFile 为空时使用内置默认机场场景；相对路径相对于任务文件所在目录。
+ * 未给出 output 的任务输出为 outputDir/name.png；未给出 time 的任务统一使用批次开始时的天空时刻。
+ */
+struct SnapshotJobList {
+    static constexpr int kDefaultWidth = 1280;
+    static constexpr int kDefaultHeight = 720;
+    static constexpr int kDefaultSettleFrames = 60;
+    static constexpr double kDefaultSettleTimeoutSeconds = 20.0;
+
+    QString earthFile;
+    int settleFrames = kDefaultSettleFrames;          /**< 每个视点至少渲染的帧数，供地形分页与 LOD 收敛。 */
+    double settleTimeoutSeconds = kDefaultSettleTimeoutSeconds; /**< 分页未完成时的最长等待。 */
+    std::vector<SnapshotJob> jobs;
+
+    /**
+     * @brief 读取任务文件；任一任务缺少经纬度或名称时整体失败，不做部分加载。
+     */
+    bool load(const QString& path);
+};
+
+} // namespace earth::headless
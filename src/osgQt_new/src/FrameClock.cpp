@@ -0,0 +1,291 @@
+/* -*-c++-*- OpenSceneGraph - Copyright (C) 2009 Wang Rui
+ *
+ * This library is open source and may be redistributed and/or modified under
+ * the terms of the OpenSceneGraph Public License (OSGPL) version 0.0 or
+ * (at your option) any later version.  The full license is in LICENSE file
+ * included with this distribution, and on the openscenegraph.org website.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * OpenSceneGraph Public License for more details.
+*/
+#include <osgQt/FrameClock>
+
+#include <osg/Notify>
+#include <osgViewer/ViewerBase>
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+
+namespace osgQt {
+
+namespace {
+
+const double DEFAULT_FRAME_RATE = 60.0;
+
+// how often an ON_DEMAND clock with nothing to draw still asks the viewers, input wakes it earlier
+const double IDLE_INTERVAL = 0.05;
+
+}
+
+QPointer<FrameClock> FrameClock::s_instance;
+
+FrameTiming::FrameTiming() :
+    intervalMs(0.0),
+    frameMs(0.0),
+    latenessMs(0.0),
+    missedDeadline(false)
+{
+}
+
+FrameClock::Statistics::Statistics() :
+    ticks(0),
+    frames(0),
+    missedDeadlines(0),
+    maxLatenessMs(0.0)
+{
+}
+
+/// Constructor. Must be called from main thread.
+FrameClock::FrameClock() :
+    _frameRate(0.0),
+    _deadline(0),
+    _idle(false),
+    _frameRequested(false),
+    _ticking(false)
+{
+    _timer.setSingleShot(true);
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &FrameClock::tick);
+}
+
+/// Destructor. Must be called from main thread.
+FrameClock::~FrameClock()
+{
+    _timer.stop();
+}
+
+FrameClock* FrameClock::instance()
+{
+    if (!s_instance)
+    {
+        s_instance = new FrameClock();
+    }
+    return s_instance;
+}
+
+void FrameClock::addViewer(osgViewer::ViewerBase* viewer, FrameCallback* callback)
+{
+    if (!viewer) return;
+
+    for (Entries::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        if (itr->viewer == viewer)
+        {
+            itr->callback = callback;
+            return;
+        }
+    }
+
+    Entry entry;
+    entry.viewer = viewer;
+    entry.callback = callback;
+    entry.lastFrame = 0;
+    _entries.push_back(entry);
+
+    // a new viewer gets its first frame right away
+    _idle = false;
+    _deadline = osg::Timer::instance()->tick();
+    updateTimer();
+}
+
+void FrameClock::removeViewer(osgViewer::ViewerBase* viewer)
+{
+    for (Entries::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        if (itr->viewer == viewer)
+        {
+            _entries.erase(itr);
+            break;
+        }
+    }
+    updateTimer();
+}
+
+bool FrameClock::containsViewer(const osgViewer::ViewerBase* viewer) const
+{
+    for (Entries::const_iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        if (itr->viewer == viewer) return true;
+    }
+    return false;
+}
+
+void FrameClock::setViewer(osgViewer::ViewerBase* viewer)
+{
+    if (_entries.size() == 1 && _entries.front().viewer == viewer) return;
+
+    _entries.clear();
+    if (viewer) addViewer(viewer);
+    else updateTimer();
+}
+
+void FrameClock::setFrameRate(double rate)
+{
+    _frameRate = std::max(rate, 0.0);
+}
+
+double FrameClock::getEffectiveFrameRate() const
+{
+    if (_frameRate > 0.0) return _frameRate;
+
+    double rate = 0.0;
+    for (Entries::const_iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        osg::ref_ptr<osgViewer::ViewerBase> viewer;
+        if (itr->viewer.lock(viewer)) rate = std::max(rate, viewer->getRunMaxFrameRate());
+    }
+    if (rate > 0.0) return rate;
+
+    QScreen* screen = QGuiApplication::primaryScreen();
+    if (screen && screen->refreshRate() > 1.0) return screen->refreshRate();
+
+    return DEFAULT_FRAME_RATE;
+}
+
+void FrameClock::requestFrame()
+{
+    _frameRequested = true;
+
+    // a running clock frames on its next tick anyway, only an idle one is brought forward
+    if (_idle && !_ticking && !_entries.empty())
+    {
+        _idle = false;
+        _deadline = osg::Timer::instance()->tick();
+        updateTimer();
+    }
+}
+
+void FrameClock::vsync()
+{
+    if (_idle || _ticking || _entries.empty()) return;
+
+    osg::Timer* timer = osg::Timer::instance();
+    _deadline = timer->tick() + static_cast<osg::Timer_t>(1.0 / (getEffectiveFrameRate() * timer->getSecondsPerTick()));
+    updateTimer();
+}
+
+void FrameClock::schedule(osg::Timer_t when)
+{
+    const osg::Timer_t now = osg::Timer::instance()->tick();
+    const double delayMs = when > now ? osg::Timer::instance()->delta_m(now, when) : 0.0;
+
+    // milliseconds are truncated, the tick rather comes a fraction early than late
+    _timer.start(static_cast<int>(delayMs));
+}
+
+void FrameClock::updateTimer()
+{
+    if (_entries.empty())
+    {
+        _timer.stop();
+        return;
+    }
+    if (_ticking) return;
+
+    if (_idle)
+    {
+        osg::Timer* timer = osg::Timer::instance();
+        schedule(timer->tick() + static_cast<osg::Timer_t>(IDLE_INTERVAL / timer->getSecondsPerTick()));
+    }
+    else
+    {
+        schedule(_deadline);
+    }
+}
+
+void FrameClock::tick()
+{
+    // ViewerBase::frame() may spin the event loop, do not frame recursively
+    if (_ticking) return;
+    _ticking = true;
+
+    osg::Timer* timer = osg::Timer::instance();
+    const osg::Timer_t period = static_cast<osg::Timer_t>(1.0 / (getEffectiveFrameRate() * timer->getSecondsPerTick()));
+    const osg::Timer_t start = timer->tick();
+
+    // the frames of this tick are due when the next one is; a tick that came early still gets a full period
+    const osg::Timer_t frameDeadline = std::max(_deadline, start) + period;
+
+    const bool requested = _frameRequested;
+    _frameRequested = false;
+    ++_statistics.ticks;
+
+    // copy, callbacks may add or remove viewers
+    Entries entries(_entries);
+    bool rendered = false;
+    for (Entries::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        osg::ref_ptr<osgViewer::ViewerBase> viewer;
+        if (!itr->viewer.lock(viewer)) continue;
+
+        if (viewer->getRunFrameScheme() == osgViewer::ViewerBase::ON_DEMAND && !requested && !viewer->checkNeedToDoFrame()) continue;
+        if (itr->callback.valid() && !itr->callback->beginFrame(*viewer)) continue;
+
+        const osg::Timer_t frameStart = timer->tick();
+        viewer->frame();
+        const osg::Timer_t frameEnd = timer->tick();
+
+        rendered = true;
+        ++_statistics.frames;
+
+        FrameTiming timing;
+        timing.intervalMs = itr->lastFrame != 0 ? timer->delta_m(itr->lastFrame, frameStart) : 0.0;
+        timing.frameMs = timer->delta_m(frameStart, frameEnd);
+        timing.missedDeadline = frameEnd > frameDeadline;
+        timing.latenessMs = timing.missedDeadline ? timer->delta_m(frameDeadline, frameEnd) : 0.0;
+
+        for (Entries::iterator current = _entries.begin(); current != _entries.end(); ++current)
+        {
+            if (current->viewer == viewer.get()) current->lastFrame = frameStart;
+        }
+
+        if (itr->callback.valid()) itr->callback->endFrame(*viewer, timing);
+    }
+
+    // forget viewers that have been deleted
+    for (Entries::iterator itr = _entries.begin(); itr != _entries.end();)
+    {
+        if (!itr->viewer.valid()) itr = _entries.erase(itr);
+        else ++itr;
+    }
+
+    const osg::Timer_t end = timer->tick();
+    if (rendered)
+    {
+        _deadline = frameDeadline;
+        if (end > frameDeadline)
+        {
+            const double latenessMs = timer->delta_m(frameDeadline, end);
+            ++_statistics.missedDeadlines;
+            _statistics.maxLatenessMs = std::max(_statistics.maxLatenessMs, latenessMs);
+            OSG_INFO<<"FrameClock: missed the frame deadline by "<<latenessMs<<" ms"<<std::endl;
+
+            // skip the slots that have passed instead of catching up with a burst of frames
+            while (_deadline <= end) _deadline += period;
+        }
+        _idle = false;
+    }
+    else
+    {
+        _idle = true;
+    }
+
+    _ticking = false;
+    updateTimer();
+}
+
+}
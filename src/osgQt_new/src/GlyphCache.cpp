@@ -0,0 +1,303 @@
+/* -*-c++-*- OpenSceneGraph - Copyright (C) 2009-2010 Mathias Froehlich
+ *
+ * This library is open source and may be redistributed and/or modified under
+ * the terms of the OpenSceneGraph Public License (OSGPL) version 0.0 or
+ * (at your option) any later version.  The full license is in LICENSE file
+ * included with this distribution, and on the openscenegraph.org website.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * OpenSceneGraph Public License for more details.
+*/
+#include <osgQt/GlyphCache>
+
+#include <osg/Notify>
+#include <OpenThreads/ScopedLock>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+
+#include <cstring>
+
+namespace osgQt {
+
+namespace {
+
+const quint32 CACHE_MAGIC = 0x45474331; // "EGC1"
+const quint32 CACHE_VERSION = 1;
+const char* const CACHE_FILE_NAME = "glyphs.cache";
+
+}
+
+GlyphRecord::GlyphRecord() :
+    page(0),
+    x(0),
+    y(0),
+    width(0),
+    height(0),
+    horizontalBearingX(0.0f),
+    horizontalBearingY(0.0f),
+    horizontalAdvance(0.0f),
+    verticalBearingX(0.0f),
+    verticalBearingY(0.0f),
+    verticalAdvance(0.0f)
+{
+}
+
+bool GlyphCache::Key::operator<(const Key& rhs) const
+{
+    if (charcode != rhs.charcode) return charcode < rhs.charcode;
+    if (pixelSize != rhs.pixelSize) return pixelSize < rhs.pixelSize;
+    return font < rhs.font;
+}
+
+GlyphCache::Page::Page() :
+    pixels(GlyphCache::PAGE_SIZE * GlyphCache::PAGE_SIZE, 0),
+    cursorX(0),
+    shelfY(0),
+    shelfHeight(0)
+{
+}
+
+GlyphCache& GlyphCache::instance()
+{
+    static GlyphCache s_cache;
+    return s_cache;
+}
+
+GlyphCache::GlyphCache() :
+    _dirty(false),
+    _budgetWarned(false)
+{
+}
+
+bool GlyphCache::find(const Key& key, GlyphRecord& record, std::vector<unsigned char>& pixels) const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+
+    std::map<Key, GlyphRecord>::const_iterator itr = _records.find(key);
+    if (itr == _records.end()) return false;
+
+    record = itr->second;
+    pixels.resize(record.width * record.height);
+    const Page& page = _pages[record.page];
+    for (unsigned int row = 0; row < record.height; ++row)
+    {
+        std::memcpy(&pixels[row * record.width],
+                    &page.pixels[(record.y + row) * PAGE_SIZE + record.x],
+                    record.width);
+    }
+    return true;
+}
+
+bool GlyphCache::insert(const Key& key, const GlyphRecord& record, const unsigned char* pixels)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+
+    if (_records.find(key) != _records.end()) return true;
+
+    GlyphRecord placed = record;
+    if (!allocate(record.width, record.height, placed.page, placed.x, placed.y))
+    {
+        if (!_budgetWarned)
+        {
+            OSG_WARN << "osgQt::GlyphCache: atlas budget of " << MAX_PAGES << " pages exhausted, "
+                        "further glyphs are rasterised on every request" << std::endl;
+            _budgetWarned = true;
+        }
+        return false;
+    }
+
+    Page& page = _pages[placed.page];
+    for (unsigned int row = 0; row < placed.height; ++row)
+    {
+        std::memcpy(&page.pixels[(placed.y + row) * PAGE_SIZE + placed.x],
+                    pixels + row * placed.width,
+                    placed.width);
+    }
+    _records[key] = placed;
+    _dirty = true;
+    return true;
+}
+
+bool GlyphCache::allocate(unsigned int width, unsigned int height, unsigned int& page, unsigned int& x, unsigned int& y)
+{
+    if (width > PAGE_SIZE || height > PAGE_SIZE) return false;
+
+    // simple shelf packing on the last page: glyphs of one label run have similar heights
+    if (_pages.empty()) _pages.push_back(Page());
+
+    Page* current = &_pages.back();
+    if (current->cursorX + width > PAGE_SIZE)
+    {
+        current->shelfY += current->shelfHeight;
+        current->cursorX = 0;
+        current->shelfHeight = 0;
+    }
+    if (current->shelfY + height > PAGE_SIZE)
+    {
+        if (_pages.size() >= MAX_PAGES) return false;
+        _pages.push_back(Page());
+        current = &_pages.back();
+    }
+
+    page = static_cast<unsigned int>(_pages.size() - 1);
+    x = current->cursorX;
+    y = current->shelfY;
+    current->cursorX += width;
+    if (height > current->shelfHeight) current->shelfHeight = height;
+    return true;
+}
+
+void GlyphCache::setDirectory(const std::string& directory)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+
+    if (directory == _directory) return;
+    _directory = directory;
+    if (!_directory.empty() && _records.empty())
+    {
+        load();
+    }
+}
+
+std::string GlyphCache::getDirectory() const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+    return _directory;
+}
+
+std::string GlyphCache::cacheFileName() const
+{
+    return QDir(QString::fromStdString(_directory)).filePath(QString::fromLatin1(CACHE_FILE_NAME)).toStdString();
+}
+
+bool GlyphCache::load()
+{
+    QFile file(QString::fromStdString(cacheFileName()));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0, pageSize = 0, pageCount = 0;
+    in >> magic >> version >> pageSize >> pageCount;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || pageSize != PAGE_SIZE || pageCount > MAX_PAGES)
+    {
+        OSG_INFO << "osgQt::GlyphCache: ignoring incompatible cache " << cacheFileName() << std::endl;
+        return false;
+    }
+
+    std::vector<Page> pages(pageCount);
+    for (quint32 i = 0; i < pageCount; ++i)
+    {
+        quint32 cursorX = 0, shelfY = 0, shelfHeight = 0;
+        QByteArray compressed;
+        in >> cursorX >> shelfY >> shelfHeight >> compressed;
+        const QByteArray raw = qUncompress(compressed);
+        if (in.status() != QDataStream::Ok || raw.size() != static_cast<int>(PAGE_SIZE * PAGE_SIZE)) return false;
+
+        pages[i].cursorX = cursorX;
+        pages[i].shelfY = shelfY;
+        pages[i].shelfHeight = shelfHeight;
+        std::memcpy(&pages[i].pixels[0], raw.constData(), PAGE_SIZE * PAGE_SIZE);
+    }
+
+    quint32 recordCount = 0;
+    in >> recordCount;
+    std::map<Key, GlyphRecord> records;
+    for (quint32 i = 0; i < recordCount && in.status() == QDataStream::Ok; ++i)
+    {
+        QByteArray font;
+        quint32 pixelSize = 0, charcode = 0;
+        GlyphRecord record;
+        in >> font >> pixelSize >> charcode
+           >> record.page >> record.x >> record.y >> record.width >> record.height
+           >> record.horizontalBearingX >> record.horizontalBearingY >> record.horizontalAdvance
+           >> record.verticalBearingX >> record.verticalBearingY >> record.verticalAdvance;
+        if (record.page >= pageCount || record.x + record.width > PAGE_SIZE || record.y + record.height > PAGE_SIZE)
+        {
+            return false;
+        }
+        Key key;
+        key.font = font.toStdString();
+        key.pixelSize = pixelSize;
+        key.charcode = charcode;
+        records[key] = record;
+    }
+    if (in.status() != QDataStream::Ok) return false;
+
+    _pages.swap(pages);
+    _records.swap(records);
+    _dirty = false;
+    OSG_INFO << "osgQt::GlyphCache: loaded " << _records.size() << " glyphs in " << _pages.size()
+             << " pages from " << cacheFileName() << std::endl;
+    return true;
+}
+
+bool GlyphCache::save()
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+
+    if (!_dirty || _directory.empty()) return true;
+    if (!QDir().mkpath(QString::fromStdString(_directory))) return false;
+
+    QSaveFile file(QString::fromStdString(cacheFileName()));
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << CACHE_MAGIC << CACHE_VERSION << quint32(PAGE_SIZE) << quint32(_pages.size());
+    for (std::vector<Page>::const_iterator itr = _pages.begin(); itr != _pages.end(); ++itr)
+    {
+        // atlas pages are mostly empty, compression keeps the file at a fraction of the page budget
+        const QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(&itr->pixels[0]),
+                                                       static_cast<int>(itr->pixels.size()));
+        out << quint32(itr->cursorX) << quint32(itr->shelfY) << quint32(itr->shelfHeight) << qCompress(raw);
+    }
+    out << quint32(_records.size());
+    for (std::map<Key, GlyphRecord>::const_iterator itr = _records.begin(); itr != _records.end(); ++itr)
+    {
+        const GlyphRecord& record = itr->second;
+        out << QByteArray::fromStdString(itr->first.font) << quint32(itr->first.pixelSize) << quint32(itr->first.charcode)
+            << record.page << record.x << record.y << record.width << record.height
+            << record.horizontalBearingX << record.horizontalBearingY << record.horizontalAdvance
+            << record.verticalBearingX << record.verticalBearingY << record.verticalAdvance;
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit())
+    {
+        OSG_WARN << "osgQt::GlyphCache: failed to write " << cacheFileName() << std::endl;
+        return false;
+    }
+    _dirty = false;
+    return true;
+}
+
+void GlyphCache::clear()
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+    _pages.clear();
+    _records.clear();
+    _dirty = false;
+    _budgetWarned = false;
+}
+
+unsigned int GlyphCache::getNumPages() const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+    return static_cast<unsigned int>(_pages.size());
+}
+
+unsigned int GlyphCache::getNumGlyphs() const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_mutex);
+    return static_cast<unsigned int>(_records.size());
+}
+
+}
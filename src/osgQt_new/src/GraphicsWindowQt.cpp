@@ -12,6 +12,7 @@
 */
 
 #include <osg/DeleteHandler>
+#include <osgQt/FrameClock>
 #include <osgQt/GraphicsWindowQt>
 #include <osgViewer/ViewerBase>
 #include <QInputEvent>
@@ -19,6 +20,12 @@
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
 #include <QWindow>
 #endif
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QThread>
+#endif
 
 #if (QT_VERSION>=QT_VERSION_CHECK(4, 6, 0))
 # define USE_GESTURES
@@ -120,28 +127,6 @@ public:
 static QtKeyboardMap s_QtKeyboardMap;
 
 
-/// The object responsible for the scene re-rendering.
-class HeartBeat : public QObject {
-public:
-    int _timerId;
-    osg::Timer _lastFrameStartTime;
-    osg::observer_ptr< osgViewer::ViewerBase > _viewer;
-
-    virtual ~HeartBeat();
-
-    void init( osgViewer::ViewerBase *viewer );
-    void stopTimer();
-    void timerEvent( QTimerEvent *event );
-
-    static HeartBeat* instance();
-private:
-    HeartBeat();
-
-    static QPointer<HeartBeat> heartBeat;
-};
-
-QPointer<HeartBeat> HeartBeat::heartBeat;
-
 #if (QT_VERSION < QT_VERSION_CHECK(5, 2, 0))
     #define GETDEVICEPIXELRATIO() 1.0
 #else
@@ -151,6 +136,10 @@ QPointer<HeartBeat> HeartBeat::heartBeat;
 GLWidget::GLWidget( QWidget* parent, const QGLWidget* shareWidget, Qt::WindowFlags f, bool forwardKeyEvents )
 : QGLWidget(parent, shareWidget, f),
 _gw( NULL ),
+_deferredEvents( 0 ),
+_deferredEventsEnqueued( 0 ),
+_deferredEventsCompressed( 0 ),
+_deferredEventBatches( 0 ),
 _touchEventsEnabled( false ),
 _forwardKeyEvents( forwardKeyEvents )
 {
@@ -162,6 +151,10 @@ GLWidget::GLWidget( QGLContext* context, QWidget* parent, const QGLWidget* share
                     bool forwardKeyEvents )
 : QGLWidget(context, parent, shareWidget, f),
 _gw( NULL ),
+_deferredEvents( 0 ),
+_deferredEventsEnqueued( 0 ),
+_deferredEventsCompressed( 0 ),
+_deferredEventBatches( 0 ),
 _touchEventsEnabled( false ),
 _forwardKeyEvents( forwardKeyEvents )
 {
@@ -173,6 +166,10 @@ GLWidget::GLWidget( const QGLFormat& format, QWidget* parent, const QGLWidget* s
                     bool forwardKeyEvents )
 : QGLWidget(format, parent, shareWidget, f),
 _gw( NULL ),
+_deferredEvents( 0 ),
+_deferredEventsEnqueued( 0 ),
+_deferredEventsCompressed( 0 ),
+_deferredEventBatches( 0 ),
 _touchEventsEnabled( false ),
 _forwardKeyEvents( forwardKeyEvents )
 {
@@ -210,23 +207,119 @@ void GLWidget::setTouchEventsEnabled(bool e)
 #endif
 }
 
-void GLWidget::processDeferredEvents()
+// deferred event types by their 4 bit code, 0 marks an empty slot of the packed queue
+static const QEvent::Type s_deferredEventTypes[] = { QEvent::None, QEvent::Hide, QEvent::Show, QEvent::ParentChange };
+static const unsigned int s_numDeferredEventTypes = sizeof(s_deferredEventTypes) / sizeof(s_deferredEventTypes[0]);
+static const unsigned int s_deferredEventBits = 4;
+static const unsigned int s_deferredEventMask = (1u << s_deferredEventBits) - 1u;
+
+static unsigned int deferredEventCode( QEvent::Type type )
+{
+    for (unsigned int code = 1; code < s_numDeferredEventTypes; ++code)
+    {
+        if (s_deferredEventTypes[code] == type) return code;
+    }
+    return 0;
+}
+
+static bool containsDeferredEvent( unsigned int queue, unsigned int code )
+{
+    for (; queue != 0; queue >>= s_deferredEventBits)
+    {
+        if ((queue & s_deferredEventMask) == code) return true;
+    }
+    return false;
+}
+
+static unsigned int removeDeferredEvent( unsigned int queue, unsigned int code )
+{
+    unsigned int result = 0;
+    unsigned int shift = 0;
+    for (; queue != 0; queue >>= s_deferredEventBits)
+    {
+        const unsigned int current = queue & s_deferredEventMask;
+        if (current == code) continue;
+        result |= current << shift;
+        shift += s_deferredEventBits;
+    }
+    return result;
+}
+
+static unsigned int appendDeferredEvent( unsigned int queue, unsigned int code )
+{
+    unsigned int shift = 0;
+    while ((queue >> shift) != 0) shift += s_deferredEventBits;
+    return queue | (code << shift);
+}
+
+int GLWidget::getNumDeferredEvents() const
+{
+    int count = 0;
+    for (unsigned int queue = _deferredEvents.load(std::memory_order_acquire); queue != 0; queue >>= s_deferredEventBits)
+    {
+        ++count;
+    }
+    return count;
+}
+
+void GLWidget::enqueueDeferredEvent( QEvent::Type eventType, QEvent::Type removeEventType )
 {
-    QQueue<QEvent::Type> deferredEventQueueCopy;
+    const unsigned int code = deferredEventCode(eventType);
+    if (code == 0)
+    {
+        OSG_WARN<<"GLWidget: event type "<<eventType<<" cannot be deferred."<<std::endl;
+        return;
+    }
+    const unsigned int removeCode = deferredEventCode(removeEventType);
+
+    _deferredEventsEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+    unsigned int current = _deferredEvents.load(std::memory_order_relaxed);
+    unsigned int next;
+    bool compressed;
+    do
     {
-        QMutexLocker lock(&_deferredEventQueueMutex);
-        deferredEventQueueCopy = _deferredEventQueue;
-        _eventCompressor.clear();
-        _deferredEventQueue.clear();
+        next = current;
+        compressed = false;
+
+        // the opposite event is cancelled, this one moves to the end of the queue
+        if (removeCode != 0 && containsDeferredEvent(next, removeCode))
+        {
+            next = removeDeferredEvent(removeDeferredEvent(next, removeCode), code);
+            compressed = true;
+        }
+
+        if (containsDeferredEvent(next, code)) compressed = true;
+        else next = appendDeferredEvent(next, code);
     }
+    while (!_deferredEvents.compare_exchange_weak(current, next, std::memory_order_release, std::memory_order_relaxed));
+
+    if (compressed) _deferredEventsCompressed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GLWidget::processDeferredEvents()
+{
+    unsigned int queue = _deferredEvents.exchange(0, std::memory_order_acquire);
+    if (queue == 0) return;
 
-    while (!deferredEventQueueCopy.isEmpty())
+    _deferredEventBatches.fetch_add(1, std::memory_order_relaxed);
+
+    for (; queue != 0; queue >>= s_deferredEventBits)
     {
-        QEvent event(deferredEventQueueCopy.dequeue());
+        QEvent event(s_deferredEventTypes[queue & s_deferredEventMask]);
         QGLWidget::event(&event);
     }
 }
 
+GLWidget::DeferredEventStatistics GLWidget::getDeferredEventStatistics() const
+{
+    DeferredEventStatistics statistics;
+    statistics.enqueued = _deferredEventsEnqueued.load(std::memory_order_relaxed);
+    statistics.compressed = _deferredEventsCompressed.load(std::memory_order_relaxed);
+    statistics.batches = _deferredEventBatches.load(std::memory_order_relaxed);
+    return statistics;
+}
+
 bool GLWidget::event( QEvent* event )
 {
 #ifdef USE_GESTURES
@@ -275,6 +368,26 @@ bool GLWidget::event( QEvent* event )
         return true;
     }
 
+    // input wakes an idle frame clock; what arrives before its next tick goes into one frame
+    switch (event->type())
+    {
+        case QEvent::KeyPress:
+        case QEvent::KeyRelease:
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::MouseButtonDblClick:
+        case QEvent::MouseMove:
+        case QEvent::Wheel:
+        case QEvent::TouchBegin:
+        case QEvent::TouchUpdate:
+        case QEvent::TouchEnd:
+        case QEvent::Resize:
+            FrameClock::instance()->requestFrame();
+            break;
+        default:
+            break;
+    }
+
     // perform regular event handling
     return QGLWidget::event( event );
 }
@@ -316,6 +429,7 @@ void GLWidget::glDraw()
 
 void GLWidget::keyPressEvent( QKeyEvent* event )
 {
+    _motionCoalescer.flush( _gw->getEventQueue() );
     setKeyboardModifiers( event );
     int value = s_QtKeyboardMap.remapKey( event );
     _gw->getEventQueue()->keyPress( value );
@@ -334,6 +448,7 @@ void GLWidget::keyReleaseEvent( QKeyEvent* event )
     }
     else
     {
+        _motionCoalescer.flush( _gw->getEventQueue() );
         setKeyboardModifiers( event );
         int value = s_QtKeyboardMap.remapKey( event );
         _gw->getEventQueue()->keyRelease( value );
@@ -347,6 +462,7 @@ void GLWidget::keyReleaseEvent( QKeyEvent* event )
 
 void GLWidget::mousePressEvent( QMouseEvent* event )
 {
+    _motionCoalescer.flush( _gw->getEventQueue() );
     if (!hasFocus())
         setFocus(Qt::MouseFocusReason);
 
@@ -365,6 +481,7 @@ void GLWidget::mousePressEvent( QMouseEvent* event )
 
 void GLWidget::mouseReleaseEvent( QMouseEvent* event )
 {
+    _motionCoalescer.flush( _gw->getEventQueue() );
     int button = 0;
     switch ( event->button() )
     {
@@ -380,6 +497,7 @@ void GLWidget::mouseReleaseEvent( QMouseEvent* event )
 
 void GLWidget::mouseDoubleClickEvent( QMouseEvent* event )
 {
+    _motionCoalescer.flush( _gw->getEventQueue() );
     int button = 0;
     switch ( event->button() )
     {
@@ -396,11 +514,12 @@ void GLWidget::mouseDoubleClickEvent( QMouseEvent* event )
 void GLWidget::mouseMoveEvent( QMouseEvent* event )
 {
     setKeyboardModifiers( event );
-    _gw->getEventQueue()->mouseMotion( event->x()*_devicePixelRatio, event->y()*_devicePixelRatio );
+    _motionCoalescer.motion( _gw->getEventQueue(), event->x()*_devicePixelRatio, event->y()*_devicePixelRatio );
 }
 
 void GLWidget::wheelEvent( QWheelEvent* event )
 {
+    _motionCoalescer.flush( _gw->getEventQueue() );
     setKeyboardModifiers( event );
     _gw->getEventQueue()->mouseScroll(
         event->orientation() == Qt::Vertical ?
@@ -439,6 +558,8 @@ bool GLWidget::gestureEvent( QGestureEvent* qevent )
     return false;
 #else
 
+    _motionCoalescer.flush( _gw->getEventQueue() );
+
     bool accept = false;
 
     if ( QPinchGesture* pinch = static_cast<QPinchGesture *>(qevent->gesture(Qt::PinchGesture) ) )
@@ -843,7 +964,7 @@ void GraphicsWindowQt::runOperations()
 {
     // While in graphics thread this is last chance to do something useful before
     // graphics thread will execute its operations.
-    if (_widget->getNumDeferredEvents() > 0)
+    if (_widget->hasDeferredEvents())
         _widget->processDeferredEvents();
 
     if (QGLContext::currentContext() != _widget->context())
@@ -854,7 +975,7 @@ void GraphicsWindowQt::runOperations()
 
 bool GraphicsWindowQt::makeCurrentImplementation()
 {
-    if (_widget->getNumDeferredEvents() > 0)
+    if (_widget->hasDeferredEvents())
         _widget->processDeferredEvents();
 
     _widget->makeCurrent();
@@ -877,7 +998,7 @@ void GraphicsWindowQt::swapBuffersImplementation()
     {
         if(!window->isExposed())
         {
-            if (_widget->getNumDeferredEvents() > 0)
+            if (_widget->hasDeferredEvents())
                 _widget->processDeferredEvents();
             return;
         }
@@ -890,7 +1011,7 @@ void GraphicsWindowQt::swapBuffersImplementation()
     // I couln't find any reliable way to do this. For now, lets hope non of *GUI thread only operations* will
     // be executed in a QGLWidget::event handler. On the other hand, calling GUI only operations in the
     // QGLWidget event handler is an indication of a Qt bug.
-    if (_widget->getNumDeferredEvents() > 0)
+    if (_widget->hasDeferredEvents())
         _widget->processDeferredEvents();
 
     // We need to call makeCurrent here to restore our previously current context
@@ -899,202 +1020,817 @@ void GraphicsWindowQt::swapBuffersImplementation()
         _widget->makeCurrent();
 }
 
+bool GraphicsWindowQt::checkEvents()
+{
+    if ( _widget )
+        _widget->getMotionCoalescer().flush( getEventQueue() );
+    return osgViewer::GraphicsWindow::checkEvents();
+}
+
 void GraphicsWindowQt::requestWarpPointer( float x, float y )
 {
     if ( _widget )
         QCursor::setPos( _widget->mapToGlobal(QPoint((int)x,(int)y)) );
 }
 
-class QtWindowingSystem : public osg::GraphicsContext::WindowingSystemInterface
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+
+PixelBufferQt::PixelBufferQt( osg::GraphicsContext::Traits* traits )
+:   _surface( NULL ),
+    _context( NULL ),
+    _realized( false )
 {
-public:
+    _traits = traits;
 
-    QtWindowingSystem()
+    // QOffscreenSurface::create() is only allowed in the main thread
+    _surface = new QOffscreenSurface;
+    _surface->setFormat( traits2qsurfaceFormat( traits ) );
+    _surface->create();
+    if ( !_surface->isValid() )
     {
-        OSG_INFO << "QtWindowingSystemInterface()" << std::endl;
+        OSG_WARN << "osgQt: PixelBufferQt - unable to create offscreen surface." << std::endl;
+        return;
     }
 
-    ~QtWindowingSystem()
-    {
-        if (osg::Referenced::getDeleteHandler())
-        {
-            osg::Referenced::getDeleteHandler()->setNumFramesToRetainObjects(0);
-            osg::Referenced::getDeleteHandler()->flushAll();
-        }
-    }
+    // initialize State
+    setState( new osg::State );
+    getState()->setGraphicsContext(this);
 
-    // Access the Qt windowing system through this singleton class.
-    static QtWindowingSystem* getInterface()
+    // initialize contextID
+    if ( _traits.valid() && _traits->sharedContext.valid() )
     {
-        static QtWindowingSystem* qtInterface = new QtWindowingSystem;
-        return qtInterface;
+        getState()->setContextID( _traits->sharedContext->getState()->getContextID() );
+        incrementContextIDUsageCount( getState()->getContextID() );
     }
-
-    // Return the number of screens present in the system
-    virtual unsigned int getNumScreens( const osg::GraphicsContext::ScreenIdentifier& /*si*/ )
+    else
     {
-        OSG_WARN << "osgQt: getNumScreens() not implemented yet." << std::endl;
-        return 0;
+        getState()->setContextID( osg::GraphicsContext::createNewContextID() );
     }
+}
 
-    // Return the resolution of specified screen
-    // (0,0) is returned if screen is unknown
-    virtual void getScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*si*/, osg::GraphicsContext::ScreenSettings & /*resolution*/ )
-    {
-        OSG_WARN << "osgQt: getScreenSettings() not implemented yet." << std::endl;
-    }
+PixelBufferQt::~PixelBufferQt()
+{
+    close(true);
 
-    // Set the resolution for given screen
-    virtual bool setScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*si*/, const osg::GraphicsContext::ScreenSettings & /*resolution*/ )
-    {
-        OSG_WARN << "osgQt: setScreenSettings() not implemented yet." << std::endl;
+    delete _surface;
+    _surface = NULL;
+}
+
+QSurfaceFormat PixelBufferQt::traits2qsurfaceFormat( const osg::GraphicsContext::Traits* traits )
+{
+    QSurfaceFormat format( QSurfaceFormat::defaultFormat() );
+
+    format.setAlphaBufferSize( traits->alpha );
+    format.setRedBufferSize( traits->red );
+    format.setGreenBufferSize( traits->green );
+    format.setBlueBufferSize( traits->blue );
+    format.setDepthBufferSize( traits->depth );
+    format.setStencilBufferSize( traits->stencil );
+    format.setSamples( traits->sampleBuffers ? static_cast<int>(traits->samples) : 0 );
+    format.setSwapBehavior( QSurfaceFormat::SingleBuffer );
+    format.setSwapInterval( 0 );
+    format.setVersion( 2, 1 );
+    format.setProfile( QSurfaceFormat::CompatibilityProfile );
+    format.setOption( QSurfaceFormat::DeprecatedFunctions );
+
+    return format;
+}
+
+bool PixelBufferQt::valid() const
+{
+    return _surface && _surface->isValid();
+}
+
+bool PixelBufferQt::realizeImplementation()
+{
+    if ( _realized )
+        return true;
+
+    if ( !valid() )
         return false;
-    }
 
-    // Enumerates available resolutions
-    virtual void enumerateScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*screenIdentifier*/, osg::GraphicsContext::ScreenSettingsList & /*resolution*/ )
+    if ( !_context )
     {
-        OSG_WARN << "osgQt: enumerateScreenSettings() not implemented yet." << std::endl;
-    }
+        // created in the calling thread, which owns the context from now on
+        _context = new QOpenGLContext;
+        _context->setFormat( _surface->requestedFormat() );
 
-    // Create a graphics context with given traits
-    virtual osg::GraphicsContext* createGraphicsContext( osg::GraphicsContext::Traits* traits )
-    {
-        if (traits->pbuffer)
+        if ( _traits.valid() && _traits->sharedContext.valid() )
         {
-            OSG_WARN << "osgQt: createGraphicsContext - pbuffer not implemented yet." << std::endl;
-            return NULL;
+            if ( PixelBufferQt* shared = dynamic_cast<PixelBufferQt*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( shared->getQOpenGLContext() );
+            else if ( GraphicsWindowQt* window = dynamic_cast<GraphicsWindowQt*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( window->getGLWidget() ? window->getGLWidget()->context()->contextHandle() : NULL );
+            else if ( GraphicsWindowQWindow* window = dynamic_cast<GraphicsWindowQWindow*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( window->getQOpenGLContext() );
         }
-        else
+
+        if ( !_context->create() )
         {
-            osg::ref_ptr< GraphicsWindowQt > window = new GraphicsWindowQt( traits );
-            if (window->valid()) return window.release();
-            else return NULL;
+            OSG_WARN << "osgQt: PixelBufferQt - unable to create OpenGL context." << std::endl;
+            delete _context;
+            _context = NULL;
+            return false;
         }
     }
 
-private:
-
-    // No implementation for these
-    QtWindowingSystem( const QtWindowingSystem& );
-    QtWindowingSystem& operator=( const QtWindowingSystem& );
-};
+    // make sure the context can be made current on the surface
+    if ( !_context->makeCurrent( _surface ) )
+    {
+        OSG_WARN << "PixelBuffer realize: Can not make context current." << std::endl;
+        return false;
+    }
+    _context->doneCurrent();
 
-#if 1
-REGISTER_WINDOWINGSYSTEMINTERFACE(Qt, QtWindowingSystem)
-#else
+    _realized = true;
+    return true;
+}
 
-// declare C entry point for static compilation.
-extern "C" void OSGQT_EXPORT graphicswindow_Qt(void)
+bool PixelBufferQt::isRealizedImplementation() const
 {
-    osg::GraphicsContext::setWindowingSystemInterface(QtWindowingSystem::getInterface());
+    return _realized;
 }
 
+void PixelBufferQt::closeImplementation()
+{
+    // the context belongs to the thread that realized it, so drop it here
+    // rather than in the destructor which may run in any thread
+    if ( _context )
+    {
+        if ( QOpenGLContext::currentContext() == _context )
+            _context->doneCurrent();
+        delete _context;
+        _context = NULL;
+    }
+    _realized = false;
+}
 
-void osgQt::initQtWindowingSystem()
+bool PixelBufferQt::makeCurrentImplementation()
 {
-    graphicswindow_Qt();
+    if ( !_realized || !_context )
+        return false;
+
+    return _context->makeCurrent( _surface );
 }
-#endif
 
+bool PixelBufferQt::makeContextCurrentImplementation( osg::GraphicsContext* /*readContext*/ )
+{
+    // Qt has no separate read surface, reads come from the bound FBO
+    return makeCurrentImplementation();
+}
 
-void osgQt::setViewer( osgViewer::ViewerBase *viewer )
+bool PixelBufferQt::releaseContextImplementation()
 {
-    HeartBeat::instance()->init( viewer );
+    if ( _context )
+        _context->doneCurrent();
+    return true;
 }
 
+void PixelBufferQt::bindPBufferToTextureImplementation( GLenum /*buffer*/ )
+{
+    OSG_WARN << "osgQt: PixelBufferQt::bindPBufferToTextureImplementation() not implemented, render to an FBO instead." << std::endl;
+}
 
-/// Constructor. Must be called from main thread.
-HeartBeat::HeartBeat() : _timerId( 0 )
+void PixelBufferQt::swapBuffersImplementation()
 {
+    // single buffered: just make sure the commands reach the driver
+    if ( _context && QOpenGLContext::currentContext() == _context )
+        _context->functions()->glFlush();
 }
 
+static int qtMouseButton( Qt::MouseButton button )
+{
+    switch ( button )
+    {
+        case Qt::LeftButton: return 1;
+        case Qt::MidButton: return 2;
+        case Qt::RightButton: return 3;
+        default: return 0;
+    }
+}
 
-/// Destructor. Must be called from main thread.
-HeartBeat::~HeartBeat()
+GLWindow::GLWindow( QWindow* parent )
+: QWindow(parent),
+_gw( NULL ),
+_forwardKeyEvents( false )
 {
-    stopTimer();
+    setSurfaceType( QSurface::OpenGLSurface );
 }
 
-HeartBeat* HeartBeat::instance()
+GLWindow::~GLWindow()
 {
-    if (!heartBeat)
+    // remove the reference to us and close GraphicsWindowQWindow
+    if( _gw )
     {
-        heartBeat = new HeartBeat();
+        _gw->_window = NULL;
+        _gw->_container = NULL;
+        _gw->close();
+        _gw = NULL;
     }
-    return heartBeat;
 }
 
-void HeartBeat::stopTimer()
+bool GLWindow::event( QEvent* event )
 {
-    if ( _timerId != 0 )
+    // input wakes an idle frame clock, the same as for GLWidget
+    switch (event->type())
     {
-        killTimer( _timerId );
-        _timerId = 0;
+        case QEvent::KeyPress:
+        case QEvent::KeyRelease:
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::MouseButtonDblClick:
+        case QEvent::MouseMove:
+        case QEvent::Wheel:
+        case QEvent::TouchBegin:
+        case QEvent::TouchUpdate:
+        case QEvent::TouchEnd:
+        case QEvent::Resize:
+        case QEvent::Expose:
+            FrameClock::instance()->requestFrame();
+            break;
+        default:
+            break;
     }
+
+    return QWindow::event( event );
 }
 
+void GLWindow::setKeyboardModifiers( QInputEvent* event )
+{
+    int modkey = event->modifiers() & (Qt::ShiftModifier | Qt::ControlModifier | Qt::AltModifier);
+    unsigned int mask = 0;
+    if ( modkey & Qt::ShiftModifier ) mask |= osgGA::GUIEventAdapter::MODKEY_SHIFT;
+    if ( modkey & Qt::ControlModifier ) mask |= osgGA::GUIEventAdapter::MODKEY_CTRL;
+    if ( modkey & Qt::AltModifier ) mask |= osgGA::GUIEventAdapter::MODKEY_ALT;
+    _gw->getEventQueue()->getCurrentEventState()->setModKeyMask( mask );
+}
 
-/// Initializes the loop for viewer. Must be called from main thread.
-void HeartBeat::init( osgViewer::ViewerBase *viewer )
+void GLWindow::exposeEvent( QExposeEvent* /*event*/ )
 {
-    if( _viewer == viewer )
-        return;
+    if ( _gw && isExposed() )
+        _gw->requestRedraw();
+}
 
-    stopTimer();
+void GLWindow::resizeEvent( QResizeEvent* event )
+{
+    if ( !_gw ) return;
 
-    _viewer = viewer;
+    const QSize& size = event->size();
+    const qreal ratio = devicePixelRatio();
 
-    if( viewer )
-    {
-        _timerId = startTimer( 0 );
-        _lastFrameStartTime.setStartTick( 0 );
-    }
+    int scaled_width = static_cast<int>(size.width()*ratio);
+    int scaled_height = static_cast<int>(size.height()*ratio);
+    _gw->resized( x(), y(), scaled_width, scaled_height );
+    _gw->getEventQueue()->windowResize( x(), y(), scaled_width, scaled_height );
+    _gw->requestRedraw();
 }
 
+void GLWindow::keyPressEvent( QKeyEvent* event )
+{
+    if ( !_gw ) return;
+
+    _motionCoalescer.flush( _gw->getEventQueue() );
+    setKeyboardModifiers( event );
+    int value = s_QtKeyboardMap.remapKey( event );
+    _gw->getEventQueue()->keyPress( value );
+
+    // unaccepted, the key goes on to the window container and its parent widgets
+    if( _forwardKeyEvents )
+        event->ignore();
+}
 
-void HeartBeat::timerEvent( QTimerEvent * /*event*/ )
+void GLWindow::keyReleaseEvent( QKeyEvent* event )
 {
-    osg::ref_ptr< osgViewer::ViewerBase > viewer;
-    if( !_viewer.lock( viewer ) )
-    {
-        // viewer has been deleted -> stop timer
-        stopTimer();
-        return;
-    }
+    if ( !_gw ) return;
 
-    // limit the frame rate
-    if( viewer->getRunMaxFrameRate() > 0.0)
+    if( !event->isAutoRepeat() )
     {
-        double dt = _lastFrameStartTime.time_s();
-        double minFrameTime = 1.0 / viewer->getRunMaxFrameRate();
-        if (dt < minFrameTime)
-            OpenThreads::Thread::microSleep(static_cast<unsigned int>(1000000.0*(minFrameTime-dt)));
+        _motionCoalescer.flush( _gw->getEventQueue() );
+        setKeyboardModifiers( event );
+        int value = s_QtKeyboardMap.remapKey( event );
+        _gw->getEventQueue()->keyRelease( value );
     }
-    else
-    {
-        // avoid excessive CPU loading when no frame is required in ON_DEMAND mode
-        if( viewer->getRunFrameScheme() == osgViewer::ViewerBase::ON_DEMAND )
-        {
-            double dt = _lastFrameStartTime.time_s();
-            if (dt < 0.01)
-                OpenThreads::Thread::microSleep(static_cast<unsigned int>(1000000.0*(0.01-dt)));
-        }
 
-        // record start frame time
-        _lastFrameStartTime.setStartTick();
+    if( _forwardKeyEvents || event->isAutoRepeat() )
+        event->ignore();
+}
 
-        // make frame
-        if( viewer->getRunFrameScheme() == osgViewer::ViewerBase::ON_DEMAND )
-        {
-            if( viewer->checkNeedToDoFrame() )
-            {
-                viewer->frame();
-            }
-        }
-        else
-        {
-            viewer->frame();
-        }
-    }
+void GLWindow::mousePressEvent( QMouseEvent* event )
+{
+    if ( !_gw ) return;
+
+    _motionCoalescer.flush( _gw->getEventQueue() );
+
+    if ( _gw->_container && !_gw->_container->hasFocus() )
+        _gw->_container->setFocus( Qt::MouseFocusReason );
+
+    const qreal ratio = devicePixelRatio();
+    setKeyboardModifiers( event );
+    _gw->getEventQueue()->mouseButtonPress( event->x()*ratio, event->y()*ratio, qtMouseButton( event->button() ) );
+}
+
+void GLWindow::mouseReleaseEvent( QMouseEvent* event )
+{
+    if ( !_gw ) return;
+
+    _motionCoalescer.flush( _gw->getEventQueue() );
+    const qreal ratio = devicePixelRatio();
+    setKeyboardModifiers( event );
+    _gw->getEventQueue()->mouseButtonRelease( event->x()*ratio, event->y()*ratio, qtMouseButton( event->button() ) );
+}
+
+void GLWindow::mouseDoubleClickEvent( QMouseEvent* event )
+{
+    if ( !_gw ) return;
+
+    _motionCoalescer.flush( _gw->getEventQueue() );
+    const qreal ratio = devicePixelRatio();
+    setKeyboardModifiers( event );
+    _gw->getEventQueue()->mouseDoubleButtonPress( event->x()*ratio, event->y()*ratio, qtMouseButton( event->button() ) );
+}
+
+void GLWindow::mouseMoveEvent( QMouseEvent* event )
+{
+    if ( !_gw ) return;
+
+    const qreal ratio = devicePixelRatio();
+    setKeyboardModifiers( event );
+    _motionCoalescer.motion( _gw->getEventQueue(), event->x()*ratio, event->y()*ratio );
+}
+
+void GLWindow::wheelEvent( QWheelEvent* event )
+{
+    if ( !_gw ) return;
+
+    _motionCoalescer.flush( _gw->getEventQueue() );
+    setKeyboardModifiers( event );
+    _gw->getEventQueue()->mouseScroll(
+        event->orientation() == Qt::Vertical ?
+            (event->delta()>0 ? osgGA::GUIEventAdapter::SCROLL_UP : osgGA::GUIEventAdapter::SCROLL_DOWN) :
+            (event->delta()>0 ? osgGA::GUIEventAdapter::SCROLL_LEFT : osgGA::GUIEventAdapter::SCROLL_RIGHT) );
+}
+
+
+
+GraphicsWindowQWindow::GraphicsWindowQWindow( osg::GraphicsContext::Traits* traits, QWidget* parent )
+:   _window( NULL ),
+    _container( NULL ),
+    _context( NULL ),
+    _realized( false )
+{
+    _traits = traits;
+
+    WindowData* windowData = _traits.valid() ? dynamic_cast<WindowData*>(_traits->inheritedWindowData.get()) : 0;
+    if ( !parent )
+        parent = windowData ? windowData->_parent : NULL;
+
+    _window = new GLWindow;
+    _window->setFormat( traits2qsurfaceFormat( _traits.get() ) );
+    _window->setGraphicsWindow( this );
+    _window->setTitle( _traits->windowName.c_str() );
+
+    if ( parent )
+    {
+        // the container owns the window from now on and deletes it with itself
+        _container = QWidget::createWindowContainer( _window, parent );
+        _container->setFocusPolicy( Qt::StrongFocus );
+        _container->setMouseTracking( true );
+        _container->resize( _traits->width, _traits->height );
+    }
+    else
+    {
+        setWindowDecorationImplementation( _traits->windowDecoration );
+        _window->setGeometry( _traits->x, _traits->y, _traits->width, _traits->height );
+    }
+
+    // the native window has to exist before a context can be made current on it
+    _window->create();
+    useCursor( _traits->useCursor );
+
+    // initialize State
+    setState( new osg::State );
+    getState()->setGraphicsContext(this);
+
+    // initialize contextID
+    if ( _traits.valid() && _traits->sharedContext.valid() )
+    {
+        getState()->setContextID( _traits->sharedContext->getState()->getContextID() );
+        incrementContextIDUsageCount( getState()->getContextID() );
+    }
+    else
+    {
+        getState()->setContextID( osg::GraphicsContext::createNewContextID() );
+    }
+
+    // make sure the event queue has the correct window rectangle size and input range
+    getEventQueue()->syncWindowRectangleWithGraphicsContext();
+}
+
+GraphicsWindowQWindow::~GraphicsWindowQWindow()
+{
+    close();
+
+    // remove reference from GLWindow, a top level window is ours to delete
+    if ( _window )
+    {
+        _window->_gw = NULL;
+        if ( !_container )
+            delete _window;
+        _window = NULL;
+    }
+}
+
+QSurfaceFormat GraphicsWindowQWindow::traits2qsurfaceFormat( const osg::GraphicsContext::Traits* traits )
+{
+    QSurfaceFormat format( PixelBufferQt::traits2qsurfaceFormat( traits ) );
+
+    format.setSwapBehavior( traits->doubleBuffer ? QSurfaceFormat::DoubleBuffer : QSurfaceFormat::SingleBuffer );
+    format.setSwapInterval( traits->vsync ? 1 : 0 );
+    format.setStereo( traits->quadBufferStereo );
+
+    return format;
+}
+
+bool GraphicsWindowQWindow::setWindowRectangleImplementation( int x, int y, int width, int height )
+{
+    if ( _container )
+        _container->setGeometry( x, y, width, height );
+    else if ( _window )
+        _window->setGeometry( x, y, width, height );
+    else
+        return false;
+
+    return true;
+}
+
+void GraphicsWindowQWindow::getWindowRectangle( int& x, int& y, int& width, int& height )
+{
+    if ( _window )
+    {
+        const QRect& geom = _container ? _container->geometry() : _window->geometry();
+        x = geom.x();
+        y = geom.y();
+        width = geom.width();
+        height = geom.height();
+    }
+}
+
+bool GraphicsWindowQWindow::setWindowDecorationImplementation( bool windowDecoration )
+{
+    _traits->windowDecoration = windowDecoration;
+
+    // an embedded window has no decoration of its own
+    if ( !_window || _container )
+        return false;
+
+    Qt::WindowFlags flags = Qt::Window|Qt::CustomizeWindowHint;
+    if ( windowDecoration )
+        flags |= Qt::WindowTitleHint|Qt::WindowMinMaxButtonsHint|Qt::WindowSystemMenuHint|Qt::WindowCloseButtonHint;
+    _window->setFlags( flags );
+
+    return true;
+}
+
+bool GraphicsWindowQWindow::getWindowDecoration() const
+{
+    return _traits->windowDecoration;
+}
+
+void GraphicsWindowQWindow::grabFocus()
+{
+    if ( _container )
+        _container->setFocus( Qt::ActiveWindowFocusReason );
+    else if ( _window )
+        _window->requestActivate();
+}
+
+void GraphicsWindowQWindow::grabFocusIfPointerInWindow()
+{
+    if ( _window && QRect( QPoint(), _window->size() ).contains( _window->mapFromGlobal( QCursor::pos() ) ) )
+        grabFocus();
+}
+
+void GraphicsWindowQWindow::raiseWindow()
+{
+    if ( _container )
+        _container->raise();
+    else if ( _window )
+        _window->raise();
+}
+
+void GraphicsWindowQWindow::setWindowName( const std::string& name )
+{
+    if ( _window )
+        _window->setTitle( name.c_str() );
+}
+
+std::string GraphicsWindowQWindow::getWindowName()
+{
+    return _window ? _window->title().toStdString() : "";
+}
+
+void GraphicsWindowQWindow::useCursor( bool cursorOn )
+{
+    if ( _window )
+    {
+        _traits->useCursor = cursorOn;
+        if ( !cursorOn ) _window->setCursor( Qt::BlankCursor );
+        else _window->setCursor( _currentCursor );
+    }
+}
+
+void GraphicsWindowQWindow::setCursor( MouseCursor cursor )
+{
+    if ( cursor==InheritCursor && _window )
+    {
+        _window->unsetCursor();
+    }
+
+    switch ( cursor )
+    {
+    case NoCursor: _currentCursor = Qt::BlankCursor; break;
+    case RightArrowCursor: case LeftArrowCursor: _currentCursor = Qt::ArrowCursor; break;
+    case InfoCursor: _currentCursor = Qt::SizeAllCursor; break;
+    case DestroyCursor: _currentCursor = Qt::ForbiddenCursor; break;
+    case HelpCursor: _currentCursor = Qt::WhatsThisCursor; break;
+    case CycleCursor: _currentCursor = Qt::ForbiddenCursor; break;
+    case SprayCursor: _currentCursor = Qt::SizeAllCursor; break;
+    case WaitCursor: _currentCursor = Qt::WaitCursor; break;
+    case TextCursor: _currentCursor = Qt::IBeamCursor; break;
+    case CrosshairCursor: _currentCursor = Qt::CrossCursor; break;
+    case HandCursor: _currentCursor = Qt::OpenHandCursor; break;
+    case UpDownCursor: _currentCursor = Qt::SizeVerCursor; break;
+    case LeftRightCursor: _currentCursor = Qt::SizeHorCursor; break;
+    case TopSideCursor: case BottomSideCursor: _currentCursor = Qt::UpArrowCursor; break;
+    case LeftSideCursor: case RightSideCursor: _currentCursor = Qt::SizeHorCursor; break;
+    case TopLeftCorner: _currentCursor = Qt::SizeBDiagCursor; break;
+    case TopRightCorner: _currentCursor = Qt::SizeFDiagCursor; break;
+    case BottomRightCorner: _currentCursor = Qt::SizeBDiagCursor; break;
+    case BottomLeftCorner: _currentCursor = Qt::SizeFDiagCursor; break;
+    default: break;
+    };
+    if ( _window ) _window->setCursor( _currentCursor );
+}
+
+bool GraphicsWindowQWindow::valid() const
+{
+    return _window && _window->handle();
+}
+
+bool GraphicsWindowQWindow::realizeImplementation()
+{
+    if ( _realized )
+        return true;
+
+    if ( !valid() )
+        return false;
+
+    if ( !_context )
+    {
+        _context = new QOpenGLContext;
+        _context->setFormat( _window->requestedFormat() );
+
+        if ( _traits.valid() && _traits->sharedContext.valid() )
+        {
+            if ( GraphicsWindowQWindow* shared = dynamic_cast<GraphicsWindowQWindow*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( shared->getQOpenGLContext() );
+            else if ( PixelBufferQt* pbuffer = dynamic_cast<PixelBufferQt*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( pbuffer->getQOpenGLContext() );
+            else if ( GraphicsWindowQt* window = dynamic_cast<GraphicsWindowQt*>( _traits->sharedContext.get() ) )
+                _context->setShareContext( window->getGLWidget() ? window->getGLWidget()->context()->contextHandle() : NULL );
+        }
+
+        if ( !_context->create() )
+        {
+            OSG_WARN << "osgQt: GraphicsWindowQWindow - unable to create OpenGL context." << std::endl;
+            delete _context;
+            _context = NULL;
+            return false;
+        }
+
+        if ( !_context->supportsThreadedOpenGL() )
+            OSG_INFO << "osgQt: GraphicsWindowQWindow - the platform does not support threaded OpenGL, keep the viewer single threaded." << std::endl;
+    }
+
+    // save the current context
+    QOpenGLContext* savedContext = QOpenGLContext::currentContext();
+    QSurface* savedSurface = savedContext ? savedContext->surface() : NULL;
+
+    _realized = true;
+    bool result = makeCurrent();
+    if ( !result )
+    {
+        _realized = false;
+        if ( savedContext )
+            savedContext->makeCurrent( savedSurface );
+
+        OSG_WARN << "Window realize: Can make context current." << std::endl;
+        return false;
+    }
+
+    // make sure the event queue has the correct window rectangle size and input range
+    getEventQueue()->syncWindowRectangleWithGraphicsContext();
+
+    // the context is probably made current from another thread next
+    if( !releaseContext() )
+        OSG_WARN << "Window realize: Can not release context." << std::endl;
+
+    // restore previous context
+    if ( savedContext )
+        savedContext->makeCurrent( savedSurface );
+
+    return true;
+}
+
+bool GraphicsWindowQWindow::isRealizedImplementation() const
+{
+    return _realized;
+}
+
+void GraphicsWindowQWindow::closeImplementation()
+{
+    if ( _context )
+    {
+        if ( QOpenGLContext::currentContext() == _context )
+            _context->doneCurrent();
+        delete _context;
+        _context = NULL;
+    }
+
+    // an embedded window goes with its container, only a top level window is closed here
+    if ( _window && !_container )
+        _window->close();
+    _realized = false;
+}
+
+bool GraphicsWindowQWindow::makeCurrentImplementation()
+{
+    if ( !_realized || !_context || !_window )
+        return false;
+
+    // a released context has no thread affinity and can be pulled into whichever thread renders next
+    QThread* currentThread = QThread::currentThread();
+    if ( _context->thread() != currentThread )
+    {
+        if ( _context->thread() != NULL )
+        {
+            OSG_WARN << "osgQt: GraphicsWindowQWindow - context is still bound to another thread." << std::endl;
+            return false;
+        }
+        _context->moveToThread( currentThread );
+    }
+
+    return _context->makeCurrent( _window );
+}
+
+bool GraphicsWindowQWindow::releaseContextImplementation()
+{
+    if ( !_context )
+        return true;
+
+    _context->doneCurrent();
+
+    // only the owning thread may push an object away, so it lets go of the context here
+    if ( _context->thread() == QThread::currentThread() )
+        _context->moveToThread( NULL );
+
+    return true;
+}
+
+void GraphicsWindowQWindow::swapBuffersImplementation()
+{
+    if ( !_context || !_window || !_window->isExposed() )
+        return;
+
+    _context->swapBuffers( _window );
+}
+
+bool GraphicsWindowQWindow::checkEvents()
+{
+    if ( _window )
+        _window->getMotionCoalescer().flush( getEventQueue() );
+    return osgViewer::GraphicsWindow::checkEvents();
+}
+
+void GraphicsWindowQWindow::requestWarpPointer( float x, float y )
+{
+    if ( _window )
+    {
+        const qreal ratio = _window->devicePixelRatio();
+        QCursor::setPos( _window->mapToGlobal( QPoint( static_cast<int>(x/ratio), static_cast<int>(y/ratio) ) ) );
+    }
+}
+
+#endif
+
+class QtWindowingSystem : public osg::GraphicsContext::WindowingSystemInterface
+{
+public:
+
+    QtWindowingSystem()
+    {
+        OSG_INFO << "QtWindowingSystemInterface()" << std::endl;
+    }
+
+    ~QtWindowingSystem()
+    {
+        if (osg::Referenced::getDeleteHandler())
+        {
+            osg::Referenced::getDeleteHandler()->setNumFramesToRetainObjects(0);
+            osg::Referenced::getDeleteHandler()->flushAll();
+        }
+    }
+
+    // Access the Qt windowing system through this singleton class.
+    static QtWindowingSystem* getInterface()
+    {
+        static QtWindowingSystem* qtInterface = new QtWindowingSystem;
+        return qtInterface;
+    }
+
+    // Return the number of screens present in the system
+    virtual unsigned int getNumScreens( const osg::GraphicsContext::ScreenIdentifier& /*si*/ )
+    {
+        OSG_WARN << "osgQt: getNumScreens() not implemented yet." << std::endl;
+        return 0;
+    }
+
+    // Return the resolution of specified screen
+    // (0,0) is returned if screen is unknown
+    virtual void getScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*si*/, osg::GraphicsContext::ScreenSettings & /*resolution*/ )
+    {
+        OSG_WARN << "osgQt: getScreenSettings() not implemented yet." << std::endl;
+    }
+
+    // Set the resolution for given screen
+    virtual bool setScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*si*/, const osg::GraphicsContext::ScreenSettings & /*resolution*/ )
+    {
+        OSG_WARN << "osgQt: setScreenSettings() not implemented yet." << std::endl;
+        return false;
+    }
+
+    // Enumerates available resolutions
+    virtual void enumerateScreenSettings( const osg::GraphicsContext::ScreenIdentifier& /*screenIdentifier*/, osg::GraphicsContext::ScreenSettingsList & /*resolution*/ )
+    {
+        OSG_WARN << "osgQt: enumerateScreenSettings() not implemented yet." << std::endl;
+    }
+
+    // Create a graphics context with given traits
+    virtual osg::GraphicsContext* createGraphicsContext( osg::GraphicsContext::Traits* traits )
+    {
+        if (traits->pbuffer)
+        {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+            osg::ref_ptr< PixelBufferQt > pbuffer = new PixelBufferQt( traits );
+            if (pbuffer->valid()) return pbuffer.release();
+            else return NULL;
+#else
+            OSG_WARN << "osgQt: createGraphicsContext - pbuffer requires Qt 5.1 or later." << std::endl;
+            return NULL;
+#endif
+        }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+        else if (dynamic_cast<GraphicsWindowQWindow::WindowData*>(traits->inheritedWindowData.get()))
+        {
+            osg::ref_ptr< GraphicsWindowQWindow > window = new GraphicsWindowQWindow( traits );
+            if (window->valid()) return window.release();
+            else return NULL;
+        }
+#endif
+        else
+        {
+            osg::ref_ptr< GraphicsWindowQt > window = new GraphicsWindowQt( traits );
+            if (window->valid()) return window.release();
+            else return NULL;
+        }
+    }
+
+private:
+
+    // No implementation for these
+    QtWindowingSystem( const QtWindowingSystem& );
+    QtWindowingSystem& operator=( const QtWindowingSystem& );
+};
+
+#if 1
+REGISTER_WINDOWINGSYSTEMINTERFACE(Qt, QtWindowingSystem)
+#else
+
+// declare C entry point for static compilation.
+extern "C" void OSGQT_EXPORT graphicswindow_Qt(void)
+{
+    osg::GraphicsContext::setWindowingSystemInterface(QtWindowingSystem::getInterface());
+}
+
+
+void osgQt::initQtWindowingSystem()
+{
+    graphicswindow_Qt();
+}
+#endif
+
+
+void osgQt::setViewer( osgViewer::ViewerBase *viewer )
+{
+    FrameClock::instance()->setViewer( viewer );
 }
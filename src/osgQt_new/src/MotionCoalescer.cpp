@@ -0,0 +1,97 @@
+/* -*-c++-*- OpenSceneGraph - Copyright (C) 2009 Wang Rui
+ *
+ * This library is open source and may be redistributed and/or modified under
+ * the terms of the OpenSceneGraph Public License (OSGPL) version 0.0 or
+ * (at your option) any later version.  The full license is in LICENSE file
+ * included with this distribution, and on the openscenegraph.org website.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * OpenSceneGraph Public License for more details.
+*/
+#include <osgQt/MotionCoalescer>
+
+#include <osgGA/EventQueue>
+#include <osgGA/GUIEventAdapter>
+
+namespace osgQt {
+
+const MotionHistory* MotionHistory::get( const osgGA::GUIEventAdapter& ea )
+{
+    return dynamic_cast<const MotionHistory*>( ea.getUserData() );
+}
+
+MotionCoalescer::Statistics::Statistics() :
+    received(0),
+    delivered(0)
+{
+}
+
+MotionCoalescer::MotionCoalescer() :
+    _enabled(true),
+    _fullRate(false),
+    _pending(false)
+{
+    _latest.x = 0.0f;
+    _latest.y = 0.0f;
+    _latest.time = 0.0;
+}
+
+void MotionCoalescer::setEnabled( bool enabled )
+{
+    _enabled = enabled;
+}
+
+void MotionCoalescer::setFullRate( bool fullRate )
+{
+    _fullRate = fullRate;
+
+    // samples gathered before the switch would arrive as a partial history
+    if ( !_fullRate )
+        _history = NULL;
+}
+
+void MotionCoalescer::motion( osgGA::EventQueue* queue, float x, float y )
+{
+    if ( !queue )
+        return;
+
+    ++_statistics.received;
+
+    _latest.x = x;
+    _latest.y = y;
+    _latest.time = queue->getTime();
+    _pending = true;
+
+    if ( _fullRate )
+    {
+        if ( !_history.valid() )
+            _history = new MotionHistory;
+        _history->_samples.push_back( _latest );
+    }
+
+    if ( !_enabled )
+        flush( queue );
+}
+
+void MotionCoalescer::flush( osgGA::EventQueue* queue )
+{
+    if ( !_pending || !queue )
+        return;
+
+    _pending = false;
+    ++_statistics.delivered;
+
+    // the event takes the current button and modifier state, which cannot have changed since the motion:
+    // every other input flushes before it updates that state
+    osgGA::GUIEventAdapter* event = queue->mouseMotion( _latest.x, _latest.y, _latest.time );
+    if ( _history.valid() )
+    {
+        if ( event && _fullRate )
+            event->setUserData( _history.get() );
+        _history = NULL;
+    }
+}
+
+}
@@ -0,0 +1,331 @@
+/* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2009 Robert Osfield
+ *
+ * This library is open source and may be redistributed and/or modified under
+ * the terms of the OpenSceneGraph Public License (OSGPL) version 0.0 or
+ * (at your option) any later version.  The full license is in LICENSE file
+ * included with this distribution, and on the openscenegraph.org website.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * OpenSceneGraph Public License for more details.
+*/
+#include <osgQt/PixelBufferRing>
+
+#include <osg/GLExtensions>
+#include <osg/Notify>
+
+#ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+#endif
+
+#ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+#endif
+
+namespace osgQt {
+
+namespace {
+
+const GLbitfield MAPPING_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+}
+
+PixelBufferRing::Slot::Slot() :
+    state(UNALLOCATED),
+    buffer(0),
+    fence(0),
+    data(0),
+    width(0),
+    height(0),
+    generation(0),
+    sequence(0)
+{
+}
+
+PixelBufferRing::PixelBufferRing() :
+    _active(false),
+    _repaintRequested(false),
+    _requestedWidth(0),
+    _requestedHeight(0),
+    _sequence(0),
+    _contextID(-1),
+    _unsupported(false),
+    _extensions(0),
+    _glBufferStorage(0),
+    _textureWidth(0),
+    _textureHeight(0),
+    _textureComplete(false)
+{
+}
+
+PixelBufferRing::~PixelBufferRing()
+{
+    // the buffers go with the context, without it current there is nothing safe to delete here
+}
+
+int PixelBufferRing::acquire(int width, int height)
+{
+    _requestedWidth.store(width, std::memory_order_relaxed);
+    _requestedHeight.store(height, std::memory_order_relaxed);
+
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        Slot& slot = _slots[i];
+        int expected = FREE;
+        if (!slot.state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire)) continue;
+
+        if (slot.width == width && slot.height == height && slot.data) return i;
+
+        // still the old size, the draw thread reallocates it on its next upload
+        slot.state.store(FREE, std::memory_order_release);
+    }
+    return -1;
+}
+
+void PixelBufferRing::publish(int slot, const QRegion& changed)
+{
+    _slots[slot].changed = changed;
+    _slots[slot].sequence = ++_sequence;
+    _slots[slot].state.store(READY, std::memory_order_release);
+}
+
+void PixelBufferRing::release(int slot)
+{
+    _slots[slot].state.store(FREE, std::memory_order_release);
+}
+
+bool PixelBufferRing::initialize(osg::State& state)
+{
+    _contextID = static_cast<int>(state.getContextID());
+    _extensions = state.get<osg::GLExtensions>();
+
+    if (!_extensions || !_extensions->isPBOSupported ||
+        !_extensions->glMapBufferRange || !_extensions->glFenceSync || !_extensions->glClientWaitSync ||
+        !osg::isGLExtensionOrVersionSupported(state.getContextID(), "GL_ARB_buffer_storage", 4.4f))
+    {
+        OSG_INFO<<"PixelBufferRing: persistent buffer mapping not supported, keeping the client memory upload."<<std::endl;
+        return false;
+    }
+
+    osg::setGLExtensionFuncPtr(_glBufferStorage, "glBufferStorage", "glBufferStorageARB");
+    return _glBufferStorage != 0;
+}
+
+void PixelBufferRing::reallocate(Slot& slot, int width, int height)
+{
+    if (slot.buffer)
+    {
+        _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, slot.buffer);
+        _extensions->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
+        _extensions->glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+    slot.data = 0;
+    slot.width = 0;
+    slot.height = 0;
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * 4;
+
+    _extensions->glGenBuffers(1, &slot.buffer);
+    _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, slot.buffer);
+    _glBufferStorage(GL_PIXEL_UNPACK_BUFFER_ARB, size, 0, MAPPING_FLAGS);
+    slot.data = static_cast<unsigned char*>(_extensions->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, 0, size, MAPPING_FLAGS));
+    _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+    if (!slot.data)
+    {
+        OSG_WARN<<"PixelBufferRing: mapping a "<<width<<"x"<<height<<" pixel buffer failed."<<std::endl;
+        _extensions->glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+        return;
+    }
+
+    slot.width = width;
+    slot.height = height;
+    ++slot.generation;
+}
+
+void PixelBufferRing::retireFinished()
+{
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        Slot& slot = _slots[i];
+        if (slot.state.load(std::memory_order_acquire) != IN_FLIGHT) continue;
+
+        const GLenum result = _extensions->glClientWaitSync(slot.fence, 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) continue;
+
+        _extensions->glDeleteSync(slot.fence);
+        slot.fence = 0;
+        slot.state.store(FREE, std::memory_order_release);
+    }
+}
+
+bool PixelBufferRing::upload(osg::State& state, bool allocateTexture)
+{
+    if (_unsupported) return false;
+
+    if (_contextID < 0)
+    {
+        if (!initialize(state))
+        {
+            _unsupported = true;
+            return false;
+        }
+    }
+    if (static_cast<int>(state.getContextID()) != _contextID) return false;
+
+    // osg caches the bound pixel buffer, clear it so that both sides agree on buffer 0 afterwards
+    state.unbindPixelBufferObject();
+
+    retireFinished();
+
+    const int width = _requestedWidth.load(std::memory_order_relaxed);
+    const int height = _requestedHeight.load(std::memory_order_relaxed);
+    if (width > 0 && height > 0)
+    {
+        for (int i = 0; i < NUM_SLOTS; ++i)
+        {
+            Slot& slot = _slots[i];
+            if (slot.width == width && slot.height == height) continue;
+
+            int expected = FREE;
+            if (!slot.state.compare_exchange_strong(expected, UNALLOCATED, std::memory_order_acquire) &&
+                expected != UNALLOCATED) continue;
+
+            reallocate(slot, width, height);
+            if (slot.data) slot.state.store(FREE, std::memory_order_release);
+        }
+    }
+
+    if (!_active.load(std::memory_order_relaxed))
+    {
+        _active.store(true, std::memory_order_release);
+        _repaintRequested.store(true, std::memory_order_release);
+    }
+
+    // the newest published slot goes up, older ones it supersedes are only merged into the changed region
+    // (only slots seen here count, one published meanwhile waits for the next upload)
+    Slot* newest = 0;
+    bool ready[NUM_SLOTS];
+    QRegion changed;
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        Slot& slot = _slots[i];
+        ready[i] = slot.state.load(std::memory_order_acquire) == READY;
+        if (!ready[i]) continue;
+
+        changed += slot.changed;
+        if (!newest || slot.sequence > newest->sequence) newest = &slot;
+    }
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        if (ready[i] && &_slots[i] != newest) _slots[i].state.store(FREE, std::memory_order_release);
+    }
+
+    if (allocateTexture) _textureComplete = false;
+
+    if (!newest)
+    {
+        if (allocateTexture && width > 0 && height > 0)
+        {
+            // give the new texture object storage until Qt delivers a complete image
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+            _textureWidth = width;
+            _textureHeight = height;
+        }
+        if (!_textureComplete) _repaintRequested.store(true, std::memory_order_release);
+        return true;
+    }
+
+    _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, newest->buffer);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (!_textureComplete || newest->width != _textureWidth || newest->height != _textureHeight)
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newest->width, newest->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        _textureWidth = newest->width;
+        _textureHeight = newest->height;
+        _textureComplete = true;
+    }
+    else
+    {
+        changed = changed.intersected(QRect(0, 0, newest->width, newest->height));
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, newest->width);
+        for (QRegion::const_iterator itr = changed.begin(); itr != changed.end(); ++itr)
+        {
+            glPixelStorei(GL_UNPACK_SKIP_PIXELS, itr->x());
+            glPixelStorei(GL_UNPACK_SKIP_ROWS, itr->y());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, itr->x(), itr->y(), itr->width(), itr->height(),
+                            GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        }
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+    // the slot returns to Qt once the GPU has consumed it, checked without waiting on later uploads
+    newest->fence = _extensions->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    newest->state.store(IN_FLIGHT, std::memory_order_release);
+    return true;
+}
+
+void PixelBufferRing::releaseGLObjects(osg::State* state)
+{
+    if (!_extensions || (state && static_cast<int>(state->getContextID()) != _contextID)) return;
+
+    // the ring does not come back, the adapter continues with its client memory path
+    _unsupported = true;
+    _active.store(false, std::memory_order_release);
+
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        Slot& slot = _slots[i];
+
+        // a slot Qt is painting into stays mapped, its memory is simply abandoned with the context
+        int expected = slot.state.load(std::memory_order_acquire);
+        if (expected == WRITING || !slot.state.compare_exchange_strong(expected, UNALLOCATED, std::memory_order_acquire)) continue;
+
+        if (slot.fence)
+        {
+            _extensions->glDeleteSync(slot.fence);
+            slot.fence = 0;
+        }
+        if (slot.buffer)
+        {
+            _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, slot.buffer);
+            _extensions->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
+            _extensions->glDeleteBuffers(1, &slot.buffer);
+            slot.buffer = 0;
+        }
+        _extensions->glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        slot.data = 0;
+        slot.width = 0;
+        slot.height = 0;
+    }
+
+    _textureComplete = false;
+}
+
+}
@@ -12,14 +12,34 @@
 */
 #include <osgQt/QFontImplementation>
 
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Uniform>
 #include <osgDB/FileNameUtils>
 #include <osgDB/Registry>
 #include <osgText/Font>
+#include <OpenThreads/Mutex>
+#include <OpenThreads/ScopedLock>
 
 #include <QFont>
+#include <QFontInfo>
 #include <QFontMetrics>
 #include <QImage>
 #include <QPainter>
+#include <QRawFont>
+#include <QVector>
+
+#ifdef OSGQT_HAVE_OPENCV
+#include <opencv2/imgproc.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
 
 #ifndef OSGTEXT_GLYPH_INTERNALFORMAT
 #define OSGTEXT_GLYPH_INTERNALFORMAT GL_ALPHA
@@ -31,73 +51,238 @@
 
 namespace osgQt {
 
-QFontImplementation::QFontImplementation(const QFont& font) :
-   _filename(font.toString().toStdString() + ".qfont"),
-   _font(font)
-{
-}
-
-QFontImplementation::~QFontImplementation()
-{
-}
+namespace {
 
-std::string
-QFontImplementation::getFileName() const
-{
-    return _filename;
-}
+const char* const SDF_VERTEX_SHADER =
+    "#version 120\n"
+    "varying vec2 texCoord;\n"
+    "varying vec4 vertexColor;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = ftransform();\n"
+    "    texCoord = gl_MultiTexCoord0.xy;\n"
+    "    vertexColor = gl_Color;\n"
+    "}\n";
 
-osgText::Glyph*
-QFontImplementation::getGlyph(const osgText::FontResolution& fontRes, unsigned int charcode)
-{
-    unsigned int fontSize = fontRes.second;
-    _font.setPixelSize(fontSize);
+const char* const SDF_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform sampler2D glyphTexture;\n"
+    "varying vec2 texCoord;\n"
+    "varying vec4 vertexColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float distance = texture2D(glyphTexture, texCoord).a;\n"
+    "    float width = max(fwidth(distance) * 0.7, 1.0 / 255.0);\n"
+    "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+    "    if (alpha <= 0.0) discard;\n"
+    "    gl_FragColor = vec4(vertexColor.rgb, vertexColor.a * alpha);\n"
+    "}\n";
 
-    float coord_scale = 1.0f/float(fontSize);
+const float EDT_INFINITY = 1e20f;
 
-    QFontMetrics fontMetrics(_font);
-    QFontMetricsF fontMetricsF(_font);
+/** Paints the glyph white on an 8 bit coverage image. Width and height are padded up to multiples of alignment,
+  * the extra rows go to the top so the baseline placement stays exact; metrics are in painted pixels. */
+void paintGlyph(const QFont& font, unsigned int charcode, int margin, int alignment, QImage& image, GlyphRecord& record)
+{
+    QFontMetrics fontMetrics(font);
+    QFontMetricsF fontMetricsF(font);
 
-    QRect rect = fontMetrics.boundingRect(QChar(charcode));
-    QRectF rectF = fontMetricsF.boundingRect(QChar(charcode));
+    const uint ucs4 = charcode;
+    const QString text = QString::fromUcs4(&ucs4, 1);
+    const bool bmp = charcode <= 0xFFFF;
 
-    int margin = 1;
+    QRect rect = fontMetrics.boundingRect(text);
+    QRectF rectF = fontMetricsF.boundingRect(text);
 
     int imageWidth = rect.width() + 2*margin;
     int imageHeight = rect.height() + 2*margin;
+    imageWidth = ((imageWidth + alignment - 1) / alignment) * alignment;
+    const int paddedHeight = ((imageHeight + alignment - 1) / alignment) * alignment;
+    const int extraTop = paddedHeight - imageHeight;
+    imageHeight = paddedHeight;
 
-    // Now paint the glyph into the image
-    QImage image(imageWidth, imageHeight, QImage::Format_ARGB32);
+    // Now paint the glyph into an 8 bit coverage image, its scanlines are the glyph bitmap
+    image = QImage(imageWidth, imageHeight, QImage::Format_Alpha8);
     image.fill(0);
     QPainter painter(&image);
     painter.setRenderHint(QPainter::TextAntialiasing);
 
-    painter.setFont(_font);
+    painter.setFont(font);
 
     painter.setBackgroundMode(Qt::TransparentMode);
     painter.setBrush(Qt::white);
     painter.setPen(Qt::white);
 
-    painter.drawText(margin - rect.left(), imageHeight - 1 - (margin + rect.bottom()), QString(QChar(charcode)));
+    painter.drawText(margin - rect.left(), imageHeight - 1 - (margin + rect.bottom()), text);
     painter.end();
 
-    // Transfer the rendered image to osg
-    osg::ref_ptr<osgText::Glyph> glyph = new osgText::Glyph(_facade, charcode);
+    record.width = (unsigned int)imageWidth;
+    record.height = (unsigned int)imageHeight;
+
+    // Layout parameters
+    float leftBearing = bmp ? float(fontMetricsF.leftBearing(QChar(charcode))) : 0.0f;
+    float rightBearing = bmp ? float(fontMetricsF.rightBearing(QChar(charcode))) : 0.0f;
+
+    // for horizonal layout
+    record.horizontalBearingX = leftBearing - margin;
+    record.horizontalBearingY = float(- rectF.bottom() - margin);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    record.horizontalAdvance = float(fontMetricsF.horizontalAdvance(text));
+#else
+    record.horizontalAdvance = float(fontMetricsF.width(text));
+#endif
+
+    // for vertical layout
+    record.verticalBearingX = float(- margin + 0.5*(leftBearing - rect.width() - rightBearing));
+    record.verticalBearingY = float(rectF.top() - margin - extraTop);
+    record.verticalAdvance = float(rectF.height() + fontMetricsF.overlinePos() - fontMetricsF.xHeight());
+}
+
+void scaleMetrics(GlyphRecord& record, float scale)
+{
+    record.horizontalBearingX *= scale;
+    record.horizontalBearingY *= scale;
+    record.horizontalAdvance *= scale;
+    record.verticalBearingX *= scale;
+    record.verticalBearingY *= scale;
+    record.verticalAdvance *= scale;
+}
 
-    unsigned int dataSize = imageWidth*imageHeight;
-    unsigned char* data = new unsigned char[dataSize];
+#ifndef OSGQT_HAVE_OPENCV
+/** Felzenszwalb/Huttenlocher exact 1D squared distance transform of f into d (n samples, stride apart). */
+void distanceTransform1D(float* data, int n, int stride, float* f, float* d, int* v, float* z)
+{
+    for (int q = 0; q < n; ++q) f[q] = data[q * stride];
 
-    // copy the qimage into the texture memory
-    for (int x = 0; x < imageWidth; ++x)
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INFINITY;
+    z[1] = EDT_INFINITY;
+    for (int q = 1; q < n; ++q)
     {
-        for (int y = 0; y < imageHeight; ++y)
+        float s = ((f[q] + float(q*q)) - (f[v[k]] + float(v[k]*v[k]))) / float(2*q - 2*v[k]);
+        while (s <= z[k])
         {
-           data[x + y*imageWidth] = qAlpha(image.pixel(x, imageHeight - 1 - y));
+            --k;
+            s = ((f[q] + float(q*q)) - (f[v[k]] + float(v[k]*v[k]))) / float(2*q - 2*v[k]);
         }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k+1] = EDT_INFINITY;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; ++q)
+    {
+        while (z[k+1] < float(q)) ++k;
+        d[q] = float((q - v[k])*(q - v[k])) + f[v[k]];
     }
+    for (int q = 0; q < n; ++q) data[q * stride] = d[q];
+}
+
+/** Euclidean distance of every pixel to the nearest seed pixel (seed[i] != 0), written to distance. */
+void distanceTransform2D(const std::vector<unsigned char>& seed, int width, int height, std::vector<float>& distance)
+{
+    distance.resize(seed.size());
+    for (size_t i = 0; i < seed.size(); ++i) distance[i] = seed[i] ? 0.0f : EDT_INFINITY;
+
+    const size_t n = size_t(std::max(width, height));
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    for (int x = 0; x < width; ++x)
+    {
+        distanceTransform1D(&distance[size_t(x)], height, width, &f[0], &d[0], &v[0], &z[0]);
+    }
+    for (int y = 0; y < height; ++y)
+    {
+        distanceTransform1D(&distance[size_t(y) * size_t(width)], width, 1, &f[0], &d[0], &v[0], &z[0]);
+    }
+    for (size_t i = 0; i < distance.size(); ++i) distance[i] = std::sqrt(distance[i]);
+}
+#endif
+
+/** Converts a coverage image painted at SDF_OVERSAMPLE resolution into the 8 bit distance field stored in the cache:
+  * 0.5 on the outline, rising inwards, SDF_SPREAD glyph pixels mapped to half the value range. Rows bottom up. */
+void computeDistanceField(const QImage& source, std::vector<unsigned char>& pixels)
+{
+    const int over = int(QFontImplementation::SDF_OVERSAMPLE);
+    const int width = source.width();
+    const int height = source.height();
+
+    std::vector<float> inside;
+    std::vector<float> outside;
+#ifdef OSGQT_HAVE_OPENCV
+    cv::Mat coverage(height, width, CV_8UC1, const_cast<uchar*>(source.constBits()), size_t(source.bytesPerLine()));
+    cv::Mat insideMask;
+    cv::threshold(coverage, insideMask, 127.0, 255.0, cv::THRESH_BINARY);
+    cv::Mat outsideMask = ~insideMask;
+    // distanceTransform measures each non-zero pixel to the nearest zero pixel
+    cv::Mat insideDistance;
+    cv::Mat outsideDistance;
+    cv::distanceTransform(insideMask, insideDistance, cv::DIST_L2, cv::DIST_MASK_PRECISE, CV_32F);
+    cv::distanceTransform(outsideMask, outsideDistance, cv::DIST_L2, cv::DIST_MASK_PRECISE, CV_32F);
+    inside.assign(insideDistance.begin<float>(), insideDistance.end<float>());
+    outside.assign(outsideDistance.begin<float>(), outsideDistance.end<float>());
+#else
+    std::vector<unsigned char> insideSeed(size_t(width) * size_t(height));
+    std::vector<unsigned char> outsideSeed(insideSeed.size());
+    for (int y = 0; y < height; ++y)
+    {
+        const uchar* line = source.constScanLine(y);
+        for (int x = 0; x < width; ++x)
+        {
+            const bool in = line[x] > 127;
+            insideSeed[size_t(y) * size_t(width) + size_t(x)] = in ? 0 : 1;
+            outsideSeed[size_t(y) * size_t(width) + size_t(x)] = in ? 1 : 0;
+        }
+    }
+    // distance to the nearest outside pixel for inside pixels and vice versa
+    distanceTransform2D(insideSeed, width, height, inside);
+    distanceTransform2D(outsideSeed, width, height, outside);
+#endif
+
+    const int fieldWidth = width / over;
+    const int fieldHeight = height / over;
+    const float toGlyphPixels = 1.0f / float(over * over * over);
+    const float encode = 0.5f / float(QFontImplementation::SDF_SPREAD);
+    pixels.resize(size_t(fieldWidth) * size_t(fieldHeight));
+    for (int fy = 0; fy < fieldHeight; ++fy)
+    {
+        for (int fx = 0; fx < fieldWidth; ++fx)
+        {
+            // box filter the signed distance over the oversampled block
+            float sum = 0.0f;
+            for (int sy = fy * over; sy < (fy + 1) * over; ++sy)
+            {
+                for (int sx = fx * over; sx < (fx + 1) * over; ++sx)
+                {
+                    const size_t i = size_t(sy) * size_t(width) + size_t(sx);
+                    sum += inside[i] > 0.0f ? inside[i] - 0.5f : 0.5f - outside[i];
+                }
+            }
+            const float value = std::min(std::max(0.5f + sum * toGlyphPixels * encode, 0.0f), 1.0f);
+            // osg images are bottom up
+            pixels[size_t(fieldHeight - 1 - fy) * size_t(fieldWidth) + size_t(fx)] = (unsigned char)std::lround(value * 255.0f);
+        }
+    }
+}
+
+unsigned long long pairKey(unsigned int left, unsigned int right)
+{
+    return (static_cast<unsigned long long>(left) << 32) | right;
+}
+
+osgText::Glyph* createGlyph(osgText::Font* facade, unsigned int charcode, const GlyphRecord& record,
+                            const std::vector<unsigned char>& pixels, float coord_scale)
+{
+    osg::ref_ptr<osgText::Glyph> glyph = new osgText::Glyph(facade, charcode);
+
+    unsigned char* data = new unsigned char[pixels.size()];
+    if (!pixels.empty()) std::memcpy(data, &pixels[0], pixels.size());
 
     // the glyph texture in osg
-    glyph->setImage(imageWidth, imageHeight, 1,
+    glyph->setImage(record.width, record.height, 1,
                     OSGTEXT_GLYPH_INTERNALFORMAT,
                     OSGTEXT_GLYPH_FORMAT, GL_UNSIGNED_BYTE,
                     data,
@@ -105,34 +290,327 @@ QFontImplementation::getGlyph(const osgText::FontResolution& fontRes, unsigned i
                     1);
     glyph->setInternalTextureFormat(OSGTEXT_GLYPH_INTERNALFORMAT);
 
-    glyph->setWidth((float)imageWidth * coord_scale);
-    glyph->setHeight((float)imageHeight * coord_scale);
+    glyph->setWidth((float)record.width * coord_scale);
+    glyph->setHeight((float)record.height * coord_scale);
 
-    // Layout parameters
-    float leftBearing = fontMetricsF.leftBearing(QChar(charcode));
-    float rightBearing = fontMetricsF.rightBearing(QChar(charcode));
+    glyph->setHorizontalBearing(osg::Vec2(record.horizontalBearingX, record.horizontalBearingY) * coord_scale);
+    glyph->setHorizontalAdvance(record.horizontalAdvance * coord_scale);
+    glyph->setVerticalBearing(osg::Vec2(record.verticalBearingX, record.verticalBearingY) * coord_scale);
+    glyph->setVerticalAdvance(record.verticalAdvance * coord_scale);
 
-    // for horizonal layout
-    osg::Vec2 bottomLeft(leftBearing - margin, - rectF.bottom() - margin);
-    glyph->setHorizontalBearing(bottomLeft * coord_scale);
-    glyph->setHorizontalAdvance(fontMetricsF.width(QChar(charcode)) * coord_scale);
+    return glyph.release();
+}
 
-    // for vertical layout
-    osg::Vec2 topMiddle(- margin + 0.5*(leftBearing - rect.width() - rightBearing),
-                        rectF.top() - margin);
-    glyph->setVerticalBearing(topMiddle * coord_scale);
-    glyph->setVerticalAdvance((rectF.height() + fontMetricsF.overlinePos() - fontMetricsF.xHeight()) * coord_scale);
+}
 
-    // ... ready
-    //addGlyph(fontRes, charcode, glyph.get());
+QFontImplementation::QFontImplementation(const QFont& font, GlyphMode mode) :
+   _filename(font.toString().toStdString() + ".qfont"),
+   _font(font),
+   _mode(mode)
+{
+    // the resolved family guards the persistent glyph cache against a different fallback font on another machine
+    QFontInfo info(font);
+    _cacheKey = (font.toString() + QLatin1Char('|') + info.family() + QLatin1Char('|') + info.styleName()).toStdString();
+    if (_mode == SIGNED_DISTANCE_FIELD)
+    {
+        _cacheKey += "|sdf";
+    }
+}
 
-    return glyph.release();
+QFontImplementation::~QFontImplementation()
+{
+}
+
+std::string
+QFontImplementation::getFileName() const
+{
+    return _filename;
+}
+
+GlyphCache::Key
+QFontImplementation::cacheKey(unsigned int fontSize, unsigned int charcode) const
+{
+    GlyphCache::Key key;
+    key.font = _cacheKey;
+    key.pixelSize = fontSize;
+    key.charcode = charcode;
+    return key;
+}
+
+osgText::Glyph*
+QFontImplementation::getGlyph(const osgText::FontResolution& fontRes, unsigned int charcode)
+{
+    // distance field glyphs ignore the requested resolution, one glyph serves every text size
+    unsigned int fontSize = fontRes.second;
+    if (_mode == SIGNED_DISTANCE_FIELD) fontSize = SDF_GLYPH_SIZE;
+    if (fontSize == 0) return 0;
+
+    float coord_scale = 1.0f/float(fontSize);
+
+    const GlyphCache::Key key = cacheKey(fontSize, charcode);
+    GlyphRecord record;
+    std::vector<unsigned char> pixels;
+    GlyphCache& cache = GlyphCache::instance();
+    if (!cache.find(key, record, pixels))
+    {
+        if (_mode == SIGNED_DISTANCE_FIELD)
+        {
+            QImage source;
+            paintDistanceFieldSource(charcode, record, source);
+            computeDistanceField(source, pixels);
+        }
+        else
+        {
+            rasterizeGlyph(fontSize, charcode, record, pixels);
+        }
+        cache.insert(key, record, pixels.empty() ? 0 : &pixels[0]);
+    }
+
+    // the advance table also drives getKerning() and layoutText(), keep osgText's layout identical to it
+    record.horizontalAdvance = getAdvance(fontSize, charcode);
+
+    // ... ready, osgText::Font::getGlyph adds it to the font's glyph map and texture atlas
+    return createGlyph(_facade, charcode, record, pixels, coord_scale);
+}
+
+void
+QFontImplementation::rasterizeGlyph(unsigned int fontSize, unsigned int charcode, GlyphRecord& record, std::vector<unsigned char>& pixels) const
+{
+    // work on a copy, getGlyph may be called from several threads
+    QFont font(_font);
+    font.setPixelSize(int(fontSize));
+
+    QImage image;
+    paintGlyph(font, charcode, 1, 1, image, record);
+
+    // osg images are bottom up
+    const int imageWidth = image.width();
+    const int imageHeight = image.height();
+    pixels.resize(size_t(imageWidth) * size_t(imageHeight));
+    for (int y = 0; y < imageHeight; ++y)
+    {
+        std::memcpy(&pixels[size_t(y) * size_t(imageWidth)], image.constScanLine(imageHeight - 1 - y), size_t(imageWidth));
+    }
+}
+
+void
+QFontImplementation::paintDistanceFieldSource(unsigned int charcode, GlyphRecord& record, QImage& image) const
+{
+    QFont font(_font);
+    font.setPixelSize(int(SDF_GLYPH_SIZE * SDF_OVERSAMPLE));
+
+    paintGlyph(font, charcode, int(SDF_SPREAD * SDF_OVERSAMPLE), int(SDF_OVERSAMPLE), image, record);
+    record.width /= SDF_OVERSAMPLE;
+    record.height /= SDF_OVERSAMPLE;
+    scaleMetrics(record, 1.0f / float(SDF_OVERSAMPLE));
+}
+
+void
+QFontImplementation::prepareGlyphs(const std::vector<unsigned int>& charcodes)
+{
+    if (_mode != SIGNED_DISTANCE_FIELD) return;
+
+    struct Pending
+    {
+        unsigned int charcode;
+        GlyphRecord record;
+        QImage source;
+        std::vector<unsigned char> field;
+    };
+
+    // painting goes through the Qt font engine and stays on this thread, only the transforms fan out
+    GlyphCache& cache = GlyphCache::instance();
+    std::vector<Pending> pending;
+    std::vector<unsigned char> scratch;
+    for (std::vector<unsigned int>::const_iterator itr = charcodes.begin(); itr != charcodes.end(); ++itr)
+    {
+        GlyphRecord cached;
+        if (cache.find(cacheKey(SDF_GLYPH_SIZE, *itr), cached, scratch)) continue;
+
+        Pending glyph;
+        glyph.charcode = *itr;
+        paintDistanceFieldSource(*itr, glyph.record, glyph.source);
+        pending.push_back(glyph);
+    }
+    if (pending.empty()) return;
+
+    std::atomic<size_t> next(0);
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t workerCount = std::min(size_t(hardware), pending.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; ++i)
+    {
+        workers.push_back(std::thread([&pending, &next]()
+        {
+            for (size_t index = next++; index < pending.size(); index = next++)
+            {
+                computeDistanceField(pending[index].source, pending[index].field);
+            }
+        }));
+    }
+    for (size_t index = next++; index < pending.size(); index = next++)
+    {
+        computeDistanceField(pending[index].source, pending[index].field);
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+    for (std::vector<Pending>::const_iterator itr = pending.begin(); itr != pending.end(); ++itr)
+    {
+        cache.insert(cacheKey(SDF_GLYPH_SIZE, itr->charcode), itr->record, itr->field.empty() ? 0 : &itr->field[0]);
+    }
+}
+
+void
+QFontImplementation::applySignedDistanceFieldShader(osg::StateSet* stateset)
+{
+    if (!stateset) return;
+
+    static osg::ref_ptr<osg::Program> s_program;
+    static OpenThreads::Mutex s_programMutex;
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(s_programMutex);
+        if (!s_program.valid())
+        {
+            s_program = new osg::Program;
+            s_program->setName("osgQt::SignedDistanceFieldText");
+            s_program->addShader(new osg::Shader(osg::Shader::VERTEX, SDF_VERTEX_SHADER));
+            s_program->addShader(new osg::Shader(osg::Shader::FRAGMENT, SDF_FRAGMENT_SHADER));
+        }
+    }
+
+    stateset->setAttributeAndModes(s_program.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+    stateset->addUniform(new osg::Uniform("glyphTexture", 0));
 }
 
 osg::Vec2
-QFontImplementation::getKerning(const osgText::FontResolution& /*fontRes*/, unsigned int /*leftcharcode*/, unsigned int /*rightcharcode*/, osgText::KerningType /*kerningType*/)
+QFontImplementation::getKerning(const osgText::FontResolution& fontRes, unsigned int leftcharcode, unsigned int rightcharcode, osgText::KerningType kerningType)
+{
+    if (kerningType == osgText::KERNING_NONE) return osg::Vec2(0, 0);
+
+    unsigned int fontSize = fontRes.second;
+    if (_mode == SIGNED_DISTANCE_FIELD) fontSize = SDF_GLYPH_SIZE;
+    if (fontSize == 0) return osg::Vec2(0, 0);
+
+    // same normalisation as the glyph metrics
+    return osg::Vec2(getKerningAdjustment(fontSize, leftcharcode, rightcharcode) / float(fontSize), 0.0f);
+}
+
+float
+QFontImplementation::getAdvance(unsigned int fontSize, unsigned int charcode)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_metricsMutex);
+
+    MetricsTable& table = _metrics[fontSize];
+    std::map<unsigned int, float>::const_iterator itr = table.advances.find(charcode);
+    if (itr != table.advances.end()) return itr->second;
+
+    return ensureMetrics(fontSize, std::vector<unsigned int>(1, charcode)).advances[charcode];
+}
+
+float
+QFontImplementation::getKerningAdjustment(unsigned int fontSize, unsigned int leftcharcode, unsigned int rightcharcode)
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_metricsMutex);
+
+    const unsigned long long key = pairKey(leftcharcode, rightcharcode);
+    MetricsTable& table = _metrics[fontSize];
+    std::map<unsigned long long, float>::const_iterator itr = table.kerning.find(key);
+    if (itr != table.kerning.end()) return itr->second;
+
+    std::vector<unsigned int> pair(2);
+    pair[0] = leftcharcode;
+    pair[1] = rightcharcode;
+    return ensureMetrics(fontSize, pair).kerning[key];
+}
+
+void
+QFontImplementation::layoutText(unsigned int fontSize, const std::vector<unsigned int>& charcodes, std::vector<float>& penPositions)
 {
-    return osg::Vec2(0, 0);
+    penPositions.assign(charcodes.size() + 1, 0.0f);
+    if (charcodes.empty() || fontSize == 0) return;
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_metricsMutex);
+
+    const MetricsTable& table = ensureMetrics(fontSize, charcodes);
+    float pen = 0.0f;
+    for (size_t i = 0; i < charcodes.size(); ++i)
+    {
+        penPositions[i] = pen;
+        pen += table.advances.find(charcodes[i])->second;
+        if (i + 1 < charcodes.size())
+        {
+            pen += table.kerning.find(pairKey(charcodes[i], charcodes[i + 1]))->second;
+        }
+    }
+    penPositions[charcodes.size()] = pen;
+}
+
+QFontImplementation::MetricsTable&
+QFontImplementation::ensureMetrics(unsigned int fontSize, const std::vector<unsigned int>& charcodes)
+{
+    MetricsTable& table = _metrics[fontSize];
+
+    bool complete = true;
+    for (size_t i = 0; i < charcodes.size() && complete; ++i)
+    {
+        complete = table.advances.count(charcodes[i]) != 0 &&
+                   (i + 1 == charcodes.size() || table.kerning.count(pairKey(charcodes[i], charcodes[i + 1])) != 0);
+    }
+    if (complete) return table;
+
+    QFont font(_font);
+    font.setPixelSize(int(fontSize));
+
+    // QRawFont is bound to the thread that created it, so it lives only for this query
+    QRawFont rawFont = QRawFont::fromFont(font);
+    QVector<quint32> indexes;
+    if (rawFont.isValid())
+    {
+        QVector<uint> ucs4(int(charcodes.size()));
+        for (size_t i = 0; i < charcodes.size(); ++i) ucs4[int(i)] = charcodes[i];
+        indexes = rawFont.glyphIndexesForString(QString::fromUcs4(ucs4.constData(), ucs4.size()));
+    }
+
+    // cmap lookup only: characters outside the BMP become surrogate pairs and there is no ligature substitution,
+    // fall back to per character metrics whenever the indexes do not line up with the characters
+    if (indexes.size() == int(charcodes.size()))
+    {
+        const QVector<QPointF> advances = rawFont.advancesForGlyphIndexes(indexes, QRawFont::SeparateAdvances);
+        const QVector<QPointF> kerned = rawFont.advancesForGlyphIndexes(indexes, QRawFont::KernedAdvances);
+        for (size_t i = 0; i < charcodes.size(); ++i)
+        {
+            // glyph 0 is .notdef, painting falls back to another font whose metrics only QFontMetricsF knows
+            if (indexes[int(i)] != 0)
+            {
+                table.advances[charcodes[i]] = float(advances[int(i)].x());
+            }
+            if (i + 1 < charcodes.size())
+            {
+                const bool kernable = indexes[int(i)] != 0 && indexes[int(i + 1)] != 0;
+                table.kerning[pairKey(charcodes[i], charcodes[i + 1])] =
+                    kernable ? float(kerned[int(i)].x() - advances[int(i)].x()) : 0.0f;
+            }
+        }
+    }
+
+    QFontMetricsF fontMetricsF(font);
+    for (size_t i = 0; i < charcodes.size(); ++i)
+    {
+        if (table.advances.count(charcodes[i]) == 0)
+        {
+            const uint ucs4 = charcodes[i];
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+            table.advances[charcodes[i]] = float(fontMetricsF.horizontalAdvance(QString::fromUcs4(&ucs4, 1)));
+#else
+            table.advances[charcodes[i]] = float(fontMetricsF.width(QString::fromUcs4(&ucs4, 1)));
+#endif
+        }
+        if (i + 1 < charcodes.size() && table.kerning.count(pairKey(charcodes[i], charcodes[i + 1])) == 0)
+        {
+            table.kerning[pairKey(charcodes[i], charcodes[i + 1])] = 0.0f;
+        }
+    }
+    return table;
 }
 
 bool
@@ -63,7 +63,14 @@ struct MyQPointerEvent : public QEvent
 };
 
 
-const QImage::Format s_imageFormat = QImage::Format_ARGB32_Premultiplied;
+// RGBA byte order on every platform, so the buffers go to GL_RGBA without swizzling; rows stay top down
+// and the image origin is TOP_LEFT, the flip happens in the texture coordinates instead of per pixel.
+const QImage::Format s_imageFormat = QImage::Format_RGBA8888_Premultiplied;
+
+// antialiased edges of repainted items reach one pixel beyond the reported rectangle
+const int s_dirtyMargin = 1;
+
+const int s_maxUploadRects = 32;
 
 QGraphicsViewAdapter::QGraphicsViewAdapter(osg::Image* image, QWidget* widget):
     _image(image),
@@ -77,7 +84,8 @@ QGraphicsViewAdapter::QGraphicsViewAdapter(osg::Image* image, QWidget* widget):
     _requiresRendering(false),
     _qtKeyModifiers(Qt::NoModifier),
     _backgroundColor(255, 255, 255),
-    _widget(widget)
+    _widget(widget),
+    _renderingToRing(false)
 {
     // make sure we have a valid QApplication before we start creating widgets.
     getOrCreateQApplication();
@@ -103,6 +111,21 @@ QGraphicsViewAdapter::QGraphicsViewAdapter(osg::Image* image, QWidget* widget):
     _qimages[1] = QImage(QSize(_width, _height), s_imageFormat);
     _qimages[2] = QImage(QSize(_width, _height), s_imageFormat);
 
+    // nothing has been painted yet, every buffer and the texture start out completely dirty
+    const QRegion full(0, 0, _width, _height);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        _qimages[i].fill(_backgroundColor);
+        _bufferRegions[i] = full;
+    }
+    _pendingRegion = full;
+    _requiresRendering = true;
+
+    for (unsigned int i = 0; i < PixelBufferRing::NUM_SLOTS; ++i)
+    {
+        _slotGenerations[i] = 0;
+    }
+
     _currentRead = 0;
     _currentWrite = 1;
     _previousWrite = 2;
@@ -117,15 +140,21 @@ QGraphicsViewAdapter::QGraphicsViewAdapter(osg::Image* image, QWidget* widget):
     assignImage(0);
 }
 
-void QGraphicsViewAdapter::repaintRequestedSlot(const QList<QRectF>&)
+void QGraphicsViewAdapter::repaintRequestedSlot(const QList<QRectF>& regions)
 {
     // OSG_NOTICE<<"QGraphicsViewAdapter::repaintRequestedSlot"<<std::endl;
+    for (QList<QRectF>::const_iterator itr = regions.begin(); itr != regions.end(); ++itr)
+    {
+        QRect rect = _graphicsView->mapFromScene(*itr).boundingRect();
+        _pendingRegion += rect.adjusted(-s_dirtyMargin, -s_dirtyMargin, s_dirtyMargin, s_dirtyMargin);
+    }
     _requiresRendering = true;
 }
 
 void QGraphicsViewAdapter::repaintRequestedSlot(const QRectF&)
 {
     // OSG_NOTICE<<"QGraphicsViewAdapter::repaintRequestedSlot"<<std::endl;
+    _pendingRegion += QRect(0, 0, _width, _height);
     _requiresRendering = true;
 }
 
@@ -314,7 +343,7 @@ QWidget* QGraphicsViewAdapter::getWidgetAt(const QPoint& pos)
 bool QGraphicsViewAdapter::sendPointerEvent(int x, int y, int buttonMask)
 {
     _previousQtMouseX = x;
-    _previousQtMouseY = _graphicsView->size().height() - y;
+    _previousQtMouseY = (_image.valid() && _image->getOrigin()==osg::Image::TOP_LEFT) ? y : _graphicsView->size().height() - y;
 
     QPoint pos(_previousQtMouseX, _previousQtMouseY);
 
@@ -345,7 +374,8 @@ bool QGraphicsViewAdapter::handlePointerEvent(int x, int y, int buttonMask)
 {
     OSG_INFO<<"dispatchPointerEvent("<<x<<", "<<y<<", "<<buttonMask<<")"<<std::endl;
 
-    y = _graphicsView->size().height()-y;
+    // texture coordinates of a TOP_LEFT image already count rows from the top
+    if (!_image.valid() || _image->getOrigin()==osg::Image::BOTTOM_LEFT) y = _graphicsView->size().height()-y;
 
     bool leftButtonPressed = (buttonMask & osgGA::GUIEventAdapter::LEFT_MOUSE_BUTTON)!=0;
     bool middleButtonPressed = (buttonMask & osgGA::GUIEventAdapter::MIDDLE_MOUSE_BUTTON)!=0;
@@ -498,6 +528,14 @@ void QGraphicsViewAdapter::setFrameLastRendered(const osg::FrameStamp* frameStam
 
             std::swap(_currentRead, _previousWrite);
             _newImageAvailable = false;
+
+            // the texture holds the previous read image, it misses everything rendered since
+            _uploadRegion += _textureRegion;
+            _textureRegion = QRegion();
+
+            // past a handful of rectangles one upload of the bounds is cheaper than many small ones,
+            // this also keeps the region bounded when no SubloadCallback consumes it
+            if (_uploadRegion.rectCount() > s_maxUploadRects) _uploadRegion = _uploadRegion.boundingRect();
         }
 
         assignImage(_currentRead);
@@ -507,20 +545,129 @@ void QGraphicsViewAdapter::setFrameLastRendered(const osg::FrameStamp* frameStam
 void QGraphicsViewAdapter::clearWriteBuffer()
 {
     QImage& image = _qimages[_currentWrite];
-    image.fill(_backgroundColor.rgba ());
-    image = QGLWidget::convertToGLFormat(image);
+    image.fill(_backgroundColor);
+
+    const QRegion full(0, 0, image.width(), image.height());
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        if (i != _currentWrite) _bufferRegions[i] += full;
+    }
+    _bufferRegions[_currentWrite] = QRegion();
 
     // swap the write buffers in a thread safe way
     OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_qimagesMutex);
+    _textureRegion += full;
     std::swap(_currentWrite, _previousWrite);
     _newImageAvailable = true;
 }
 
+void QGraphicsViewAdapter::renderRegion(QImage& image, const QRegion& region)
+{
+    if (region.isEmpty()) return;
+
+    // paint the dirty rectangles with the graphics view
+    QPainter painter(&image);
+    for (QRegion::const_iterator itr = region.begin(); itr != region.end(); ++itr)
+    {
+        const QRect& rect = *itr;
+        painter.setClipRect(rect);
+
+        // Clear the rectangle otherwise there are artifacts for some widgets that overpaint.
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(rect, _backgroundColor);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+        _graphicsView->render(&painter, QRectF(rect), rect, Qt::IgnoreAspectRatio);
+    }
+    painter.end();
+}
+
+void QGraphicsViewAdapter::renderToPixelBufferRing()
+{
+    int width, height;
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_qresizeMutex);
+        if (_graphicsView->size().width() != _width || _graphicsView->size().height() != _height)
+        {
+            _graphicsView->setGeometry(0, 0, _width, _height);
+            _graphicsView->viewport()->setGeometry(0, 0, _width, _height);
+
+            _widget->setGeometry(0, 0, _width, _height);
+        }
+        width = _width;
+        height = _height;
+    }
+
+    const int slot = _pixelBufferRing->acquire(width, height);
+    if (slot < 0)
+    {
+        // every slot is queued or still read by the GPU, try again next frame rather than wait
+        _requiresRendering = true;
+        return;
+    }
+
+    const QRect bounds(0, 0, width, height);
+    if (!_renderingToRing)
+    {
+        for (unsigned int i = 0; i < PixelBufferRing::NUM_SLOTS; ++i)
+        {
+            _slotRegions[i] = bounds;
+        }
+        _renderingToRing = true;
+    }
+    if (_slotGenerations[slot] != _pixelBufferRing->generation(slot))
+    {
+        _slotGenerations[slot] = _pixelBufferRing->generation(slot);
+        _slotRegions[slot] = bounds;
+    }
+
+    const QRegion changed = _pendingRegion.intersected(bounds);
+    _pendingRegion = QRegion();
+    for (unsigned int i = 0; i < PixelBufferRing::NUM_SLOTS; ++i)
+    {
+        _slotRegions[i] += changed;
+    }
+    const QRegion paintRegion = _slotRegions[slot].intersected(bounds);
+    _slotRegions[slot] = QRegion();
+
+    // Qt paints straight into the mapped buffer, the draw thread uploads from it
+    QImage image(_pixelBufferRing->data(slot), width, height, _pixelBufferRing->bytesPerLine(slot), s_imageFormat);
+    renderRegion(image, paintRegion);
+    _pixelBufferRing->publish(slot, changed);
+
+    // the osg::Image keeps following the size, event handlers map texture coordinates through it
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_qimagesMutex);
+    if (!_newImageAvailable && _qimages[_currentRead].size() != bounds.size())
+    {
+        _qimages[_previousWrite] = QImage(width, height, s_imageFormat);
+        _qimages[_previousWrite].fill(_backgroundColor);
+        _newImageAvailable = true;
+    }
+}
+
 void QGraphicsViewAdapter::render()
 {
+    _requiresRendering = false;
+
+    if (_pixelBufferRing.valid() && _pixelBufferRing->isActive())
+    {
+        renderToPixelBufferRing();
+        return;
+    }
+
+    if (_renderingToRing)
+    {
+        // back from the ring, the QImages missed everything painted in the meantime
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            _bufferRegions[i] = QRegion(0, 0, _qimages[i].width(), _qimages[i].height());
+        }
+        _pendingRegion += QRect(0, 0, _width, _height);
+        _renderingToRing = false;
+    }
+
     OSG_INFO<<"Current write = "<<_currentWrite<<std::endl;
     QImage& image = _qimages[_currentWrite];
-    _requiresRendering = false;
 
     // If we got a resize, act on it, first by resizing the view, then the current image
 
@@ -538,46 +685,28 @@ void QGraphicsViewAdapter::render()
         {
             _qimages[_currentWrite] = QImage(_width, _height, s_imageFormat);
             image = _qimages[_currentWrite];
+            _bufferRegions[_currentWrite] = QRegion(0, 0, _width, _height);
         }
         OSG_INFO << "render image " << _currentWrite << " with size (" << _width << "," << _height << ")" <<std::endl;
     }
 
-#if 1
-    // paint the image with the graphics view
-    QPainter painter(&image);
-
-    // Clear the image otherwise there are artifacts for some widgets that overpaint.
-    painter.setCompositionMode(QPainter::CompositionMode_Source);
-    painter.fillRect(0, 0, image.width(), image.height(), _backgroundColor);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-
-    QRectF destinationRect(0, 0, image.width(), image.height());
-    QRect sourceRect(0, 0, image.width(), image.height());
-    _graphicsView->render(&painter, destinationRect, sourceRect, Qt::IgnoreAspectRatio);
-    painter.end();
-#elif 0
-    QPixmap pixmap(QPixmap::grabWidget(_graphicsView.data(), QRect(0, 0, image.width(), image.height())));
-    image = pixmap.toImage();
-#else
-    // paint the image with the graphics view
-    QPixmap pixmap(image.width(), image.height());
-    // Clear the image otherwise there are artifacts for some widgets that overpaint.
-    pixmap.fill(Qt::transparent);
-    QPainter painter(&pixmap);
-
-    QRectF destinationRect(0, 0, image.width(), image.height());
-    QRect sourceRect(0, 0, image.width(), image.height());
-    _graphicsView->render(&painter, destinationRect, _graphicsView->viewport()->rect());
-    painter.end();
-
-    image = pixmap.toImage();
-#endif
+    // every buffer has to catch up with what changed, the one painted now only for this render
+    const QRect bounds(0, 0, image.width(), image.height());
+    const QRegion changed = _pendingRegion.intersected(bounds);
+    _pendingRegion = QRegion();
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        _bufferRegions[i] += changed;
+    }
+    const QRegion paintRegion = _bufferRegions[_currentWrite].intersected(bounds);
+    _bufferRegions[_currentWrite] = QRegion();
 
-    // convert into OpenGL format - flipping around the Y axis and swizzling the pixels
-    image = QGLWidget::convertToGLFormat(image);
+    renderRegion(image, paintRegion);
 
     // swap the write buffers in a thread safe way
     OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_qimagesMutex);
+    _textureRegion += changed;
+    if (image.size() != _qimages[_currentRead].size()) _textureRegion += bounds;
     std::swap(_currentWrite, _previousWrite);
     _newImageAvailable = true;
 }
@@ -589,9 +718,21 @@ void QGraphicsViewAdapter::assignImage(unsigned int i)
 
     OSG_INFO<<"assignImage("<<i<<") image = "<<&image<<" size = ("<<image.width()<<","<<image.height()<<") data = "<<(void*)data<<std::endl;
 
+    const bool sizeChanged = _image->s() != image.width() || _image->t() != image.height();
+
     _image->setImage(image.width(), image.height(), 1,
                      4, GL_RGBA, GL_UNSIGNED_BYTE,
                      data, osg::Image::NO_DELETE, 1);
+    _image->setOrigin(osg::Image::TOP_LEFT);
+
+    if (sizeChanged) _uploadRegion = QRegion(0, 0, image.width(), image.height());
+}
+
+QRegion QGraphicsViewAdapter::takeUploadRegion()
+{
+    QRegion region;
+    std::swap(region, _uploadRegion);
+    return region;
 }
 
 void QGraphicsViewAdapter::resize(int width, int height)
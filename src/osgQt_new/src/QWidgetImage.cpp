@@ -12,11 +12,15 @@
 */
 
 #include <osgQt/QWidgetImage>
+#include <OpenThreads/ScopedLock>
 #include <QLayout>
 
 namespace osgQt
 {
 
+// a context that rarely subloads collects regions from all others, past this it uploads the bounds instead
+static const int s_maxPendingRects = 16;
+
 QWidgetImage::QWidgetImage( QWidget* widget )
 {
     // make sure we have a valid QApplication before we start creating widgets.
@@ -40,7 +44,8 @@ void QWidgetImage::clearWriteBuffer()
 
 void QWidgetImage::render()
 {
-    if (_adapter->requiresRendering()) _adapter->render();
+    PixelBufferRing* ring = _adapter->getPixelBufferRing();
+    if (_adapter->requiresRendering() || (ring && ring->takeRepaintRequest())) _adapter->render();
 }
 
 void QWidgetImage::scaleImage(int s,int t,int /*r*/, GLenum /*newDataType*/)
@@ -63,4 +68,111 @@ bool QWidgetImage::sendKeyEvent(int key, bool keyDown)
     return _adapter->sendKeyEvent(key, keyDown);
 }
 
+osg::Texture2D* QWidgetImage::createTexture(bool persistentPixelBuffers)
+{
+    if (persistentPixelBuffers && !_adapter->getPixelBufferRing()) _adapter->setPixelBufferRing(new PixelBufferRing);
+
+    osg::Texture2D* texture = new osg::Texture2D(this);
+    texture->setResizeNonPowerOfTwoHint(false);
+    texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+    texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+    texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+    texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+    texture->setSubloadCallback(new SubloadCallback(this));
+    return texture;
+}
+
+QWidgetImage::SubloadCallback::SubloadCallback(QWidgetImage* image):
+    _image(image),
+    _ring(image->_adapter ? image->_adapter->getPixelBufferRing() : 0)
+{
+}
+
+QRegion QWidgetImage::SubloadCallback::takePendingRegion(QWidgetImage& image, unsigned int contextID) const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_contextStatesMutex);
+
+    // operator[] grows the buffer, index contextID before walking the other contexts
+    QRegion& own = _contextStates[contextID].pending;
+
+    const QRegion region = image._adapter ? image._adapter->takeUploadRegion() : QRegion();
+    if (!region.isEmpty())
+    {
+        for (unsigned int i = 0; i < _contextStates.size(); ++i)
+        {
+            QRegion& pending = _contextStates[i].pending;
+            pending += region;
+            if (pending.rectCount() > s_maxPendingRects) pending = pending.boundingRect();
+        }
+    }
+
+    QRegion result;
+    std::swap(result, own);
+    return result;
+}
+
+void QWidgetImage::SubloadCallback::load(const osg::Texture2D& /*texture*/, osg::State& state) const
+{
+    if (_ring.valid() && _ring->upload(state, true)) return;
+
+    osg::ref_ptr<QWidgetImage> image;
+    if (!_image.lock(image) || !image->data()) return;
+
+    // the whole image goes up now, whatever this context had pending is covered; the other contexts keep theirs
+    const unsigned int contextID = state.getContextID();
+    takePendingRegion(*image, contextID);
+
+    const GLsizei width = image->s();
+    const GLsizei height = image->t();
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_contextStatesMutex);
+        _contextStates[contextID].width = width;
+        _contextStates[contextID].height = height;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, image->getPacking());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+                 image->getPixelFormat(), image->getDataType(), image->data());
+}
+
+void QWidgetImage::SubloadCallback::subload(const osg::Texture2D& texture, osg::State& state) const
+{
+    if (_ring.valid() && _ring->upload(state, false)) return;
+
+    osg::ref_ptr<QWidgetImage> image;
+    if (!_image.lock(image) || !image->data() || !image->_adapter) return;
+
+    const unsigned int contextID = state.getContextID();
+    GLsizei width = 0;
+    GLsizei height = 0;
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_contextStatesMutex);
+        width = _contextStates[contextID].width;
+        height = _contextStates[contextID].height;
+    }
+
+    if (image->s() != width || image->t() != height)
+    {
+        load(texture, state);
+        return;
+    }
+
+    const QRegion region = takePendingRegion(*image, contextID).intersected(QRect(0, 0, width, height));
+    if (region.isEmpty()) return;
+
+    // the rectangles are read in place, the unpack state picks them out of the full rows
+    glPixelStorei(GL_UNPACK_ALIGNMENT, image->getPacking());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, image->s());
+    for (QRegion::const_iterator itr = region.begin(); itr != region.end(); ++itr)
+    {
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, itr->x());
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, itr->y());
+        glTexSubImage2D(GL_TEXTURE_2D, 0, itr->x(), itr->y(), itr->width(), itr->height(),
+                        image->getPixelFormat(), image->getDataType(), image->data());
+    }
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
 }
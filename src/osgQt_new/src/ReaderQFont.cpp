@@ -10,6 +10,7 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
  * OpenSceneGraph Public License for more details.
 */
+#include <osg/Version>
 #include <osgDB/FileNameUtils>
 #include <osgDB/Registry>
 #include <osgText/Font>
@@ -21,6 +22,8 @@
 
 #include <osgQt/QFontImplementation>
 
+#include <sstream>
+
 namespace osgQFont {
 
 class ReaderQFont : public osgDB::ReaderWriter
@@ -29,11 +32,26 @@ class ReaderQFont : public osgDB::ReaderWriter
         ReaderQFont()
         {
             supportsExtension("qfont", "Qt font meta loader");
+            supportsOption("sdf", "Generate signed distance field glyphs shared by all text sizes");
         }
 
         virtual const char* className() const { return "QFont Font Reader"; }
 
-        virtual ReadResult readObject(const std::string& file, const osgDB::ReaderWriter::Options* /*options*/) const
+        /** Options are whitespace separated words; "sdf" must be one of them, not part of another word. */
+        static bool hasOption(const osgDB::ReaderWriter::Options* options, const std::string& name)
+        {
+            if (!options) return false;
+
+            std::istringstream stream(options->getOptionString());
+            std::string word;
+            while (stream >> word)
+            {
+                if (word == name) return true;
+            }
+            return false;
+        }
+
+        virtual ReadResult readObject(const std::string& file, const osgDB::ReaderWriter::Options* options) const
         {
             if (!acceptsExtension(osgDB::getLowerCaseFileExtension(file)))
                 return ReadResult::FILE_NOT_HANDLED;
@@ -55,12 +73,20 @@ class ReaderQFont : public osgDB::ReaderWriter
             if (!font.fromString(QString::fromStdString(osgDB::getNameLessExtension(file))))
                 return ReadResult::FILE_NOT_FOUND;
 
-            return new osgText::Font(new osgQt::QFontImplementation(font));
+            if (!hasOption(options, "sdf"))
+                return new osgText::Font(new osgQt::QFontImplementation(font));
+
+            osg::ref_ptr<osgText::Font> sdfFont = new osgText::Font(new osgQt::QFontImplementation(font, osgQt::QFontImplementation::SIGNED_DISTANCE_FIELD));
+#if OSG_VERSION_GREATER_OR_EQUAL(3,6,0)
+            // the glyphs already are distance fields, osgText must copy them verbatim instead of deriving its own
+            sdfFont->setShaderTechnique(osgText::GREYSCALE);
+#endif
+            return sdfFont.release();
         }
 };
 
 // now register with Registry to instantiate the above
-// reader/writer.
+// reader/writer. Static builds must reference it with USE_OSGPLUGIN(qfont).
 REGISTER_OSGPLUGIN(qfont, ReaderQFont)
 
 }
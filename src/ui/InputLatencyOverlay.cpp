@@ -0,0 +1,253 @@
+#include "ui/InputLatencyOverlay.h"
+
+#include "core/InputLatencyTracer.h"
+
+#include <QDebug>
+#include <QFontDatabase>
+
+#include <osg/Camera>
+#include <osg/Geode>
+#include <osg/GraphicsContext>
+#include <osg/NodeCallback>
+#include <osg/StateSet>
+#include <osg/Viewport>
+#include <osgDB/Options>
+#include <osgDB/Registry>
+#include <osgGA/EventQueue>
+#include <osgGA/GUIEventHandler>
+#include <osgQt/QFontImplementation>
+#include <osgText/Font>
+#include <osgText/Text>
+#include <osgViewer/GraphicsWindow>
+#include <osgViewer/View>
+
+#include <string>
+#include <vector>
+
+// earth_osgqt 是静态库，ReaderQFont.o 无人引用时会被链接器丢弃；在此引用才能注册 qfont 读取器。
+USE_OSGPLUGIN(qfont)
+
+namespace earth::ui {
+namespace {
+constexpr int kRefreshIntervalMs = 250;
+constexpr float kCharacterSize = 14.0F;
+constexpr float kMargin = 10.0F;
+
+using Tracer = core::InputLatencyTracer;
+
+bool isInputEvent(osgGA::GUIEventAdapter::EventType type) {
+    switch (type) {
+    case osgGA::GUIEventAdapter::PUSH:
+    case osgGA::GUIEventAdapter::RELEASE:
+    case osgGA::GUIEventAdapter::DOUBLECLICK:
+    case osgGA::GUIEventAdapter::DRAG:
+    case osgGA::GUIEventAdapter::MOVE:
+    case osgGA::GUIEventAdapter::KEYDOWN:
+    case osgGA::GUIEventAdapter::KEYUP:
+    case osgGA::GUIEventAdapter::SCROLL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+unsigned int frameNumberOf(const osg::FrameStamp* stamp) {
+    return stamp != nullptr ? stamp->getFrameNumber() : 0U;
+}
+} // namespace
+
+/**
+ * @brief 位于事件处理器链首，事件遍历取出输入事件时打点；事件时间换算为 osg::Timer 刻度后即为 Qt 投递时刻。
+ */
+class InputLatencyOverlay::DispatchStamp : public osgGA::GUIEventHandler {
+public:
+    explicit DispatchStamp(osgViewer::GraphicsWindow* window)
+        : m_window(window) {
+    }
+
+    bool handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa) override {
+        osg::ref_ptr<osgViewer::GraphicsWindow> window;
+        if (!isInputEvent(ea.getEventType()) || aa.asView() == nullptr || !m_window.lock(window) ||
+            window->getEventQueue() == nullptr) {
+            return false;
+        }
+
+        const osg::Timer* timer = osg::Timer::instance();
+        const auto eventTick = window->getEventQueue()->getStartTick() +
+                               static_cast<osg::Timer_t>(ea.getTime() / timer->getSecondsPerTick());
+        Tracer::instance().markInput(frameNumberOf(aa.asView()->getFrameStamp()), eventTick, timer->tick());
+        return false;
+    }
+
+private:
+    osg::observer_ptr<osgViewer::GraphicsWindow> m_window;
+};
+
+/**
+ * @brief 主相机剔除开始。
+ */
+class InputLatencyOverlay::CullStamp : public osg::NodeCallback {
+public:
+    void operator()(osg::Node* node, osg::NodeVisitor* nv) override {
+        Tracer::instance().markStage(Tracer::Stage::Cull, frameNumberOf(nv->getFrameStamp()), osg::Timer::instance()->tick());
+        traverse(node, nv);
+    }
+};
+
+/**
+ * @brief 主相机绘制开始。
+ */
+class InputLatencyOverlay::DrawStamp : public osg::Camera::DrawCallback {
+public:
+    void operator()(osg::RenderInfo& renderInfo) const override {
+        Tracer::instance().markStage(Tracer::Stage::Draw, frameNumberOf(renderInfo.getState()->getFrameStamp()),
+                                     osg::Timer::instance()->tick());
+    }
+};
+
+/**
+ * @brief 包装原有交换回调，SwapBuffers 返回后打点并结束该帧样本。
+ */
+class InputLatencyOverlay::SwapStamp : public osg::GraphicsContext::SwapCallback {
+public:
+    explicit SwapStamp(osg::GraphicsContext::SwapCallback* previous)
+        : m_previous(previous) {
+    }
+
+    void swapBuffersImplementation(osg::GraphicsContext* gc) override {
+        if (m_previous.valid()) {
+            m_previous->swapBuffersImplementation(gc);
+        } else {
+            gc->swapBuffersImplementation();
+        }
+        const osg::State* state = gc->getState();
+        Tracer::instance().markStage(Tracer::Stage::Swap, frameNumberOf(state != nullptr ? state->getFrameStamp() : nullptr),
+                                     osg::Timer::instance()->tick());
+    }
+
+    osg::GraphicsContext::SwapCallback* previous() const { return m_previous.get(); }
+
+private:
+    osg::ref_ptr<osg::GraphicsContext::SwapCallback> m_previous;
+};
+
+InputLatencyOverlay::InputLatencyOverlay(osgViewer::View* view, osgViewer::GraphicsWindow* window)
+    : m_view(view)
+    , m_window(window) {
+    if (view == nullptr || window == nullptr) {
+        return;
+    }
+
+    m_dispatchStamp = new DispatchStamp(window);
+    view->getEventHandlers().push_front(m_dispatchStamp.get());
+
+    osg::Camera* camera = view->getCamera();
+    m_cullStamp = new CullStamp();
+    camera->addCullCallback(m_cullStamp.get());
+    m_drawStamp = new DrawStamp();
+    camera->addInitialDrawCallback(m_drawStamp.get());
+
+    m_swapStamp = new SwapStamp(window->getSwapCallback());
+    window->setSwapCallback(m_swapStamp.get());
+
+    m_text = new osgText::Text();
+    m_text->setDataVariance(osg::Object::DYNAMIC);
+    m_text->setCharacterSize(kCharacterSize);
+    m_text->setAxisAlignment(osgText::TextBase::SCREEN);
+    m_text->setAlignment(osgText::TextBase::LEFT_TOP);
+    m_text->setColor(osg::Vec4(1.0F, 1.0F, 0.6F, 1.0F));
+    m_text->setBackdropType(osgText::Text::OUTLINE);
+    m_text->setText("input latency: waiting for input");
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable(m_text.get());
+    osg::StateSet* stateSet = geode->getOrCreateStateSet();
+    stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    stateSet->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+
+    // 等宽系统字体经 qfont 插件以距离场字形加载，表格列对齐且缩放不糊；加载失败时保留 osgText 默认字体。
+    const std::string fontName = QFontDatabase::systemFont(QFontDatabase::FixedFont).toString().toStdString() + ".qfont";
+    osg::ref_ptr<osgDB::Options> fontOptions = new osgDB::Options("sdf");
+    osg::ref_ptr<osgText::Font> font = osgText::readRefFontFile(fontName, fontOptions.get());
+    auto* implementation = font.valid() ? dynamic_cast<osgQt::QFontImplementation*>(font->getImplementation()) : nullptr;
+    if (implementation != nullptr
+        && implementation->getGlyphMode() == osgQt::QFontImplementation::SIGNED_DISTANCE_FIELD) {
+        std::vector<unsigned int> charcodes;
+        for (unsigned int charcode = 0x20; charcode < 0x7F; ++charcode) {
+            charcodes.push_back(charcode);
+        }
+        implementation->prepareGlyphs(charcodes);
+        m_text->setFont(font.get());
+        osgQt::QFontImplementation::applySignedDistanceFieldShader(stateSet);
+    } else {
+        qWarning() << "[InputLatency] 无法以距离场字形加载" << QString::fromStdString(fontName)
+                   << "，使用 osgText 默认字体";
+    }
+
+    // 独立场景的从相机，与主相机共用图形上下文，在主场景之后绘制。
+    m_hudCamera = new osg::Camera();
+    m_hudCamera->setName("InputLatencyHud");
+    m_hudCamera->setGraphicsContext(window);
+    m_hudCamera->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+    m_hudCamera->setViewMatrix(osg::Matrix::identity());
+    m_hudCamera->setClearMask(GL_DEPTH_BUFFER_BIT);
+    m_hudCamera->setRenderOrder(osg::Camera::POST_RENDER);
+    m_hudCamera->setAllowEventFocus(false);
+    m_hudCamera->addChild(geode.get());
+    view->addSlave(m_hudCamera.get(), false);
+    update();
+
+    Tracer::instance().setEnabled(true);
+}
+
+InputLatencyOverlay::~InputLatencyOverlay() {
+    Tracer::instance().setEnabled(false);
+
+    osg::ref_ptr<osgViewer::View> view;
+    if (m_view.lock(view)) {
+        view->getEventHandlers().remove(m_dispatchStamp);
+        if (osg::Camera* camera = view->getCamera()) {
+            camera->removeCullCallback(m_cullStamp.get());
+            camera->removeInitialDrawCallback(m_drawStamp.get());
+        }
+        const unsigned int slave = view->findSlaveIndexForCamera(m_hudCamera.get());
+        if (slave < view->getNumSlaves()) {
+            view->removeSlave(slave);
+        }
+    }
+
+    osg::ref_ptr<osgViewer::GraphicsWindow> window;
+    if (m_window.lock(window) && m_swapStamp.valid() && window->getSwapCallback() == m_swapStamp.get()) {
+        window->setSwapCallback(m_swapStamp->previous());
+    }
+}
+
+void InputLatencyOverlay::update() {
+    osg::ref_ptr<osgViewer::View> view;
+    if (!m_hudCamera.valid() || !m_view.lock(view)) {
+        return;
+    }
+
+    const osg::Viewport* viewport = view->getCamera()->getViewport();
+    const osg::Viewport* hudViewport = m_hudCamera->getViewport();
+    if (viewport != nullptr && (hudViewport == nullptr || hudViewport->width() != viewport->width() ||
+                                hudViewport->height() != viewport->height())) {
+        const double width = viewport->width();
+        const double height = viewport->height();
+        m_hudCamera->setViewport(new osg::Viewport(0.0, 0.0, width, height));
+        m_hudCamera->setProjectionMatrixAsOrtho2D(0.0, width, 0.0, height);
+        m_text->setPosition(osg::Vec3(kMargin, static_cast<float>(height) - kMargin, 0.0F));
+    }
+
+    if (m_refreshTimer.isValid() && m_refreshTimer.elapsed() < kRefreshIntervalMs) {
+        return;
+    }
+    m_refreshTimer.start();
+
+    const Tracer::Summary summary = Tracer::instance().summarize();
+    if (summary.stages[static_cast<std::size_t>(Tracer::Stage::Swap)].samples > 0) {
+        m_text->setText(Tracer::formatSummary(summary).toStdString());
+    }
+}
+
+} // namespace earth::ui
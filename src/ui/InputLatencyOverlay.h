@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QElapsedTimer>
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+namespace osg {
+class Camera;
+class GraphicsContext;
+}
+
+namespace osgText {
+class Text;
+}
+
+namespace osgViewer {
+class GraphicsWindow;
+class View;
+}
+
+namespace earth::ui {
+
+/**
+ * @brief 为 core::InputLatencyTracer 在视图上挂接打点钩子，并以 HUD 叠加层显示延迟分布。
+ *
+ * 钩子依次位于：事件处理器链首（取出输入事件）、主相机剔除回调、主相机初始绘制回调与图形上下文的交换回调；
+ * 绘制工具的处理器阶段由 MapDrawingEventHandler 自行打点。析构时全部摘除并恢复原有交换回调。
+ */
+class InputLatencyOverlay final {
+public:
+    InputLatencyOverlay(osgViewer::View* view, osgViewer::GraphicsWindow* window);
+    ~InputLatencyOverlay();
+
+    InputLatencyOverlay(const InputLatencyOverlay&) = delete;
+    InputLatencyOverlay& operator=(const InputLatencyOverlay&) = delete;
+
+    /**
+     * @brief 每帧在 GUI 线程调用：跟随主相机视口，并按固定间隔刷新 HUD 文本。
+     */
+    void update();
+
+private:
+    class DispatchStamp;
+    class CullStamp;
+    class DrawStamp;
+    class SwapStamp;
+
+    osg::observer_ptr<osgViewer::View> m_view;
+    osg::observer_ptr<osgViewer::GraphicsWindow> m_window;
+    osg::ref_ptr<DispatchStamp> m_dispatchStamp;
+    osg::ref_ptr<CullStamp> m_cullStamp;
+    osg::ref_ptr<DrawStamp> m_drawStamp;
+    osg::ref_ptr<SwapStamp> m_swapStamp;
+    osg::ref_ptr<osg::Camera> m_hudCamera;
+    osg::ref_ptr<osgText::Text> m_text;
+    QElapsedTimer m_refreshTimer;
+};
+
+} // namespace earth::ui
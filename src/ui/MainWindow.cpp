@@ -1,28 +1,68 @@
 #include "ui/MainWindow.h"
 
+#include "core/EnvironmentBootstrapper.h"
+#include "core/FrameMetrics.h"
+#include "core/InputLatencyTracer.h"
 #include "core/SimulationBootstrapper.h"
+#include "core/SkyQualitySettings.h"
+#include "core/SkyTimeController.h"
 #include "ui/SceneWidget.h"
 #include "ui/draw/MapDrawingController.h"
 
+#ifdef EARTH_ENABLE_AIRTRAFFIC
+#include "airtraffic/AirTrafficLayer.h"
+#include "airtraffic/TrackRecorder.h"
+#include "airtraffic/TrackReplayPlayer.h"
+#endif
+
+#ifdef EARTH_ENABLE_DATABRIDGE
+#include "databridge/DataBridgeService.h"
+#endif
+
+#ifdef EARTH_ENABLE_WEATHER
+#include "weather/WeatherSystem.h"
+#endif
+
+#ifdef EARTH_ENABLE_WIND
+#include "wind/WindLayer.h"
+#endif
+
+#ifdef EARTH_ENABLE_VISION
+#include "vision/RunwayMonitor.h"
+#endif
+
 #include <QAction>
 #include <QActionGroup>
 #include <QColorDialog>
+#include <QComboBox>
+#include <QDateEdit>
+#include <QDateTime>
 #include <QDialog>
+#include <QDir>
 #include <QDialogButtonBox>
 #include <QDoubleSpinBox>
 #include <QFileDialog>
 #include <QFormLayout>
+#include <QInputDialog>
 #include <QLabel>
 #include <QList>
+#include <QMenu>
+#include <QMenuBar>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QSignalBlocker>
+#include <QSlider>
 #include <QStatusBar>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include <algorithm>
 #include <cmath>
 
+#include <osg/Math>
+#include <osgEarth/GeoData>
 #include <osgEarth/MapNode>
 #include <osgDB/ReadFile>
 
@@ -31,6 +71,10 @@
 namespace {
 using ColorRgba = earth::ui::draw::ColorRgba;
 
+constexpr int kSkyCalibrationDelayMs = 2000;
+constexpr int kSkyCalibrationWarmupFrames = 10;
+constexpr int kSkyCalibrationFrames = 30;
+
 ColorRgba toRgba(const QColor& color) {
     return {
         static_cast<float>(color.redF()),
@@ -67,6 +111,10 @@ void MainWindow::initializeSimulation() {
         return;
     }
 
+    // 先读取天空画质配置，使内置 SkyNode 首次创建即使用上次校准/覆盖的档位。
+    core::EnvironmentBootstrapper::instance().initialize();
+    m_skyQuality = std::make_unique<core::SkyQualitySettings>(core::SkyQualitySettings::load());
+    m_bootstrapper->setSkyQuality(m_skyQuality->effectiveQuality(), m_skyQuality->ambient);
     m_bootstrapper->initialize();
 
     if (m_ui->openGLWidget != nullptr) {
@@ -107,9 +155,11 @@ void MainWindow::initializeSimulation() {
                             .arg(QString::number(lon, 'f', 6))
                             .arg(QString::number(lat, 'f', 6))
                             .arg(QString::number(height, 'f', 1)));
+                    updateWindReadout(lon, lat, height);
                 });
         connect(m_ui->openGLWidget, &SceneWidget::frameRateChanged, this,
                 [this](double fps) {
+                    m_lastFps = fps;
                     if (!m_fpsLabel) return;
                     if (fps <= 0.0) {
                         m_fpsLabel->setText(tr("帧率: -- FPS"));
@@ -118,14 +168,23 @@ void MainWindow::initializeSimulation() {
                             tr("帧率: %1 FPS").arg(QString::number(fps, 'f', 1)));
                     }
                 });
+        connect(m_ui->openGLWidget, &SceneWidget::frameMetricsChanged, this,
+                [this](const QString& summary) {
+                    if (!m_fpsLabel) return;
+                    m_fpsLabel->setToolTip(summary);
+                });
     }
 
     ensureDrawingController();
+    ensureAirTrafficLayer();
+    ensureWeatherSystem();
+    ensureWindLayer();
 }
 
 void MainWindow::registerActionHandlers() {
     // 为AddEarth动作添加特殊处理，连接到openEarthFile槽函数
     connect(m_ui->AddEarth, &QAction::triggered, this, &MainWindow::openEarthFile);
+    connect(m_ui->ChangeTime, &QAction::triggered, this, &MainWindow::editSkyTime);
     
     const QList<QAction*> actions = {
         m_ui->SetLosHeight,
@@ -152,16 +211,18 @@ void MainWindow::registerActionHandlers() {
         m_ui->AddPolygon,
         m_ui->AddCircle,
         m_ui->FogEffect,
+#ifndef EARTH_ENABLE_WEATHER
         m_ui->Rain,
         m_ui->Snow,
         m_ui->Cloud,
+        m_ui->Fire,
+#endif
         m_ui->AddElevation,
         m_ui->VisibilityAnalysis,
         m_ui->ViewshedAnalysis,
         m_ui->RadarAnalysis,
         m_ui->WaterAnalysis,
         m_ui->TerrainProfileAnalysis,
-        m_ui->Fire,
         m_ui->Distance,
         m_ui->Area,
         m_ui->Angle,
@@ -178,7 +239,6 @@ void MainWindow::registerActionHandlers() {
         m_ui->GatheringPlace,
         m_ui->ParallelSearch,
         m_ui->SectorSearch,
-        m_ui->ChangeTime,
     };
 
     for (QAction* action : actions) {
@@ -186,6 +246,12 @@ void MainWindow::registerActionHandlers() {
     }
 
     setupDrawingActions();
+    setupReplayActions();
+    setupWeatherActions();
+    setupWindActions();
+    setupVisionActions();
+    setupSkyQualityActions();
+    setupLatencyActions();
 }
 
 void MainWindow::bindAction(QAction* action) {
@@ -270,6 +336,10 @@ bool MainWindow::loadEarthFile(const QString& filePath) {
     }
 
     ensureDrawingController();
+    ensureAirTrafficLayer();
+    ensureWeatherSystem();
+    ensureWindLayer();
+    ensureRunwayMonitor();
     
     return true;
 }
@@ -470,6 +540,914 @@ void MainWindow::applyDrawingStyle() {
     m_drawingController->setStrokeThickness(static_cast<float>(m_penThickness));
 }
 
+void MainWindow::ensureAirTrafficLayer() {
+#ifdef EARTH_ENABLE_AIRTRAFFIC
+    if (!m_airTrafficLayer) {
+        m_airTrafficLayer = std::make_unique<airtraffic::AirTrafficLayer>();
+        m_trackRecorder = std::make_unique<airtraffic::TrackRecorder>();
+        m_replayPlayer = std::make_unique<airtraffic::TrackReplayPlayer>();
+        m_airTrafficLayer->setRecorder(m_trackRecorder.get());
+        connectDataBridge();
+    }
+    if (m_bootstrapper) {
+        m_airTrafficLayer->setMapNode(m_bootstrapper->activeMapNode());
+    }
+#endif
+}
 
-} // namespace earth::ui
+void MainWindow::connectDataBridge() {
+#if defined(EARTH_ENABLE_DATABRIDGE) && defined(EARTH_ENABLE_AIRTRAFFIC)
+    if (!m_airTrafficLayer) {
+        return;
+    }
+    if (!m_dataBridge) {
+        m_dataBridge = std::make_unique<databridge::DataBridgeService>();
+    }
+
+    const auto transport = m_dataBridge->start();
+    if (auto* sb = statusBar()) {
+        sb->showMessage(tr("数据桥接: %1").arg(databridge::DataBridgeService::transportName(transport)), 4000);
+    }
+
+    // 每帧在 update 遍历中直接读取共享内存，把实体状态转换为航迹报文；
+    // 录制时原始实体状态另以 DataBridge 来源写入日志，保留航迹报文中没有的字段（如 flags、发布时刻）。
+    databridge::DataBridgeService* bridge = m_dataBridge.get();
+    airtraffic::TrackRecorder* recorder = m_trackRecorder.get();
+    airtraffic::TrackReplayPlayer* player = m_replayPlayer.get();
+    auto entities = std::make_shared<std::vector<databridge::EntityState>>();
+    m_airTrafficLayer->setReportSource([bridge, recorder, player, entities](std::vector<airtraffic::TrackReport>& out) {
+        const bool recording = recorder != nullptr && recorder->isRecording() && (player == nullptr || !player->isOpen());
+        entities->clear();
+        bridge->poll([&out, &entities, recording](const databridge::EntityState& state) {
+            if (recording) {
+                entities->push_back(state);
+            }
+            airtraffic::TrackReport report;
+            report.trackId = state.entityId;
+            report.timestampSec = state.timestampSec;
+            report.longitudeDeg = state.longitudeDeg;
+            report.latitudeDeg = state.latitudeDeg;
+            report.altitudeMeters = state.altitudeMeters;
+            report.groundSpeedMps = state.groundSpeedMps;
+            report.trackDeg = state.trackDeg;
+            report.verticalRateMps = state.verticalRateMps;
+            out.push_back(report);
+        });
+        if (recording && !entities->empty()) {
+            const double nowSec = static_cast<double>(QDateTime::currentMSecsSinceEpoch()) / 1000.0;
+            recorder->recordRaw(nowSec, databridge::kEntityBatchRecordType, core::replay::RecordSource::DataBridge,
+                                entities->data(),
+                                static_cast<std::uint32_t>(entities->size() * sizeof(databridge::EntityState)));
+        }
+    });
+#endif
+}
+
+void MainWindow::setupReplayActions() {
+#ifdef EARTH_ENABLE_AIRTRAFFIC
+    QMenu* replayMenu = menuBar()->addMenu(tr("回放"));
+
+    QAction* recordAction = replayMenu->addAction(tr("录制航迹"));
+    recordAction->setCheckable(true);
+    connect(recordAction, &QAction::toggled, this, [this, recordAction](bool checked) {
+        if (!m_trackRecorder) {
+            return;
+        }
+        if (!checked) {
+            const QString path = m_trackRecorder->filePath();
+            m_trackRecorder->stop();
+            if (auto* sb = statusBar()) {
+                sb->showMessage(tr("航迹录制已保存: %1").arg(path), 5000);
+            }
+            return;
+        }
+
+        const QDir replayDir(QDir(core::EnvironmentBootstrapper::instance().dataRoot()).filePath(QStringLiteral("replay")));
+        const QString path = replayDir.filePath(
+            QStringLiteral("track-%1.erpl").arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"))));
+        if (!m_trackRecorder->start(path)) {
+            QSignalBlocker blocker(recordAction);
+            recordAction->setChecked(false);
+            QMessageBox::warning(this, tr("录制失败"), tr("无法创建录制文件: %1").arg(path));
+            return;
+        }
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("开始录制航迹: %1").arg(path), 5000);
+        }
+    });
+
+    QAction* openAction = replayMenu->addAction(tr("打开回放日志..."));
+    connect(openAction, &QAction::triggered, this, [this]() {
+        if (!m_replayPlayer || !m_airTrafficLayer) {
+            return;
+        }
+        const QString filePath = QFileDialog::getOpenFileName(
+            this, tr("打开回放日志"),
+            QDir(core::EnvironmentBootstrapper::instance().dataRoot()).filePath(QStringLiteral("replay")),
+            tr("回放日志 (*.erpl);;所有文件 (*.*)"));
+        if (filePath.isEmpty()) {
+            return;
+        }
+        if (!m_replayPlayer->open(filePath)) {
+            QMessageBox::warning(this, tr("回放失败"), tr("无法打开回放日志: %1").arg(filePath));
+            return;
+        }
+        m_airTrafficLayer->setReplayPlayer(m_replayPlayer.get());
+        m_replayPlayer->play();
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("回放中，时长 %1 秒").arg(m_replayPlayer->endTime() - m_replayPlayer->startTime(), 0, 'f', 1),
+                            5000);
+        }
+    });
+
+    QAction* pauseAction = replayMenu->addAction(tr("暂停/继续"));
+    connect(pauseAction, &QAction::triggered, this, [this]() {
+        if (!m_replayPlayer || !m_replayPlayer->isOpen()) {
+            return;
+        }
+        if (m_replayPlayer->isPlaying()) {
+            m_replayPlayer->pause();
+        } else {
+            m_replayPlayer->play();
+        }
+    });
+
+    QAction* seekAction = replayMenu->addAction(tr("定位..."));
+    connect(seekAction, &QAction::triggered, this, [this]() {
+        if (!m_replayPlayer || !m_replayPlayer->isOpen()) {
+            return;
+        }
+        const double duration = m_replayPlayer->endTime() - m_replayPlayer->startTime();
+        bool ok = false;
+        const double offset = QInputDialog::getDouble(
+            this, tr("回放定位"), tr("距起点（秒）"), m_replayPlayer->currentTime() - m_replayPlayer->startTime(), 0.0,
+            duration, 1, &ok);
+        if (ok) {
+            m_replayPlayer->seek(m_replayPlayer->startTime() + offset);
+        }
+    });
+
+    QAction* speedAction = replayMenu->addAction(tr("倍速..."));
+    connect(speedAction, &QAction::triggered, this, [this]() {
+        if (!m_replayPlayer) {
+            return;
+        }
+        bool ok = false;
+        const double speed = QInputDialog::getDouble(this, tr("回放倍速"), tr("倍速"), m_replayPlayer->speed(),
+                                                     airtraffic::TrackReplayPlayer::kMinSpeed,
+                                                     airtraffic::TrackReplayPlayer::kMaxSpeed, 1, &ok);
+        if (ok) {
+            m_replayPlayer->setSpeed(speed);
+        }
+    });
+
+    QAction* stopAction = replayMenu->addAction(tr("退出回放"));
+    connect(stopAction, &QAction::triggered, this, [this]() {
+        if (!m_replayPlayer || !m_airTrafficLayer) {
+            return;
+        }
+        m_airTrafficLayer->setReplayPlayer(nullptr);
+        m_replayPlayer->close();
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("已退出回放，恢复实时航迹"), 4000);
+        }
+    });
+#endif
+}
+
+void MainWindow::editSkyTime() {
+    if (!m_bootstrapper) {
+        return;
+    }
+    if (m_skyTimeDialog != nullptr) {
+        m_skyTimeDialog->show();
+        m_skyTimeDialog->raise();
+        return;
+    }
+
+    core::SkyTimeController& clock = m_bootstrapper->skyTime();
+    m_skyTimeDialog = new QDialog(this);
+    m_skyTimeDialog->setWindowTitle(tr("天空时间"));
+
+    auto* layout = new QVBoxLayout(m_skyTimeDialog);
+    auto* form = new QFormLayout();
+    layout->addLayout(form);
+
+    auto* modeCombo = new QComboBox();
+    modeCombo->addItem(tr("手动"), static_cast<int>(core::SkyClockMode::Manual));
+    modeCombo->addItem(tr("实时"), static_cast<int>(core::SkyClockMode::Realtime));
+    modeCombo->addItem(tr("加速"), static_cast<int>(core::SkyClockMode::Accelerated));
+    modeCombo->setCurrentIndex(modeCombo->findData(static_cast<int>(clock.mode())));
+    auto* scaleSpin = new QDoubleSpinBox();
+    scaleSpin->setRange(1.0, 3600.0);
+    scaleSpin->setDecimals(0);
+    scaleSpin->setSuffix(tr(" 倍"));
+    scaleSpin->setValue(clock.timeScale());
+    auto* dateEdit = new QDateEdit();
+    dateEdit->setDisplayFormat(QStringLiteral("yyyy-MM-dd"));
+    dateEdit->setCalendarPopup(true);
+    auto* timeSlider = new QSlider(Qt::Horizontal);
+    timeSlider->setRange(0, 24 * 60 - 1);
+    auto* timeLabel = new QLabel();
+
+    form->addRow(tr("模式"), modeCombo);
+    form->addRow(tr("加速倍率"), scaleSpin);
+    form->addRow(tr("日期 (UTC)"), dateEdit);
+    form->addRow(tr("时刻"), timeSlider);
+    form->addRow(QString(), timeLabel);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::rejected, m_skyTimeDialog, &QDialog::hide);
+
+    // 控件只反映控制器推算的时刻；实时/加速模式下由定时器刷新，刷新时屏蔽信号避免回写。
+    const auto syncWidgets = [this, dateEdit, timeSlider, timeLabel]() {
+        const QDateTime current = QDateTime::fromMSecsSinceEpoch(
+            static_cast<qint64>(m_bootstrapper->skyTime().epochSeconds() * 1000.0), Qt::UTC);
+        const QSignalBlocker dateBlocker(dateEdit);
+        const QSignalBlocker sliderBlocker(timeSlider);
+        dateEdit->setDate(current.date());
+        timeSlider->setValue(current.time().hour() * 60 + current.time().minute());
+        timeLabel->setText(current.toString(QStringLiteral("yyyy-MM-dd HH:mm 'UTC'")));
+    };
+    const auto applyManualTime = [this, dateEdit, timeSlider, modeCombo, syncWidgets]() {
+        // 拖动滑块或改日期即切回手动模式，滑块信号再密集，控制器每帧也只下发一次。
+        core::SkyTimeController& skyTime = m_bootstrapper->skyTime();
+        skyTime.setMode(core::SkyClockMode::Manual);
+        {
+            const QSignalBlocker blocker(modeCombo);
+            modeCombo->setCurrentIndex(modeCombo->findData(static_cast<int>(core::SkyClockMode::Manual)));
+        }
+        const QDateTime target(dateEdit->date(), QTime(0, 0).addSecs(timeSlider->value() * 60), Qt::UTC);
+        skyTime.setEpochSeconds(static_cast<double>(target.toMSecsSinceEpoch()) / 1000.0);
+        syncWidgets();
+    };
+
+    connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, modeCombo, syncWidgets]() {
+        m_bootstrapper->skyTime().setMode(static_cast<core::SkyClockMode>(modeCombo->currentData().toInt()));
+        syncWidgets();
+    });
+    connect(scaleSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+            [this](double value) { m_bootstrapper->skyTime().setTimeScale(value); });
+    connect(dateEdit, &QDateEdit::dateChanged, this, applyManualTime);
+    connect(timeSlider, &QSlider::valueChanged, this, applyManualTime);
+
+    auto* refreshTimer = new QTimer(m_skyTimeDialog);
+    refreshTimer->setInterval(500);
+    connect(refreshTimer, &QTimer::timeout, this, [this, syncWidgets]() {
+        if (m_bootstrapper->skyTime().mode() != core::SkyClockMode::Manual) {
+            syncWidgets();
+        }
+    });
+    refreshTimer->start();
+
+    syncWidgets();
+    m_skyTimeDialog->show();
+}
+
+void MainWindow::setupSkyQualityActions() {
+    if (m_ui->ParamSetting == nullptr || !m_skyQuality) {
+        return;
+    }
+
+    QMenu* qualityMenu = m_ui->ParamSetting->addMenu(tr("天空画质"));
+    m_skyQualityGroup = new QActionGroup(this);
+    m_skyQualityGroup->setExclusive(true);
+    for (const osgEarth::SkyOptions::Quality quality :
+         {osgEarth::SkyOptions::QUALITY_DEFAULT, osgEarth::SkyOptions::QUALITY_LOW,
+          osgEarth::SkyOptions::QUALITY_MEDIUM, osgEarth::SkyOptions::QUALITY_HIGH}) {
+        QAction* action = qualityMenu->addAction(core::skyQualityName(quality));
+        action->setCheckable(true);
+        action->setData(static_cast<int>(quality));
+        m_skyQualityGroup->addAction(action);
+    }
+    connect(m_skyQualityGroup, &QActionGroup::triggered, this, [this](QAction* action) {
+        m_skyQuality->overrideQuality = static_cast<osgEarth::SkyOptions::Quality>(action->data().toInt());
+        m_skyQuality->save();
+        applySkyQuality();
+    });
+
+    qualityMenu->addSeparator();
+    QAction* recalibrateAction = qualityMenu->addAction(tr("重新校准"));
+    connect(recalibrateAction, &QAction::triggered, this, &MainWindow::calibrateSkyQuality);
+    applySkyQuality();
+
+    // 首次启动或更换显卡后，等窗口显示、场景稳定后自动校准；操作员已手动指定档位时不打扰。
+    QTimer::singleShot(kSkyCalibrationDelayMs, this, [this]() {
+        if (m_skyQuality->overrideQuality != osgEarth::SkyOptions::QUALITY_DEFAULT || m_ui->openGLWidget == nullptr) {
+            return;
+        }
+        if (m_skyQuality->needsCalibration(m_ui->openGLWidget->rendererName())) {
+            calibrateSkyQuality();
+        }
+    });
+}
+
+void MainWindow::applySkyQuality() {
+    if (!m_bootstrapper || !m_skyQuality) {
+        return;
+    }
+    if (m_bootstrapper->setSkyQuality(m_skyQuality->effectiveQuality(), m_skyQuality->ambient) &&
+        m_ui->openGLWidget != nullptr) {
+        // 天空节点已重建，重新装载场景以便新 SkyNode attach 到 view。
+        m_ui->openGLWidget->setSimulation(m_bootstrapper.get());
+    }
+
+    if (m_skyQualityGroup == nullptr) {
+        return;
+    }
+    for (QAction* action : m_skyQualityGroup->actions()) {
+        const auto quality = static_cast<osgEarth::SkyOptions::Quality>(action->data().toInt());
+        action->setChecked(quality == m_skyQuality->overrideQuality);
+        if (quality == osgEarth::SkyOptions::QUALITY_DEFAULT) {
+            action->setText(m_skyQuality->calibrated
+                                ? tr("自动（校准结果：%1）").arg(core::skyQualityName(m_skyQuality->calibratedQuality))
+                                : tr("自动（未校准）"));
+        }
+    }
+}
+
+void MainWindow::calibrateSkyQuality() {
+    SceneWidget* widget = m_ui->openGLWidget;
+    if (!m_bootstrapper || !m_skyQuality || widget == nullptr) {
+        return;
+    }
+
+    QStringList report;
+    osgEarth::SkyOptions::Quality best = osgEarth::SkyOptions::QUALITY_LOW;
+    bool measured = false;
+    for (const osgEarth::SkyOptions::Quality quality :
+         {osgEarth::SkyOptions::QUALITY_LOW, osgEarth::SkyOptions::QUALITY_MEDIUM, osgEarth::SkyOptions::QUALITY_HIGH}) {
+        if (!m_bootstrapper->usesBuiltinSky()) {
+            break;
+        }
+        if (m_bootstrapper->setSkyQuality(quality, m_skyQuality->ambient)) {
+            widget->setSimulation(m_bootstrapper.get());
+        }
+
+        const double frameMs = widget->measureFrameTimeMs(kSkyCalibrationWarmupFrames, kSkyCalibrationFrames);
+        if (frameMs < 0.0) {
+            break;
+        }
+        measured = true;
+        core::FrameMetrics::instance().recordDuration("sky.calibrateFrame", frameMs);
+        report << tr("%1 %2 ms").arg(core::skyQualityName(quality)).arg(frameMs, 0, 'f', 1);
+        if (frameMs > m_skyQuality->frameBudgetMs) {
+            break;
+        }
+        best = quality;
+    }
+
+    if (!measured) {
+        // 视图不可见或当前为外部场景自带的天空，无法测量，保持原档位。
+        applySkyQuality();
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("天空画质校准失败：视图不可见或当前场景使用自带天空"), 5000);
+        }
+        return;
+    }
+
+    m_skyQuality->calibratedQuality = best;
+    m_skyQuality->calibrated = true;
+    m_skyQuality->renderer = widget->rendererName();
+    m_skyQuality->calibratedAt = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    m_skyQuality->save();
+    applySkyQuality();
+
+    if (auto* sb = statusBar()) {
+        sb->showMessage(tr("天空画质校准完成：%1（预算 %2 ms；%3）")
+                            .arg(core::skyQualityName(best))
+                            .arg(m_skyQuality->frameBudgetMs, 0, 'f', 0)
+                            .arg(report.join(tr("，"))),
+                        8000);
+    }
+}
+
+void MainWindow::setupLatencyActions() {
+#ifdef EARTH_ENABLE_PERF
+    if (m_ui->ParamSetting == nullptr) {
+        return;
+    }
+
+    QMenu* latencyMenu = m_ui->ParamSetting->addMenu(tr("输入延迟"));
+    QAction* overlayAction = latencyMenu->addAction(tr("延迟叠加层"));
+    overlayAction->setCheckable(true);
+    overlayAction->setToolTip(tr("在视图左上角显示输入事件到画面交换各阶段的 p50/p95/p99 延迟"));
+    connect(overlayAction, &QAction::toggled, this, [this](bool enabled) {
+        if (m_ui->openGLWidget != nullptr) {
+            m_ui->openGLWidget->setInputLatencyOverlay(enabled);
+        }
+    });
+
+    QAction* exportAction = latencyMenu->addAction(tr("导出 CSV..."));
+    connect(exportAction, &QAction::triggered, this, [this]() {
+        const QString path = QFileDialog::getSaveFileName(this, tr("导出输入延迟"),
+                                                          QDir::home().filePath(QStringLiteral("input_latency.csv")),
+                                                          tr("CSV 文件 (*.csv)"));
+        if (path.isEmpty()) {
+            return;
+        }
+        const bool exported = core::InputLatencyTracer::instance().exportCsv(path);
+        if (auto* sb = statusBar()) {
+            sb->showMessage(exported ? tr("输入延迟已导出: %1").arg(path) : tr("输入延迟导出失败: %1").arg(path), 5000);
+        }
+    });
+#endif
+}
+
+void MainWindow::ensureWeatherSystem() {
+#ifdef EARTH_ENABLE_WEATHER
+    if (!m_bootstrapper) {
+        return;
+    }
+    if (!m_weather) {
+        m_weather = std::make_unique<weather::WeatherSystem>();
+    }
+    const osgEarth::MapNode* mapNode = m_bootstrapper->activeMapNode();
+    m_weather->attach(m_bootstrapper->environmentRoot(), mapNode == nullptr || mapNode->isGeocentric());
+#endif
+}
+
+void MainWindow::setupWeatherActions() {
+#ifdef EARTH_ENABLE_WEATHER
+    for (QAction* action : {m_ui->Rain, m_ui->Snow}) {
+        if (action == nullptr) {
+            continue;
+        }
+        action->setCheckable(true);
+        connect(action, &QAction::toggled, this, [this, action](bool checked) {
+            togglePrecipitation(action, checked);
+        });
+    }
+
+    if (m_ui->Cloud) {
+        m_ui->Cloud->setCheckable(true);
+        connect(m_ui->Cloud, &QAction::toggled, this, &MainWindow::toggleClouds);
+    }
+
+    if (m_ui->Fire) {
+        // 火源为布置模式：勾选后每次单击地图放置一处火源。
+        m_ui->Fire->setCheckable(true);
+        m_ui->Fire->setToolTip(tr("勾选后单击地图布置火源"));
+        if (m_ui->openGLWidget) {
+            connect(m_ui->openGLWidget, &SceneWidget::mouseGeoClicked, this,
+                    [this](double lon, double lat, double height) {
+                        if (m_ui->Fire->isChecked()) {
+                            placeFireAt(lon, lat, height);
+                        }
+                    });
+        }
+    }
+
+    if (m_ui->Weather) {
+        QAction* settingsAction = m_ui->Weather->addAction(tr("降水参数..."));
+        connect(settingsAction, &QAction::triggered, this, &MainWindow::editPrecipitationSettings);
+
+        QAction* impostorAction = m_ui->Weather->addAction(tr("云层低配模式"));
+        impostorAction->setCheckable(true);
+        impostorAction->setToolTip(tr("每像素单次采样代替光线步进，适用于性能较弱的席位"));
+        connect(impostorAction, &QAction::toggled, this, [this](bool checked) {
+            if (m_weather) {
+                m_weather->clouds().setImpostor(checked);
+            }
+        });
+
+        QAction* clearFiresAction = m_ui->Weather->addAction(tr("清除全部火源"));
+        connect(clearFiresAction, &QAction::triggered, this, [this]() {
+            if (!m_weather) {
+                return;
+            }
+            m_weather->fires().clear();
+            if (auto* sb = statusBar()) {
+                sb->showMessage(tr("已清除全部火源"), 3000);
+            }
+        });
+    }
+#endif
+}
+
+void MainWindow::togglePrecipitation(QAction* action, bool checked) {
+#ifdef EARTH_ENABLE_WEATHER
+    if (!m_weather || action == nullptr) {
+        return;
+    }
+
+    weather::PrecipitationEffect& effect = m_weather->precipitation();
+    QAction* other = action == m_ui->Rain ? m_ui->Snow : m_ui->Rain;
+    if (checked) {
+        if (other != nullptr && other->isChecked()) {
+            QSignalBlocker blocker(other);
+            other->setChecked(false);
+        }
+        effect.setType(action == m_ui->Snow ? weather::PrecipitationType::Snow : weather::PrecipitationType::Rain);
+    }
+
+    const bool wasEnabled = effect.isEnabled();
+    effect.setEnabled(checked);
+    if (wasEnabled == checked) {
+        return;
+    }
+
+    reportWeatherFpsDelta(action->text(), checked);
+#else
+    Q_UNUSED(action);
+    Q_UNUSED(checked);
+#endif
+}
+
+void MainWindow::toggleClouds(bool checked) {
+#ifdef EARTH_ENABLE_WEATHER
+    if (!m_weather) {
+        return;
+    }
+
+    weather::CloudLayer& clouds = m_weather->clouds();
+    if (clouds.isEnabled() == checked) {
+        return;
+    }
+    clouds.setEnabled(checked);
+    reportWeatherFpsDelta(m_ui->Cloud != nullptr ? m_ui->Cloud->text() : tr("云层"), checked);
+#else
+    Q_UNUSED(checked);
+#endif
+}
+
+void MainWindow::reportWeatherFpsDelta(const QString& name, bool enabled) {
+    // 等待帧率统计窗口稳定后再比较，避免把切换瞬间的抖动算进去。
+    const double baselineFps = m_lastFps;
+    QTimer::singleShot(3000, this, [this, baselineFps, name, enabled]() {
+        const double delta = m_lastFps - baselineFps;
+        core::FrameMetrics::instance().recordValue("weather.fpsDelta", delta, "FPS");
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("%1%2后帧率 %3 → %4 FPS（%5）")
+                                .arg(name)
+                                .arg(enabled ? tr("开启") : tr("关闭"))
+                                .arg(baselineFps, 0, 'f', 1)
+                                .arg(m_lastFps, 0, 'f', 1)
+                                .arg(delta, 0, 'f', 1),
+                            6000);
+        }
+    });
+}
+
+void MainWindow::placeFireAt(double lon, double lat, double height) {
+#ifdef EARTH_ENABLE_WEATHER
+    if (!m_weather || !m_bootstrapper) {
+        return;
+    }
+    const osgEarth::MapNode* mapNode = m_bootstrapper->activeMapNode();
+    if (mapNode == nullptr || mapNode->getMapSRS() == nullptr) {
+        return;
+    }
+
+    // 先转换到地图自身的坐标系再求局部坐标系：地理坐标系的 GeoPoint 总是给出地心坐标，
+    // 在投影地图上会落到场景之外。局部坐标系第三列即该点的“向上”方向，投影地图下即世界 Z 轴。
+    const osgEarth::GeoPoint geographic(mapNode->getMapSRS()->getGeographicSRS(), lon, lat, height,
+                                        osgEarth::ALTMODE_ABSOLUTE);
+    osgEarth::GeoPoint point;
+    osg::Matrixd localToWorld;
+    if (!geographic.transform(mapNode->getMapSRS(), point) || !point.createLocalToWorld(localToWorld)) {
+        return;
+    }
+    const osg::Vec3d up(localToWorld(2, 0), localToWorld(2, 1), localToWorld(2, 2));
+
+    weather::FireSmokeSystem& fires = m_weather->fires();
+    const weather::FireHandle handle =
+        fires.addFire(localToWorld.getTrans(), up, weather::FireKind::Flame, 0.8F);
+    if (auto* sb = statusBar()) {
+        if (handle.isValid()) {
+            sb->showMessage(tr("已布置火源（%1/%2）").arg(fires.activeCount()).arg(weather::FireSmokeSystem::kMaxEmitters),
+                            3000);
+        } else {
+            sb->showMessage(tr("火源数量已达上限 %1，请先清除").arg(weather::FireSmokeSystem::kMaxEmitters), 5000);
+        }
+    }
+#else
+    Q_UNUSED(lon);
+    Q_UNUSED(lat);
+    Q_UNUSED(height);
+#endif
+}
+
+void MainWindow::editPrecipitationSettings() {
+#ifdef EARTH_ENABLE_WEATHER
+    if (!m_weather) {
+        return;
+    }
+    if (m_precipitationDialog != nullptr) {
+        m_precipitationDialog->show();
+        m_precipitationDialog->raise();
+        return;
+    }
+
+    weather::PrecipitationEffect& effect = m_weather->precipitation();
+    m_precipitationDialog = new QDialog(this);
+    m_precipitationDialog->setWindowTitle(tr("降水参数"));
+
+    auto* layout = new QVBoxLayout(m_precipitationDialog);
+    auto* form = new QFormLayout();
+    layout->addLayout(form);
+
+    const auto makeSlider = [](int minimum, int maximum, int value) {
+        auto* slider = new QSlider(Qt::Horizontal);
+        slider->setRange(minimum, maximum);
+        slider->setValue(value);
+        return slider;
+    };
+
+    auto* intensitySlider = makeSlider(0, 100, static_cast<int>(effect.intensity() * 100.0F));
+    auto* densitySlider = makeSlider(0, 100, static_cast<int>(effect.density() * 100.0F));
+    auto* windSpeedSpin = new QDoubleSpinBox();
+    windSpeedSpin->setRange(0.0, 40.0);
+    windSpeedSpin->setSuffix(tr(" m/s"));
+    auto* windDirSpin = new QDoubleSpinBox();
+    windDirSpin->setRange(0.0, 359.0);
+    windDirSpin->setSuffix(tr(" °"));
+
+    form->addRow(tr("强度"), intensitySlider);
+    form->addRow(tr("密度"), densitySlider);
+    form->addRow(tr("风速"), windSpeedSpin);
+    form->addRow(tr("风向（来向）"), windDirSpin);
+
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::rejected, m_precipitationDialog, &QDialog::hide);
+
+    connect(intensitySlider, &QSlider::valueChanged, this, [this](int value) {
+        m_weather->precipitation().setIntensity(static_cast<float>(value) / 100.0F);
+    });
+    connect(densitySlider, &QSlider::valueChanged, this, [this](int value) {
+        m_weather->precipitation().setDensity(static_cast<float>(value) / 100.0F);
+    });
+    const auto applyWind = [this, windSpeedSpin, windDirSpin]() {
+        // 气象风向为来向，漂移方向与之相反。
+        const double radians = osg::DegreesToRadians(windDirSpin->value() + 180.0);
+        const double speed = windSpeedSpin->value();
+        const auto east = static_cast<float>(speed * std::sin(radians));
+        const auto north = static_cast<float>(speed * std::cos(radians));
+        m_weather->precipitation().setWind(east, north);
+        m_weather->clouds().setWind(east, north);
+        m_weather->fires().setWind(east, north);
+    };
+    connect(windSpeedSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, applyWind);
+    connect(windDirSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, applyWind);
+
+    m_precipitationDialog->show();
+#endif
+}
+
+void MainWindow::ensureWindLayer() {
+#ifdef EARTH_ENABLE_WIND
+    if (!m_windLayer) {
+        m_windLayer = std::make_unique<wind::WindLayer>();
+    }
+    if (m_bootstrapper) {
+        m_windLayer->setMapNode(m_bootstrapper->activeMapNode());
+    }
+#endif
+}
+
+void MainWindow::ensureRunwayMonitor() {
+#ifdef EARTH_ENABLE_VISION
+    if (m_runwayMonitor && m_runwayMonitor->isRunning() && m_bootstrapper &&
+        !m_runwayMonitor->start(*m_bootstrapper)) {
+        // 取消勾选会经由 toggled 信号停止检测并隐藏状态栏标签。
+        if (auto* action = findChild<QAction*>(QStringLiteral("RunwayMonitor"))) {
+            action->setChecked(false);
+        }
+    }
+#endif
+}
 
+void MainWindow::setupVisionActions() {
+#ifdef EARTH_ENABLE_VISION
+    QMenu* visionMenu = menuBar()->addMenu(tr("跑道检测"));
+
+    QAction* monitorAction = visionMenu->addAction(tr("跑道异物检测"));
+    monitorAction->setObjectName(QStringLiteral("RunwayMonitor"));
+    monitorAction->setCheckable(true);
+    monitorAction->setToolTip(tr("机场上空俯视相机逐帧与参考画面比较，标出跑道范围内的变化"));
+    connect(monitorAction, &QAction::toggled, this, &MainWindow::toggleRunwayMonitor);
+
+    QAction* resetAction = visionMenu->addAction(tr("重置参考帧"));
+    connect(resetAction, &QAction::triggered, this, [this]() {
+        if (m_runwayMonitor) {
+            m_runwayMonitor->resetReference();
+        }
+    });
+#endif
+}
+
+void MainWindow::toggleRunwayMonitor(bool enabled) {
+#ifdef EARTH_ENABLE_VISION
+    if (!enabled) {
+        if (m_runwayMonitor) {
+            m_runwayMonitor->stop();
+        }
+        if (m_visionLabel) {
+            m_visionLabel->hide();
+        }
+        return;
+    }
+    if (!m_bootstrapper) {
+        return;
+    }
+
+    if (!m_runwayMonitor) {
+        m_runwayMonitor = std::make_unique<vision::RunwayMonitor>();
+        // 回调在检测线程中执行，只拷贝摘要并投递到 UI 线程。
+        m_runwayMonitor->setReportCallback([this](const vision::ChangeReport& report) {
+            const auto regionCount = static_cast<int>(report.regions.size());
+            const double fraction = report.changedFraction;
+            const bool referenceReset = report.referenceReset;
+            QMetaObject::invokeMethod(
+                this,
+                [this, regionCount, fraction, referenceReset]() {
+                    if (!m_visionLabel || !m_runwayMonitor || !m_runwayMonitor->isRunning()) {
+                        return;
+                    }
+                    m_visionLabel->setText(referenceReset
+                                               ? tr("跑道检测: 已更新参考帧")
+                                               : tr("跑道变化: %1 处 (%2%)")
+                                                     .arg(regionCount)
+                                                     .arg(fraction * 100.0, 0, 'f', 2));
+                    m_visionLabel->setToolTip(
+                        tr("丢弃帧数: %1").arg(static_cast<qulonglong>(m_runwayMonitor->droppedFrames())));
+                },
+                Qt::QueuedConnection);
+        });
+    }
+    if (!m_visionLabel) {
+        m_visionLabel = new QLabel(this);
+        m_visionLabel->setObjectName(QStringLiteral("visionLabel"));
+        m_visionLabel->setMinimumWidth(160);
+        m_visionLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        if (auto* sb = statusBar()) {
+            sb->addPermanentWidget(m_visionLabel, 0);
+        }
+    }
+
+    if (!m_runwayMonitor->start(*m_bootstrapper)) {
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("跑道检测启动失败：当前场景没有可用的地图"), 5000);
+        }
+        if (auto* action = findChild<QAction*>(QStringLiteral("RunwayMonitor"))) {
+            const QSignalBlocker blocker(action);
+            action->setChecked(false);
+        }
+        return;
+    }
+    m_visionLabel->setText(tr("跑道检测: 建立参考帧..."));
+    m_visionLabel->show();
+#else
+    Q_UNUSED(enabled);
+#endif
+}
+
+void MainWindow::setupWindActions() {
+#ifdef EARTH_ENABLE_WIND
+    QMenu* windMenu = menuBar()->addMenu(tr("风场"));
+
+    QAction* loadAction = windMenu->addAction(tr("加载风场数据..."));
+    connect(loadAction, &QAction::triggered, this, &MainWindow::loadWindData);
+
+    QAction* showAction = windMenu->addAction(tr("显示风场粒子"));
+    showAction->setObjectName(QStringLiteral("ShowWindParticles"));
+    showAction->setCheckable(true);
+    connect(showAction, &QAction::toggled, this, [this](bool checked) {
+        if (m_windLayer) {
+            m_windLayer->setEnabled(checked);
+        }
+    });
+
+    QAction* timeAction = windMenu->addAction(tr("预报时刻..."));
+    connect(timeAction, &QAction::triggered, this, &MainWindow::editWindForecastTime);
+
+    QAction* runwayAction = windMenu->addAction(tr("跑道方向..."));
+    connect(runwayAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const double heading = QInputDialog::getDouble(this, tr("跑道方向"), tr("跑道真航向（度）"),
+                                                       m_runwayHeadingDeg, 0.0, 359.9, 1, &ok);
+        if (ok) {
+            m_runwayHeadingDeg = heading;
+        }
+    });
+#endif
+}
+
+void MainWindow::loadWindData() {
+#ifdef EARTH_ENABLE_WIND
+    if (!m_windLayer) {
+        return;
+    }
+
+    const QString filePath = QFileDialog::getOpenFileName(this, tr("加载风场数据"), QString(),
+                                                          tr("风场描述文件 (*.json);;所有文件 (*.*)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    if (!m_windLayer->load(filePath)) {
+        QMessageBox::warning(this, tr("加载失败"), tr("无法读取风场数据: %1").arg(filePath));
+        return;
+    }
+
+    m_windLayer->setEnabled(true);
+    if (auto* showAction = findChild<QAction*>(QStringLiteral("ShowWindParticles"))) {
+        QSignalBlocker blocker(showAction);
+        showAction->setChecked(true);
+    }
+    if (!m_windLabel) {
+        m_windLabel = new QLabel(this);
+        m_windLabel->setObjectName(QStringLiteral("windLabel"));
+        m_windLabel->setMinimumWidth(200);
+        m_windLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        if (auto* sb = statusBar()) {
+            sb->addPermanentWidget(m_windLabel, 0);
+        }
+    }
+    m_windLabel->setText(tr("侧风: --"));
+
+    const wind::WindGrid& grid = m_windLayer->grid();
+    if (auto* sb = statusBar()) {
+        sb->showMessage(tr("已加载风场: %1×%2×%3 网格，%4 个时次")
+                            .arg(grid.sizeX())
+                            .arg(grid.sizeY())
+                            .arg(grid.sizeZ())
+                            .arg(grid.times().size()),
+                        5000);
+    }
+#endif
+}
+
+void MainWindow::editWindForecastTime() {
+#ifdef EARTH_ENABLE_WIND
+    if (!m_windLayer || !m_windLayer->hasData()) {
+        if (auto* sb = statusBar()) {
+            sb->showMessage(tr("请先加载风场数据"), 4000);
+        }
+        return;
+    }
+    // QPointer 在旧对话框真正析构时才置空，重新赋值后不会被旧对话框的析构误清。
+    if (m_windTimeDialog) {
+        m_windTimeDialog->close();
+        m_windTimeDialog->deleteLater();
+    }
+
+    // 每次打开按当前数据重建，滑块以分钟为刻度覆盖全部时次。
+    const std::vector<double>& times = m_windLayer->grid().times();
+    const double start = times.front();
+    const int totalMinutes = static_cast<int>(std::ceil((times.back() - start) / 60.0));
+
+    auto* dialog = new QDialog(this);
+    dialog->setWindowTitle(tr("风场预报时刻"));
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    m_windTimeDialog = dialog;
+
+    auto* layout = new QVBoxLayout(dialog);
+    auto* timeLabel = new QLabel(dialog);
+    auto* slider = new QSlider(Qt::Horizontal, dialog);
+    slider->setRange(0, std::max(totalMinutes, 0));
+    slider->setValue(static_cast<int>(std::clamp((m_windLayer->forecastTime() - start) / 60.0, 0.0,
+                                                 static_cast<double>(totalMinutes))));
+    layout->addWidget(timeLabel);
+    layout->addWidget(slider);
+
+    const auto applyTime = [this, timeLabel, start](int minutes) {
+        const double epochSeconds = start + minutes * 60.0;
+        m_windLayer->setForecastTime(epochSeconds);
+        timeLabel->setText(
+            QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(epochSeconds * 1000.0), Qt::UTC)
+                .toString(QStringLiteral("yyyy-MM-dd HH:mm 'UTC'")));
+    };
+    connect(slider, &QSlider::valueChanged, this, applyTime);
+    applyTime(slider->value());
+
+    dialog->show();
+#endif
+}
+
+void MainWindow::updateWindReadout(double lon, double lat, double height) {
+#ifdef EARTH_ENABLE_WIND
+    if (!m_windLayer || !m_windLabel) {
+        return;
+    }
+
+    wind::WindSample sample;
+    if (!m_windLayer->sampleAt(lon, lat, height + 10.0, sample)) {
+        m_windLabel->setText(tr("侧风: --（超出风场范围）"));
+        return;
+    }
+
+    const wind::RunwayWind components = wind::runwayComponents(sample, m_runwayHeadingDeg);
+    m_windLabel->setText(tr("跑道 %1°  顶风 %2 m/s  侧风 %3 m/s")
+                             .arg(m_runwayHeadingDeg, 0, 'f', 0)
+                             .arg(components.headwind, 0, 'f', 1)
+                             .arg(components.crosswind, 0, 'f', 1));
+#else
+    Q_UNUSED(lon);
+    Q_UNUSED(lat);
+    Q_UNUSED(height);
+#endif
+}
+
+} // namespace earth::ui
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QMainWindow>
+#include <QPointer>
 #include <QString>
 #include <memory>
 
@@ -8,6 +9,7 @@
 
 class QAction;
 class QActionGroup;
+class QDialog;
 class QFileDialog;
 class QLabel;
 
@@ -17,12 +19,45 @@ class EarthMainWindow;
 
 namespace earth::core {
 class SimulationBootstrapper;
+struct SkyQualitySettings;
 }
 
 namespace earth::ui::draw {
 class MapDrawingController;
 }
 
+#ifdef EARTH_ENABLE_AIRTRAFFIC
+namespace earth::airtraffic {
+class AirTrafficLayer;
+class TrackRecorder;
+class TrackReplayPlayer;
+}
+#endif
+
+#ifdef EARTH_ENABLE_WEATHER
+namespace earth::weather {
+class WeatherSystem;
+}
+#endif
+
+#ifdef EARTH_ENABLE_DATABRIDGE
+namespace earth::databridge {
+class DataBridgeService;
+}
+#endif
+
+#ifdef EARTH_ENABLE_WIND
+namespace earth::wind {
+class WindLayer;
+}
+#endif
+
+#ifdef EARTH_ENABLE_VISION
+namespace earth::vision {
+class RunwayMonitor;
+}
+#endif
+
 namespace earth::ui {
 
 /**
@@ -47,6 +82,14 @@ private slots:
      * @brief 打开画笔样式配置，统一设置颜色与线宽。
      */
     void editDrawingStyle();
+    /**
+     * @brief 打开非模态天空时间面板：实时、加速或拖动滑块浏览 24 小时昼夜变化。
+     */
+    void editSkyTime();
+    /**
+     * @brief 依次以低/中/高画质渲染若干帧，选出满足帧预算的最高档位并写入数据目录。
+     */
+    void calibrateSkyQuality();
 
 private:
     /**
@@ -94,14 +137,145 @@ private:
      */
     void applyDrawingStyle();
 
+    /**
+     * @brief 确保空管交通图层挂接到当前 MapNode（加载新 .earth 后需重新挂接）。
+     */
+    void ensureAirTrafficLayer();
+
+    /**
+     * @brief 构建“回放”菜单：航迹录制、打开日志、定位、倍速与退出回放。
+     */
+    void setupReplayActions();
+
+    /**
+     * @brief 启动数据桥接并将其接入空管交通图层的每帧报文源。
+     */
+    void connectDataBridge();
+
+    /**
+     * @brief 确保天气系统挂接到环境根节点，并按当前地图坐标系更新效果参数。
+     */
+    void ensureWeatherSystem();
+
+    /**
+     * @brief 绑定雨/雪/云层开关、云层低配模式与降水参数面板。
+     */
+    void setupWeatherActions();
+
+    /**
+     * @brief 切换降水效果，并在稳定数秒后于状态栏报告开启前后的帧率变化。
+     */
+    void togglePrecipitation(QAction* action, bool checked);
+
+    /**
+     * @brief 切换体积云层；只改变节点可见性，不重建 SkyNode。
+     */
+    void toggleClouds(bool checked);
+
+    /**
+     * @brief 等待帧率统计稳定后，于状态栏报告天气效果切换前后的帧率变化。
+     */
+    void reportWeatherFpsDelta(const QString& name, bool enabled);
+
+    /**
+     * @brief 火源布置模式下，在地图点击处布置一个火源（槽位耗尽时提示）。
+     */
+    void placeFireAt(double lon, double lat, double height);
+
+    /**
+     * @brief 打开非模态降水参数面板，强度/密度/风速调整即时生效。
+     */
+    void editPrecipitationSettings();
+
+    /**
+     * @brief 确保风场图层挂接到当前 MapNode。
+     */
+    void ensureWindLayer();
+
+    /**
+     * @brief 构建“风场”菜单：加载网格数据、显示开关、预报时刻与跑道方向。
+     */
+    void setupWindActions();
+
+    /**
+     * @brief 选择风场描述文件（*.json）并加载。
+     */
+    void loadWindData();
+
+    /**
+     * @brief 打开非模态预报时刻面板，在相邻时次之间连续插值。
+     */
+    void editWindForecastTime();
+
+    /**
+     * @brief 在“参数”菜单下创建天空画质子菜单（自动/低/中/高、重新校准）。
+     */
+    void setupSkyQualityActions();
+
+    /**
+     * @brief 按配置的生效档位重建天空，并同步菜单勾选状态。
+     */
+    void applySkyQuality();
+
+    /**
+     * @brief 在“参数”菜单下创建输入延迟子菜单（叠加层开关、导出 CSV），仅在启用性能诊断模块时生效。
+     */
+    void setupLatencyActions();
+
+    /**
+     * @brief 在鼠标位置（离地 10 米）采样风场，于状态栏显示相对跑道的顶风/侧风分量。
+     */
+    void updateWindReadout(double lon, double lat, double height);
+
+    /**
+     * @brief 场景切换后，若跑道检测正在运行则按新地图重建俯视相机。
+     */
+    void ensureRunwayMonitor();
+
+    /**
+     * @brief 创建“跑道检测”菜单（异物检测开关、重置参考帧）。
+     */
+    void setupVisionActions();
+
+    /**
+     * @brief 启停跑道变化检测，结果显示在状态栏。
+     */
+    void toggleRunwayMonitor(bool enabled);
+
     std::unique_ptr<Ui::EarthMainWindow> m_ui;
     std::unique_ptr<core::SimulationBootstrapper> m_bootstrapper;
+    QDialog* m_skyTimeDialog = nullptr;
+    std::unique_ptr<core::SkyQualitySettings> m_skyQuality;
+    QActionGroup* m_skyQualityGroup = nullptr;
     QLabel* m_coordLabel = nullptr;
     QLabel* m_fpsLabel = nullptr;
     QActionGroup* m_drawingActionGroup = nullptr;
     std::unique_ptr<draw::MapDrawingController> m_drawingController;
     draw::ColorRgba m_penColor {0.97F, 0.58F, 0.20F, 1.0F};
     double m_penThickness = 4.0;
+    double m_lastFps = 0.0;
+#ifdef EARTH_ENABLE_WEATHER
+    std::unique_ptr<weather::WeatherSystem> m_weather;
+    QDialog* m_precipitationDialog = nullptr;
+#endif
+#ifdef EARTH_ENABLE_DATABRIDGE
+    std::unique_ptr<databridge::DataBridgeService> m_dataBridge;
+#endif
+#ifdef EARTH_ENABLE_WIND
+    std::unique_ptr<wind::WindLayer> m_windLayer;
+    QLabel* m_windLabel = nullptr;
+    QPointer<QDialog> m_windTimeDialog;
+    double m_runwayHeadingDeg = 90.0;
+#endif
+#ifdef EARTH_ENABLE_VISION
+    std::unique_ptr<vision::RunwayMonitor> m_runwayMonitor;
+    QLabel* m_visionLabel = nullptr;
+#endif
+#ifdef EARTH_ENABLE_AIRTRAFFIC
+    std::unique_ptr<airtraffic::TrackRecorder> m_trackRecorder;
+    std::unique_ptr<airtraffic::TrackReplayPlayer> m_replayPlayer;
+    std::unique_ptr<airtraffic::AirTrafficLayer> m_airTrafficLayer;
+#endif
 };
 
 } // namespace earth::ui
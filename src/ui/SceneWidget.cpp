@@ -1,8 +1,12 @@
 #include "ui/SceneWidget.h"
 
+#include "core/FrameMetrics.h"
 #include "core/SimulationBootstrapper.h"
+#include "ui/InputLatencyOverlay.h"
 
+#include <QByteArray>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QtGlobal>
 #include <QEvent>
 #include <QHideEvent>
@@ -12,11 +16,14 @@
 #include <QVBoxLayout>
 #include <algorithm>
 #include <mutex>
+#include <vector>
 #include <osg/Camera>
+#include <osg/GL>
 #include <osg/Vec4>
 #include <osg/Viewport>
 #include <osgGA/GUIEventAdapter>
 #include <osgGA/StateSetManipulator>
+#include <osgQt/FrameClock>
 #include <osgQt/GraphicsWindowQt>
 #include <osgUtil/IntersectionVisitor>
 #include <osgUtil/LineSegmentIntersector>
@@ -35,11 +42,52 @@ constexpr int kDefaultWidth = 640;
 constexpr int kDefaultHeight = 360;
 constexpr double kNearPlane = 0.1;
 constexpr double kFarPlane = 5e6;
-constexpr int kFrameIntervalMs = 16;
+constexpr int kClickSlopPixels = 4;
 } // namespace
 
+/**
+ * @brief 挂在共享帧时钟上的钩子：节拍由 osgQt::FrameClock 按精确定时器调度，不再由本窗口的定时器驱动。
+ */
+class SceneWidget::FrameHook : public osgQt::FrameClock::FrameCallback {
+public:
+    explicit FrameHook(SceneWidget* owner)
+        : m_owner(owner) {
+    }
+
+    bool beginFrame(osgViewer::ViewerBase& /*viewer*/) override {
+        return m_owner != nullptr && m_owner->beginFrame();
+    }
+
+    void endFrame(osgViewer::ViewerBase& /*viewer*/, const osgQt::FrameTiming& timing) override {
+        if (m_owner == nullptr) {
+            return;
+        }
+        if (timing.missedDeadline) {
+            core::FrameMetrics::instance().recordValue("frame.late", timing.latenessMs, "ms");
+        }
+        m_owner->resolveHoverPick();
+        if (m_owner->m_latencyOverlay) {
+            m_owner->m_latencyOverlay->update();
+        }
+        m_owner->updateFrameRateMetrics();
+    }
+
+private:
+    QPointer<SceneWidget> m_owner;
+};
+
+SceneWidget::SurfaceBackend SceneWidget::backendFromEnvironment() {
+    const QByteArray value = qgetenv("EARTH_GL_BACKEND").trimmed().toLower();
+    return value == "qwindow" ? SurfaceBackend::QWindow : SurfaceBackend::GLWidget;
+}
+
 SceneWidget::SceneWidget(QWidget* parent)
+    : SceneWidget(backendFromEnvironment(), parent) {
+}
+
+SceneWidget::SceneWidget(SurfaceBackend backend, QWidget* parent)
     : QWidget(parent)
+    , m_backend(backend)
     , m_viewer(new osgViewer::CompositeViewer())
     , m_view(new osgViewer::View()) {
     setMinimumSize(kDefaultWidth, kDefaultHeight);
@@ -52,14 +100,26 @@ SceneWidget::SceneWidget(QWidget* parent)
     });
 
     m_viewer->setThreadingModel(osgViewer::CompositeViewer::SingleThreaded);
-    connect(&m_frameTimer, &QTimer::timeout, this, &SceneWidget::onFrame);
-    m_frameTimer.setInterval(kFrameIntervalMs);
-    m_frameTimer.start(kFrameIntervalMs);
+    m_frameHook = new FrameHook(this);
 
     ensureGraphicsWindow();
     initializeViewer();
 }
 
+SceneWidget::~SceneWidget() {
+    osgQt::FrameClock::instance()->removeViewer(m_viewer.get());
+}
+
+void SceneWidget::setInputLatencyOverlay(bool enabled) {
+    if (!enabled) {
+        m_latencyOverlay.reset();
+        return;
+    }
+    if (!m_latencyOverlay && m_view.valid() && m_graphicsWindow.valid()) {
+        m_latencyOverlay = std::make_unique<InputLatencyOverlay>(m_view.get(), m_graphicsWindow.get());
+    }
+}
+
 void SceneWidget::setSimulation(core::SimulationBootstrapper* bootstrapper) {
     m_bootstrapper = bootstrapper;
     m_lastAttachedSky = nullptr;
@@ -79,16 +139,12 @@ void SceneWidget::home() {
 
 void SceneWidget::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
-    if (!m_frameTimer.isActive()) {
-        m_frameTimer.start(kFrameIntervalMs);
-    }
+    osgQt::FrameClock::instance()->addViewer(m_viewer.get(), m_frameHook.get());
 }
 
 void SceneWidget::hideEvent(QHideEvent* event) {
     QWidget::hideEvent(event);
-    if (m_frameTimer.isActive()) {
-        m_frameTimer.stop();
-    }
+    osgQt::FrameClock::instance()->removeViewer(m_viewer.get());
     resetFrameStats();
 }
 
@@ -98,31 +154,119 @@ void SceneWidget::resizeEvent(QResizeEvent* event) {
 }
 
 bool SceneWidget::eventFilter(QObject* watched, QEvent* event) {
-    if (watched == m_glWidget && event->type() == QEvent::MouseMove) {
+    if (watched == m_inputSource && event->type() == QEvent::MouseMove) {
+        // 高回报率鼠标每帧可产生十余次移动，只记下位置，帧结束时拾取一次。
+        m_hoverPos = static_cast<QMouseEvent*>(event)->pos();
+    } else if (watched == m_inputSource && event->type() == QEvent::MouseButtonPress) {
+        const auto* mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() == Qt::LeftButton) {
+            m_pressPos = mouseEvent->pos();
+        }
+    } else if (watched == m_inputSource && event->type() == QEvent::MouseButtonRelease) {
         const auto* mouseEvent = static_cast<QMouseEvent*>(event);
-        double lon = 0.0;
-        double lat = 0.0;
-        double height = 0.0;
-        if (computeGeoAt(mouseEvent->pos(), lon, lat, height)) {
-            emit mouseGeoPositionChanged(lon, lat, height);
+        // 位移超过阈值视为拖拽漫游，不当作单击。
+        if (mouseEvent->button() == Qt::LeftButton &&
+            (mouseEvent->pos() - m_pressPos).manhattanLength() <= kClickSlopPixels) {
+            double lon = 0.0;
+            double lat = 0.0;
+            double height = 0.0;
+            if (computeGeoAt(mouseEvent->pos(), lon, lat, height)) {
+                emit mouseGeoClicked(lon, lat, height);
+            }
         }
     }
     return QWidget::eventFilter(watched, event);
 }
 
-void SceneWidget::onFrame() {
+void SceneWidget::resolveHoverPick() {
+    if (!m_hoverPos) {
+        return;
+    }
+    const QPoint pos = *m_hoverPos;
+    m_hoverPos.reset();
+
+    double lon = 0.0;
+    double lat = 0.0;
+    double height = 0.0;
+    if (computeGeoAt(pos, lon, lat, height)) {
+        emit mouseGeoPositionChanged(lon, lat, height);
+    }
+}
+
+void SceneWidget::setFullRateMotion(bool enabled) {
+    m_fullRateMotion = enabled;
+    if (osgQt::MotionCoalescer* coalescer = motionCoalescer()) {
+        coalescer->setFullRate(enabled);
+    }
+}
+
+osgQt::MotionCoalescer* SceneWidget::motionCoalescer() const {
+    if (auto* window = dynamic_cast<osgQt::GraphicsWindowQt*>(m_graphicsWindow.get());
+        window != nullptr && window->getGLWidget() != nullptr) {
+        return &window->getGLWidget()->getMotionCoalescer();
+    }
+    if (auto* window = dynamic_cast<osgQt::GraphicsWindowQWindow*>(m_graphicsWindow.get());
+        window != nullptr && window->getGLWindow() != nullptr) {
+        return &window->getGLWindow()->getMotionCoalescer();
+    }
+    return nullptr;
+}
+
+bool SceneWidget::beginFrame() {
     if (!isVisible() || !m_viewerInitialized || !m_viewer.valid() || !m_graphicsWindow.valid()) {
         resetFrameStats();
-        return;
+        return false;
     }
 
     if (!m_fpsTimer.isValid()) {
         m_fpsTimer.start();
         m_frameCounter = 0;
     }
+    return true;
+}
+
+double SceneWidget::measureFrameTimeMs(int warmupFrames, int measuredFrames) {
+    if (!isVisible() || !m_viewerInitialized || !m_viewer.valid() || !m_graphicsWindow.valid() || measuredFrames <= 0) {
+        return -1.0;
+    }
+
+    osgQt::FrameClock* clock = osgQt::FrameClock::instance();
+    const bool clockActive = clock->containsViewer(m_viewer.get());
+    clock->removeViewer(m_viewer.get());
+
+    for (int i = 0; i < warmupFrames; ++i) {
+        m_viewer->frame();
+    }
+
+    // glFinish 把 GPU 耗时计入单帧时间，避免驱动排队让重负载档位看起来很快。
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(measuredFrames));
+    QElapsedTimer timer;
+    for (int i = 0; i < measuredFrames; ++i) {
+        timer.start();
+        m_viewer->frame();
+        if (m_graphicsWindow->makeCurrent()) {
+            glFinish();
+        }
+        samples.push_back(static_cast<double>(timer.nsecsElapsed()) / 1.0e6);
+    }
+
+    if (clockActive) {
+        clock->addViewer(m_viewer.get(), m_frameHook.get());
+    }
+    resetFrameStats();
+
+    auto middle = samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2);
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
 
-    m_viewer->frame();
-    updateFrameRateMetrics();
+QString SceneWidget::rendererName() const {
+    if (!m_graphicsWindow.valid() || !m_graphicsWindow->makeCurrent()) {
+        return {};
+    }
+    const auto* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    return renderer != nullptr ? QString::fromLatin1(renderer) : QString();
 }
 
 void SceneWidget::initializeViewer() {
@@ -163,7 +307,7 @@ void SceneWidget::initializeViewer() {
 }
 
 void SceneWidget::ensureGraphicsWindow() {
-    if (m_graphicsWindow.valid() && !m_glWidget.isNull()) {
+    if (m_graphicsWindow.valid() && !m_surfaceWidget.isNull()) {
         return;
     }
 
@@ -178,41 +322,53 @@ void SceneWidget::ensureGraphicsWindow() {
     traits->stencil = 8;
     traits->samples = 4;
     traits->sampleBuffers = traits->samples > 0 ? 1 : 0;
-    traits->inheritedWindowData = new osgQt::GraphicsWindowQt::WindowData(nullptr, this);
 
-    m_graphicsWindow = new osgQt::GraphicsWindowQt(traits.get(), this);
-    if (!m_graphicsWindow.valid()) {
-        qWarning() << "[SceneWidget] Failed to create osgQt::GraphicsWindowQt";
-        return;
-    }
-
-    m_glWidget = m_graphicsWindow->getGLWidget();
-    if (!m_glWidget) {
-        qWarning() << "[SceneWidget] GraphicsWindowQt returned null GLWidget";
-        return;
+    if (m_backend == SurfaceBackend::QWindow) {
+        // QWindow 放在窗口容器里，鼠标事件直接投递给 QWindow，事件过滤器也装在它上面。
+        traits->inheritedWindowData = new osgQt::GraphicsWindowQWindow::WindowData(this);
+        osg::ref_ptr<osgQt::GraphicsWindowQWindow> window = new osgQt::GraphicsWindowQWindow(traits.get(), this);
+        if (!window->valid() || window->getContainer() == nullptr) {
+            qWarning() << "[SceneWidget] Failed to create osgQt::GraphicsWindowQWindow";
+            return;
+        }
+        m_graphicsWindow = window;
+        m_surfaceWidget = window->getContainer();
+        m_inputSource = window->getGLWindow();
+    } else {
+        traits->inheritedWindowData = new osgQt::GraphicsWindowQt::WindowData(nullptr, this);
+        osg::ref_ptr<osgQt::GraphicsWindowQt> window = new osgQt::GraphicsWindowQt(traits.get(), this);
+        if (window->getGLWidget() == nullptr) {
+            qWarning() << "[SceneWidget] GraphicsWindowQt returned null GLWidget";
+            return;
+        }
+        m_graphicsWindow = window;
+        m_surfaceWidget = window->getGLWidget();
+        m_inputSource = window->getGLWidget();
     }
 
-    qDebug() << "[SceneWidget] GLWidget created, windowFlags=" << m_glWidget->windowFlags() << " parent="
-             << m_glWidget->parent();
+    qDebug() << "[SceneWidget]" << (m_backend == SurfaceBackend::QWindow ? "QWindow" : "GLWidget")
+             << "surface created, windowFlags=" << m_surfaceWidget->windowFlags()
+             << " parent=" << m_surfaceWidget->parent();
 
-    m_glWidget->setFocusPolicy(Qt::StrongFocus);
-    m_glWidget->setMouseTracking(true);
-    m_glWidget->installEventFilter(this);
-    setFocusProxy(m_glWidget);
+    m_surfaceWidget->setFocusPolicy(Qt::StrongFocus);
+    m_surfaceWidget->setMouseTracking(true);
+    m_inputSource->installEventFilter(this);
+    setFullRateMotion(m_fullRateMotion);
+    setFocusProxy(m_surfaceWidget);
 
     if (!layout()) {
         auto* newLayout = new QVBoxLayout(this);
         newLayout->setContentsMargins(0, 0, 0, 0);
         newLayout->setSpacing(0);
     }
-    if (layout()->indexOf(m_glWidget) == -1) {
-        layout()->addWidget(m_glWidget);
-        qDebug() << "[SceneWidget] GLWidget added to layout, isWindow=" << m_glWidget->isWindow();
+    if (layout()->indexOf(m_surfaceWidget) == -1) {
+        layout()->addWidget(m_surfaceWidget);
+        qDebug() << "[SceneWidget] surface added to layout, isWindow=" << m_surfaceWidget->isWindow();
     }
 
-    m_glWidget->show();
-    qDebug() << "[SceneWidget] GLWidget show, isWindow=" << m_glWidget->isWindow()
-             << " effective parent=" << m_glWidget->parentWidget();
+    m_surfaceWidget->show();
+    qDebug() << "[SceneWidget] surface show, isWindow=" << m_surfaceWidget->isWindow()
+             << " effective parent=" << m_surfaceWidget->parentWidget();
 }
 
 void SceneWidget::applySceneData() {
@@ -273,6 +429,7 @@ void SceneWidget::updateFrameRateMetrics() {
         emit frameRateChanged(fps);
         m_lastReportedFps = fps;
     }
+    emit frameMetricsChanged(core::FrameMetrics::formatSnapshot(core::FrameMetrics::instance().takeSnapshot()));
 
     m_frameCounter = 0;
     m_fpsTimer.restart();
@@ -361,11 +518,11 @@ bool SceneWidget::computeGeoAt(const QPoint& pos, double& lon, double& lat, doub
 }
 
 float SceneWidget::currentDevicePixelRatio() const {
-    if (m_glWidget) {
+    if (m_surfaceWidget) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
-        return static_cast<float>(m_glWidget->devicePixelRatioF());
+        return static_cast<float>(m_surfaceWidget->devicePixelRatioF());
 #else
-        return static_cast<float>(m_glWidget->devicePixelRatio());
+        return static_cast<float>(m_surfaceWidget->devicePixelRatio());
 #endif
     }
 #if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
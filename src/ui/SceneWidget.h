@@ -1,31 +1,33 @@
 #pragma once
 
 #include <QElapsedTimer>
+#include <QPoint>
 #include <QPointer>
-#include <QTimer>
 #include <QWidget>
 #include <osg/ref_ptr>
 #include <osgViewer/CompositeViewer>
 
+#include <memory>
+#include <optional>
+
 class QHideEvent;
 class QShowEvent;
 class QResizeEvent;
 class QMouseEvent;
 class QPaintEvent;
 class QEvent;
-class QPoint;
 
 namespace osgEarth {
 class SkyNode;
 }
 
-namespace osgViewer {
-class View;
+namespace osgQt {
+class MotionCoalescer;
 }
 
-namespace osgQt {
-class GraphicsWindowQt;
-class GLWidget;
+namespace osgViewer {
+class GraphicsWindow;
+class View;
 }
 
 namespace earth::core {
@@ -34,14 +36,32 @@ class SimulationBootstrapper;
 
 namespace earth::ui {
 
+class InputLatencyOverlay;
+
 /**
- * @brief 基于 osgQt::GraphicsWindowQt 的 osgEarth 场景窗口，负责在 Qt UI 中嵌入三维视图并桥接交互。
+ * @brief 基于 osgQt 图形窗口的 osgEarth 场景窗口，负责在 Qt UI 中嵌入三维视图并桥接交互。
  */
 class SceneWidget : public QWidget {
     Q_OBJECT
 
 public:
+    /**
+     * @brief 嵌入式 GL 表面的实现：QGLWidget（osgQt::GraphicsWindowQt）或 QWindow + QOpenGLContext
+     *        （osgQt::GraphicsWindowQWindow，绘制线程直接交换缓冲，不经过 Qt 绘制流程）。
+     */
+    enum class SurfaceBackend { GLWidget, QWindow };
+
+    /**
+     * @brief 由环境变量 EARTH_GL_BACKEND 选择后端：qwindow 为 QWindow，未设置或其他值为 QGLWidget。
+     */
+    static SurfaceBackend backendFromEnvironment();
+
     explicit SceneWidget(QWidget* parent = nullptr);
+    /**
+     * @brief 使用指定 GL 表面后端构造，供基准对比两种后端。
+     */
+    SceneWidget(SurfaceBackend backend, QWidget* parent);
+    ~SceneWidget() override;
 
     /**
      * @brief 注入仿真初始化器，SceneWidget 会自动挂接场景与环境配置。
@@ -63,15 +83,47 @@ public:
      */
     osgViewer::View* embeddedView() const noexcept { return m_view.get(); }
 
+    /**
+     * @brief 暂时从帧时钟注销，同步渲染若干帧并返回单帧耗时中位数（毫秒，含 glFinish）；视图不可用时返回负值。
+     */
+    double measureFrameTimeMs(int warmupFrames, int measuredFrames);
+
+    /**
+     * @brief 当前 OpenGL 上下文的 GL_RENDERER 字符串，上下文不可用时为空。
+     */
+    QString rendererName() const;
+
+    SurfaceBackend surfaceBackend() const noexcept { return m_backend; }
+
+    /**
+     * @brief 开关输入延迟追踪：挂接各阶段打点钩子并在视图左上角显示延迟分布，关闭时摘除钩子。
+     */
+    void setInputLatencyOverlay(bool enabled);
+    bool inputLatencyOverlay() const noexcept { return m_latencyOverlay != nullptr; }
+
+    /**
+     * @brief 鼠标移动默认每帧只向 osgGA 投递最新一次；开启后合并事件携带两帧之间的全部采样（自由画笔等工具使用）。
+     */
+    void setFullRateMotion(bool enabled);
+    bool fullRateMotion() const noexcept { return m_fullRateMotion; }
+
 signals:
     /**
      * @brief 鼠标拾取新的经纬度时发出信号，单位为度/米。
      */
     void mouseGeoPositionChanged(double lon, double lat, double height);
+    /**
+     * @brief 左键单击（按下与抬起位置相近，非拖拽漫游）地表时发出信号，单位为度/米。
+     */
+    void mouseGeoClicked(double lon, double lat, double height);
     /**
      * @brief 渲染帧率统计更新时发出信号，单位为 FPS。
      */
     void frameRateChanged(double fps);
+    /**
+     * @brief 与帧率同频发出的逐帧性能指标摘要（各模块耗时/计数），多行文本。
+     */
+    void frameMetricsChanged(const QString& summary);
 
 protected:
     void showEvent(QShowEvent* event) override;
@@ -79,10 +131,13 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
     bool eventFilter(QObject* watched, QEvent* event) override;
 
-private slots:
-    void onFrame();
-
 private:
+    class FrameHook;
+
+    /**
+     * @brief 帧时钟每个节拍渲染前询问：视图不可见或尚未就绪时跳过本帧。
+     */
+    bool beginFrame();
     void initializeViewer();
     void ensureGraphicsWindow();
     void applySceneData();
@@ -98,18 +153,31 @@ private:
      */
     bool computeGeoAt(const QPoint& pos, double& lon, double& lat, double& height) const;
     float currentDevicePixelRatio() const;
+    /**
+     * @brief 每帧结束时对本帧最后一次鼠标位置做一次拾取，替代逐个鼠标移动事件拾取。
+     */
+    void resolveHoverPick();
+    osgQt::MotionCoalescer* motionCoalescer() const;
 
     core::SimulationBootstrapper* m_bootstrapper = nullptr;
     osg::ref_ptr<osgViewer::CompositeViewer> m_viewer;
     osg::ref_ptr<osgViewer::View> m_view;
-    osg::ref_ptr<osgQt::GraphicsWindowQt> m_graphicsWindow;
-    QPointer<osgQt::GLWidget> m_glWidget;
-    QTimer m_frameTimer;
+    SurfaceBackend m_backend = SurfaceBackend::GLWidget;
+    osg::ref_ptr<osgViewer::GraphicsWindow> m_graphicsWindow;
+    /// 放入布局的表面控件：GLWidget 本身或 QWindow 的容器。
+    QPointer<QWidget> m_surfaceWidget;
+    /// 接收鼠标事件、安装事件过滤器的对象：GLWidget 或 GLWindow。
+    QPointer<QObject> m_inputSource;
+    osg::ref_ptr<FrameHook> m_frameHook;
+    std::unique_ptr<InputLatencyOverlay> m_latencyOverlay;
     bool m_viewerInitialized = false;
     const osgEarth::SkyNode* m_lastAttachedSky = nullptr;
     QElapsedTimer m_fpsTimer;
     int m_frameCounter = 0;
     double m_lastReportedFps = 0.0;
+    QPoint m_pressPos;
+    std::optional<QPoint> m_hoverPos;
+    bool m_fullRateMotion = false;
 };
 
 } // namespace earth::ui
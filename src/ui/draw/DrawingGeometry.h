@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ui/draw/DrawingTypes.h"
+
+#include <array>
+
+namespace earth::ui::draw {
+
+/**
+ * @brief 由拖拽的两个对角点生成经纬度对齐的矩形顶点（左上、右上、右下、左下），高程取两点均值。
+ *
+ * 纯函数且不分配内存，绘制控制器与微基准共用。
+ */
+inline std::array<MapGeoPoint, 4> rectangleVertices(const MapGeoPoint& first, const MapGeoPoint& second) noexcept {
+    const double meanAltitude = 0.5 * (first.altitudeMeters + second.altitudeMeters);
+    return {{
+        {first.longitudeDeg, first.latitudeDeg, meanAltitude},
+        {second.longitudeDeg, first.latitudeDeg, meanAltitude},
+        {second.longitudeDeg, second.latitudeDeg, meanAltitude},
+        {first.longitudeDeg, second.latitudeDeg, meanAltitude},
+    }};
+}
+
+} // namespace earth::ui::draw
@@ -1,13 +1,14 @@
 #include "ui/draw/MapDrawingController.h"
 
+#include "core/geo/Geodesy.h"
 #include "ui/SceneWidget.h"
+#include "ui/draw/DrawingGeometry.h"
 #include "ui/draw/MapDrawingEventHandler.h"
 
 #include <algorithm>
 #include <cmath>
 
 #include <osg/Group>
-#include <osg/Math>
 #include <osgViewer/View>
 
 #include <osgEarth/AltitudeSymbol>
@@ -66,10 +67,14 @@ void MapDrawingController::attachSceneWidget(SceneWidget* widget) {
     }
 
     removeEventHandler();
+    if (m_sceneWidget != nullptr) {
+        m_sceneWidget->setFullRateMotion(false);
+    }
     m_sceneWidget = widget;
     m_view = nullptr;
     if (m_sceneWidget != nullptr) {
         m_view = m_sceneWidget->embeddedView();
+        m_sceneWidget->setFullRateMotion(m_activeTool == DrawingTool::Freehand);
     }
 
     installEventHandler();
@@ -96,6 +101,9 @@ void MapDrawingController::setTool(DrawingTool tool) {
 
     m_activeTool = tool;
     m_interactionEnabled = (tool != DrawingTool::None);
+    if (m_sceneWidget != nullptr) {
+        m_sceneWidget->setFullRateMotion(tool == DrawingTool::Freehand);
+    }
     resetActivePrimitive();
 }
 
@@ -163,6 +171,24 @@ void MapDrawingController::pointerDrag(const MapGeoPoint& point) {
     }
 }
 
+void MapDrawingController::pointerDragBatch(const std::vector<MapGeoPoint>& points) {
+    if (!m_interactionEnabled || points.empty()) {
+        return;
+    }
+    if (!m_freehandDrawing) {
+        pointerDrag(points.back());
+        return;
+    }
+
+    bool appended = false;
+    for (const MapGeoPoint& point : points) {
+        appended = pushPolylineVertex(point, true) || appended;
+    }
+    if (appended) {
+        rebuildPreview();
+    }
+}
+
 void MapDrawingController::pointerRelease(const MapGeoPoint& point) {
     if (!m_interactionEnabled) {
         return;
@@ -282,7 +308,8 @@ void MapDrawingController::rebuildPreview() {
         previewPoint = m_previewPoint;
     } else if (m_activeTool == DrawingTool::Rectangle && m_previewPoint.has_value()) {
         primitive.type = PrimitiveType::Polygon;
-        primitive.vertices = buildRectangleVertices(m_activeVertices.front(), m_previewPoint.value());
+        const auto corners = rectangleVertices(m_activeVertices.front(), m_previewPoint.value());
+        primitive.vertices.assign(corners.begin(), corners.end());
         primitive.filled = true;
         primitive.strokeColor = m_strokeColor;
         primitive.fillOpacity = 0.28;
@@ -318,17 +345,23 @@ void MapDrawingController::addPointPrimitive(const MapGeoPoint& point) {
 }
 
 void MapDrawingController::appendPolylineVertex(const MapGeoPoint& point, bool forceSample) {
+    if (pushPolylineVertex(point, forceSample)) {
+        rebuildPreview();
+    }
+}
+
+bool MapDrawingController::pushPolylineVertex(const MapGeoPoint& point, bool forceSample) {
     const double minDistance =
         forceSample ? kMinSampleDistanceMeters * 0.25 : kMinSampleDistanceMeters;
 
     if (!m_activeVertices.empty()) {
         const MapGeoPoint& last = m_activeVertices.back();
         if (distanceMeters(last, point) < minDistance) {
-            return;
+            return false;
         }
     }
     m_activeVertices.push_back(point);
-    rebuildPreview();
+    return true;
 }
 
 void MapDrawingController::finalizePolyline() {
@@ -378,7 +411,8 @@ void MapDrawingController::finalizeRectangle(const MapGeoPoint& current, bool fo
 
     PrimitiveDefinition primitive;
     primitive.type = PrimitiveType::Polygon;
-    primitive.vertices = buildRectangleVertices(m_activeVertices.front(), current);
+    const auto corners = rectangleVertices(m_activeVertices.front(), current);
+    primitive.vertices.assign(corners.begin(), corners.end());
     primitive.strokeColor = m_strokeColor;
     primitive.filled = true;
     primitive.fillOpacity = 0.35;
@@ -482,45 +516,12 @@ osg::ref_ptr<osgEarth::FeatureNode> MapDrawingController::createNode(
     return node;
 }
 
-std::vector<MapGeoPoint> MapDrawingController::buildRectangleVertices(
-    const MapGeoPoint& first,
-    const MapGeoPoint& second) const {
-    std::vector<MapGeoPoint> vertices;
-    vertices.reserve(4);
-
-    const double meanAltitude = 0.5 * (first.altitudeMeters + second.altitudeMeters);
-
-    MapGeoPoint topLeft = first;
-    topLeft.altitudeMeters = meanAltitude;
-
-    MapGeoPoint topRight{second.longitudeDeg, first.latitudeDeg, meanAltitude};
-    MapGeoPoint bottomRight = second;
-    bottomRight.altitudeMeters = meanAltitude;
-    MapGeoPoint bottomLeft{first.longitudeDeg, second.latitudeDeg, meanAltitude};
-
-    vertices.push_back(topLeft);
-    vertices.push_back(topRight);
-    vertices.push_back(bottomRight);
-    vertices.push_back(bottomLeft);
-    return vertices;
-}
-
 bool MapDrawingController::hasActiveVertices(std::size_t minVertices) const {
     return m_activeVertices.size() >= minVertices;
 }
 
 double MapDrawingController::distanceMeters(const MapGeoPoint& a, const MapGeoPoint& b) {
-    constexpr double kEarthRadius = 6378137.0;
-    const double lat1 = osg::DegreesToRadians(a.latitudeDeg);
-    const double lat2 = osg::DegreesToRadians(b.latitudeDeg);
-    const double dLat = lat2 - lat1;
-    const double dLon = osg::DegreesToRadians(b.longitudeDeg - a.longitudeDeg);
-
-    const double sinHalfLat = std::sin(dLat / 2.0);
-    const double sinHalfLon = std::sin(dLon / 2.0);
-    double hav = sinHalfLat * sinHalfLat + std::cos(lat1) * std::cos(lat2) * sinHalfLon * sinHalfLon;
-    hav = std::min(1.0, std::max(0.0, hav));
-    return 2.0 * kEarthRadius * std::asin(std::sqrt(hav));
+    return core::geo::haversineMeters(a.longitudeDeg, a.latitudeDeg, b.longitudeDeg, b.latitudeDeg);
 }
 
 } // namespace earth::ui::draw
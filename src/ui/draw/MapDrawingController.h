@@ -72,6 +72,10 @@ public:
     // ---- 供事件处理器回调的接口 ----
     void pointerPress(const MapGeoPoint& point);
     void pointerDrag(const MapGeoPoint& point);
+    /**
+     * @brief 一帧内合并的多个拖拽采样（按时间先后），自由画笔逐点追加后只重建一次预览。
+     */
+    void pointerDragBatch(const std::vector<MapGeoPoint>& points);
     void pointerRelease(const MapGeoPoint& point);
     void pointerDoubleClick(const MapGeoPoint& point);
     void pointerMove(const MapGeoPoint& point);
@@ -87,6 +91,7 @@ private:
 
     void addPointPrimitive(const MapGeoPoint& point);
     void appendPolylineVertex(const MapGeoPoint& point, bool forceSample = false);
+    [[nodiscard]] bool pushPolylineVertex(const MapGeoPoint& point, bool forceSample);
     void finalizePolyline();
     void beginRectangle(const MapGeoPoint& anchor);
     void updateRectanglePreview(const MapGeoPoint& current);
@@ -98,7 +103,6 @@ private:
         std::optional<MapGeoPoint> preview,
         bool previewNode) const;
 
-    std::vector<MapGeoPoint> buildRectangleVertices(const MapGeoPoint& first, const MapGeoPoint& second) const;
     [[nodiscard]] bool hasActiveVertices(std::size_t minVertices) const;
     [[nodiscard]] static double distanceMeters(const MapGeoPoint& a, const MapGeoPoint& b);
 
@@ -1,7 +1,9 @@
 #include "ui/draw/MapDrawingEventHandler.h"
 
+#include "core/InputLatencyTracer.h"
 #include "ui/draw/MapDrawingController.h"
 
+#include <osgQt/MotionCoalescer>
 #include <osgViewer/View>
 #include <osgUtil/LineSegmentIntersector>
 
@@ -28,9 +30,15 @@ bool MapDrawingEventHandler::handle(const osgGA::GUIEventAdapter& ea, osgGA::GUI
         return false;
     }
 
+    auto& tracer = core::InputLatencyTracer::instance();
+    if (tracer.enabled() && ea.getEventType() != osgGA::GUIEventAdapter::FRAME && m_view->getFrameStamp() != nullptr) {
+        tracer.markStage(core::InputLatencyTracer::Stage::Handler, m_view->getFrameStamp()->getFrameNumber(),
+                         osg::Timer::instance()->tick());
+    }
+
     MapGeoPoint geo{};
     auto sampleCurrent = [&]() -> bool {
-        return samplePoint(ea, geo);
+        return samplePoint(ea.getX(), ea.getY(), geo);
     };
 
     bool consumed = false;
@@ -42,7 +50,13 @@ bool MapDrawingEventHandler::handle(const osgGA::GUIEventAdapter& ea, osgGA::GUI
         }
         break;
     case osgGA::GUIEventAdapter::DRAG:
-        if ((ea.getButtonMask() & osgGA::GUIEventAdapter::LEFT_MOUSE_BUTTON) != 0u && sampleCurrent()) {
+        if ((ea.getButtonMask() & osgGA::GUIEventAdapter::LEFT_MOUSE_BUTTON) == 0u) {
+            break;
+        }
+        if (std::vector<MapGeoPoint> points; dragHistory(ea, points)) {
+            m_controller->pointerDragBatch(points);
+            consumed = true;
+        } else if (sampleCurrent()) {
             m_controller->pointerDrag(geo);
             consumed = true;
         }
@@ -71,7 +85,24 @@ bool MapDrawingEventHandler::handle(const osgGA::GUIEventAdapter& ea, osgGA::GUI
     return consumed;
 }
 
-bool MapDrawingEventHandler::samplePoint(const osgGA::GUIEventAdapter& ea, MapGeoPoint& outPoint) const {
+bool MapDrawingEventHandler::dragHistory(const osgGA::GUIEventAdapter& ea, std::vector<MapGeoPoint>& outPoints) const {
+    const osgQt::MotionHistory* history = osgQt::MotionHistory::get(ea);
+    if (history == nullptr || history->getSamples().empty()) {
+        return false;
+    }
+
+    outPoints.clear();
+    outPoints.reserve(history->getSamples().size());
+    MapGeoPoint geo{};
+    for (const osgQt::MotionHistory::Sample& sample : history->getSamples()) {
+        if (samplePoint(sample.x, sample.y, geo)) {
+            outPoints.push_back(geo);
+        }
+    }
+    return !outPoints.empty();
+}
+
+bool MapDrawingEventHandler::samplePoint(float x, float y, MapGeoPoint& outPoint) const {
     if (m_view == nullptr) {
         return false;
     }
@@ -82,7 +113,7 @@ bool MapDrawingEventHandler::samplePoint(const osgGA::GUIEventAdapter& ea, MapGe
     }
 
     osgUtil::LineSegmentIntersector::Intersections hits;
-    if (!m_view->computeIntersections(ea.getX(), ea.getY(), hits)) {
+    if (!m_view->computeIntersections(x, y, hits)) {
         return false;
     }
     if (hits.empty()) {
@@ -5,6 +5,8 @@
 #include <osg/observer_ptr>
 #include <osgGA/GUIEventHandler>
 
+#include <vector>
+
 namespace osgViewer {
 class View;
 }
@@ -35,7 +37,11 @@ public:
     bool handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& aa) override;
 
 private:
-    [[nodiscard]] bool samplePoint(const osgGA::GUIEventAdapter& ea, MapGeoPoint& outPoint) const;
+    [[nodiscard]] bool samplePoint(float x, float y, MapGeoPoint& outPoint) const;
+    /**
+     * @brief 合并拖拽事件携带的全速率采样逐个求交；事件没有采样历史时返回 false。
+     */
+    [[nodiscard]] bool dragHistory(const osgGA::GUIEventAdapter& ea, std::vector<MapGeoPoint>& outPoints) const;
 
     MapDrawingController* m_controller = nullptr;
     osgViewer::View* m_view = nullptr;
@@ -0,0 +1,69 @@
+#include "vision/FrameQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace earth::vision {
+
+FrameQueue::FrameQueue(std::size_t capacity)
+    : m_capacity(std::max<std::size_t>(capacity, 1)) {
+}
+
+bool FrameQueue::push(CapturedFrame frame) {
+    bool keptAll = true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) {
+            ++m_dropped;
+            return false;
+        }
+        while (m_frames.size() >= m_capacity) {
+            m_frames.pop_front();
+            ++m_dropped;
+            keptAll = false;
+        }
+        m_frames.push_back(std::move(frame));
+    }
+    m_ready.notify_one();
+    return keptAll;
+}
+
+bool FrameQueue::pop(CapturedFrame& out) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ready.wait(lock, [this]() {
+        return m_closed || !m_frames.empty();
+    });
+    if (m_frames.empty()) {
+        return false;
+    }
+    out = std::move(m_frames.front());
+    m_frames.pop_front();
+    return true;
+}
+
+void FrameQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_frames.clear();
+    }
+    m_ready.notify_all();
+}
+
+void FrameQueue::reopen() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frames.clear();
+    m_closed = false;
+}
+
+std::size_t FrameQueue::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frames.size();
+}
+
+std::uint64_t FrameQueue::droppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+} // namespace earth::vision
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace earth::vision {
+
+/**
+ * @brief 一帧回读图像：RGBA8，行序与 OpenGL 一致（自下而上）。
+ */
+struct CapturedFrame {
+    cv::Mat image;
+    std::uint64_t frameNumber = 0;
+    double referenceTime = 0.0;
+};
+
+/**
+ * @brief 渲染线程与检测线程之间的有界帧队列。
+ *
+ * 写入端永不阻塞：队列满时丢弃最旧的帧，保证渲染循环不会因图像处理变慢而卡顿，检测端总是拿到较新的画面。
+ */
+class FrameQueue {
+public:
+    explicit FrameQueue(std::size_t capacity);
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /**
+     * @brief 入队；队列已关闭时丢弃。返回 false 表示为腾出空间丢弃了旧帧或本帧。
+     */
+    bool push(CapturedFrame frame);
+
+    /**
+     * @brief 阻塞直到取得一帧；队列关闭且为空时返回 false。
+     */
+    bool pop(CapturedFrame& out);
+
+    /**
+     * @brief 关闭队列并唤醒全部等待的消费者。
+     */
+    void close();
+
+    /**
+     * @brief 清空并重新开放队列。
+     */
+    void reopen();
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::uint64_t droppedCount() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<CapturedFrame> m_frames;
+    std::size_t m_capacity = 1;
+    std::uint64_t m_dropped = 0;
+    bool m_closed = false;
+};
+
+} // namespace earth::vision
@@ -0,0 +1,146 @@
+#include "vision/PboFrameGrabber.h"
+
+#include "core/FrameMetrics.h"
+
+#include <osg/BufferObject>
+#include <osg/FrameStamp>
+#include <osg/GLExtensions>
+#include <osg/State>
+#include <osg/Viewport>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr std::size_t kBytesPerPixel = 4;
+} // namespace
+
+namespace earth::vision {
+
+PboFrameGrabber::PboFrameGrabber(std::shared_ptr<FrameQueue> queue, unsigned int captureInterval)
+    : m_queue(std::move(queue)) {
+    setCaptureInterval(captureInterval);
+}
+
+void PboFrameGrabber::setCaptureInterval(unsigned int interval) noexcept {
+    m_interval.store(std::max(interval, 1U));
+}
+
+void PboFrameGrabber::operator()(osg::RenderInfo& renderInfo) const {
+    osg::State* state = renderInfo.getState();
+    osg::GLExtensions* ext = state != nullptr ? state->get<osg::GLExtensions>() : nullptr;
+    if (!m_enabled.load()) {
+        if (ext != nullptr) {
+            releaseBuffers(ext);
+        }
+        return;
+    }
+    ++m_drawCount;
+    const osg::FrameStamp* stamp = state != nullptr ? state->getFrameStamp() : nullptr;
+    const bool capture =
+        stamp != nullptr ? capturesFrame(stamp->getFrameNumber()) : m_drawCount % m_interval.load() == 0;
+    if (!m_queue || !capture) {
+        return;
+    }
+
+    const osg::Camera* camera = renderInfo.getCurrentCamera();
+    const osg::Viewport* viewport = camera != nullptr ? camera->getViewport() : nullptr;
+    if (viewport == nullptr || viewport->width() <= 0.0 || viewport->height() <= 0.0) {
+        return;
+    }
+    const int x = static_cast<int>(viewport->x());
+    const int y = static_cast<int>(viewport->y());
+    const int width = static_cast<int>(viewport->width());
+    const int height = static_cast<int>(viewport->height());
+
+    if (ext == nullptr || !ext->isPBOSupported) {
+        readSynchronously(x, y, width, height, stamp);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    ensureBuffers(ext, width, height);
+
+    // 1. 当前帧异步读入写槽位，glReadPixels 立即返回。
+    Slot& write = m_slots[m_writeIndex];
+    ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, write.buffer);
+    // osg::State 不跟踪像素存储参数，改动后须恢复，以免影响其他回读代码。
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    write.frameNumber = stamp != nullptr ? stamp->getFrameNumber() : m_drawCount;
+    write.referenceTime = stamp != nullptr ? stamp->getReferenceTime() : 0.0;
+    write.pending = true;
+
+    // 2. 映射环中最旧的槽位（kRingSize-1 次捕获之前发起），数据已传输完毕。
+    const std::size_t readIndex = (m_writeIndex + 1) % kRingSize;
+    Slot& read = m_slots[readIndex];
+    if (read.pending) {
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, read.buffer);
+        if (const void* pixels = ext->glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB)) {
+            CapturedFrame frame;
+            frame.image.create(height, width, CV_8UC4);
+            std::memcpy(frame.image.data, pixels, frame.image.total() * kBytesPerPixel);
+            frame.frameNumber = read.frameNumber;
+            frame.referenceTime = read.referenceTime;
+            ext->glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+            m_queue->push(std::move(frame));
+        }
+        read.pending = false;
+    }
+    ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    m_writeIndex = readIndex;
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    core::FrameMetrics::instance().recordDuration("vision.readback", elapsed.count());
+}
+
+void PboFrameGrabber::ensureBuffers(osg::GLExtensions* ext, int width, int height) const {
+    if (m_slots.front().buffer != 0 && width == m_width && height == m_height) {
+        return;
+    }
+    releaseBuffers(ext);
+
+    const auto bytes =
+        static_cast<GLsizeiptrARB>(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * kBytesPerPixel);
+    for (Slot& slot : m_slots) {
+        ext->glGenBuffers(1, &slot.buffer);
+        ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, slot.buffer);
+        ext->glBufferData(GL_PIXEL_PACK_BUFFER_ARB, bytes, nullptr, GL_STREAM_READ_ARB);
+        slot.pending = false;
+    }
+    ext->glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+    m_width = width;
+    m_height = height;
+    m_writeIndex = 0;
+}
+
+void PboFrameGrabber::releaseBuffers(osg::GLExtensions* ext) const {
+    for (Slot& slot : m_slots) {
+        if (slot.buffer != 0) {
+            ext->glDeleteBuffers(1, &slot.buffer);
+        }
+        slot = Slot {};
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+void PboFrameGrabber::readSynchronously(int x, int y, int width, int height, const osg::FrameStamp* stamp) const {
+    CapturedFrame frame;
+    frame.image.create(height, width, CV_8UC4);
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, frame.image.data);
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    frame.frameNumber = stamp != nullptr ? stamp->getFrameNumber() : m_drawCount;
+    frame.referenceTime = stamp != nullptr ? stamp->getReferenceTime() : 0.0;
+    m_queue->push(std::move(frame));
+}
+
+} // namespace earth::vision
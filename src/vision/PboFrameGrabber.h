@@ -0,0 +1,73 @@
+#pragma once
+
+#include "vision/FrameQueue.h"
+
+#include <osg/Camera>
+#include <osg/GL>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace earth::vision {
+
+/**
+ * @brief 相机绘制回调：通过像素缓冲对象（PBO）环异步回读颜色缓冲，推入 FrameQueue。
+ *
+ * 每次捕获只发起 glReadPixels 到当前 PBO，并映射 kRingSize-1 次捕获之前的 PBO——此时 GPU 早已完成传输，
+ * 映射不会让渲染线程等待。可挂为 FBO 相机的 PostDrawCallback（FBO 仍绑定时）或主相机的 FinalDrawCallback。
+ * 回调只服务于单个图形上下文；不支持 PBO 的驱动退化为同步回读。
+ */
+class PboFrameGrabber : public osg::Camera::DrawCallback {
+public:
+    static constexpr std::size_t kRingSize = 3;
+
+    explicit PboFrameGrabber(std::shared_ptr<FrameQueue> queue, unsigned int captureInterval = 1);
+
+    /**
+     * @brief 关闭后下一次绘制会释放 PBO；重新开启时重建。
+     */
+    void setEnabled(bool enabled) noexcept { m_enabled.store(enabled); }
+    [[nodiscard]] bool isEnabled() const noexcept { return m_enabled.load(); }
+
+    /**
+     * @brief 每隔多少帧捕获一次，按帧号判定。
+     */
+    void setCaptureInterval(unsigned int interval) noexcept;
+
+    /**
+     * @brief 帧号为 frameNumber 的帧是否捕获；挂载相机据此在剔除阶段跳过不捕获的帧，省掉整遍渲染。
+     */
+    [[nodiscard]] bool capturesFrame(unsigned int frameNumber) const noexcept {
+        return frameNumber % m_interval.load() == 0;
+    }
+
+    void operator()(osg::RenderInfo& renderInfo) const override;
+
+protected:
+    ~PboFrameGrabber() override = default;
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        std::uint64_t frameNumber = 0;
+        double referenceTime = 0.0;
+        bool pending = false;
+    };
+
+    void ensureBuffers(osg::GLExtensions* ext, int width, int height) const;
+    void releaseBuffers(osg::GLExtensions* ext) const;
+    void readSynchronously(int x, int y, int width, int height, const osg::FrameStamp* stamp) const;
+
+    std::shared_ptr<FrameQueue> m_queue;
+    std::atomic<bool> m_enabled {true};
+    std::atomic<unsigned int> m_interval {1};
+    mutable std::array<Slot, kRingSize> m_slots {};
+    mutable std::size_t m_writeIndex = 0;
+    mutable std::uint64_t m_drawCount = 0;
+    mutable int m_width = 0;
+    mutable int m_height = 0;
+};
+
+} // namespace earth::vision
@@ -0,0 +1,178 @@
+#include "vision/RunwayChangeDetector.h"
+
+#include "core/FrameMetrics.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace {
+// 无变化时参考帧融合新画面的权重，约数十帧跟上一次光照变化。
+constexpr double kReferenceBlend = 0.05;
+} // namespace
+
+namespace earth::vision {
+
+RunwayChangeDetector::RunwayChangeDetector(std::shared_ptr<FrameQueue> queue)
+    : m_queue(std::move(queue)) {
+}
+
+RunwayChangeDetector::~RunwayChangeDetector() {
+    stop();
+}
+
+void RunwayChangeDetector::setMask(core::RunwayMaskView mask) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mask = std::move(mask);
+    m_roi.reset();
+}
+
+void RunwayChangeDetector::setThresholds(int diffThreshold, double minAreaPixels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_diffThreshold = std::clamp(diffThreshold, 1, 255);
+    m_minAreaPixels = std::max(minAreaPixels, 0.0);
+}
+
+void RunwayChangeDetector::setReportCallback(ReportCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_callback = std::move(callback);
+}
+
+void RunwayChangeDetector::resetReference() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reference.reset();
+}
+
+void RunwayChangeDetector::start(unsigned int workerCount) {
+    if (isRunning() || !m_queue) {
+        return;
+    }
+    if (workerCount == 0) {
+        workerCount = std::max(1U, std::thread::hardware_concurrency() / 2U);
+    }
+    m_queue->reopen();
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+void RunwayChangeDetector::stop() {
+    if (m_queue) {
+        m_queue->close();
+    }
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+void RunwayChangeDetector::workerLoop() {
+    CapturedFrame frame;
+    while (m_queue->pop(frame)) {
+        const ChangeReport report = process(frame);
+
+        core::FrameMetrics& metrics = core::FrameMetrics::instance();
+        metrics.recordDuration("vision.detect", report.processMs);
+        metrics.recordValue("vision.dropped", static_cast<double>(m_queue->droppedCount()), "帧");
+
+        ReportCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            callback = m_callback;
+        }
+        if (callback) {
+            callback(report);
+        }
+    }
+}
+
+ChangeReport RunwayChangeDetector::process(const CapturedFrame& frame) {
+    const auto start = std::chrono::steady_clock::now();
+    ChangeReport report;
+    report.frameNumber = frame.frameNumber;
+
+    // GL 回读自下而上，翻转后与跑道掩码的行序（自北向南）一致。
+    cv::Mat gray;
+    cv::cvtColor(frame.image, gray, cv::COLOR_RGBA2GRAY);
+    cv::flip(gray, gray, 0);
+
+    std::shared_ptr<const cv::Mat> reference;
+    int diffThreshold = kDefaultDiffThreshold;
+    double minArea = kDefaultMinAreaPixels;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_reference || m_reference->size() != gray.size()) {
+            m_reference = std::make_shared<const cv::Mat>(gray);
+            report.referenceReset = true;
+        }
+        reference = m_reference;
+        diffThreshold = m_diffThreshold;
+        minArea = m_minAreaPixels;
+    }
+
+    if (!report.referenceReset) {
+        cv::Mat changed;
+        cv::absdiff(gray, *reference, changed);
+        cv::threshold(changed, changed, diffThreshold, 255.0, cv::THRESH_BINARY);
+
+        const std::shared_ptr<const cv::Mat> roi = roiFor(gray.size());
+        if (roi) {
+            cv::bitwise_and(changed, *roi, changed);
+        }
+        // 开运算去掉抗锯齿边缘与纹理闪烁造成的孤立噪点。
+        cv::morphologyEx(changed, changed, cv::MORPH_OPEN, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)));
+
+        const int roiPixels = roi ? cv::countNonZero(*roi) : static_cast<int>(gray.total());
+        report.changedFraction =
+            roiPixels > 0 ? static_cast<double>(cv::countNonZero(changed)) / static_cast<double>(roiPixels) : 0.0;
+
+        std::vector<std::vector<cv::Point>> contours;
+        cv::findContours(changed, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+        for (const std::vector<cv::Point>& contour : contours) {
+            const double area = cv::contourArea(contour);
+            if (area >= minArea) {
+                report.regions.push_back({cv::boundingRect(contour), area});
+            }
+        }
+
+        if (report.regions.empty()) {
+            auto blended = std::make_shared<cv::Mat>();
+            cv::addWeighted(*reference, 1.0 - kReferenceBlend, gray, kReferenceBlend, 0.0, *blended);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // 其他线程已替换参考帧（或被重置）时放弃本次融合。
+            if (m_reference == reference) {
+                m_reference = std::move(blended);
+            }
+        }
+    }
+
+    report.processMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+std::shared_ptr<const cv::Mat> RunwayChangeDetector::roiFor(const cv::Size& size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_roi && m_roi->size() == size) {
+        return m_roi;
+    }
+    if (m_mask.empty()) {
+        return nullptr;
+    }
+
+    cv::Mat roi;
+    if (m_mask.mat().size() == size) {
+        cv::threshold(m_mask.mat(), roi, 0.0, 255.0, cv::THRESH_BINARY);
+    } else {
+        cv::resize(m_mask.mat(), roi, size, 0.0, 0.0, cv::INTER_NEAREST);
+        cv::threshold(roi, roi, 0.0, 255.0, cv::THRESH_BINARY);
+    }
+    m_roi = std::make_shared<const cv::Mat>(std::move(roi));
+    return m_roi;
+}
+
+} // namespace earth::vision
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/RunwayMaskService.h"
+#include "vision/FrameQueue.h"
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace earth::vision {
+
+/**
+ * @brief 一处变化区域（像素坐标，行序自北向南，与跑道掩码一致）。
+ */
+struct ChangeRegion {
+    cv::Rect bounds;
+    double areaPixels = 0.0;
+};
+
+/**
+ * @brief 单帧检测结果。
+ */
+struct ChangeReport {
+    std::uint64_t frameNumber = 0;
+    double changedFraction = 0.0; /**< 跑道区域内变化像素占比。 */
+    double processMs = 0.0;
+    bool referenceReset = false;  /**< 本帧被用作新的参考帧，没有比较。 */
+    std::vector<ChangeRegion> regions;
+};
+
+/**
+ * @brief 跑道变化检测：工作线程池从 FrameQueue 取帧，与参考帧差分，并以跑道掩码为 ROI 标出变化区域。
+ *
+ * 参考帧以只读共享快照发布，各工作线程无需加锁即可比较；无变化时参考帧按小权重缓慢融合新画面，
+ * 以吸收昼夜光照的渐变。报告回调在工作线程中调用。
+ */
+class RunwayChangeDetector {
+public:
+    using ReportCallback = std::function<void(const ChangeReport&)>;
+
+    static constexpr int kDefaultDiffThreshold = 40;
+    static constexpr double kDefaultMinAreaPixels = 12.0;
+
+    explicit RunwayChangeDetector(std::shared_ptr<FrameQueue> queue);
+    ~RunwayChangeDetector();
+
+    RunwayChangeDetector(const RunwayChangeDetector&) = delete;
+    RunwayChangeDetector& operator=(const RunwayChangeDetector&) = delete;
+
+    /**
+     * @brief 设置 ROI 掩码（非零像素参与比较）；尺寸与帧不同时按最近邻缩放一次并缓存。
+     */
+    void setMask(core::RunwayMaskView mask);
+
+    void setThresholds(int diffThreshold, double minAreaPixels);
+
+    void setReportCallback(ReportCallback callback);
+
+    /**
+     * @brief 下一帧成为新的参考帧。
+     */
+    void resetReference();
+
+    /**
+     * @brief 启动 workerCount 个工作线程（0 表示按硬件并发数的一半）。
+     */
+    void start(unsigned int workerCount = 0);
+
+    /**
+     * @brief 关闭队列并等待全部工作线程退出。
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const noexcept { return !m_workers.empty(); }
+
+private:
+    void workerLoop();
+    ChangeReport process(const CapturedFrame& frame);
+    std::shared_ptr<const cv::Mat> roiFor(const cv::Size& size);
+
+    std::shared_ptr<FrameQueue> m_queue;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    core::RunwayMaskView m_mask;
+    std::shared_ptr<const cv::Mat> m_roi;
+    std::shared_ptr<const cv::Mat> m_reference;
+    ReportCallback m_callback;
+    int m_diffThreshold = kDefaultDiffThreshold;
+    double m_minAreaPixels = kDefaultMinAreaPixels;
+};
+
+} // namespace earth::vision
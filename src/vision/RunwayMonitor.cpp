@@ -0,0 +1,145 @@
+#include "vision/RunwayMonitor.h"
+
+#include "core/SimulationBootstrapper.h"
+#include "vision/PboFrameGrabber.h"
+
+#include <osg/Camera>
+#include <osg/FrameStamp>
+#include <osg/Group>
+#include <osg/NodeCallback>
+#include <osg/NodeVisitor>
+#include <osg/Texture2D>
+#include <osgEarth/GeoData>
+#include <osgEarth/MapNode>
+#include <osgEarth/SpatialReference>
+
+#include <utility>
+
+namespace {
+constexpr double kCameraAltitudeMeters = 3000.0;
+// 远裁剪面低于椭球面的余量，覆盖低于海平面的机场与地形误差。
+constexpr double kDepthMarginMeters = 1000.0;
+} // namespace
+
+namespace earth::vision {
+namespace {
+/**
+ * @brief 俯视相机外层组的剔除回调：只有回读器要捕获的帧才遍历相机，其余帧整遍地图渲染都不发生。
+ *
+ * 挂在相机自身上无效——剔除回调不遍历时 RTT 相机的渲染阶段仍会清屏并执行 PostDraw，回读到空白帧。
+ */
+class CaptureFrameGate : public osg::NodeCallback {
+public:
+    explicit CaptureFrameGate(PboFrameGrabber* grabber)
+        : m_grabber(grabber) {
+    }
+
+    void operator()(osg::Node* node, osg::NodeVisitor* nv) override {
+        const osg::FrameStamp* stamp = nv->getFrameStamp();
+        if (stamp == nullptr || m_grabber->capturesFrame(stamp->getFrameNumber())) {
+            traverse(node, nv);
+        }
+    }
+
+private:
+    osg::ref_ptr<PboFrameGrabber> m_grabber;
+};
+} // namespace
+
+RunwayMonitor::RunwayMonitor()
+    : m_queue(std::make_shared<FrameQueue>(kQueueCapacity))
+    , m_detector(m_queue)
+    , m_grabber(new PboFrameGrabber(m_queue, kDefaultCaptureInterval)) {
+}
+
+RunwayMonitor::~RunwayMonitor() {
+    stop();
+}
+
+bool RunwayMonitor::start(const core::SimulationBootstrapper& bootstrapper, int resolution) {
+    stop();
+
+    osgEarth::MapNode* mapNode = bootstrapper.activeMapNode();
+    osg::Group* parent = bootstrapper.environmentRoot();
+    if (mapNode == nullptr || mapNode->getMapSRS() == nullptr || parent == nullptr) {
+        return false;
+    }
+    const core::RunwayMaskView mask = bootstrapper.runwayMask(resolution);
+    if (mask.empty()) {
+        return false;
+    }
+    const core::RunwayMaskPyramid& pyramid = *mask.pyramid();
+    const int size = mask.mat().cols;
+
+    // 在机场中心正上方建立局部 ENU 坐标系：相机沿 -Z 俯视，图像上方为正北，与掩码行序一致。
+    // 须先转换到地图坐标系，否则投影地图上得到的是地心坐标系，相机对不准场景。
+    const osgEarth::GeoPoint geographicEye(mapNode->getMapSRS()->getGeographicSRS(), pyramid.centerLon,
+                                           pyramid.centerLat, kCameraAltitudeMeters, osgEarth::ALTMODE_ABSOLUTE);
+    osgEarth::GeoPoint eye;
+    osg::Matrixd localToWorld;
+    if (!geographicEye.transform(mapNode->getMapSRS(), eye) || !eye.createLocalToWorld(localToWorld)) {
+        return false;
+    }
+
+    m_colorTarget = new osg::Texture2D();
+    m_colorTarget->setTextureSize(size, size);
+    m_colorTarget->setInternalFormat(GL_RGBA);
+    m_colorTarget->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+    m_colorTarget->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+
+    const double half = pyramid.extentMeters * 0.5;
+    m_camera = new osg::Camera();
+    m_camera->setName("RunwayOverheadCamera");
+    m_camera->setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+    m_camera->setRenderOrder(osg::Camera::PRE_RENDER);
+    m_camera->setRenderTargetImplementation(osg::Camera::FRAME_BUFFER_OBJECT);
+    m_camera->setViewport(0, 0, size, size);
+    m_camera->setClearMask(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_camera->setClearColor(osg::Vec4(0.0F, 0.0F, 0.0F, 1.0F));
+    m_camera->setComputeNearFarMode(osg::CullSettings::DO_NOT_COMPUTE_NEAR_FAR);
+    m_camera->setProjectionMatrixAsOrtho(-half, half, -half, half, 1.0, kCameraAltitudeMeters + kDepthMarginMeters);
+    m_camera->setViewMatrix(osg::Matrixd::inverse(localToWorld));
+    m_camera->attach(osg::Camera::COLOR_BUFFER, m_colorTarget.get());
+    m_camera->attach(osg::Camera::DEPTH_BUFFER, GL_DEPTH_COMPONENT24);
+    // PostDraw 时 FBO 仍处于绑定状态，回读的就是俯视相机自己的颜色附件。
+    m_camera->setPostDrawCallback(m_grabber.get());
+    m_camera->addChild(mapNode);
+
+    m_detector.setMask(mask);
+    m_detector.resetReference();
+    m_detector.start();
+
+    m_gate = new osg::Group();
+    m_gate->setName("RunwayOverheadCaptureGate");
+    m_gate->setCullCallback(new CaptureFrameGate(m_grabber.get()));
+    m_gate->addChild(m_camera.get());
+    parent->addChild(m_gate.get());
+    m_parent = parent;
+    return true;
+}
+
+void RunwayMonitor::stop() {
+    osg::ref_ptr<osg::Group> parent;
+    if (m_gate.valid() && m_parent.lock(parent)) {
+        parent->removeChild(m_gate.get());
+    }
+    m_detector.stop();
+    m_gate = nullptr;
+    m_camera = nullptr;
+    m_colorTarget = nullptr;
+    m_parent = nullptr;
+}
+
+void RunwayMonitor::resetReference() {
+    m_detector.resetReference();
+}
+
+void RunwayMonitor::setReportCallback(RunwayChangeDetector::ReportCallback callback) {
+    m_detector.setReportCallback(std::move(callback));
+}
+
+std::uint64_t RunwayMonitor::droppedFrames() const {
+    return m_queue->droppedCount();
+}
+
+} // namespace earth::vision
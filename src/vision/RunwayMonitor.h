@@ -0,0 +1,70 @@
+#pragma once
+
+#include "vision/RunwayChangeDetector.h"
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <memory>
+
+namespace osg {
+class Camera;
+class Group;
+class Texture2D;
+} // namespace osg
+
+namespace earth::core {
+class SimulationBootstrapper;
+}
+
+namespace earth::vision {
+
+class PboFrameGrabber;
+
+/**
+ * @brief 跑道监视：在机场上空放置正射俯视的离屏相机，经 PBO 异步回读后交给 RunwayChangeDetector。
+ *
+ * 俯视相机的覆盖范围与分辨率取自跑道掩码金字塔，回读图像与掩码逐像素对齐，掩码可直接作为 ROI。
+ * 相机经外层组挂在环境根节点下，只在回读器捕获的帧（每 kDefaultCaptureInterval 帧一次）参与渲染；
+ * 检测在工作线程完成，渲染循环只承担一次异步回读。
+ */
+class RunwayMonitor {
+public:
+    static constexpr int kDefaultResolution = 1024;
+    static constexpr unsigned int kDefaultCaptureInterval = 5;
+    static constexpr std::size_t kQueueCapacity = 4;
+
+    RunwayMonitor();
+    ~RunwayMonitor();
+
+    RunwayMonitor(const RunwayMonitor&) = delete;
+    RunwayMonitor& operator=(const RunwayMonitor&) = delete;
+
+    /**
+     * @brief 为当前机场创建俯视相机并启动检测；已在运行时先停止再按当前地图重建。
+     * @return 当前没有地图时返回 false。
+     */
+    bool start(const core::SimulationBootstrapper& bootstrapper, int resolution = kDefaultResolution);
+    void stop();
+    [[nodiscard]] bool isRunning() const noexcept { return m_camera.valid(); }
+
+    void resetReference();
+
+    /**
+     * @brief 检测结果回调，在工作线程中调用。
+     */
+    void setReportCallback(RunwayChangeDetector::ReportCallback callback);
+
+    [[nodiscard]] std::uint64_t droppedFrames() const;
+
+private:
+    std::shared_ptr<FrameQueue> m_queue;
+    RunwayChangeDetector m_detector;
+    osg::ref_ptr<PboFrameGrabber> m_grabber;
+    osg::ref_ptr<osg::Group> m_gate; /**< 俯视相机的外层组，只在捕获帧遍历相机。 */
+    osg::ref_ptr<osg::Camera> m_camera;
+    osg::ref_ptr<osg::Texture2D> m_colorTarget;
+    osg::observer_ptr<osg::Group> m_parent;
+};
+
+} // namespace earth::vision
@@ -0,0 +1,75 @@
+#include "weather/CameraAnchoredGroup.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <osg/FrameStamp>
+#include <osg/Matrix>
+#include <osgUtil/CullVisitor>
+
+namespace {
+constexpr double kMaxStepSeconds = 0.25;
+} // namespace
+
+namespace earth::weather {
+
+double wrapPeriod(double value, double period) {
+    if (period <= 0.0) {
+        return 0.0;
+    }
+    const double wrapped = std::fmod(value, period);
+    return wrapped < 0.0 ? wrapped + period : wrapped;
+}
+
+CameraAnchoredGroup::CameraAnchoredGroup()
+    : m_ellipsoid(new osg::EllipsoidModel()) {
+    // 子节点包围盒位于局部坐标原点附近，世界坐标下的包围球没有意义，交由 traverse 自行处理。
+    setCullingActive(false);
+}
+
+void CameraAnchoredGroup::traverse(osg::NodeVisitor& nv) {
+    auto* cv = dynamic_cast<osgUtil::CullVisitor*>(&nv);
+    if (cv == nullptr || cv->getModelViewMatrix() == nullptr) {
+        osg::Group::traverse(nv);
+        return;
+    }
+
+    AnchorState state;
+    state.eyeWorld = cv->getEyeLocal();
+    if (m_geocentric) {
+        const osg::Vec3d& eye = state.eyeWorld;
+        m_ellipsoid->computeLocalToWorldTransformFromXYZ(eye.x(), eye.y(), eye.z(), state.localToWorld);
+        double latitude = 0.0;
+        double longitude = 0.0;
+        m_ellipsoid->convertXYZToLatLongHeight(eye.x(), eye.y(), eye.z(), latitude, longitude, state.eyeAltitude);
+    } else {
+        state.localToWorld.makeTranslate(state.eyeWorld);
+        state.eyeAltitude = state.eyeWorld.z();
+    }
+
+    const osg::FrameStamp* stamp = nv.getFrameStamp();
+    state.simulationTime = stamp != nullptr ? stamp->getSimulationTime() : 0.0;
+    const double referenceTime = stamp != nullptr ? stamp->getReferenceTime() : 0.0;
+    if (m_hasLastEye) {
+        state.deltaSeconds = std::clamp(state.simulationTime - m_lastTime, 0.0, kMaxStepSeconds);
+        state.frameSeconds = std::max(referenceTime - m_lastReferenceTime, 0.0);
+        // 旋转部分正交，transform3x3(M, v) 即 M 的逆旋转作用于 v，得到局部 ENU 中的位移。
+        state.eyeDeltaLocal = osg::Matrixd::transform3x3(state.localToWorld, state.eyeWorld - m_lastEye);
+        if (state.eyeDeltaLocal.length() > m_teleportDistance) {
+            state.eyeDeltaLocal.set(0.0, 0.0, 0.0);
+        }
+    }
+    m_lastEye = state.eyeWorld;
+    m_lastTime = state.simulationTime;
+    m_lastReferenceTime = referenceTime;
+    m_hasLastEye = true;
+
+    onAnchor(state);
+
+    osg::ref_ptr<osg::RefMatrix> modelView = new osg::RefMatrix(state.localToWorld * (*cv->getModelViewMatrix()));
+    cv->pushModelViewMatrix(modelView.get(), osg::Transform::RELATIVE_RF);
+    osg::Group::traverse(nv);
+    cv->popModelViewMatrix();
+}
+
+} // namespace earth::weather
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <osg/CoordinateSystemNode>
+#include <osg/Group>
+#include <osg/Matrixd>
+#include <osg/Vec3d>
+#include <osg/ref_ptr>
+
+namespace earth::weather {
+
+/**
+ * @brief 以相机为原点的局部 ENU 锚定组节点，供降水、云层等“跟随相机”的环境效果复用。
+ *
+ * cull 阶段压入以相机位置为原点、Z 轴朝上的模型视图矩阵，子节点几何只需在相机附近的局部坐标中建模，
+ * 不受地心坐标大数值的精度影响；派生类通过 onAnchor() 获取本帧的相机位移与时间步长来更新 uniform。
+ */
+class CameraAnchoredGroup : public osg::Group {
+public:
+    /**
+     * @brief 单次 cull 的锚定信息。
+     */
+    struct AnchorState {
+        osg::Vec3d eyeWorld;       /**< 相机世界坐标。 */
+        osg::Matrixd localToWorld; /**< 相机处局部 ENU → 世界坐标。 */
+        osg::Vec3d eyeDeltaLocal;  /**< 相机相对上一帧在局部 ENU 中的位移（瞬移时为零）。 */
+        double eyeAltitude = 0.0;  /**< 相机椭球高（米）。 */
+        double simulationTime = 0.0;
+        double deltaSeconds = 0.0; /**< 距上一次 cull 的仿真时间，已限幅。 */
+        double frameSeconds = 0.0; /**< 距上一次 cull 的真实时间，不受仿真时间倍率影响，用于性能自适应。 */
+    };
+
+    CameraAnchoredGroup();
+
+    /**
+     * @brief 地图是否为地心坐标系；投影地图直接以世界 Z 轴为“上”。
+     */
+    void setGeocentric(bool geocentric) { m_geocentric = geocentric; }
+    [[nodiscard]] bool isGeocentric() const noexcept { return m_geocentric; }
+
+    /**
+     * @brief 相机单帧位移超过该距离（米）时视为瞬移，不再累积位移。
+     */
+    void setTeleportDistance(double meters) { m_teleportDistance = meters; }
+
+    void traverse(osg::NodeVisitor& nv) override;
+
+protected:
+    ~CameraAnchoredGroup() override = default;
+
+    virtual void onAnchor(const AnchorState& state) = 0;
+
+private:
+    osg::ref_ptr<osg::EllipsoidModel> m_ellipsoid;
+    osg::Vec3d m_lastEye;
+    double m_lastTime = 0.0;
+    double m_lastReferenceTime = 0.0;
+    double m_teleportDistance = 1000.0;
+    bool m_hasLastEye = false;
+    bool m_geocentric = true;
+};
+
+/**
+ * @brief 将 value 折返到 [0, period)。
+ */
+double wrapPeriod(double value, double period);
+
+} // namespace earth::weather
@@ -0,0 +1,340 @@
+#include "weather/CloudLayer.h"
+
+#include "core/EnvironmentBootstrapper.h"
+#include "core/FrameMetrics.h"
+#include "weather/CameraAnchoredGroup.h"
+#include "weather/CloudNoise.h"
+
+#include <QDir>
+
+#include <osg/BlendFunc>
+#include <osg/CullFace>
+#include <osg/Depth>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Texture3D>
+#include <osg/Uniform>
+#include <osg/Vec2d>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kNoiseTextureUnit = 5;
+constexpr float kRangeMeters = 30000.0F;
+constexpr float kTileMeters = 8000.0F;
+constexpr float kVerticalTileMeters = 2000.0F;
+constexpr float kDefaultBaseMeters = 1500.0F;
+constexpr float kDefaultTopMeters = 3200.0F;
+constexpr double kDefaultFrameBudgetMs = 22.0;
+constexpr double kAdjustIntervalSeconds = 0.5;
+constexpr double kFrameSmoothing = 0.1;
+
+const char* const kVertexShader = R"(#version 120
+uniform vec3 earth_CloudExtent;
+varying vec3 v_local;
+
+void main()
+{
+    // 单位盒顶点：xy ∈ [-1,1] 展开到可视半径，z ∈ [0,1] 展开到相对相机的云底/云顶
+    vec3 p = vec3(gl_Vertex.xy * earth_CloudExtent.x, mix(earth_CloudExtent.y, earth_CloudExtent.z, gl_Vertex.z));
+    v_local = p;
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 1.0);
+}
+)";
+
+const char* const kFragmentShader = R"(#version 120
+uniform sampler3D earth_CloudNoise;
+uniform vec3 earth_CloudExtent;
+uniform vec3 earth_CloudOffset;
+uniform vec4 earth_CloudParams;
+uniform float earth_CloudImpostor;
+varying vec3 v_local;
+
+const int kMaxSteps = 64;
+const float kExtinction = 0.004;
+
+float heightFraction(float z)
+{
+    return clamp((z - earth_CloudExtent.y) / max(earth_CloudExtent.z - earth_CloudExtent.y, 1.0), 0.0, 1.0);
+}
+
+float cloudDensity(vec3 p)
+{
+    // 采样坐标 = 相对相机位置 + 世界稳定偏移（xy 已折返到一个平铺周期内，z 为相机高度）
+    vec3 uvw = vec3((p.xy + earth_CloudOffset.xy) / earth_CloudParams.z, (p.z + earth_CloudOffset.z) / earth_CloudParams.z * 4.0);
+    float noise = texture3D(earth_CloudNoise, uvw).r;
+    float h = heightFraction(p.z);
+    float profile = smoothstep(0.0, 0.15, h) * (1.0 - smoothstep(0.55, 1.0, h));
+    float coverage = earth_CloudParams.x;
+    return clamp((noise - (1.0 - coverage)) / max(coverage, 0.01), 0.0, 1.0) * profile * earth_CloudParams.y;
+}
+
+vec3 cloudColor(float z)
+{
+    return mix(vec3(0.58, 0.61, 0.66), vec3(1.0), heightFraction(z));
+}
+
+void main()
+{
+    vec3 dir = normalize(v_local);
+    float t0 = 0.0;
+    float t1 = length(v_local);
+    if (abs(dir.z) > 1e-4) {
+        float ta = earth_CloudExtent.y / dir.z;
+        float tb = earth_CloudExtent.z / dir.z;
+        t0 = max(t0, min(ta, tb));
+        t1 = min(t1, max(ta, tb));
+    } else if (earth_CloudExtent.y > 0.0 || earth_CloudExtent.z < 0.0) {
+        discard;
+    }
+    if (t1 <= t0) {
+        discard;
+    }
+
+    // 远处水平淡出，掩盖可视半径边界
+    float fade = 1.0 - smoothstep(0.6, 1.0, length(dir.xy * t0) / earth_CloudExtent.x);
+
+    if (earth_CloudImpostor > 0.5) {
+        float mid = 0.5 * (earth_CloudExtent.y + earth_CloudExtent.z);
+        float t = abs(dir.z) > 1e-4 ? clamp(mid / dir.z, t0, t1) : 0.5 * (t0 + t1);
+        vec3 p = dir * t;
+        float alpha = 1.0 - exp(-cloudDensity(p) * (t1 - t0) * kExtinction);
+        gl_FragColor = vec4(cloudColor(p.z), alpha * fade);
+        return;
+    }
+
+    int steps = int(earth_CloudParams.w);
+    float stepLength = (t1 - t0) / float(steps);
+    float t = t0 + 0.5 * stepLength;
+    float transmittance = 1.0;
+    vec3 light = vec3(0.0);
+    for (int i = 0; i < kMaxSteps; ++i) {
+        if (i >= steps || transmittance < 0.02) {
+            break;
+        }
+        vec3 p = dir * t;
+        float density = cloudDensity(p);
+        if (density > 0.0) {
+            float a = 1.0 - exp(-density * stepLength * kExtinction);
+            light += transmittance * a * cloudColor(p.z);
+            transmittance *= 1.0 - a;
+        }
+        t += stepLength;
+    }
+
+    float alpha = 1.0 - transmittance;
+    gl_FragColor = vec4(light / max(alpha, 1e-3), alpha * fade);
+}
+)";
+
+/**
+ * @brief 云层锚定节点：积分相机位移与风漂移得到世界稳定的噪声偏移，并按帧时间调整步进次数。
+ */
+class CloudNode final : public earth::weather::CameraAnchoredGroup {
+public:
+    CloudNode()
+        : m_extent(new osg::Uniform("earth_CloudExtent", osg::Vec3f()))
+        , m_offset(new osg::Uniform("earth_CloudOffset", osg::Vec3f()))
+        , m_params(new osg::Uniform("earth_CloudParams", osg::Vec4f())) {
+        setName("CloudLayer");
+        setTeleportDistance(kTileMeters);
+        osg::StateSet* stateSet = getOrCreateStateSet();
+        stateSet->addUniform(m_extent.get());
+        stateSet->addUniform(m_offset.get());
+        stateSet->addUniform(m_params.get());
+    }
+
+    void setAltitude(double base, double top) {
+        m_base = std::min(base, top);
+        m_top = std::max(base, top);
+    }
+    void setWind(const osg::Vec2d& wind) { m_wind = wind; }
+    void setFrameBudget(double milliseconds) { m_frameBudget = std::max(milliseconds, 1.0) / 1000.0; }
+    void setLook(float coverage, float density) {
+        m_coverage = coverage;
+        m_density = density;
+        applyParams();
+    }
+
+protected:
+    void onAnchor(const AnchorState& state) override {
+        // 相机前进时采样点随之前移，风则使云团顺风飘移；偏移折返到一个平铺周期内，避免 float 精度流失。
+        for (int axis = 0; axis < 2; ++axis) {
+            const double step = state.eyeDeltaLocal[axis] - m_wind[axis] * state.deltaSeconds;
+            m_offsetValue[axis] = earth::weather::wrapPeriod(m_offsetValue[axis] + step, kTileMeters);
+        }
+        m_offset->set(osg::Vec3f(static_cast<float>(m_offsetValue.x()), static_cast<float>(m_offsetValue.y()),
+                                 static_cast<float>(earth::weather::wrapPeriod(state.eyeAltitude, kVerticalTileMeters))));
+        m_extent->set(osg::Vec3f(kRangeMeters, static_cast<float>(m_base - state.eyeAltitude),
+                                 static_cast<float>(m_top - state.eyeAltitude)));
+        adaptSteps(state.frameSeconds);
+    }
+
+private:
+    void adaptSteps(double frameSeconds) {
+        if (frameSeconds <= 0.0) {
+            return;
+        }
+        m_frameAverage = m_frameAverage <= 0.0 ? frameSeconds
+                                               : m_frameAverage + (frameSeconds - m_frameAverage) * kFrameSmoothing;
+        m_sinceAdjust += frameSeconds;
+        if (m_sinceAdjust < kAdjustIntervalSeconds) {
+            return;
+        }
+        m_sinceAdjust = 0.0;
+
+        // 超预算时按比例快速回落，富余时小步恢复，避免在阈值附近来回抖动。
+        int steps = m_steps;
+        if (m_frameAverage > m_frameBudget * 1.1) {
+            steps = static_cast<int>(std::floor(steps * 0.75));
+        } else if (m_frameAverage < m_frameBudget * 0.8) {
+            steps += 4;
+        }
+        steps = std::clamp(steps, earth::weather::CloudLayer::kMinSteps, earth::weather::CloudLayer::kMaxSteps);
+        if (steps != m_steps) {
+            m_steps = steps;
+            applyParams();
+        }
+        earth::core::FrameMetrics::instance().recordValue("weather.cloudSteps", m_steps, "步");
+    }
+
+    void applyParams() {
+        m_params->set(osg::Vec4f(m_coverage, m_density, kTileMeters, static_cast<float>(m_steps)));
+    }
+
+    osg::ref_ptr<osg::Uniform> m_extent;
+    osg::ref_ptr<osg::Uniform> m_offset;
+    osg::ref_ptr<osg::Uniform> m_params;
+    osg::Vec2d m_wind;
+    osg::Vec2d m_offsetValue;
+    double m_base = kDefaultBaseMeters;
+    double m_top = kDefaultTopMeters;
+    double m_frameBudget = kDefaultFrameBudgetMs / 1000.0;
+    double m_frameAverage = 0.0;
+    double m_sinceAdjust = 0.0;
+    float m_coverage = 0.0F;
+    float m_density = 0.0F;
+    int m_steps = earth::weather::CloudLayer::kMaxSteps / 2;
+};
+
+osg::ref_ptr<osg::Geometry> buildSlabGeometry() {
+    // 单位盒：xy ∈ [-1,1]，z ∈ [0,1]；只绘制背面，相机位于盒内外都能得到一次覆盖整个云层的片元。
+    osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array();
+    for (int corner = 0; corner < 8; ++corner) {
+        vertices->push_back(osg::Vec3((corner & 1) != 0 ? 1.0F : -1.0F, (corner & 2) != 0 ? 1.0F : -1.0F,
+                                      (corner & 4) != 0 ? 1.0F : 0.0F));
+    }
+
+    const GLushort faces[] = {
+        0, 2, 3, 1, // 底
+        4, 5, 7, 6, // 顶
+        0, 1, 5, 4, // 南
+        2, 6, 7, 3, // 北
+        0, 4, 6, 2, // 西
+        1, 3, 7, 5, // 东
+    };
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geometry->setName("CloudSlab");
+    geometry->setUseDisplayList(false);
+    geometry->setUseVertexBufferObjects(true);
+    geometry->setVertexArray(vertices.get());
+    geometry->addPrimitiveSet(new osg::DrawElementsUShort(GL_QUADS, sizeof(faces) / sizeof(faces[0]), faces));
+    // 真实尺寸在着色器中展开，包围盒取可视半径，供近远平面计算。
+    geometry->setInitialBound(
+        osg::BoundingBox(-kRangeMeters, -kRangeMeters, -kRangeMeters, kRangeMeters, kRangeMeters, kRangeMeters));
+    return geometry;
+}
+
+CloudNode* cloudNode(const osg::ref_ptr<osg::Group>& root) {
+    return static_cast<CloudNode*>(root.get());
+}
+} // namespace
+
+namespace earth::weather {
+
+CloudLayer::CloudLayer()
+    : m_root(new CloudNode())
+    , m_impostorUniform(new osg::Uniform("earth_CloudImpostor", 0.0F)) {
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable(buildSlabGeometry().get());
+    m_root->addChild(geode.get());
+
+    const QString dataRoot = core::EnvironmentBootstrapper::instance().dataRoot();
+    const QString cacheDirectory = dataRoot.isEmpty() ? QString() : QDir(dataRoot).filePath(QStringLiteral("cache"));
+    osg::ref_ptr<osg::Texture3D> noise =
+        createCloudNoiseTexture(loadOrGenerateCloudNoise(cacheDirectory, kCloudNoiseSize), kCloudNoiseSize);
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->setName("CloudLayerProgram");
+    program->addShader(new osg::Shader(osg::Shader::VERTEX, kVertexShader));
+    program->addShader(new osg::Shader(osg::Shader::FRAGMENT, kFragmentShader));
+
+    osg::StateSet* stateSet = m_root->getOrCreateStateSet();
+    stateSet->setDataVariance(osg::Object::DYNAMIC);
+    stateSet->setAttributeAndModes(program.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+    stateSet->setTextureAttribute(kNoiseTextureUnit, noise.get(), osg::StateAttribute::ON);
+    stateSet->addUniform(new osg::Uniform("earth_CloudNoise", kNoiseTextureUnit));
+    stateSet->addUniform(m_impostorUniform.get());
+    stateSet->setAttributeAndModes(new osg::CullFace(osg::CullFace::FRONT), osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::Depth(osg::Depth::LESS, 0.0, 1.0, false), osg::StateAttribute::ON);
+    stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    stateSet->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+
+    m_root->setNodeMask(0U);
+    applyParams();
+}
+
+CloudLayer::~CloudLayer() = default;
+
+osg::Node* CloudLayer::node() const {
+    return m_root.get();
+}
+
+void CloudLayer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    m_root->setNodeMask(enabled ? ~0U : 0U);
+}
+
+void CloudLayer::setImpostor(bool impostor) {
+    m_impostor = impostor;
+    m_impostorUniform->set(impostor ? 1.0F : 0.0F);
+}
+
+void CloudLayer::setCoverage(float coverage) {
+    m_coverage = std::clamp(coverage, 0.0F, 1.0F);
+    applyParams();
+}
+
+void CloudLayer::setDensity(float density) {
+    m_density = std::clamp(density, 0.0F, 1.0F);
+    applyParams();
+}
+
+void CloudLayer::setAltitude(float baseMeters, float topMeters) {
+    cloudNode(m_root)->setAltitude(baseMeters, topMeters);
+}
+
+void CloudLayer::setWind(float eastMps, float northMps) {
+    cloudNode(m_root)->setWind(osg::Vec2d(eastMps, northMps));
+}
+
+void CloudLayer::setFrameBudget(double milliseconds) {
+    cloudNode(m_root)->setFrameBudget(milliseconds);
+}
+
+void CloudLayer::setGeocentric(bool geocentric) {
+    cloudNode(m_root)->setGeocentric(geocentric);
+}
+
+void CloudLayer::applyParams() {
+    cloudNode(m_root)->setLook(m_coverage, m_density);
+}
+
+} // namespace earth::weather
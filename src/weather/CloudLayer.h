@@ -0,0 +1,85 @@
+#pragma once
+
+#include <osg/ref_ptr>
+
+namespace osg {
+class Group;
+class Node;
+class Uniform;
+} // namespace osg
+
+namespace earth::weather {
+
+/**
+ * @brief 以相机为中心的体积云层。
+ *
+ * 启动时从数据根目录缓存加载（首次生成）可平铺的 Perlin-Worley 三维噪声纹理，片元着色器在云底与云顶之间光线步进；
+ * 步进次数依据真实帧时间自适应，另提供单次采样的低配（impostor）模式供性能较弱的席位使用。
+ * 开关只切换节点掩码，不会像 configureSky 那样重建 SkyNode。
+ */
+class CloudLayer {
+public:
+    static constexpr int kMinSteps = 8;
+    static constexpr int kMaxSteps = 64;
+
+    CloudLayer();
+    ~CloudLayer();
+
+    CloudLayer(const CloudLayer&) = delete;
+    CloudLayer& operator=(const CloudLayer&) = delete;
+
+    /**
+     * @brief 效果根节点，由 WeatherSystem 挂到环境根节点下。
+     */
+    [[nodiscard]] osg::Node* node() const;
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const noexcept { return m_enabled; }
+
+    /**
+     * @brief 低配模式：每个像素只在云层中间高度采样一次，不做光线步进。
+     */
+    void setImpostor(bool impostor);
+    [[nodiscard]] bool isImpostor() const noexcept { return m_impostor; }
+
+    /**
+     * @brief 云量 [0,1]，越大噪声阈值越低、云团越连片。
+     */
+    void setCoverage(float coverage);
+    [[nodiscard]] float coverage() const noexcept { return m_coverage; }
+
+    /**
+     * @brief 云体光学密度 [0,1]。
+     */
+    void setDensity(float density);
+    [[nodiscard]] float density() const noexcept { return m_density; }
+
+    /**
+     * @brief 云底/云顶高度（米，椭球高）。
+     */
+    void setAltitude(float baseMeters, float topMeters);
+
+    /**
+     * @brief 云层随风漂移速度（米/秒），东向/北向分量。
+     */
+    void setWind(float eastMps, float northMps);
+
+    /**
+     * @brief 自适应步进的目标帧时间（毫秒），帧时间超出时减少步进次数，富余时逐步恢复。
+     */
+    void setFrameBudget(double milliseconds);
+
+    void setGeocentric(bool geocentric);
+
+private:
+    void applyParams();
+
+    osg::ref_ptr<osg::Group> m_root;
+    osg::ref_ptr<osg::Uniform> m_impostorUniform;
+    float m_coverage = 0.45F;
+    float m_density = 0.6F;
+    bool m_enabled = false;
+    bool m_impostor = false;
+};
+
+} // namespace earth::weather
@@ -0,0 +1,278 @@
+#include "weather/CloudNoise.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+
+#include <osg/Image>
+#include <osg/Texture3D>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+
+namespace {
+constexpr char kCacheMagic[8] = {'E', 'A', 'R', 'T', 'H', 'C', 'N', 'Z'};
+// 噪声算法或参数调整时递增，旧缓存会被自动丢弃重建。
+constexpr std::uint32_t kCacheVersion = 1;
+constexpr std::uint32_t kNoiseSeed = 20240421U;
+
+struct CacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t size;
+};
+
+static_assert(sizeof(CacheHeader) == 16, "unexpected cloud noise cache header layout");
+
+/**
+ * @brief 以固定种子打乱的置换表，保证每台机器生成的噪声完全一致。
+ */
+class Permutation {
+public:
+    Permutation() {
+        std::iota(m_table.begin(), m_table.end(), 0);
+        std::mt19937 rng(kNoiseSeed);
+        std::shuffle(m_table.begin(), m_table.end(), rng);
+    }
+
+    [[nodiscard]] int hash(int x, int y, int z) const {
+        return m_table[(m_table[(m_table[x & 255] + y) & 255] + z) & 255];
+    }
+
+private:
+    std::array<int, 256> m_table {};
+};
+
+int wrapIndex(int value, int period) {
+    const int wrapped = value % period;
+    return wrapped < 0 ? wrapped + period : wrapped;
+}
+
+double fade(double t) {
+    return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+}
+
+double gradientDot(int hash, double x, double y, double z) {
+    // 经典 Perlin 的 12 个棱方向梯度。
+    switch (hash % 12) {
+    case 0: return x + y;
+    case 1: return -x + y;
+    case 2: return x - y;
+    case 3: return -x - y;
+    case 4: return x + z;
+    case 5: return -x + z;
+    case 6: return x - z;
+    case 7: return -x - z;
+    case 8: return y + z;
+    case 9: return -y + z;
+    case 10: return y - z;
+    default: return -y - z;
+    }
+}
+
+/**
+ * @brief 周期为 period 个晶格的 Perlin 噪声，输入为晶格坐标，输出约在 [-1,1]。
+ */
+double periodicPerlin(const Permutation& perm, double x, double y, double z, int period) {
+    const int x0 = static_cast<int>(std::floor(x));
+    const int y0 = static_cast<int>(std::floor(y));
+    const int z0 = static_cast<int>(std::floor(z));
+    const double fx = x - x0;
+    const double fy = y - y0;
+    const double fz = z - z0;
+
+    double corners[8];
+    for (int corner = 0; corner < 8; ++corner) {
+        const int dx = corner & 1;
+        const int dy = (corner >> 1) & 1;
+        const int dz = (corner >> 2) & 1;
+        const int h = perm.hash(wrapIndex(x0 + dx, period), wrapIndex(y0 + dy, period), wrapIndex(z0 + dz, period));
+        corners[corner] = gradientDot(h, fx - dx, fy - dy, fz - dz);
+    }
+
+    const double u = fade(fx);
+    const double v = fade(fy);
+    const double w = fade(fz);
+    const auto lerp = [](double a, double b, double t) { return a + (b - a) * t; };
+    const double x00 = lerp(corners[0], corners[1], u);
+    const double x10 = lerp(corners[2], corners[3], u);
+    const double x01 = lerp(corners[4], corners[5], u);
+    const double x11 = lerp(corners[6], corners[7], u);
+    return lerp(lerp(x00, x10, v), lerp(x01, x11, v), w);
+}
+
+/**
+ * @brief 周期为 cells 个单元的 Worley（F1）噪声，输入为单元坐标，输出为到最近特征点的距离（单元尺度）。
+ */
+double periodicWorley(const Permutation& perm, double x, double y, double z, int cells) {
+    const int cx = static_cast<int>(std::floor(x));
+    const int cy = static_cast<int>(std::floor(y));
+    const int cz = static_cast<int>(std::floor(z));
+    double nearest = 3.0;
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const int ix = wrapIndex(cx + dx, cells);
+                const int iy = wrapIndex(cy + dy, cells);
+                const int iz = wrapIndex(cz + dz, cells);
+                // 用三次不同偏移的哈希得到单元内特征点位置。
+                const double px = cx + dx + perm.hash(ix, iy, iz) / 255.0;
+                const double py = cy + dy + perm.hash(ix + 71, iy, iz) / 255.0;
+                const double pz = cz + dz + perm.hash(ix, iy + 113, iz) / 255.0;
+                const double ddx = px - x;
+                const double ddy = py - y;
+                const double ddz = pz - z;
+                nearest = std::min(nearest, ddx * ddx + ddy * ddy + ddz * ddz);
+            }
+        }
+    }
+    return std::sqrt(nearest);
+}
+
+bool readCache(const QString& filePath, int size, std::vector<std::uint8_t>& voxels) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const std::size_t voxelCount = static_cast<std::size_t>(size) * size * size;
+    CacheHeader header {};
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+        std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion ||
+        header.size != static_cast<std::uint32_t>(size)) {
+        return false;
+    }
+
+    voxels.resize(voxelCount);
+    if (file.read(reinterpret_cast<char*>(voxels.data()), static_cast<qint64>(voxelCount)) !=
+        static_cast<qint64>(voxelCount)) {
+        voxels.clear();
+        return false;
+    }
+    return true;
+}
+
+void writeCache(const QString& filePath, int size, const std::vector<std::uint8_t>& voxels) {
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[CloudNoise] 无法写入噪声缓存" << filePath << file.errorString();
+        return;
+    }
+
+    CacheHeader header {};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.size = static_cast<std::uint32_t>(size);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(voxels.data()), static_cast<qint64>(voxels.size()));
+    if (!file.commit()) {
+        qWarning() << "[CloudNoise] 噪声缓存提交失败" << filePath << file.errorString();
+    }
+}
+} // namespace
+
+namespace earth::weather {
+
+std::vector<std::uint8_t> generateCloudNoise(int size) {
+    size = std::max(size, 8);
+    const Permutation perm;
+    const std::array<int, 3> perlinPeriods {4, 8, 16};
+    const std::array<double, 3> perlinWeights {0.5714, 0.2857, 0.1429};
+    const std::array<int, 3> worleyCells {4, 8, 16};
+    const std::array<double, 3> worleyWeights {0.625, 0.25, 0.125};
+
+    std::vector<double> values(static_cast<std::size_t>(size) * size * size);
+    std::size_t index = 0;
+    for (int z = 0; z < size; ++z) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const double u = (x + 0.5) / size;
+                const double v = (y + 0.5) / size;
+                const double w = (z + 0.5) / size;
+
+                double perlin = 0.0;
+                for (std::size_t octave = 0; octave < perlinPeriods.size(); ++octave) {
+                    const int period = perlinPeriods[octave];
+                    perlin += perlinWeights[octave] * periodicPerlin(perm, u * period, v * period, w * period, period);
+                }
+                perlin = std::clamp(perlin * 0.5 + 0.5, 0.0, 1.0);
+
+                double worley = 0.0;
+                for (std::size_t octave = 0; octave < worleyCells.size(); ++octave) {
+                    const int cells = worleyCells[octave];
+                    const double distance = periodicWorley(perm, u * cells, v * cells, w * cells, cells);
+                    worley += worleyWeights[octave] * std::clamp(1.0 - distance, 0.0, 1.0);
+                }
+
+                // Perlin-Worley：以反相 Worley 作为 Perlin 的下限重映射，保留轮廓的同时得到团块状边缘。
+                const double lower = worley - 1.0;
+                values[index++] = std::clamp((perlin - lower) / (1.0 - lower), 0.0, 1.0);
+            }
+        }
+    }
+
+    // 拉伸到完整的 8 位范围，着色器中的覆盖率阈值才能在 [0,1] 上线性生效。
+    const auto [lowest, highest] = std::minmax_element(values.begin(), values.end());
+    const double minValue = *lowest;
+    const double range = std::max(*highest - minValue, 1e-6);
+    std::vector<std::uint8_t> voxels(values.size());
+    std::transform(values.begin(), values.end(), voxels.begin(), [minValue, range](double value) {
+        return static_cast<std::uint8_t>(std::lround((value - minValue) / range * 255.0));
+    });
+    return voxels;
+}
+
+std::vector<std::uint8_t> loadOrGenerateCloudNoise(const QString& cacheDirectory, int size) {
+    QString cacheFile;
+    if (!cacheDirectory.isEmpty() && QDir().mkpath(cacheDirectory)) {
+        cacheFile = QDir(cacheDirectory).filePath(QStringLiteral("cloud-noise-%1.bin").arg(size));
+    }
+
+    std::vector<std::uint8_t> voxels;
+    if (!cacheFile.isEmpty() && readCache(cacheFile, size, voxels)) {
+        return voxels;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    voxels = generateCloudNoise(size);
+    qDebug() << "[CloudNoise] 生成云层噪声" << size << "^3，耗时" << timer.elapsed() << "ms";
+
+    if (!cacheFile.isEmpty()) {
+        writeCache(cacheFile, size, voxels);
+    }
+    return voxels;
+}
+
+osg::ref_ptr<osg::Texture3D> createCloudNoiseTexture(const std::vector<std::uint8_t>& voxels, int size) {
+    const std::size_t voxelCount = static_cast<std::size_t>(size) * size * size;
+    if (size <= 0 || voxels.size() != voxelCount) {
+        return nullptr;
+    }
+
+    auto* data = new unsigned char[voxelCount];
+    std::memcpy(data, voxels.data(), voxelCount);
+
+    osg::ref_ptr<osg::Image> image = new osg::Image();
+    image->setImage(size, size, size, GL_LUMINANCE8, GL_LUMINANCE, GL_UNSIGNED_BYTE, data,
+                    osg::Image::USE_NEW_DELETE);
+
+    osg::ref_ptr<osg::Texture3D> texture = new osg::Texture3D(image.get());
+    texture->setName("CloudNoise");
+    texture->setWrap(osg::Texture::WRAP_S, osg::Texture::REPEAT);
+    texture->setWrap(osg::Texture::WRAP_T, osg::Texture::REPEAT);
+    texture->setWrap(osg::Texture::WRAP_R, osg::Texture::REPEAT);
+    texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+    texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+    texture->setResizeNonPowerOfTwoHint(false);
+    texture->setUnRefImageDataAfterApply(true);
+    return texture;
+}
+
+} // namespace earth::weather
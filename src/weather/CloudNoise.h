@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QString>
+
+#include <osg/ref_ptr>
+
+#include <cstdint>
+#include <vector>
+
+namespace osg {
+class Texture3D;
+}
+
+namespace earth::weather {
+
+/**
+ * @brief 云层噪声体默认边长（体素）。
+ */
+constexpr int kCloudNoiseSize = 64;
+
+/**
+ * @brief 生成可平铺的 Perlin-Worley 三维噪声，size³ 个 8 位体素，按 x 最快、z 最慢排列。
+ *
+ * 低频 Perlin 分形给出云团轮廓，Worley 分形给出蓬松的团块边缘；所有频率均以 size 为周期，纹理 REPEAT 采样无接缝。
+ */
+std::vector<std::uint8_t> generateCloudNoise(int size);
+
+/**
+ * @brief 从缓存目录读取噪声体，缺失或版本不符时重新生成并写回缓存。
+ * @param cacheDirectory 缓存目录，通常为 EnvironmentBootstrapper 数据根目录下的 cache；为空时不落盘。
+ */
+std::vector<std::uint8_t> loadOrGenerateCloudNoise(const QString& cacheDirectory, int size = kCloudNoiseSize);
+
+/**
+ * @brief 以单通道 8 位噪声体创建 REPEAT/线性过滤的三维纹理。
+ */
+osg::ref_ptr<osg::Texture3D> createCloudNoiseTexture(const std::vector<std::uint8_t>& voxels, int size);
+
+} // namespace earth::weather
@@ -0,0 +1,424 @@
+#include "weather/FireSmokeSystem.h"
+
+#include "core/FrameMetrics.h"
+#include "weather/CameraAnchoredGroup.h"
+
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Uniform>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+using earth::weather::FireHandle;
+using earth::weather::FireKind;
+using earth::weather::FireSmokeSystem;
+
+constexpr unsigned int kFlameParticles = 48;
+constexpr unsigned int kSmokeParticles = 32;
+constexpr float kEmitterScaleMeters = 4.0F;
+constexpr double kIgnitionSeconds = 3.0;
+constexpr double kDefaultImpostorMeters = 4000.0;
+constexpr double kDefaultCullMeters = 20000.0;
+// 远景替身只保留这一比例的粒子，并按面积守恒放大粒子尺寸。
+constexpr float kImpostorFraction = 0.2F;
+// 两种粒子寿命（1.2 s / 9 s）都能整除该周期，动画时间折返时不会跳变。
+constexpr double kTimeWrapSeconds = 3600.0;
+
+const char* const kCommonVertexSource = R"(
+uniform vec4 earth_FireCenter[kMaxEmitters];
+uniform vec4 earth_FireUp[kMaxEmitters];
+uniform vec4 earth_FireParams[kMaxEmitters];
+uniform float earth_FireTime;
+uniform vec3 earth_FireWind;
+varying vec2 v_corner;
+varying vec4 v_color;
+
+void emitterFrame(vec3 up, out vec3 side, out vec3 forward)
+{
+    vec3 reference = abs(up.z) < 0.9 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    side = normalize(cross(reference, up));
+    forward = cross(up, side);
+}
+
+void emitBillboard(vec3 center, float size, bool visible)
+{
+    // 在视空间展开四个角点，粒子始终正对相机
+    v_corner = gl_MultiTexCoord0.xy;
+    vec4 view = gl_ModelViewMatrix * vec4(center, 1.0);
+    view.xy += gl_MultiTexCoord0.xy * size;
+    gl_Position = visible ? gl_ProjectionMatrix * view : vec4(2.0, 2.0, 2.0, 1.0);
+}
+)";
+
+const char* const kFlameVertexMain = R"(
+void main()
+{
+    // gl_Vertex 为随机种子（w 为寿命相位）；纹理坐标 xy 为角点，z 为火源槽位，w 为粒子在池中的排序
+    int e = int(gl_MultiTexCoord0.z);
+    vec4 center = earth_FireCenter[e];
+    vec4 up = earth_FireUp[e];
+    vec4 params = earth_FireParams[e];
+    float intensity = params.x;
+    bool visible = center.w > 0.5 && intensity > 0.001 && gl_MultiTexCoord0.w < up.w;
+
+    vec4 seed = gl_Vertex;
+    float age = fract(earth_FireTime / 1.2 + seed.w);
+    vec3 side;
+    vec3 forward;
+    emitterFrame(up.xyz, side, forward);
+
+    float scale = params.z;
+    vec2 offset = (seed.xy * 2.0 - 1.0) * scale * (0.5 + 0.5 * intensity) * (1.0 - 0.7 * age);
+    float rise = scale * (0.6 + 1.6 * intensity) * age * (0.7 + 0.6 * seed.z);
+    float sway = sin(earth_FireTime * 6.0 + seed.w * 20.0) * 0.1 * scale * age;
+    vec3 p = center.xyz + side * (offset.x + sway) + forward * offset.y + up.xyz * rise;
+
+    float size = scale * (0.45 - 0.25 * age) * (0.6 + 0.4 * intensity) * params.w;
+    v_color = vec4(mix(vec3(1.0, 0.92, 0.55), vec3(0.9, 0.25, 0.05), age),
+                   (1.0 - age) * smoothstep(0.0, 0.1, age) * intensity);
+    emitBillboard(p, size, visible);
+}
+)";
+
+const char* const kSmokeVertexMain = R"(
+void main()
+{
+    int e = int(gl_MultiTexCoord0.z);
+    vec4 center = earth_FireCenter[e];
+    vec4 up = earth_FireUp[e];
+    vec4 params = earth_FireParams[e];
+    float intensity = params.y;
+    bool visible = center.w > 0.5 && intensity > 0.001 && gl_MultiTexCoord0.w < up.w;
+
+    vec4 seed = gl_Vertex;
+    float life = 9.0;
+    float age = fract(earth_FireTime / life + seed.w);
+    vec3 side;
+    vec3 forward;
+    emitterFrame(up.xyz, side, forward);
+
+    float scale = params.z;
+    vec2 offset = (seed.xy * 2.0 - 1.0) * scale * (0.4 + 2.5 * age);
+    float rise = scale * (1.0 + 10.0 * intensity) * age * (0.8 + 0.4 * seed.z);
+    vec3 p = center.xyz + side * offset.x + forward * offset.y + up.xyz * rise + earth_FireWind * (age * life);
+
+    float size = scale * (0.6 + 3.0 * age) * params.w;
+    float gray = mix(0.18, 0.55, age);
+    v_color = vec4(vec3(gray), smoothstep(0.0, 0.08, age) * (1.0 - age) * 0.55 * intensity);
+    emitBillboard(p, size, visible);
+}
+)";
+
+const char* const kFlameFragmentShader = R"(#version 120
+varying vec2 v_corner;
+varying vec4 v_color;
+
+void main()
+{
+    float alpha = v_color.a * (1.0 - smoothstep(0.15, 1.0, length(v_corner)));
+    if (alpha < 0.003) {
+        discard;
+    }
+    gl_FragColor = vec4(v_color.rgb * alpha, alpha);
+}
+)";
+
+const char* const kSmokeFragmentShader = R"(#version 120
+varying vec2 v_corner;
+varying vec4 v_color;
+
+void main()
+{
+    float alpha = v_color.a * (1.0 - smoothstep(0.3, 1.0, length(v_corner)));
+    if (alpha < 0.003) {
+        discard;
+    }
+    gl_FragColor = vec4(v_color.rgb, alpha);
+}
+)";
+
+std::string vertexSource(const char* mainSource) {
+    return std::string("#version 120\n#define kMaxEmitters ") + std::to_string(FireSmokeSystem::kMaxEmitters) + "\n" +
+           kCommonVertexSource + mainSource;
+}
+
+/**
+ * @brief 生成某种效果的完整粒子池：每个火源槽位 particlesPerEmitter 个四边形，全部槽位合并为一个几何体。
+ */
+osg::ref_ptr<osg::Geometry> buildParticlePool(const char* name, unsigned int particlesPerEmitter, std::uint32_t seedValue) {
+    std::mt19937 rng(seedValue);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+    const osg::Vec2 corners[4] = {{-1.0F, -1.0F}, {1.0F, -1.0F}, {1.0F, 1.0F}, {-1.0F, 1.0F}};
+
+    const std::size_t vertexCount = FireSmokeSystem::kMaxEmitters * particlesPerEmitter * 4U;
+    osg::ref_ptr<osg::Vec4Array> seeds = new osg::Vec4Array();
+    osg::ref_ptr<osg::Vec4Array> attributes = new osg::Vec4Array();
+    seeds->reserve(vertexCount);
+    attributes->reserve(vertexCount);
+    for (std::size_t emitter = 0; emitter < FireSmokeSystem::kMaxEmitters; ++emitter) {
+        for (unsigned int particle = 0; particle < particlesPerEmitter; ++particle) {
+            const osg::Vec4 seed(unit(rng), unit(rng), unit(rng), unit(rng));
+            // 排序值均匀分布，远景替身只需比较阈值即可保留前若干个粒子。
+            const float rank = (static_cast<float>(particle) + 0.5F) / static_cast<float>(particlesPerEmitter);
+            for (const osg::Vec2& corner : corners) {
+                seeds->push_back(seed);
+                attributes->push_back(osg::Vec4(corner.x(), corner.y(), static_cast<float>(emitter), rank));
+            }
+        }
+    }
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geometry->setName(name);
+    geometry->setUseDisplayList(false);
+    geometry->setUseVertexBufferObjects(true);
+    geometry->setVertexArray(seeds.get());
+    geometry->setTexCoordArray(0, attributes.get(), osg::Array::BIND_PER_VERTEX);
+    geometry->addPrimitiveSet(new osg::DrawArrays(GL_QUADS, 0, static_cast<GLsizei>(seeds->size())));
+    const auto range = static_cast<float>(kDefaultCullMeters);
+    geometry->setInitialBound(osg::BoundingBox(-range, -range, -range, range, range, range));
+    return geometry;
+}
+
+/**
+ * @brief 火源槽位表与锚定节点：每次 cull 把活动火源换算到相机局部坐标并写入 uniform 数组。
+ */
+class FireNode final : public earth::weather::CameraAnchoredGroup {
+public:
+    struct Slot {
+        osg::Vec3d world;
+        osg::Vec3d up;
+        double birthTime = -1.0;
+        float intensity = 0.0F;
+        std::uint32_t generation = 0;
+        FireKind kind = FireKind::Flame;
+        bool active = false;
+    };
+
+    FireNode()
+        : m_center(new osg::Uniform(osg::Uniform::FLOAT_VEC4, "earth_FireCenter", FireSmokeSystem::kMaxEmitters))
+        , m_up(new osg::Uniform(osg::Uniform::FLOAT_VEC4, "earth_FireUp", FireSmokeSystem::kMaxEmitters))
+        , m_params(new osg::Uniform(osg::Uniform::FLOAT_VEC4, "earth_FireParams", FireSmokeSystem::kMaxEmitters))
+        , m_time(new osg::Uniform("earth_FireTime", 0.0F))
+        , m_wind(new osg::Uniform("earth_FireWind", osg::Vec3f())) {
+        setName("FireSmokeSystem");
+        osg::StateSet* stateSet = getOrCreateStateSet();
+        for (osg::Uniform* uniform : {m_center.get(), m_up.get(), m_params.get(), m_time.get(), m_wind.get()}) {
+            stateSet->addUniform(uniform);
+        }
+
+        m_freeList.reserve(FireSmokeSystem::kMaxEmitters);
+        for (std::size_t i = FireSmokeSystem::kMaxEmitters; i > 0; --i) {
+            m_freeList.push_back(static_cast<std::uint16_t>(i - 1));
+        }
+        for (std::size_t i = 0; i < FireSmokeSystem::kMaxEmitters; ++i) {
+            m_center->setElement(static_cast<unsigned int>(i), osg::Vec4f());
+        }
+    }
+
+    FireHandle acquire(const osg::Vec3d& world, const osg::Vec3d& up, FireKind kind, float intensity) {
+        if (m_freeList.empty()) {
+            return {};
+        }
+        const std::uint16_t index = m_freeList.back();
+        m_freeList.pop_back();
+
+        Slot& slot = m_slots[index];
+        slot.world = world;
+        slot.up = up;
+        slot.up.normalize();
+        slot.kind = kind;
+        slot.intensity = std::clamp(intensity, 0.0F, 1.0F);
+        slot.birthTime = -1.0;
+        slot.active = true;
+        ++slot.generation;
+        return {index, slot.generation};
+    }
+
+    bool release(FireHandle handle) {
+        Slot* slot = resolve(handle);
+        if (slot == nullptr) {
+            return false;
+        }
+        slot->active = false;
+        ++slot->generation;
+        m_center->setElement(handle.index, osg::Vec4f());
+        m_freeList.push_back(handle.index);
+        return true;
+    }
+
+    Slot* resolve(FireHandle handle) {
+        if (!handle.isValid() || handle.index >= m_slots.size()) {
+            return nullptr;
+        }
+        Slot& slot = m_slots[handle.index];
+        return slot.active && slot.generation == handle.generation ? &slot : nullptr;
+    }
+
+    void releaseAll() {
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].active) {
+                release({static_cast<std::uint16_t>(i), m_slots[i].generation});
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t activeCount() const noexcept { return m_slots.size() - m_freeList.size(); }
+
+    void setWind(const osg::Vec3f& wind) { m_wind->set(wind); }
+
+    void setLodDistances(double impostor, double cull) {
+        m_cullDistance = std::max(cull, 1.0);
+        m_impostorDistance = std::clamp(impostor, 0.0, m_cullDistance);
+    }
+
+protected:
+    void onAnchor(const AnchorState& state) override {
+        m_time->set(static_cast<float>(earth::weather::wrapPeriod(state.simulationTime, kTimeWrapSeconds)));
+
+        std::size_t visible = 0;
+        for (std::size_t i = 0; i < m_slots.size(); ++i) {
+            Slot& slot = m_slots[i];
+            if (!slot.active) {
+                continue;
+            }
+            if (slot.birthTime < 0.0) {
+                slot.birthTime = state.simulationTime;
+            }
+
+            // 以双精度在世界坐标求差后再转入相机局部坐标，上传到 GPU 的 float 只保存相对位置，远离原点也不抖动。
+            const osg::Vec3d local = osg::Matrixd::transform3x3(state.localToWorld, slot.world - state.eyeWorld);
+            const osg::Vec3d up = osg::Matrixd::transform3x3(state.localToWorld, slot.up);
+            const double distance = local.length();
+            const bool inRange = distance < m_cullDistance;
+            const bool impostor = distance > m_impostorDistance;
+            const auto ignition = static_cast<float>(
+                std::clamp((state.simulationTime - slot.birthTime) / kIgnitionSeconds, 0.0, 1.0));
+            const float strength = slot.intensity * ignition;
+
+            const auto index = static_cast<unsigned int>(i);
+            m_center->setElement(index, osg::Vec4f(osg::Vec3f(local), inRange ? 1.0F : 0.0F));
+            m_up->setElement(index, osg::Vec4f(osg::Vec3f(up), impostor ? kImpostorFraction : 1.0F));
+            m_params->setElement(index, osg::Vec4f(slot.kind == FireKind::Flame ? strength : 0.0F,
+                                                   slot.kind == FireKind::Flame ? strength : 0.6F * strength,
+                                                   kEmitterScaleMeters,
+                                                   impostor ? 1.0F / std::sqrt(kImpostorFraction) : 1.0F));
+            visible += inRange ? 1U : 0U;
+        }
+
+        earth::core::FrameMetrics& metrics = earth::core::FrameMetrics::instance();
+        metrics.recordValue("fire.active", static_cast<double>(activeCount()), "个");
+        metrics.recordValue("fire.visible", static_cast<double>(visible), "个");
+    }
+
+private:
+    std::array<Slot, FireSmokeSystem::kMaxEmitters> m_slots {};
+    std::vector<std::uint16_t> m_freeList;
+    osg::ref_ptr<osg::Uniform> m_center;
+    osg::ref_ptr<osg::Uniform> m_up;
+    osg::ref_ptr<osg::Uniform> m_params;
+    osg::ref_ptr<osg::Uniform> m_time;
+    osg::ref_ptr<osg::Uniform> m_wind;
+    double m_impostorDistance = kDefaultImpostorMeters;
+    double m_cullDistance = kDefaultCullMeters;
+};
+
+osg::ref_ptr<osg::Geode> buildEffectGeode(const char* name, unsigned int particlesPerEmitter, std::uint32_t seed,
+                                          const char* vertexMain, const char* fragmentSource, bool additive,
+                                          int renderBin) {
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->setName(name);
+    geode->addDrawable(buildParticlePool(name, particlesPerEmitter, seed).get());
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->setName(std::string(name) + "Program");
+    program->addShader(new osg::Shader(osg::Shader::VERTEX, vertexSource(vertexMain)));
+    program->addShader(new osg::Shader(osg::Shader::FRAGMENT, fragmentSource));
+
+    osg::StateSet* stateSet = geode->getOrCreateStateSet();
+    stateSet->setAttributeAndModes(program.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+    stateSet->setAttributeAndModes(additive ? new osg::BlendFunc(GL_ONE, GL_ONE)
+                                            : new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA),
+                                   osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::Depth(osg::Depth::LESS, 0.0, 1.0, false), osg::StateAttribute::ON);
+    stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    stateSet->setMode(GL_CULL_FACE, osg::StateAttribute::OFF);
+    stateSet->setRenderBinDetails(renderBin, "DepthSortedBin");
+    return geode;
+}
+
+FireNode* fireNode(const osg::ref_ptr<osg::Group>& root) {
+    return static_cast<FireNode*>(root.get());
+}
+} // namespace
+
+namespace earth::weather {
+
+FireSmokeSystem::FireSmokeSystem()
+    : m_root(new FireNode()) {
+    // 烟雾先画、火焰后以加色混合叠加，两种效果各自只有一次绘制调用。
+    m_root->addChild(
+        buildEffectGeode("SmokeParticles", kSmokeParticles, 7U, kSmokeVertexMain, kSmokeFragmentShader, false, 10)
+            .get());
+    m_root->addChild(
+        buildEffectGeode("FlameParticles", kFlameParticles, 11U, kFlameVertexMain, kFlameFragmentShader, true, 11)
+            .get());
+    m_root->getOrCreateStateSet()->setDataVariance(osg::Object::DYNAMIC);
+}
+
+FireSmokeSystem::~FireSmokeSystem() = default;
+
+osg::Node* FireSmokeSystem::node() const {
+    return m_root.get();
+}
+
+FireHandle FireSmokeSystem::addFire(const osg::Vec3d& worldPosition, const osg::Vec3d& up, FireKind kind,
+                                    float intensity) {
+    return fireNode(m_root)->acquire(worldPosition, up, kind, intensity);
+}
+
+bool FireSmokeSystem::removeFire(FireHandle handle) {
+    return fireNode(m_root)->release(handle);
+}
+
+bool FireSmokeSystem::setIntensity(FireHandle handle, float intensity) {
+    FireNode::Slot* slot = fireNode(m_root)->resolve(handle);
+    if (slot == nullptr) {
+        return false;
+    }
+    slot->intensity = std::clamp(intensity, 0.0F, 1.0F);
+    return true;
+}
+
+void FireSmokeSystem::clear() {
+    fireNode(m_root)->releaseAll();
+}
+
+std::size_t FireSmokeSystem::activeCount() const noexcept {
+    return fireNode(m_root)->activeCount();
+}
+
+void FireSmokeSystem::setWind(float eastMps, float northMps) {
+    fireNode(m_root)->setWind(osg::Vec3f(eastMps, northMps, 0.0F));
+}
+
+void FireSmokeSystem::setLodDistances(double impostorMeters, double cullMeters) {
+    fireNode(m_root)->setLodDistances(impostorMeters, cullMeters);
+}
+
+void FireSmokeSystem::setGeocentric(bool geocentric) {
+    fireNode(m_root)->setGeocentric(geocentric);
+}
+
+} // namespace earth::weather
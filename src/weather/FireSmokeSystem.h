@@ -0,0 +1,94 @@
+#pragma once
+
+#include <osg/Vec3d>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osg {
+class Group;
+class Node;
+} // namespace osg
+
+namespace earth::weather {
+
+/**
+ * @brief 火源类型：明火（伴随烟柱）或仅烟雾（阴燃、熄灭后的余烟）。
+ */
+enum class FireKind {
+    Flame,
+    SmokeOnly
+};
+
+/**
+ * @brief 火源句柄：槽位下标 + 代数，槽位回收复用后旧句柄自动失效。
+ */
+struct FireHandle {
+    static constexpr std::uint16_t kInvalidIndex = 0xFFFFU;
+
+    std::uint16_t index = kInvalidIndex;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool isValid() const noexcept { return index != kInvalidIndex; }
+};
+
+/**
+ * @brief 池化的火焰/烟雾效果，供应急演练同时布置数十个火源。
+ *
+ * 粒子池在构造时按“最大火源数 × 每火源粒子数”一次性生成，火源只占用固定槽位，增删不分配任何对象；
+ * 每种效果（火焰、烟雾）全部火源合并为一次绘制，火源位置与参数通过 uniform 数组传入，粒子运动在顶点着色器中计算。
+ * 超过降级距离的火源只保留少量放大的粒子作为远景替身，超过剔除距离则完全不绘制。
+ */
+class FireSmokeSystem {
+public:
+    static constexpr std::size_t kMaxEmitters = 64;
+
+    FireSmokeSystem();
+    ~FireSmokeSystem();
+
+    FireSmokeSystem(const FireSmokeSystem&) = delete;
+    FireSmokeSystem& operator=(const FireSmokeSystem&) = delete;
+
+    /**
+     * @brief 效果根节点，由 WeatherSystem 挂到环境根节点下。
+     */
+    [[nodiscard]] osg::Node* node() const;
+
+    /**
+     * @brief 在世界坐标处布置火源；up 为该点的局部“向上”方向。槽位耗尽时返回无效句柄。
+     * @param intensity 火势 [0,1]，影响火焰高度与烟柱浓度。
+     */
+    FireHandle addFire(const osg::Vec3d& worldPosition, const osg::Vec3d& up, FireKind kind, float intensity);
+
+    /**
+     * @brief 熄灭火源并回收槽位；句柄已失效时返回 false。
+     */
+    bool removeFire(FireHandle handle);
+
+    bool setIntensity(FireHandle handle, float intensity);
+
+    /**
+     * @brief 熄灭全部火源。
+     */
+    void clear();
+
+    [[nodiscard]] std::size_t activeCount() const noexcept;
+
+    /**
+     * @brief 烟柱随风漂移（米/秒），东向/北向分量。
+     */
+    void setWind(float eastMps, float northMps);
+
+    /**
+     * @brief 远景替身距离与剔除距离（米）。
+     */
+    void setLodDistances(double impostorMeters, double cullMeters);
+
+    void setGeocentric(bool geocentric);
+
+private:
+    osg::ref_ptr<osg::Group> m_root;
+};
+
+} // namespace earth::weather
@@ -0,0 +1,242 @@
+#include "weather/PrecipitationEffect.h"
+
+#include "weather/CameraAnchoredGroup.h"
+
+#include <algorithm>
+#include <random>
+
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/LineWidth>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Uniform>
+
+namespace {
+constexpr float kRainFallMps = 9.0F;
+constexpr float kSnowFallMps = 1.2F;
+constexpr float kRainBoxMeters = 60.0F;
+constexpr float kSnowBoxMeters = 40.0F;
+
+const char* const kVertexShader = R"(#version 120
+uniform vec3 earth_PrecipShift;
+uniform vec3 earth_PrecipBox;
+uniform vec3 earth_PrecipVelocity;
+uniform float earth_PrecipStreakSeconds;
+uniform float earth_PrecipVisible;
+uniform float earth_PrecipTime;
+uniform float earth_PrecipSway;
+varying float v_alpha;
+
+void main()
+{
+    // gl_Vertex.xyz 为 [0,1) 位置种子，w 为可见阈值；纹理坐标 x 区分线段头(0)/尾(1)
+    vec4 seed = gl_Vertex;
+    float tail = gl_MultiTexCoord0.x;
+
+    vec3 p = mod(seed.xyz * earth_PrecipBox + earth_PrecipShift, earth_PrecipBox) - 0.5 * earth_PrecipBox;
+    float phase = seed.w * 6.2831853 + earth_PrecipTime;
+    p.xy += earth_PrecipSway * vec2(sin(phase), cos(phase * 0.7));
+    p -= earth_PrecipVelocity * (earth_PrecipStreakSeconds * tail);
+
+    vec3 n = abs(p) / (0.5 * earth_PrecipBox);
+    float edge = 1.0 - smoothstep(0.7, 1.0, max(max(n.x, n.y), n.z));
+    float visible = step(seed.w, earth_PrecipVisible);
+    v_alpha = edge * visible * (1.0 - 0.6 * tail);
+
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 1.0);
+    if (visible < 0.5) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    }
+}
+)";
+
+const char* const kFragmentShader = R"(#version 120
+uniform vec4 earth_PrecipColor;
+varying float v_alpha;
+
+void main()
+{
+    gl_FragColor = vec4(earth_PrecipColor.rgb, earth_PrecipColor.a * v_alpha);
+}
+)";
+
+/**
+ * @brief 降水锚定节点：在 cull 阶段积分风/下落位移与相机位移，使雨滴相对地面运动而不是粘在镜头上。
+ */
+class PrecipitationNode final : public earth::weather::CameraAnchoredGroup {
+public:
+    PrecipitationNode()
+        : m_shift(new osg::Uniform("earth_PrecipShift", osg::Vec3f()))
+        , m_time(new osg::Uniform("earth_PrecipTime", 0.0F)) {
+        setName("PrecipitationEffect");
+        setTeleportDistance(m_boxSize.length() * 10.0);
+        osg::StateSet* stateSet = getOrCreateStateSet();
+        stateSet->addUniform(m_shift.get());
+        stateSet->addUniform(m_time.get());
+    }
+
+    void setVelocity(const osg::Vec3d& velocity) { m_velocity = velocity; }
+    void setBox(const osg::Vec3d& box) {
+        m_boxSize = box;
+        setTeleportDistance(box.length() * 10.0);
+    }
+
+protected:
+    void onAnchor(const AnchorState& state) override {
+        const osg::Vec3d step = m_velocity * state.deltaSeconds - state.eyeDeltaLocal;
+        for (int axis = 0; axis < 3; ++axis) {
+            m_shiftValue[axis] = earth::weather::wrapPeriod(m_shiftValue[axis] + step[axis], m_boxSize[axis]);
+        }
+        m_shift->set(osg::Vec3f(m_shiftValue));
+        m_time->set(static_cast<float>(earth::weather::wrapPeriod(state.simulationTime, 1000.0)));
+    }
+
+private:
+    osg::ref_ptr<osg::Uniform> m_shift;
+    osg::ref_ptr<osg::Uniform> m_time;
+    osg::Vec3d m_velocity;
+    osg::Vec3d m_boxSize {kRainBoxMeters, kRainBoxMeters, kRainBoxMeters};
+    osg::Vec3d m_shiftValue;
+};
+
+osg::ref_ptr<osg::Geometry> buildParticleGeometry(unsigned int count) {
+    std::mt19937 rng(20240421U);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+    osg::ref_ptr<osg::Vec4Array> seeds = new osg::Vec4Array();
+    osg::ref_ptr<osg::FloatArray> tails = new osg::FloatArray();
+    seeds->reserve(count * 2U);
+    tails->reserve(count * 2U);
+    for (unsigned int i = 0; i < count; ++i) {
+        const osg::Vec4 seed(unit(rng), unit(rng), unit(rng), unit(rng));
+        seeds->push_back(seed);
+        seeds->push_back(seed);
+        tails->push_back(0.0F);
+        tails->push_back(1.0F);
+    }
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geometry->setName("PrecipitationParticles");
+    geometry->setUseDisplayList(false);
+    geometry->setUseVertexBufferObjects(true);
+    geometry->setVertexArray(seeds.get());
+    geometry->setTexCoordArray(0, tails.get(), osg::Array::BIND_PER_VERTEX);
+    geometry->addPrimitiveSet(new osg::DrawArrays(GL_LINES, 0, static_cast<GLsizei>(seeds->size())));
+    // 顶点只是种子，真实位置在着色器中展开到 ±box/2，这里给出对应包围盒以参与近远平面计算。
+    geometry->setInitialBound(osg::BoundingBox(-kRainBoxMeters, -kRainBoxMeters, -kRainBoxMeters, kRainBoxMeters,
+                                               kRainBoxMeters, kRainBoxMeters));
+    return geometry;
+}
+
+PrecipitationNode* precipitationNode(const osg::ref_ptr<osg::Group>& root) {
+    return static_cast<PrecipitationNode*>(root.get());
+}
+} // namespace
+
+namespace earth::weather {
+
+PrecipitationEffect::PrecipitationEffect(unsigned int maxParticles)
+    : m_root(new PrecipitationNode())
+    , m_velocity(new osg::Uniform("earth_PrecipVelocity", osg::Vec3f()))
+    , m_streakSeconds(new osg::Uniform("earth_PrecipStreakSeconds", 0.0F))
+    , m_sway(new osg::Uniform("earth_PrecipSway", 0.0F))
+    , m_visible(new osg::Uniform("earth_PrecipVisible", 0.0F))
+    , m_color(new osg::Uniform("earth_PrecipColor", osg::Vec4f()))
+    , m_box(new osg::Uniform("earth_PrecipBox", osg::Vec3f()))
+    , m_maxParticles(std::max(maxParticles, 1U)) {
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable(buildParticleGeometry(m_maxParticles).get());
+    m_root->addChild(geode.get());
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->setName("PrecipitationProgram");
+    program->addShader(new osg::Shader(osg::Shader::VERTEX, kVertexShader));
+    program->addShader(new osg::Shader(osg::Shader::FRAGMENT, kFragmentShader));
+
+    osg::StateSet* stateSet = m_root->getOrCreateStateSet();
+    stateSet->setDataVariance(osg::Object::DYNAMIC);
+    stateSet->setAttributeAndModes(program.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+    stateSet->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::Depth(osg::Depth::LESS, 0.0, 1.0, false), osg::StateAttribute::ON);
+    stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    stateSet->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+    for (osg::Uniform* uniform :
+         {m_velocity.get(), m_streakSeconds.get(), m_sway.get(), m_visible.get(), m_color.get(), m_box.get()}) {
+        stateSet->addUniform(uniform);
+    }
+
+    m_root->setNodeMask(0U);
+    applyTypeUniforms();
+    applyVisibility();
+}
+
+PrecipitationEffect::~PrecipitationEffect() = default;
+
+osg::Node* PrecipitationEffect::node() const {
+    return m_root.get();
+}
+
+void PrecipitationEffect::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    m_root->setNodeMask(enabled ? ~0U : 0U);
+}
+
+void PrecipitationEffect::setType(PrecipitationType type) {
+    if (m_type == type) {
+        return;
+    }
+    m_type = type;
+    applyTypeUniforms();
+    applyVisibility();
+}
+
+void PrecipitationEffect::setIntensity(float intensity) {
+    m_intensity = std::clamp(intensity, 0.0F, 1.0F);
+    applyVisibility();
+}
+
+void PrecipitationEffect::setDensity(float density) {
+    m_density = std::clamp(density, 0.0F, 1.0F);
+    applyVisibility();
+}
+
+void PrecipitationEffect::setWind(float eastMps, float northMps) {
+    m_windEast = eastMps;
+    m_windNorth = northMps;
+    applyTypeUniforms();
+}
+
+void PrecipitationEffect::setGeocentric(bool geocentric) {
+    precipitationNode(m_root)->setGeocentric(geocentric);
+}
+
+void PrecipitationEffect::applyTypeUniforms() {
+    const bool snow = m_type == PrecipitationType::Snow;
+    const float fall = snow ? kSnowFallMps : kRainFallMps;
+    const float box = snow ? kSnowBoxMeters : kRainBoxMeters;
+    const osg::Vec3f velocity(m_windEast, m_windNorth, -fall);
+
+    m_velocity->set(velocity);
+    m_box->set(osg::Vec3f(box, box, box));
+    m_streakSeconds->set(snow ? 0.02F : 0.06F);
+    m_sway->set(snow ? 0.6F : 0.0F);
+
+    PrecipitationNode* node = precipitationNode(m_root);
+    node->setVelocity(osg::Vec3d(velocity));
+    node->setBox(osg::Vec3d(box, box, box));
+    m_root->getOrCreateStateSet()->setAttributeAndModes(new osg::LineWidth(snow ? 2.5F : 1.0F), osg::StateAttribute::ON);
+}
+
+void PrecipitationEffect::applyVisibility() {
+    const bool snow = m_type == PrecipitationType::Snow;
+    m_visible->set(m_density * m_intensity);
+    const float alpha = 0.2F + 0.5F * m_intensity;
+    m_color->set(snow ? osg::Vec4f(0.95F, 0.95F, 1.0F, alpha) : osg::Vec4f(0.70F, 0.75F, 0.82F, alpha));
+}
+
+} // namespace earth::weather
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <osg/ref_ptr>
+
+namespace osg {
+class Group;
+class Node;
+class Uniform;
+} // namespace osg
+
+namespace earth::weather {
+
+/**
+ * @brief 降水类型。
+ */
+enum class PrecipitationType {
+    Rain,
+    Snow
+};
+
+/**
+ * @brief 以相机为中心的 GPU 降水效果。
+ *
+ * 粒子几何只在构造时生成一次（每个粒子一条线段，顶点只携带随机种子），
+ * 运动、风漂移、环绕相机的循环与边缘淡出全部在顶点着色器中完成；CPU 每帧只在 cull 阶段更新少量 uniform。
+ * 粒子体积固定跟随相机，开销与地图范围无关。
+ */
+class PrecipitationEffect {
+public:
+    static constexpr unsigned int kDefaultMaxParticles = 60000;
+
+    explicit PrecipitationEffect(unsigned int maxParticles = kDefaultMaxParticles);
+    ~PrecipitationEffect();
+
+    PrecipitationEffect(const PrecipitationEffect&) = delete;
+    PrecipitationEffect& operator=(const PrecipitationEffect&) = delete;
+
+    /**
+     * @brief 效果根节点，挂到 SimulationBootstrapper::environmentRoot() 下即可。
+     */
+    [[nodiscard]] osg::Node* node() const;
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const noexcept { return m_enabled; }
+
+    void setType(PrecipitationType type);
+    [[nodiscard]] PrecipitationType type() const noexcept { return m_type; }
+
+    /**
+     * @brief 降水强度 [0,1]，影响可见粒子比例与亮度。
+     */
+    void setIntensity(float intensity);
+    [[nodiscard]] float intensity() const noexcept { return m_intensity; }
+
+    /**
+     * @brief 粒子密度 [0,1]，即粒子池中参与绘制的最大比例。
+     */
+    void setDensity(float density);
+    [[nodiscard]] float density() const noexcept { return m_density; }
+
+    /**
+     * @brief 风漂移（米/秒），东向/北向分量。
+     */
+    void setWind(float eastMps, float northMps);
+
+    /**
+     * @brief 地图是否为地心坐标系；决定局部“向上”方向的计算方式。
+     */
+    void setGeocentric(bool geocentric);
+
+    [[nodiscard]] unsigned int maxParticles() const noexcept { return m_maxParticles; }
+
+private:
+    void applyTypeUniforms();
+    void applyVisibility();
+
+    osg::ref_ptr<osg::Group> m_root;
+    osg::ref_ptr<osg::Uniform> m_velocity;
+    osg::ref_ptr<osg::Uniform> m_streakSeconds;
+    osg::ref_ptr<osg::Uniform> m_sway;
+    osg::ref_ptr<osg::Uniform> m_visible;
+    osg::ref_ptr<osg::Uniform> m_color;
+    osg::ref_ptr<osg::Uniform> m_box;
+    unsigned int m_maxParticles = 0;
+    PrecipitationType m_type = PrecipitationType::Rain;
+    float m_intensity = 0.6F;
+    float m_density = 1.0F;
+    float m_windEast = 0.0F;
+    float m_windNorth = 0.0F;
+    bool m_enabled = false;
+};
+
+} // namespace earth::weather
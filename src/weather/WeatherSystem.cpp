@@ -0,0 +1,41 @@
+#include "weather/WeatherSystem.h"
+
+#include <osg/Group>
+
+namespace earth::weather {
+
+WeatherSystem::WeatherSystem()
+    : m_root(new osg::Group()) {
+    m_root->setName("WeatherRoot");
+    m_root->addChild(m_clouds.node());
+    m_root->addChild(m_fires.node());
+    m_root->addChild(m_precipitation.node());
+}
+
+WeatherSystem::~WeatherSystem() {
+    detach();
+}
+
+void WeatherSystem::attach(osg::Group* environmentRoot, bool geocentric) {
+    m_precipitation.setGeocentric(geocentric);
+    m_clouds.setGeocentric(geocentric);
+    m_fires.setGeocentric(geocentric);
+    if (m_environmentRoot.get() == environmentRoot) {
+        return;
+    }
+    detach();
+    m_environmentRoot = environmentRoot;
+    if (environmentRoot != nullptr && !environmentRoot->containsNode(m_root.get())) {
+        environmentRoot->addChild(m_root.get());
+    }
+}
+
+void WeatherSystem::detach() {
+    osg::ref_ptr<osg::Group> environmentRoot;
+    if (m_environmentRoot.lock(environmentRoot)) {
+        environmentRoot->removeChild(m_root.get());
+    }
+    m_environmentRoot = nullptr;
+}
+
+} // namespace earth::weather
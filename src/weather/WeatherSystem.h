@@ -0,0 +1,47 @@
+#pragma once
+
+#include "weather/CloudLayer.h"
+#include "weather/FireSmokeSystem.h"
+#include "weather/PrecipitationEffect.h"
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+namespace osg {
+class Group;
+}
+
+namespace earth::weather {
+
+/**
+ * @brief 天气效果的统一入口：持有各效果节点，并挂接到 SimulationBootstrapper 的环境根节点。
+ *
+ * 环境根节点在加载外部 .earth 时保持不变，因此切换场景无需重建天气效果。
+ */
+class WeatherSystem {
+public:
+    WeatherSystem();
+    ~WeatherSystem();
+
+    WeatherSystem(const WeatherSystem&) = delete;
+    WeatherSystem& operator=(const WeatherSystem&) = delete;
+
+    /**
+     * @brief 挂接到环境根节点；geocentric 表示当前地图是否为地心坐标系。
+     */
+    void attach(osg::Group* environmentRoot, bool geocentric);
+    void detach();
+
+    [[nodiscard]] PrecipitationEffect& precipitation() noexcept { return m_precipitation; }
+    [[nodiscard]] CloudLayer& clouds() noexcept { return m_clouds; }
+    [[nodiscard]] FireSmokeSystem& fires() noexcept { return m_fires; }
+
+private:
+    osg::ref_ptr<osg::Group> m_root;
+    osg::observer_ptr<osg::Group> m_environmentRoot;
+    PrecipitationEffect m_precipitation;
+    CloudLayer m_clouds;
+    FireSmokeSystem m_fires;
+};
+
+} // namespace earth::weather
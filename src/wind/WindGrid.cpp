@@ -0,0 +1,331 @@
+#include "wind/WindGrid.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EARTH_WIND_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+constexpr int kMaxResampledLevels = 32;
+constexpr double kStandardPressureHpa = 1013.25;
+
+float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+/**
+ * @brief 将连续网格坐标拆成下标与小数部分，保证 index+1 仍在网格内。
+ */
+void splitCoordinate(float f, int size, int& index, float& fraction) {
+    if (size < 2) {
+        index = 0;
+        fraction = 0.0F;
+        return;
+    }
+    index = std::clamp(static_cast<int>(std::floor(f)), 0, size - 2);
+    fraction = std::clamp(f - static_cast<float>(index), 0.0F, 1.0F);
+}
+} // namespace
+
+namespace earth::wind {
+
+double pressureToAltitude(double hectopascal) {
+    return 44330.77 * (1.0 - std::pow(std::max(hectopascal, 1.0) / kStandardPressureHpa, 0.190263));
+}
+
+RunwayWind runwayComponents(const WindSample& wind, double runwayHeadingDeg) {
+    const double heading = runwayHeadingDeg * 3.14159265358979323846 / 180.0;
+    const double alongEast = std::sin(heading);
+    const double alongNorth = std::cos(heading);
+
+    // 风矢量表示空气运动方向：与跑道方向相反即为顶风；跑道右侧法向 (cos h, -sin h) 上的分量即自左向右的侧风。
+    RunwayWind result;
+    result.headwind = static_cast<float>(-(wind.u * alongEast + wind.v * alongNorth));
+    result.crosswind = static_cast<float>(wind.u * alongNorth - wind.v * alongEast);
+    return result;
+}
+
+std::uint16_t toHalfFloat(float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign = static_cast<std::uint16_t>((bits >> 16U) & 0x8000U);
+    const std::uint32_t rawExponent = (bits >> 23U) & 0xFFU;
+    std::uint32_t mantissa = bits & 0x7FFFFFU;
+
+    if (rawExponent == 0xFFU) {
+        return static_cast<std::uint16_t>(sign | 0x7C00U | (mantissa != 0U ? 0x200U : 0U));
+    }
+
+    const int exponent = static_cast<int>(rawExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<std::uint16_t>(sign | 0x7C00U);
+    }
+    if (exponent <= 0) {
+        // 结果为 half 的非规格化数或零。
+        if (exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000U;
+        const auto shift = static_cast<std::uint32_t>(14 - exponent);
+        std::uint32_t half = mantissa >> shift;
+        if (((mantissa >> (shift - 1U)) & 1U) != 0U) {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    std::uint32_t half = (static_cast<std::uint32_t>(exponent) << 10U) | (mantissa >> 13U);
+    if ((mantissa & 0x1000U) != 0U) {
+        ++half; // 进位溢出到指数位时恰好得到正确的下一个可表示值。
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+bool WindGrid::load(const QString& descriptorPath) {
+    QFile descriptorFile(descriptorPath);
+    if (!descriptorFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "[WindGrid] 无法打开风场描述文件" << descriptorPath << descriptorFile.errorString();
+        return false;
+    }
+
+    QJsonParseError parseError {};
+    const QJsonDocument document = QJsonDocument::fromJson(descriptorFile.readAll(), &parseError);
+    if (!document.isObject()) {
+        qWarning() << "[WindGrid] 风场描述文件解析失败" << descriptorPath << parseError.errorString();
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    const int nx = root.value(QStringLiteral("nx")).toInt();
+    const int ny = root.value(QStringLiteral("ny")).toInt();
+    const int components = root.value(QStringLiteral("components")).toInt(3);
+    const double lonStep = root.value(QStringLiteral("lonStep")).toDouble();
+    const double latStep = root.value(QStringLiteral("latStep")).toDouble();
+    const QJsonArray levelArray = root.value(QStringLiteral("levels")).toArray();
+    const QJsonArray timeArray = root.value(QStringLiteral("times")).toArray();
+    if (nx < 2 || ny < 2 || (components != 2 && components != 3) || lonStep <= 0.0 || latStep <= 0.0 ||
+        levelArray.isEmpty() || timeArray.isEmpty()) {
+        qWarning() << "[WindGrid] 风场描述文件字段不完整" << descriptorPath;
+        return false;
+    }
+
+    std::vector<double> times;
+    times.reserve(static_cast<std::size_t>(timeArray.size()));
+    for (const QJsonValue& value : timeArray) {
+        const QDateTime time = QDateTime::fromString(value.toString(), Qt::ISODate);
+        if (!time.isValid() || (!times.empty() && time.toMSecsSinceEpoch() / 1000.0 <= times.back())) {
+            qWarning() << "[WindGrid] 时次无效或未按时间递增" << value.toString();
+            return false;
+        }
+        times.push_back(static_cast<double>(time.toMSecsSinceEpoch()) / 1000.0);
+    }
+
+    const auto levelCount = static_cast<std::size_t>(levelArray.size());
+    std::vector<double> levelAltitudes(levelCount);
+    for (std::size_t l = 0; l < levelCount; ++l) {
+        levelAltitudes[l] = pressureToAltitude(levelArray.at(static_cast<int>(l)).toDouble());
+    }
+
+    const QString dataPath =
+        QFileInfo(descriptorPath).dir().filePath(root.value(QStringLiteral("data")).toString());
+    QFile dataFile(dataPath);
+    if (!dataFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "[WindGrid] 无法打开风场数据文件" << dataPath << dataFile.errorString();
+        return false;
+    }
+
+    const std::size_t plane = static_cast<std::size_t>(nx) * static_cast<std::size_t>(ny);
+    const std::size_t levelStride = plane * static_cast<std::size_t>(components);
+    const std::size_t stepStride = levelStride * levelCount;
+    std::vector<float> raw(stepStride * times.size());
+    const auto expectedBytes = static_cast<qint64>(raw.size() * sizeof(float));
+    if (dataFile.read(reinterpret_cast<char*>(raw.data()), expectedBytes) != expectedBytes) {
+        qWarning() << "[WindGrid] 风场数据长度不足" << dataPath << "期望字节" << expectedBytes;
+        return false;
+    }
+
+    // 按高度升序排列气压层，再重采样到等间距高度层，GPU 纹理的 r 坐标因此与高度成线性关系。
+    std::vector<std::size_t> order(levelCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&levelAltitudes](std::size_t a, std::size_t b) { return levelAltitudes[a] < levelAltitudes[b]; });
+
+    const int nz = levelCount < 2 ? 1 : std::min(static_cast<int>(levelCount) * 2, kMaxResampledLevels);
+    const double altMin = levelAltitudes[order.front()];
+    const double altMax = levelAltitudes[order.back()];
+    const double altStep = nz > 1 ? (altMax - altMin) / (nz - 1) : 1.0;
+
+    std::vector<std::vector<float>> steps(times.size(), std::vector<float>(plane * static_cast<std::size_t>(nz) * 4U));
+    for (std::size_t t = 0; t < times.size(); ++t) {
+        const float* source = raw.data() + t * stepStride;
+        std::vector<float>& target = steps[t];
+        for (int k = 0; k < nz; ++k) {
+            const double altitude = altMin + altStep * k;
+            std::size_t upper = 1;
+            while (upper + 1 < levelCount && levelAltitudes[order[upper]] < altitude) {
+                ++upper;
+            }
+            const std::size_t lower = levelCount < 2 ? 0 : upper - 1;
+            upper = std::min(upper, levelCount - 1);
+            const double span = levelAltitudes[order[upper]] - levelAltitudes[order[lower]];
+            const auto weight = span > 0.0
+                                    ? static_cast<float>(std::clamp((altitude - levelAltitudes[order[lower]]) / span, 0.0, 1.0))
+                                    : 0.0F;
+
+            const float* lowerLevel = source + order[lower] * levelStride;
+            const float* upperLevel = source + order[upper] * levelStride;
+            float* out = target.data() + static_cast<std::size_t>(k) * plane * 4U;
+            for (std::size_t p = 0; p < plane; ++p) {
+                for (int c = 0; c < 3; ++c) {
+                    const float a = c < components ? lowerLevel[static_cast<std::size_t>(c) * plane + p] : 0.0F;
+                    const float b = c < components ? upperLevel[static_cast<std::size_t>(c) * plane + p] : 0.0F;
+                    out[p * 4U + static_cast<std::size_t>(c)] = lerp(a, b, weight);
+                }
+                out[p * 4U + 3U] = 0.0F;
+            }
+        }
+    }
+
+    m_steps = std::move(steps);
+    m_times = std::move(times);
+    m_lonMin = root.value(QStringLiteral("lonMin")).toDouble();
+    m_latMin = root.value(QStringLiteral("latMin")).toDouble();
+    m_lonStep = lonStep;
+    m_latStep = latStep;
+    m_altMin = altMin;
+    m_altStep = altStep;
+    m_nx = nx;
+    m_ny = ny;
+    m_nz = nz;
+    return true;
+}
+
+bool WindGrid::sample(double lonDeg, double latDeg, double altitudeMeters, double epochSeconds,
+                      WindSample& out) const {
+    if (!isValid()) {
+        return false;
+    }
+
+    const double fx = (lonDeg - m_lonMin) / m_lonStep;
+    const double fy = (latDeg - m_latMin) / m_latStep;
+    if (fx < 0.0 || fy < 0.0 || fx > m_nx - 1 || fy > m_ny - 1) {
+        return false;
+    }
+    const double fz = std::clamp((altitudeMeters - m_altMin) / m_altStep, 0.0, static_cast<double>(m_nz - 1));
+
+    std::size_t step0 = 0;
+    std::size_t step1 = 0;
+    float blend = 0.0F;
+    locateTime(epochSeconds, step0, step1, blend);
+
+    float a[4];
+    sampleStep(step0, static_cast<float>(fx), static_cast<float>(fy), static_cast<float>(fz), a);
+    if (step1 != step0 && blend > 0.0F) {
+        float b[4];
+        sampleStep(step1, static_cast<float>(fx), static_cast<float>(fy), static_cast<float>(fz), b);
+        for (int c = 0; c < 3; ++c) {
+            a[c] = lerp(a[c], b[c], blend);
+        }
+    }
+
+    out.u = a[0];
+    out.v = a[1];
+    out.w = a[2];
+    return true;
+}
+
+void WindGrid::locateTime(double epochSeconds, std::size_t& step0, std::size_t& step1, float& blend) const {
+    step0 = 0;
+    step1 = 0;
+    blend = 0.0F;
+    if (m_times.size() < 2) {
+        return;
+    }
+
+    const auto upper = std::upper_bound(m_times.begin(), m_times.end(), epochSeconds);
+    if (upper == m_times.begin()) {
+        return;
+    }
+    if (upper == m_times.end()) {
+        step0 = step1 = m_times.size() - 1;
+        return;
+    }
+
+    step1 = static_cast<std::size_t>(upper - m_times.begin());
+    step0 = step1 - 1;
+    blend = static_cast<float>((epochSeconds - m_times[step0]) / (m_times[step1] - m_times[step0]));
+}
+
+std::vector<std::uint16_t> WindGrid::halfFloatVolume(std::size_t step) const {
+    std::vector<std::uint16_t> volume;
+    if (step >= m_steps.size()) {
+        return volume;
+    }
+
+    const std::vector<float>& source = m_steps[step];
+    const std::size_t voxels = source.size() / 4U;
+    volume.resize(voxels * 3U);
+    for (std::size_t i = 0; i < voxels; ++i) {
+        volume[i * 3U] = toHalfFloat(source[i * 4U]);
+        volume[i * 3U + 1U] = toHalfFloat(source[i * 4U + 1U]);
+        volume[i * 3U + 2U] = toHalfFloat(source[i * 4U + 2U]);
+    }
+    return volume;
+}
+
+void WindGrid::sampleStep(std::size_t step, float fx, float fy, float fz, float out[4]) const {
+    int i0 = 0;
+    int j0 = 0;
+    int k0 = 0;
+    float tx = 0.0F;
+    float ty = 0.0F;
+    float tz = 0.0F;
+    splitCoordinate(fx, m_nx, i0, tx);
+    splitCoordinate(fy, m_ny, j0, ty);
+    splitCoordinate(fz, m_nz, k0, tz);
+    const int k1 = std::min(k0 + 1, m_nz - 1);
+
+    const float* base = m_steps[step].data();
+    const auto corner = [this, base](int i, int j, int k) {
+        return base + ((static_cast<std::size_t>(k) * m_ny + static_cast<std::size_t>(j)) * m_nx +
+                       static_cast<std::size_t>(i)) * 4U;
+    };
+
+#ifdef EARTH_WIND_SSE
+    // 每个角点的 (u,v,w,0) 恰好是一个 128 位向量，三个分量一起完成 7 次线性插值。
+    const auto lerp4 = [](__m128 a, __m128 b, __m128 t) { return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)); };
+    const __m128 wx = _mm_set1_ps(tx);
+    const __m128 wy = _mm_set1_ps(ty);
+    const __m128 wz = _mm_set1_ps(tz);
+    const __m128 c00 = lerp4(_mm_loadu_ps(corner(i0, j0, k0)), _mm_loadu_ps(corner(i0 + 1, j0, k0)), wx);
+    const __m128 c10 = lerp4(_mm_loadu_ps(corner(i0, j0 + 1, k0)), _mm_loadu_ps(corner(i0 + 1, j0 + 1, k0)), wx);
+    const __m128 c01 = lerp4(_mm_loadu_ps(corner(i0, j0, k1)), _mm_loadu_ps(corner(i0 + 1, j0, k1)), wx);
+    const __m128 c11 = lerp4(_mm_loadu_ps(corner(i0, j0 + 1, k1)), _mm_loadu_ps(corner(i0 + 1, j0 + 1, k1)), wx);
+    _mm_storeu_ps(out, lerp4(lerp4(c00, c10, wy), lerp4(c01, c11, wy), wz));
+#else
+    for (int c = 0; c < 4; ++c) {
+        const float c00 = lerp(corner(i0, j0, k0)[c], corner(i0 + 1, j0, k0)[c], tx);
+        const float c10 = lerp(corner(i0, j0 + 1, k0)[c], corner(i0 + 1, j0 + 1, k0)[c], tx);
+        const float c01 = lerp(corner(i0, j0, k1)[c], corner(i0 + 1, j0, k1)[c], tx);
+        const float c11 = lerp(corner(i0, j0 + 1, k1)[c], corner(i0 + 1, j0 + 1, k1)[c], tx);
+        out[c] = lerp(lerp(c00, c10, ty), lerp(c01, c11, ty), tz);
+    }
+#endif
+}
+
+} // namespace earth::wind
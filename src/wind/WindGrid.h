@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace earth::wind {
+
+/**
+ * @brief 单点风矢量（米/秒）：u 东向、v 北向、w 垂直向上。
+ */
+struct WindSample {
+    float u = 0.0F;
+    float v = 0.0F;
+    float w = 0.0F;
+};
+
+/**
+ * @brief 风矢量相对跑道的分解结果（米/秒）。
+ */
+struct RunwayWind {
+    float headwind = 0.0F;  /**< 顶风为正，顺风为负。 */
+    float crosswind = 0.0F; /**< 自左向右吹为正。 */
+};
+
+/**
+ * @brief 规则经纬网格上的多时次风场数据。
+ *
+ * 数据由一个 JSON 描述文件与一个 float32 小端二进制文件组成：
+ * @code
+ * {
+ *   "lonMin": 119.0, "latMin": 25.8, "lonStep": 0.05, "latStep": 0.05,
+ *   "nx": 64, "ny": 64, "components": 3,
+ *   "levels": [1000, 925, 850, 700, 500],
+ *   "times": ["2026-10-18T00:00:00Z", "2026-10-18T03:00:00Z"],
+ *   "data": "wind.bin"
+ * }
+ * @endcode
+ * 二进制按 [时次][气压层][分量 u,v(,w)][纬向 ny][经向 nx] 排列。
+ * 气压层按标准大气换算为高度后重采样为等间距高度层，CPU 采样与 GPU 纹理使用同一份网格；
+ * 每个网格点以 (u,v,w,0) 四个 float 交错存放，便于 SIMD 一次读入一个角点。
+ */
+class WindGrid {
+public:
+    WindGrid() = default;
+
+    /**
+     * @brief 读取描述文件及其引用的二进制数据，失败时保持原有数据不变。
+     */
+    bool load(const QString& descriptorPath);
+
+    [[nodiscard]] bool isValid() const noexcept { return !m_steps.empty(); }
+
+    /**
+     * @brief 三线性插值采样指定时刻的风矢量，时刻位于两个时次之间时线性混合。
+     * @return 经纬度落在网格范围外时返回 false；高度与时间超出范围时取边界值。
+     */
+    bool sample(double lonDeg, double latDeg, double altitudeMeters, double epochSeconds, WindSample& out) const;
+
+    /**
+     * @brief 将指定时次转换为 RGB half-float 体数据（x 最快、z 最慢），用于上传 GPU 三维纹理。
+     */
+    [[nodiscard]] std::vector<std::uint16_t> halfFloatVolume(std::size_t step) const;
+
+    /**
+     * @brief 将时刻定位到相邻两个时次及混合系数。
+     */
+    void locateTime(double epochSeconds, std::size_t& step0, std::size_t& step1, float& blend) const;
+
+    [[nodiscard]] int sizeX() const noexcept { return m_nx; }
+    [[nodiscard]] int sizeY() const noexcept { return m_ny; }
+    [[nodiscard]] int sizeZ() const noexcept { return m_nz; }
+    [[nodiscard]] double lonMin() const noexcept { return m_lonMin; }
+    [[nodiscard]] double latMin() const noexcept { return m_latMin; }
+    [[nodiscard]] double lonMax() const noexcept { return m_lonMin + m_lonStep * (m_nx - 1); }
+    [[nodiscard]] double latMax() const noexcept { return m_latMin + m_latStep * (m_ny - 1); }
+    [[nodiscard]] double altitudeMin() const noexcept { return m_altMin; }
+    [[nodiscard]] double altitudeMax() const noexcept { return m_altMin + m_altStep * (m_nz - 1); }
+    [[nodiscard]] const std::vector<double>& times() const noexcept { return m_times; }
+
+private:
+    void sampleStep(std::size_t step, float fx, float fy, float fz, float out[4]) const;
+
+    std::vector<std::vector<float>> m_steps;
+    std::vector<double> m_times;
+    double m_lonMin = 0.0;
+    double m_latMin = 0.0;
+    double m_lonStep = 1.0;
+    double m_latStep = 1.0;
+    double m_altMin = 0.0;
+    double m_altStep = 1.0;
+    int m_nx = 0;
+    int m_ny = 0;
+    int m_nz = 0;
+};
+
+/**
+ * @brief 按国际标准大气将气压（百帕）换算为位势高度（米）。
+ */
+double pressureToAltitude(double hectopascal);
+
+/**
+ * @brief 按跑道真航向（度）分解风矢量的顶风与侧风分量。
+ */
+RunwayWind runwayComponents(const WindSample& wind, double runwayHeadingDeg);
+
+/**
+ * @brief float32 → IEEE 754 half（就近舍入，超范围饱和为无穷）。
+ */
+std::uint16_t toHalfFloat(float value);
+
+} // namespace earth::wind
@@ -0,0 +1,353 @@
+#include "wind/WindLayer.h"
+
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/LineWidth>
+#include <osg/Math>
+#include <osg/MatrixTransform>
+#include <osg/NodeCallback>
+#include <osg/NodeVisitor>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/StateSet>
+#include <osg/Texture3D>
+#include <osg/Uniform>
+
+#include <osgEarth/GeoData>
+#include <osgEarth/MapNode>
+#include <osgEarth/SpatialReference>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_RGB16F_ARB
+#define GL_RGB16F_ARB 0x881B
+#endif
+
+namespace {
+constexpr int kTrailSegments = 6;
+constexpr float kLifetimeSeconds = 12.0F;
+constexpr float kTrailSeconds = 0.35F;
+// 动画时间按寿命的整数倍折返，fract() 不会因折返产生跳变，同时避免 float 精度随运行时长下降。
+constexpr double kTimeWrapSeconds = 3600.0;
+constexpr double kReferenceSpeedMps = 15.0;
+constexpr double kMetersPerDegree = 6371000.0 * osg::PI / 180.0;
+
+const char* const kVertexShader = R"(#version 120
+uniform sampler3D earth_WindField0;
+uniform sampler3D earth_WindField1;
+uniform float earth_WindBlend;
+uniform vec4 earth_WindDomain;     // 半宽、半高（米），最低、最高高度（米）
+uniform vec3 earth_WindTexScale;
+uniform vec3 earth_WindTexOffset;
+uniform float earth_WindTime;
+uniform float earth_WindLifetime;
+uniform float earth_WindTrailSeconds;
+uniform float earth_WindTrailCount;
+uniform float earth_WindSpeedScale; // 显示时间倍率：区域尺度下真实风速的位移过小，放大后才能看出流动
+varying vec4 v_color;
+
+const int kSteps = 6;
+
+vec3 windAt(vec3 f)
+{
+    vec3 uvw = clamp(f, 0.0, 1.0) * earth_WindTexScale + earth_WindTexOffset;
+    return mix(texture3D(earth_WindField0, uvw).xyz, texture3D(earth_WindField1, uvw).xyz, earth_WindBlend);
+}
+
+vec3 speedColor(float speed)
+{
+    float s = clamp(speed / 30.0, 0.0, 1.0);
+    vec3 calm = vec3(0.35, 0.65, 1.0);
+    vec3 fresh = vec3(0.4, 1.0, 0.5);
+    vec3 strong = vec3(1.0, 0.85, 0.3);
+    vec3 gale = vec3(1.0, 0.3, 0.25);
+    return s < 0.33 ? mix(calm, fresh, s / 0.33) : (s < 0.66 ? mix(fresh, strong, (s - 0.33) / 0.33) : mix(strong, gale, (s - 0.66) / 0.34));
+}
+
+void main()
+{
+    // gl_Vertex.xyz 为网格归一化坐标中的种子，w 为寿命相位；纹理坐标 x 为沿拖尾的序号
+    float trail = gl_MultiTexCoord0.x;
+    float age = fract(earth_WindTime / earth_WindLifetime + gl_Vertex.w) * earth_WindLifetime;
+    float t = max(age - trail * earth_WindTrailSeconds, 0.0);
+
+    vec3 span = vec3(2.0 * earth_WindDomain.xy, max(earth_WindDomain.w - earth_WindDomain.z, 1.0));
+    float dt = t * earth_WindSpeedScale / float(kSteps);
+    vec3 f = gl_Vertex.xyz;
+    for (int i = 0; i < kSteps; ++i) {
+        vec3 mid = f + 0.5 * dt * windAt(f) / span;
+        f += dt * windAt(mid) / span;
+    }
+
+    vec3 p = vec3((f.xy * 2.0 - 1.0) * earth_WindDomain.xy, mix(earth_WindDomain.z, earth_WindDomain.w, f.z));
+    p.z -= dot(p.xy, p.xy) / (2.0 * 6371000.0);
+
+    float life = age / earth_WindLifetime;
+    float inside = step(0.0, f.x) * step(f.x, 1.0) * step(0.0, f.y) * step(f.y, 1.0);
+    float alpha = smoothstep(0.0, 0.1, life) * (1.0 - smoothstep(0.8, 1.0, life)) * inside;
+    v_color = vec4(speedColor(length(windAt(f).xy)), alpha * (1.0 - trail / earth_WindTrailCount));
+
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 1.0);
+}
+)";
+
+const char* const kFragmentShader = R"(#version 120
+varying vec4 v_color;
+
+void main()
+{
+    gl_FragColor = v_color;
+}
+)";
+
+/**
+ * @brief 在 update 遍历中推进粒子动画时间。
+ */
+class WindAnimationCallback final : public osg::NodeCallback {
+public:
+    explicit WindAnimationCallback(osg::Uniform* time)
+        : m_time(time) {
+    }
+
+    void operator()(osg::Node* node, osg::NodeVisitor* nv) override {
+        if (const osg::FrameStamp* stamp = nv->getFrameStamp()) {
+            m_time->set(static_cast<float>(std::fmod(stamp->getSimulationTime(), kTimeWrapSeconds)));
+        }
+        traverse(node, nv);
+    }
+
+private:
+    osg::ref_ptr<osg::Uniform> m_time;
+};
+
+osg::ref_ptr<osg::Geometry> buildParticleGeometry(unsigned int count) {
+    std::mt19937 rng(20261018U);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+    osg::ref_ptr<osg::Vec4Array> seeds = new osg::Vec4Array();
+    osg::ref_ptr<osg::FloatArray> trails = new osg::FloatArray();
+    seeds->reserve(count * kTrailSegments * 2U);
+    trails->reserve(count * kTrailSegments * 2U);
+    for (unsigned int i = 0; i < count; ++i) {
+        // 高度种子取平方，使粒子更多分布在机场关心的低空。
+        const float height = unit(rng);
+        const osg::Vec4 seed(unit(rng), unit(rng), height * height, unit(rng));
+        for (int segment = 0; segment < kTrailSegments; ++segment) {
+            seeds->push_back(seed);
+            seeds->push_back(seed);
+            trails->push_back(static_cast<float>(segment));
+            trails->push_back(static_cast<float>(segment + 1));
+        }
+    }
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geometry->setName("WindParticles");
+    geometry->setUseDisplayList(false);
+    geometry->setUseVertexBufferObjects(true);
+    geometry->setVertexArray(seeds.get());
+    geometry->setTexCoordArray(0, trails.get(), osg::Array::BIND_PER_VERTEX);
+    geometry->addPrimitiveSet(new osg::DrawArrays(GL_LINES, 0, static_cast<GLsizei>(seeds->size())));
+    return geometry;
+}
+
+osg::ref_ptr<osg::Texture3D> createFieldTexture(const earth::wind::WindGrid& grid, std::size_t step) {
+    const std::vector<std::uint16_t> volume = grid.halfFloatVolume(step);
+    if (volume.empty()) {
+        return nullptr;
+    }
+
+    auto* data = new unsigned char[volume.size() * sizeof(std::uint16_t)];
+    std::memcpy(data, volume.data(), volume.size() * sizeof(std::uint16_t));
+
+    osg::ref_ptr<osg::Image> image = new osg::Image();
+    image->setImage(grid.sizeX(), grid.sizeY(), grid.sizeZ(), GL_RGB16F_ARB, GL_RGB, GL_HALF_FLOAT, data,
+                    osg::Image::USE_NEW_DELETE);
+
+    osg::ref_ptr<osg::Texture3D> texture = new osg::Texture3D(image.get());
+    texture->setName("WindField");
+    texture->setInternalFormat(GL_RGB16F_ARB);
+    texture->setSourceFormat(GL_RGB);
+    texture->setSourceType(GL_HALF_FLOAT);
+    texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+    texture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+    texture->setWrap(osg::Texture::WRAP_R, osg::Texture::CLAMP_TO_EDGE);
+    texture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+    texture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+    texture->setResizeNonPowerOfTwoHint(false);
+    texture->setUnRefImageDataAfterApply(true);
+    return texture;
+}
+} // namespace
+
+namespace earth::wind {
+
+WindLayer::WindLayer(unsigned int particleCount)
+    : m_root(new osg::MatrixTransform())
+    , m_particles(buildParticleGeometry(std::max(particleCount, 1U)))
+    , m_blend(new osg::Uniform("earth_WindBlend", 0.0F))
+    , m_domain(new osg::Uniform("earth_WindDomain", osg::Vec4f()))
+    , m_texScale(new osg::Uniform("earth_WindTexScale", osg::Vec3f(1.0F, 1.0F, 1.0F)))
+    , m_texOffset(new osg::Uniform("earth_WindTexOffset", osg::Vec3f()))
+    , m_speedScale(new osg::Uniform("earth_WindSpeedScale", 1.0F)) {
+    m_root->setName("WindLayer");
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable(m_particles.get());
+    m_root->addChild(geode.get());
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->setName("WindParticleProgram");
+    program->addShader(new osg::Shader(osg::Shader::VERTEX, kVertexShader));
+    program->addShader(new osg::Shader(osg::Shader::FRAGMENT, kFragmentShader));
+
+    osg::ref_ptr<osg::Uniform> time = new osg::Uniform("earth_WindTime", 0.0F);
+    osg::StateSet* stateSet = m_root->getOrCreateStateSet();
+    stateSet->setDataVariance(osg::Object::DYNAMIC);
+    stateSet->setAttributeAndModes(program.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+    stateSet->setAttributeAndModes(new osg::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::Depth(osg::Depth::LESS, 0.0, 1.0, false), osg::StateAttribute::ON);
+    stateSet->setAttributeAndModes(new osg::LineWidth(1.5F), osg::StateAttribute::ON);
+    stateSet->setMode(GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED);
+    stateSet->setRenderingHint(osg::StateSet::TRANSPARENT_BIN);
+    stateSet->addUniform(new osg::Uniform("earth_WindField0", 0));
+    stateSet->addUniform(new osg::Uniform("earth_WindField1", 1));
+    stateSet->addUniform(new osg::Uniform("earth_WindLifetime", kLifetimeSeconds));
+    stateSet->addUniform(new osg::Uniform("earth_WindTrailSeconds", kTrailSeconds));
+    stateSet->addUniform(new osg::Uniform("earth_WindTrailCount", static_cast<float>(kTrailSegments)));
+    for (osg::Uniform* uniform :
+         {time.get(), m_blend.get(), m_domain.get(), m_texScale.get(), m_texOffset.get(), m_speedScale.get()}) {
+        stateSet->addUniform(uniform);
+    }
+
+    m_updateCallback = new WindAnimationCallback(time.get());
+    m_root->setUpdateCallback(m_updateCallback.get());
+    m_root->setNodeMask(0U);
+}
+
+WindLayer::~WindLayer() {
+    if (m_root.valid()) {
+        m_root->setUpdateCallback(nullptr);
+    }
+    detachRoot();
+}
+
+void WindLayer::setMapNode(osgEarth::MapNode* node) {
+    if (m_mapNode.get() == node) {
+        return;
+    }
+    detachRoot();
+    m_mapNode = node;
+    updatePlacement();
+    attachRoot();
+}
+
+bool WindLayer::load(const QString& descriptorPath) {
+    if (!m_grid.load(descriptorPath)) {
+        return false;
+    }
+
+    rebuildTextures();
+    updatePlacement();
+    setForecastTime(m_grid.times().front());
+    setEnabled(m_enabled);
+    return true;
+}
+
+void WindLayer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    m_root->setNodeMask(enabled && hasData() ? ~0U : 0U);
+}
+
+void WindLayer::setForecastTime(double epochSeconds) {
+    m_forecastTime = epochSeconds;
+    if (m_textures.empty()) {
+        return;
+    }
+
+    std::size_t step0 = 0;
+    std::size_t step1 = 0;
+    float blend = 0.0F;
+    m_grid.locateTime(epochSeconds, step0, step1, blend);
+
+    // 只切换绑定的两个时次纹理，纹理本身在加载时一次性上传。
+    osg::StateSet* stateSet = m_root->getOrCreateStateSet();
+    stateSet->setTextureAttribute(0, m_textures[step0].get(), osg::StateAttribute::ON);
+    stateSet->setTextureAttribute(1, m_textures[step1].get(), osg::StateAttribute::ON);
+    m_blend->set(blend);
+}
+
+bool WindLayer::sampleAt(double lonDeg, double latDeg, double altitudeMeters, WindSample& out) const {
+    return m_grid.sample(lonDeg, latDeg, altitudeMeters, m_forecastTime, out);
+}
+
+void WindLayer::rebuildTextures() {
+    m_textures.clear();
+    for (std::size_t step = 0; step < m_grid.times().size(); ++step) {
+        m_textures.push_back(createFieldTexture(m_grid, step));
+    }
+
+    // 网格点位于纹素中心：归一化坐标 f ∈ [0,1] 映射到 [0.5/n, 1-0.5/n]。
+    const auto scale = [](int n) { return n > 1 ? static_cast<float>(n - 1) / static_cast<float>(n) : 0.0F; };
+    const auto offset = [](int n) { return 0.5F / static_cast<float>(std::max(n, 1)); };
+    m_texScale->set(osg::Vec3f(scale(m_grid.sizeX()), scale(m_grid.sizeY()), scale(m_grid.sizeZ())));
+    m_texOffset->set(osg::Vec3f(offset(m_grid.sizeX()), offset(m_grid.sizeY()), offset(m_grid.sizeZ())));
+}
+
+void WindLayer::updatePlacement() {
+    if (!hasData()) {
+        return;
+    }
+
+    const double centerLon = 0.5 * (m_grid.lonMin() + m_grid.lonMax());
+    const double centerLat = 0.5 * (m_grid.latMin() + m_grid.latMax());
+    const double halfWidth =
+        0.5 * (m_grid.lonMax() - m_grid.lonMin()) * kMetersPerDegree * std::cos(osg::DegreesToRadians(centerLat));
+    const double halfHeight = 0.5 * (m_grid.latMax() - m_grid.latMin()) * kMetersPerDegree;
+    m_domain->set(osg::Vec4f(static_cast<float>(halfWidth), static_cast<float>(halfHeight),
+                             static_cast<float>(m_grid.altitudeMin()), static_cast<float>(m_grid.altitudeMax())));
+    m_speedScale->set(static_cast<float>(0.3 * 2.0 * halfWidth / (kReferenceSpeedMps * kLifetimeSeconds)));
+
+    // 着色器在网格中心的局部 ENU 坐标中输出位置，包围盒据此给出，参与近远平面计算。
+    m_particles->setInitialBound(osg::BoundingBox(-halfWidth, -halfHeight, m_grid.altitudeMin() - 1000.0, halfWidth,
+                                                  halfHeight, m_grid.altitudeMax()));
+    m_particles->dirtyBound();
+
+    osgEarth::MapNode* mapNode = m_mapNode.get();
+    if (mapNode == nullptr || mapNode->getMapSRS() == nullptr) {
+        return;
+    }
+    const osgEarth::GeoPoint center(osgEarth::SpatialReference::get("wgs84"), centerLon, centerLat, 0.0,
+                                    osgEarth::ALTMODE_ABSOLUTE);
+    osg::Matrixd localToWorld;
+    if (center.transform(mapNode->getMapSRS()).createLocalToWorld(localToWorld)) {
+        m_root->setMatrix(localToWorld);
+    }
+}
+
+void WindLayer::attachRoot() {
+    osgEarth::MapNode* node = m_mapNode.get();
+    if (node == nullptr || !m_root.valid()) {
+        return;
+    }
+    if (!node->containsNode(m_root.get())) {
+        node->addChild(m_root.get());
+    }
+}
+
+void WindLayer::detachRoot() {
+    osgEarth::MapNode* node = m_mapNode.get();
+    if (node != nullptr && m_root.valid()) {
+        node->removeChild(m_root.get());
+    }
+}
+
+} // namespace earth::wind
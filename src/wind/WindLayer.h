@@ -0,0 +1,89 @@
+#pragma once
+
+#include "wind/WindGrid.h"
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <vector>
+
+namespace osg {
+class Geometry;
+class MatrixTransform;
+class Node;
+class NodeCallback;
+class Texture3D;
+class Uniform;
+} // namespace osg
+
+namespace osgEarth {
+class MapNode;
+}
+
+namespace earth::wind {
+
+/**
+ * @brief 风场图层：持有风场网格，把各时次上传为 half-float 三维纹理，并在 GPU 上平流粒子显示风场。
+ *
+ * 粒子轨迹完全在顶点着色器中积分（每个顶点从种子出发做固定步数的中点法积分），
+ * 相邻两个时次的纹理按混合系数插值；CPU 侧采样（如跑道侧风）直接使用同一份网格。
+ */
+class WindLayer {
+public:
+    static constexpr unsigned int kDefaultParticles = 4096;
+
+    explicit WindLayer(unsigned int particleCount = kDefaultParticles);
+    ~WindLayer();
+
+    WindLayer(const WindLayer&) = delete;
+    WindLayer& operator=(const WindLayer&) = delete;
+
+    /**
+     * @brief 更新挂载的 MapNode，图层根节点随之迁移并按新地图坐标系重新定位。
+     */
+    void setMapNode(osgEarth::MapNode* node);
+
+    /**
+     * @brief 加载风场描述文件，成功后重建纹理并把预报时刻置于首个时次。
+     */
+    bool load(const QString& descriptorPath);
+
+    [[nodiscard]] const WindGrid& grid() const noexcept { return m_grid; }
+    [[nodiscard]] bool hasData() const noexcept { return m_grid.isValid(); }
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const noexcept { return m_enabled; }
+
+    /**
+     * @brief 设置预报时刻（UTC 秒），切换绑定的两个时次纹理并更新混合系数。
+     */
+    void setForecastTime(double epochSeconds);
+    [[nodiscard]] double forecastTime() const noexcept { return m_forecastTime; }
+
+    /**
+     * @brief 在当前预报时刻采样风矢量，位置超出网格时返回 false。
+     */
+    bool sampleAt(double lonDeg, double latDeg, double altitudeMeters, WindSample& out) const;
+
+private:
+    void rebuildTextures();
+    void updatePlacement();
+    void attachRoot();
+    void detachRoot();
+
+    WindGrid m_grid;
+    osg::ref_ptr<osg::MatrixTransform> m_root;
+    osg::ref_ptr<osg::Geometry> m_particles;
+    osg::ref_ptr<osg::NodeCallback> m_updateCallback;
+    osg::observer_ptr<osgEarth::MapNode> m_mapNode;
+    std::vector<osg::ref_ptr<osg::Texture3D>> m_textures;
+    osg::ref_ptr<osg::Uniform> m_blend;
+    osg::ref_ptr<osg::Uniform> m_domain;
+    osg::ref_ptr<osg::Uniform> m_texScale;
+    osg::ref_ptr<osg::Uniform> m_texOffset;
+    osg::ref_ptr<osg::Uniform> m_speedScale;
+    double m_forecastTime = 0.0;
+    bool m_enabled = false;
+};
+
+} // namespace earth::wind
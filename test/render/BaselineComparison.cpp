@@ -0,0 +1,79 @@
+#include "render/BaselineComparison.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+
+namespace earth::bench {
+namespace {
+
+double absoluteSlack(const QString& metric) {
+    if (metric.startsWith(QStringLiteral("residentMb"))) {
+        return 16.0;
+    }
+    if (metric.startsWith(QStringLiteral("paging"))) {
+        return 2.0;
+    }
+    return 0.5; // 毫秒
+}
+
+} // namespace
+
+bool BaselineComparison::load(const QString& path, QJsonObject& baseline) {
+    QFile file(path);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[RenderBench] 无法打开基线" << path << file.errorString();
+        return false;
+    }
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    if (!document.isObject()) {
+        qWarning() << "[RenderBench] 基线解析失败" << path;
+        return false;
+    }
+    baseline = document.object();
+    return true;
+}
+
+bool BaselineComparison::save(const QString& path, const QJsonObject& metrics, const QString& renderer) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[RenderBench] 无法写入基线" << path << file.errorString();
+        return false;
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("renderer"), renderer);
+    root.insert(QStringLiteral("metrics"), metrics);
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+ComparisonResult BaselineComparison::compare(const QJsonObject& metrics, const QJsonObject& baseline,
+                                             double tolerance) {
+    ComparisonResult result;
+    const QJsonObject reference = baseline.value(QStringLiteral("metrics")).toObject();
+    result.hasBaseline = !reference.isEmpty();
+
+    for (auto it = reference.begin(); it != reference.end(); ++it) {
+        if (!metrics.contains(it.key())) {
+            continue;
+        }
+        const double expected = it.value().toDouble();
+        const double actual = metrics.value(it.key()).toDouble();
+        const double limit = expected * (1.0 + tolerance) + absoluteSlack(it.key());
+        const QString line = QStringLiteral("%1: %2 -> %3").arg(it.key()).arg(expected, 0, 'f', 2).arg(actual, 0, 'f', 2);
+        if (actual > limit) {
+            result.regressions << line;
+        } else if (actual < expected * (1.0 - tolerance) - absoluteSlack(it.key())) {
+            result.improvements << line;
+        }
+    }
+    return result;
+}
+
+} // namespace earth::bench
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+namespace earth::bench {
+
+/**
+ * @brief 与基线比较的结果；regressions 为空表示通过。
+ */
+struct ComparisonResult {
+    bool hasBaseline = false;
+    QStringList regressions;
+    QStringList improvements;
+};
+
+/**
+ * @brief 基线文件读写与比较。基线为 FrameRecorder::summary() 的 JSON，外加记录时的渲染器名称：
+ * @code
+ * { "renderer": "llvmpipe (LLVM 15.0.7, 256 bits)", "metrics": { "frameMsMedian": 14.2, ... } }
+ * @endcode
+ * 所有指标都是越小越好；当前值超过 基线 × (1 + tolerance) + 绝对余量 时判为回退。
+ * 绝对余量避免亚毫秒级指标因计时抖动误报。
+ */
+class BaselineComparison {
+public:
+    static constexpr double kDefaultTolerance = 0.15;
+
+    static bool load(const QString& path, QJsonObject& baseline);
+    static bool save(const QString& path, const QJsonObject& metrics, const QString& renderer);
+
+    static ComparisonResult compare(const QJsonObject& metrics, const QJsonObject& baseline, double tolerance);
+};
+
+} // namespace earth::bench
@@ -0,0 +1,144 @@
+#include "render/FrameRecorder.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include <osg/Camera>
+#include <osg/FrameStamp>
+#include <osg/Stats>
+#include <osgDB/DatabasePager>
+#include <osgViewer/Viewer>
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace earth::bench {
+namespace {
+
+double statMs(osg::Stats* stats, unsigned int frameNumber, const std::string& name) {
+    double seconds = 0.0;
+    if (stats != nullptr && stats->getAttribute(frameNumber, name, seconds)) {
+        return seconds * 1000.0;
+    }
+    return 0.0;
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto index = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+    auto nth = values.begin() + static_cast<std::ptrdiff_t>(index);
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+} // namespace
+
+void FrameRecorder::enableStats(osgViewer::Viewer& viewer) {
+    if (osg::Stats* stats = viewer.getCamera()->getStats()) {
+        stats->collectStats("rendering", true);
+    }
+}
+
+double FrameRecorder::residentMemoryMb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<double>(counters.WorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#elif defined(__linux__)
+    std::FILE* file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0.0;
+    }
+    long pages = 0;
+    long resident = 0;
+    const int read = std::fscanf(file, "%ld %ld", &pages, &resident);
+    std::fclose(file);
+    if (read != 2) {
+        return 0.0;
+    }
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+    return 0.0;
+#endif
+}
+
+void FrameRecorder::record(osgViewer::Viewer& viewer, double frameMs) {
+    FrameSample sample;
+    sample.frame = static_cast<int>(m_samples.size());
+    sample.frameMs = frameMs;
+
+    const osg::FrameStamp* stamp = viewer.getFrameStamp();
+    osg::Stats* stats = viewer.getCamera()->getStats();
+    if (stamp != nullptr) {
+        sample.cullMs = statMs(stats, stamp->getFrameNumber(), "Cull traversal time taken");
+        sample.drawMs = statMs(stats, stamp->getFrameNumber(), "Draw traversal time taken");
+    }
+    if (const osgDB::DatabasePager* pager = viewer.getDatabasePager()) {
+        sample.pagingRequests = static_cast<int>(pager->getFileRequestListSize() + pager->getDataToCompileListSize() +
+                                                 pager->getDataToMergeListSize());
+    }
+    sample.residentMb = residentMemoryMb();
+    m_samples.push_back(sample);
+}
+
+QJsonObject FrameRecorder::summary() const {
+    QJsonObject result;
+    if (m_samples.empty()) {
+        return result;
+    }
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(m_samples.size());
+    double cullSum = 0.0;
+    double drawSum = 0.0;
+    int pagingPeak = 0;
+    double residentPeak = 0.0;
+    for (const FrameSample& sample : m_samples) {
+        frameTimes.push_back(sample.frameMs);
+        cullSum += sample.cullMs;
+        drawSum += sample.drawMs;
+        pagingPeak = std::max(pagingPeak, sample.pagingRequests);
+        residentPeak = std::max(residentPeak, sample.residentMb);
+    }
+    const auto count = static_cast<double>(m_samples.size());
+
+    result.insert(QStringLiteral("frameMsMedian"), percentile(frameTimes, 0.5));
+    result.insert(QStringLiteral("frameMsP95"), percentile(frameTimes, 0.95));
+    result.insert(QStringLiteral("frameMsMax"), *std::max_element(frameTimes.begin(), frameTimes.end()));
+    result.insert(QStringLiteral("cullMsMean"), cullSum / count);
+    result.insert(QStringLiteral("drawMsMean"), drawSum / count);
+    result.insert(QStringLiteral("pagingRequestsPeak"), pagingPeak);
+    result.insert(QStringLiteral("residentMbPeak"), residentPeak);
+    // 整段路径的内存增长，持续上升通常意味着分页卸载或缓存回收失效。
+    result.insert(QStringLiteral("residentMbGrowth"), m_samples.back().residentMb - m_samples.front().residentMb);
+    return result;
+}
+
+bool FrameRecorder::writeCsv(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "[RenderBench] 无法写入" << path << file.errorString();
+        return false;
+    }
+    QTextStream stream(&file);
+    stream << "frame,frame_ms,cull_ms,draw_ms,paging_requests,resident_mb\n";
+    for (const FrameSample& sample : m_samples) {
+        stream << sample.frame << ',' << sample.frameMs << ',' << sample.cullMs << ',' << sample.drawMs << ','
+               << sample.pagingRequests << ',' << sample.residentMb << '\n';
+    }
+    return true;
+}
+
+} // namespace earth::bench
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <vector>
+
+namespace osgViewer {
+class Viewer;
+}
+
+namespace earth::bench {
+
+/**
+ * @brief 单帧采样。cull/draw 取自 osgViewer 的 rendering 统计，分页计数取自 DatabasePager 队列长度。
+ */
+struct FrameSample {
+    int frame = 0;
+    double frameMs = 0.0;
+    double cullMs = 0.0;
+    double drawMs = 0.0;
+    int pagingRequests = 0; /**< 待读取 + 待编译 + 待合并的分页请求数。 */
+    double residentMb = 0.0;
+};
+
+/**
+ * @brief 逐帧记录渲染指标，汇总为可与基线比较的统计量。
+ */
+class FrameRecorder {
+public:
+    /**
+     * @brief 打开 Viewer 主相机的 rendering 统计，必须在第一帧之前调用。
+     */
+    static void enableStats(osgViewer::Viewer& viewer);
+
+    /**
+     * @brief 进程当前常驻内存（MB），平台不支持时返回 0。
+     */
+    static double residentMemoryMb();
+
+    /**
+     * @brief 在 viewer.frame() 返回后调用，记录刚结束的一帧。
+     */
+    void record(osgViewer::Viewer& viewer, double frameMs);
+
+    [[nodiscard]] const std::vector<FrameSample>& samples() const noexcept { return m_samples; }
+
+    /**
+     * @brief 汇总统计：帧时间中位数/P95/最大值、cull/draw 平均值、分页峰值、内存峰值与增长量。
+     */
+    [[nodiscard]] QJsonObject summary() const;
+
+    bool writeCsv(const QString& path) const;
+
+private:
+    std::vector<FrameSample> m_samples;
+};
+
+} // namespace earth::bench
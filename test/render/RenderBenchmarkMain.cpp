@@ -0,0 +1,137 @@
+#include "render/BaselineComparison.h"
+#include "render/FrameRecorder.h"
+#include "render/RenderScenario.h"
+
+#include "core/SimulationBootstrapper.h"
+#include "headless/OffscreenViewer.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+
+#include <osgViewer/Viewer>
+
+namespace {
+constexpr int kExitRegression = 1;
+constexpr int kExitSetupFailed = 2;
+// 没有可比较的基线（缺失或渲染器不同）时返回，ctest 以 SKIP_RETURN_CODE 报告为跳过而不是通过。
+constexpr int kExitNoBaseline = 77;
+
+void applyKey(earth::headless::OffscreenViewer& view, const earth::bench::CameraKey& key) {
+    view.setViewpoint(view.makeViewpoint(key.longitude, key.latitude, key.altitude, key.heading, key.pitch, key.range));
+}
+} // namespace
+
+/**
+ * @brief 渲染回归基准：离屏加载参考场景，沿脚本路径逐帧渲染并记录帧时间、cull/draw、分页与内存，
+ * 与保存的基线比较，超出容差时返回非零退出码供 ctest 判定失败。
+ */
+int main(int argc, char* argv[]) {
+    QCoreApplication::setOrganizationName(QStringLiteral("EarthSimLab"));
+    QCoreApplication::setApplicationName(QStringLiteral("earth-render-bench"));
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("机场三维场景渲染回归基准。"));
+    parser.addHelpOption();
+    const QCommandLineOption scenarioOption(QStringLiteral("scenario"), QStringLiteral("场景 JSON。"),
+                                            QStringLiteral("file"));
+    const QCommandLineOption baselineOption(QStringLiteral("baseline"), QStringLiteral("基线 JSON。"),
+                                            QStringLiteral("file"));
+    const QCommandLineOption outputOption(QStringLiteral("output"), QStringLiteral("结果输出目录。"),
+                                          QStringLiteral("dir"), QStringLiteral("."));
+    const QCommandLineOption toleranceOption(QStringLiteral("tolerance"), QStringLiteral("相对容差，默认 0.15。"),
+                                             QStringLiteral("ratio"),
+                                             QString::number(earth::bench::BaselineComparison::kDefaultTolerance));
+    const QCommandLineOption updateOption(QStringLiteral("update-baseline"), QStringLiteral("用本次结果覆盖基线。"));
+    parser.addOptions({scenarioOption, baselineOption, outputOption, toleranceOption, updateOption});
+    parser.process(app);
+
+    earth::bench::RenderScenario scenario;
+    if (!scenario.load(parser.value(scenarioOption))) {
+        return kExitSetupFailed;
+    }
+
+    earth::headless::OffscreenViewer view;
+    if (!view.initialize(scenario.earthFile, scenario.width, scenario.height) || !view.realize()) {
+        qWarning() << "[RenderBench] 无法创建离屏视图";
+        return kExitSetupFailed;
+    }
+    earth::bench::FrameRecorder::enableStats(*view.viewer());
+    if (scenario.hasTime) {
+        view.simulation().skyTime().setEpochSeconds(scenario.epochSeconds);
+    }
+
+    // 仿真时间按固定步长推进，帧内容与机器快慢无关，只有耗时随机器变化。
+    const double step = 1.0 / scenario.frameRate;
+    double simulationTime = 0.0;
+    applyKey(view, scenario.sample(0.0));
+    for (int i = 0; i < scenario.warmupFrames; ++i) {
+        view.frame(simulationTime);
+        simulationTime += step;
+    }
+
+    earth::bench::FrameRecorder recorder;
+    QElapsedTimer timer;
+    const int frames = scenario.frameCount();
+    for (int i = 0; i < frames; ++i) {
+        applyKey(view, scenario.sample(static_cast<double>(i) * step));
+        timer.start();
+        // 颜色附件回读到 osg::Image 会等待 GPU 完成，帧时间因此包含真实的绘制耗时。
+        view.frame(simulationTime);
+        recorder.record(*view.viewer(), static_cast<double>(timer.nsecsElapsed()) / 1.0e6);
+        simulationTime += step;
+    }
+
+    const QString renderer = view.rendererName();
+    const QDir outputDir(parser.value(outputOption));
+    QDir().mkpath(outputDir.absolutePath());
+    recorder.writeCsv(outputDir.filePath(scenario.name + QStringLiteral(".csv")));
+    view.grab().save(outputDir.filePath(scenario.name + QStringLiteral(".png")));
+    view.close();
+
+    const QJsonObject metrics = recorder.summary();
+    QFile summaryFile(outputDir.filePath(scenario.name + QStringLiteral(".summary.json")));
+    if (summaryFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        summaryFile.write(QJsonDocument(metrics).toJson(QJsonDocument::Indented));
+    }
+    qInfo().noquote() << "[RenderBench]" << scenario.name << renderer << frames << "帧"
+                      << QString::fromUtf8(QJsonDocument(metrics).toJson(QJsonDocument::Compact));
+
+    const QString baselinePath = parser.value(baselineOption);
+    if (parser.isSet(updateOption)) {
+        if (baselinePath.isEmpty()) {
+            qWarning() << "[RenderBench] --update-baseline 需要 --baseline";
+            return kExitSetupFailed;
+        }
+        return earth::bench::BaselineComparison::save(baselinePath, metrics, renderer) ? 0 : kExitSetupFailed;
+    }
+
+    QJsonObject baseline;
+    if (baselinePath.isEmpty() || !earth::bench::BaselineComparison::load(baselinePath, baseline)) {
+        // 没有基线时只产出候选文件，首次在目标机器上运行后人工确认再提交。
+        const QString candidate = outputDir.filePath(scenario.name + QStringLiteral(".baseline.json"));
+        earth::bench::BaselineComparison::save(candidate, metrics, renderer);
+        qWarning() << "[RenderBench] 无基线，已写出候选基线" << candidate;
+        return kExitNoBaseline;
+    }
+    const QString baselineRenderer = baseline.value(QStringLiteral("renderer")).toString();
+    if (baselineRenderer != renderer) {
+        qWarning() << "[RenderBench] 基线渲染器" << baselineRenderer << "与当前" << renderer << "不同，跳过比较";
+        return kExitNoBaseline;
+    }
+
+    const earth::bench::ComparisonResult result =
+        earth::bench::BaselineComparison::compare(metrics, baseline, parser.value(toleranceOption).toDouble());
+    for (const QString& line : result.improvements) {
+        qInfo().noquote() << "[RenderBench] 改善" << line;
+    }
+    for (const QString& line : result.regressions) {
+        qWarning().noquote() << "[RenderBench] 回退" << line;
+    }
+    return result.regressions.isEmpty() ? 0 : kExitRegression;
+}
@@ -0,0 +1,124 @@
+#include "render/RenderScenario.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+
+namespace earth::bench {
+namespace {
+
+double lerp(double a, double b, double t) {
+    return a + (b - a) * t;
+}
+
+double lerpHeading(double a, double b, double t) {
+    double delta = std::fmod(b - a, 360.0);
+    if (delta > 180.0) {
+        delta -= 360.0;
+    } else if (delta < -180.0) {
+        delta += 360.0;
+    }
+    return a + delta * t;
+}
+
+} // namespace
+
+bool RenderScenario::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[RenderBench] 无法打开场景文件" << path << file.errorString();
+        return false;
+    }
+
+    QJsonParseError parseError {};
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!document.isObject()) {
+        qWarning() << "[RenderBench] 场景文件解析失败" << path << parseError.errorString();
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    const QDir baseDir = QFileInfo(path).absoluteDir();
+    name = root.value(QStringLiteral("name")).toString(QFileInfo(path).completeBaseName());
+    const QString earth = root.value(QStringLiteral("earthFile")).toString();
+    earthFile = earth.isEmpty() ? QString() : baseDir.absoluteFilePath(earth);
+    width = std::max(root.value(QStringLiteral("width")).toInt(width), 16);
+    height = std::max(root.value(QStringLiteral("height")).toInt(height), 16);
+    warmupFrames = std::max(root.value(QStringLiteral("warmupFrames")).toInt(warmupFrames), 0);
+    frameRate = std::max(root.value(QStringLiteral("frameRate")).toDouble(frameRate), 1.0);
+
+    if (root.contains(QStringLiteral("skyTime"))) {
+        const QDateTime time = QDateTime::fromString(root.value(QStringLiteral("skyTime")).toString(), Qt::ISODate);
+        if (!time.isValid()) {
+            qWarning() << "[RenderBench] skyTime 无效" << path;
+            return false;
+        }
+        epochSeconds = static_cast<double>(time.toMSecsSinceEpoch()) / 1000.0;
+        hasTime = true;
+    }
+
+    this->path.clear();
+    for (const QJsonValue& value : root.value(QStringLiteral("path")).toArray()) {
+        const QJsonObject object = value.toObject();
+        CameraKey key;
+        key.time = object.value(QStringLiteral("t")).toDouble();
+        key.longitude = object.value(QStringLiteral("lon")).toDouble();
+        key.latitude = object.value(QStringLiteral("lat")).toDouble();
+        key.altitude = object.value(QStringLiteral("alt")).toDouble(key.altitude);
+        key.heading = object.value(QStringLiteral("heading")).toDouble(key.heading);
+        key.pitch = std::clamp(object.value(QStringLiteral("pitch")).toDouble(key.pitch), -90.0, 0.0);
+        key.range = std::max(object.value(QStringLiteral("range")).toDouble(key.range), 1.0);
+        if (!this->path.empty() && key.time <= this->path.back().time) {
+            qWarning() << "[RenderBench] 相机路径未按时间递增" << path;
+            return false;
+        }
+        this->path.push_back(key);
+    }
+    if (this->path.size() < 2) {
+        qWarning() << "[RenderBench] 相机路径至少需要两个关键帧" << path;
+        return false;
+    }
+    return true;
+}
+
+int RenderScenario::frameCount() const {
+    return std::max(1, static_cast<int>(std::lround(duration() * frameRate)) + 1);
+}
+
+CameraKey RenderScenario::sample(double t) const {
+    if (path.empty()) {
+        return {};
+    }
+    if (t <= path.front().time) {
+        return path.front();
+    }
+    if (t >= path.back().time) {
+        return path.back();
+    }
+
+    const auto upper = std::upper_bound(path.begin(), path.end(), t,
+                                        [](double time, const CameraKey& key) { return time < key.time; });
+    const CameraKey& b = *upper;
+    const CameraKey& a = *(upper - 1);
+    const double s = (t - a.time) / (b.time - a.time);
+
+    CameraKey key;
+    key.time = t;
+    key.longitude = lerp(a.longitude, b.longitude, s);
+    key.latitude = lerp(a.latitude, b.latitude, s);
+    key.altitude = lerp(a.altitude, b.altitude, s);
+    key.heading = lerpHeading(a.heading, b.heading, s);
+    key.pitch = lerp(a.pitch, b.pitch, s);
+    key.range = std::exp(lerp(std::log(a.range), std::log(b.range), s));
+    return key;
+}
+
+} // namespace earth::bench
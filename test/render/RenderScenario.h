@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QString>
+
+#include <vector>
+
+namespace earth::bench {
+
+/**
+ * @brief 相机路径关键帧：时间（秒）与 EarthManipulator 语义的视点。
+ */
+struct CameraKey {
+    double time = 0.0;
+    double longitude = 0.0;
+    double latitude = 0.0;
+    double altitude = 0.0;
+    double heading = 0.0;
+    double pitch = -45.0;
+    double range = 2000.0;
+};
+
+/**
+ * @brief 渲染基准场景：参考 .earth 场景 + 脚本化相机路径。
+ * @code
+ * {
+ *   "name": "default-airport-flyover",
+ *   "earthFile": "",
+ *   "width": 1280, "height": 720,
+ *   "warmupFrames": 60, "frameRate": 30,
+ *   "skyTime": "2021-04-21T14:00:00Z",
+ *   "path": [
+ *     { "t": 0,  "lon": 0.0, "lat": 0.0, "heading": 0,   "pitch": -20, "range": 8000 },
+ *     { "t": 10, "lon": 0.0, "lat": 0.0, "heading": 180, "pitch": -60, "range": 1500 }
+ *   ]
+ * }
+ * @endcode
+ * earthFile 为空时使用内置默认机场场景，相对路径相对于场景文件所在目录。
+ * 路径按 1/frameRate 的固定仿真步长逐帧插值：经纬度、高度与俯仰线性插值，航向取最短弧，距离按对数插值。
+ */
+struct RenderScenario {
+    QString name;
+    QString earthFile;
+    int width = 1280;
+    int height = 720;
+    int warmupFrames = 60;
+    double frameRate = 30.0;
+    double epochSeconds = 0.0;
+    bool hasTime = false;
+    std::vector<CameraKey> path;
+
+    bool load(const QString& path);
+
+    [[nodiscard]] double duration() const { return path.empty() ? 0.0 : path.back().time; }
+    [[nodiscard]] int frameCount() const;
+
+    /**
+     * @brief 路径上 t 时刻的视点，t 超出范围时取端点。
+     */
+    [[nodiscard]] CameraKey sample(double t) const;
+};
+
+} // namespace earth::bench